@@ -0,0 +1,319 @@
+// ----------------------------------------------------------------------------
+// LightWare I2C API bus sizing benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_i2c_grf500_simulator.h"
+#include "lw_platform_linux_i2c_bus.h"
+
+// Bus time simulated for every case.
+#define BENCHMARK_BUS_TIME_US 2000000
+
+// Poll rate asked of every sensor to saturate the bus.
+#define BENCHMARK_SATURATE_HZ 1000000.0f
+
+// Fastest update rate of the device, used to size deployments.
+#define BENCHMARK_DEVICE_RATE_HZ 10.0f
+
+// Sensors are commissioned on the default address, then moved from here up.
+#define BENCHMARK_DEFAULT_ADDRESS 0x66
+#define BENCHMARK_BASE_ADDRESS 0x10
+
+// The fault runs fail reads on purpose, so keep the bus logs out of the results.
+void lw_debug_print(const char *format, ...) {
+    (void)format;
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+static lw_i2c_simulator_bus bus;
+static lw_i2c_grf500_simulator devices[LW_I2C_BUS_MAX_SENSORS];
+static lw_i2c_simulator_device clients[LW_I2C_BUS_MAX_SENSORS];
+
+typedef struct {
+    uint64_t reads;
+    uint64_t errors;
+    uint64_t transfers;
+    uint64_t busy_ns;
+    uint64_t elapsed_us;
+    uint64_t host_us;
+} benchmark_result;
+
+// ----------------------------------------------------------------------------
+// Put sensors on a fresh bus, and set them up through the API the way they
+// would be commissioned: one at a time on the default address, then moved.
+// ----------------------------------------------------------------------------
+static void setup_bus(uint32_t clock_hz, uint32_t sensor_count, lw_grf500_distance_config config, float fault_probability) {
+    lw_i2c_simulator_bus_config bus_config;
+    lw_i2c_simulator_bus_get_default_config(&bus_config);
+    bus_config.clock_hz = clock_hz;
+    check_success(lw_i2c_simulator_bus_init(&bus, &bus_config), "Invalid bus config");
+
+    for (uint32_t i = 0; i < sensor_count; ++i) {
+        lw_i2c_grf500_simulator_config device_config;
+        lw_i2c_grf500_simulator_get_default_config(&device_config);
+        device_config.seed = i + 1;
+        device_config.distance_cm = 500 + 100 * (int32_t)i;
+        check_success(lw_i2c_grf500_simulator_init(&devices[i], &device_config), "Invalid device config");
+        check_success(lw_i2c_simulator_bus_attach(&bus, &devices[i]), "Failed to attach device");
+
+        lw_i2c_simulator_device_init(&clients[i], &bus, BENCHMARK_DEFAULT_ADDRESS);
+        check_success(lw_grf500_set_distance_config(&clients[i].device, config), "Failed to set distance config");
+        check_success(lw_grf500_set_i2c_address(&clients[i].device, (uint8_t)(BENCHMARK_BASE_ADDRESS + i)), "Failed to set I2C address");
+        clients[i].address = (uint8_t)(BENCHMARK_BASE_ADDRESS + i);
+
+        // Faults start once the sensors are set up.
+        devices[i].config.nak_probability = fault_probability;
+        devices[i].config.corrupt_probability = fault_probability / 10;
+        devices[i].config.stretch_fault_probability = fault_probability / 10;
+    }
+
+    memset(&bus.stats, 0, sizeof(bus.stats));
+}
+
+static benchmark_result finish(uint64_t start_us, uint64_t host_start_us, uint64_t reads, uint64_t errors) {
+    benchmark_result result;
+    result.reads = reads;
+    result.errors = errors;
+    result.transfers = bus.stats.transfers;
+    result.busy_ns = bus.stats.busy_ns;
+    result.elapsed_us = lw_i2c_simulator_bus_get_time_us(&bus) - start_us;
+    result.host_us = lw_platform_get_time_us() - host_start_us;
+
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Poll every sensor through the bus scheduler, at a rate per sensor.
+// ----------------------------------------------------------------------------
+static benchmark_result run_scheduler(uint32_t sensor_count, lw_grf500_distance_config config, float rate_hz) {
+    for (uint32_t i = 0; i < sensor_count; ++i) {
+        check_success(lw_i2c_bus_add_sensor(&bus.bus, clients[i].address, config, rate_hz, NULL), "Failed to add sensor");
+    }
+
+    uint64_t start_us = lw_i2c_simulator_bus_get_time_us(&bus);
+    uint64_t end_us = start_us + BENCHMARK_BUS_TIME_US;
+    uint64_t host_start_us = lw_platform_get_time_us();
+
+    // Sensors become due from the start of the run.
+    for (uint32_t i = 0; i < sensor_count; ++i) {
+        bus.bus.sensors[i].next_due_us = start_us;
+    }
+
+    while (1) {
+        uint64_t now_us = lw_i2c_simulator_bus_get_time_us(&bus);
+
+        if (now_us >= end_us) {
+            break;
+        }
+
+        uint64_t next_due_us = lw_i2c_bus_next_due_us(&bus.bus);
+
+        if (next_due_us > now_us) {
+            lw_i2c_simulator_bus_idle(&bus, ((next_due_us < end_us) ? next_due_us : end_us) - now_us);
+            continue;
+        }
+
+        uint32_t completed = 0;
+        lw_i2c_bus_poll(&bus.bus, now_us, &completed);
+    }
+
+    return finish(start_us, host_start_us, bus.bus.reads, bus.bus.errors);
+}
+
+// ----------------------------------------------------------------------------
+// Check that every sensor reads back its own target, so the bus really talked
+// to each device.
+// ----------------------------------------------------------------------------
+static void check_readings(uint32_t sensor_count, lw_grf500_distance_config config) {
+    for (uint32_t i = 0; i < sensor_count; ++i) {
+        const lw_i2c_grf500_simulator_config *device_config = &devices[i].config;
+        lw_grf500_distance_data_cm distance_data;
+
+        check_success(lw_grf500_get_distance_data(&clients[i].device, config, &distance_data), "Failed to read distance data");
+
+        int32_t distance_cm = distance_data.first_return_raw_cm;
+
+        if (distance_cm < device_config->distance_cm - 50 || distance_cm > device_config->distance_cm + device_config->amplitude_cm + 50) {
+            printf("Sensor at 0x%02X read %d cm, outside its target range\n", clients[i].address, distance_cm);
+            exit(1);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Read every sensor in turn with the managed API, one transfer per read.
+// ----------------------------------------------------------------------------
+static benchmark_result run_managed(uint32_t sensor_count, lw_grf500_distance_config config) {
+    uint64_t start_us = lw_i2c_simulator_bus_get_time_us(&bus);
+    uint64_t end_us = start_us + BENCHMARK_BUS_TIME_US;
+    uint64_t host_start_us = lw_platform_get_time_us();
+    uint64_t reads = 0;
+    uint64_t errors = 0;
+
+    for (uint32_t i = 0; lw_i2c_simulator_bus_get_time_us(&bus) < end_us; i = (i + 1) % sensor_count) {
+        lw_grf500_distance_data_cm distance_data;
+
+        if (lw_grf500_get_distance_data(&clients[i].device, config, &distance_data) == LW_RESULT_SUCCESS) {
+            reads++;
+        } else {
+            errors++;
+        }
+    }
+
+    return finish(start_us, host_start_us, reads, errors);
+}
+
+static void print_result(const char *label, uint32_t sensor_count, lw_grf500_distance_config config, benchmark_result *result) {
+    double seconds = (double)result->elapsed_us / 1000000.0;
+    double reads_per_second = (double)result->reads / seconds;
+    double bus_load = (double)result->busy_ns / 10.0 / (double)result->elapsed_us;
+    double sensor_capacity = reads_per_second / BENCHMARK_DEVICE_RATE_HZ;
+
+    printf("%-10s %7u %5u %10.0f %10.1f %8.1f %6.1f%% %9.0f\n",
+           label,
+           sensor_count,
+           lw_count_bits(config) * 4,
+           reads_per_second,
+           reads_per_second / sensor_count,
+           (result->reads > 0) ? (double)result->elapsed_us / (double)result->reads : 0.0,
+           bus_load,
+           sensor_capacity);
+}
+
+static void print_header(void) {
+    printf("%-10s %7s %5s %10s %10s %8s %7s %9s\n", "clock", "sensors", "bytes", "reads/s", "Hz/sensor", "us/read", "load", "at 10 Hz");
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    uint32_t clocks[] = {100000, 400000, 1000000};
+    const char *clock_names[] = {"100 kHz", "400 kHz", "1 MHz"};
+    uint32_t sensor_counts[] = {1, 2, 4, 8, 16};
+    lw_grf500_distance_config configs[] = {
+        LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW,
+        LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW | LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_STRENGTH,
+        LW_GRF500_DISTANCE_CONFIG_ALL,
+    };
+    uint64_t total_reads = 0;
+    uint64_t total_host_us = 0;
+
+    lw_i2c_simulator_bus_config default_config;
+    lw_i2c_simulator_bus_get_default_config(&default_config);
+
+    printf("Simulated GRF-500 sensors on one I2C bus, %u us transfer overhead, %u ms of bus time per case.\n", default_config.transfer_overhead_us, BENCHMARK_BUS_TIME_US / 1000);
+    printf("The 'at 10 Hz' column is how many sensors the bus can poll at the fastest device update rate.\n");
+
+    // ----------------------------------------------------------------------------
+    // Saturated bus, polled through the scheduler with combined transfers.
+    // ----------------------------------------------------------------------------
+    printf("\nBus scheduler, one combined transfer for all due sensors:\n");
+    print_header();
+
+    for (uint32_t c = 0; c < sizeof(clocks) / sizeof(clocks[0]); ++c) {
+        for (uint32_t f = 0; f < sizeof(configs) / sizeof(configs[0]); ++f) {
+            for (uint32_t s = 0; s < sizeof(sensor_counts) / sizeof(sensor_counts[0]); ++s) {
+                setup_bus(clocks[c], sensor_counts[s], configs[f], 0);
+                benchmark_result result = run_scheduler(sensor_counts[s], configs[f], BENCHMARK_SATURATE_HZ);
+                check_readings(sensor_counts[s], configs[f]);
+                print_result(clock_names[c], sensor_counts[s], configs[f], &result);
+                total_reads += result.reads;
+                total_host_us += result.host_us;
+            }
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // The same, read one sensor at a time through the managed API.
+    // ----------------------------------------------------------------------------
+    printf("\nManaged API, one transfer per read:\n");
+    print_header();
+
+    for (uint32_t c = 0; c < sizeof(clocks) / sizeof(clocks[0]); ++c) {
+        for (uint32_t s = 0; s < sizeof(sensor_counts) / sizeof(sensor_counts[0]); ++s) {
+            setup_bus(clocks[c], sensor_counts[s], configs[1], 0);
+            benchmark_result result = run_managed(sensor_counts[s], configs[1]);
+            print_result(clock_names[c], sensor_counts[s], configs[1], &result);
+            total_reads += result.reads;
+            total_host_us += result.host_us;
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // Bus load with every sensor at the device update rate.
+    // ----------------------------------------------------------------------------
+    printf("\nBus scheduler, every sensor at %.0f Hz:\n", BENCHMARK_DEVICE_RATE_HZ);
+    print_header();
+
+    for (uint32_t c = 0; c < sizeof(clocks) / sizeof(clocks[0]); ++c) {
+        setup_bus(clocks[c], LW_I2C_BUS_MAX_SENSORS, configs[2], 0);
+        benchmark_result result = run_scheduler(LW_I2C_BUS_MAX_SENSORS, configs[2], BENCHMARK_DEVICE_RATE_HZ);
+        print_result(clock_names[c], LW_I2C_BUS_MAX_SENSORS, configs[2], &result);
+        total_reads += result.reads;
+        total_host_us += result.host_us;
+    }
+
+    // ----------------------------------------------------------------------------
+    // Saturated bus with faults. NAKs fail a combined transfer and make the
+    // scheduler retry its sensors one at a time.
+    // ----------------------------------------------------------------------------
+    float faults[] = {0, 0.001f, 0.01f, 0.05f};
+
+    printf("\nBus scheduler at 400 kHz with 8 sensors and faults:\n");
+    printf("%-10s %10s %10s %10s %10s %10s %10s\n", "NAK prob", "reads/s", "errors", "transfers", "timeouts", "flipped", "us/read");
+
+    for (uint32_t f = 0; f < sizeof(faults) / sizeof(faults[0]); ++f) {
+        setup_bus(400000, 8, configs[1], faults[f]);
+        benchmark_result result = run_scheduler(8, configs[1], BENCHMARK_SATURATE_HZ);
+        uint64_t flipped = 0;
+
+        for (uint32_t i = 0; i < 8; ++i) {
+            flipped += devices[i].stats.corrupted_bytes;
+        }
+
+        printf("%-10.3f %10.0f %10llu %10llu %10llu %10llu %10.1f\n",
+               faults[f],
+               (double)result.reads * 1000000.0 / (double)result.elapsed_us,
+               (unsigned long long)result.errors,
+               (unsigned long long)result.transfers,
+               (unsigned long long)bus.stats.stretch_timeouts,
+               (unsigned long long)flipped,
+               (result.reads > 0) ? (double)result.elapsed_us / (double)result.reads : 0.0);
+        total_reads += result.reads;
+        total_host_us += result.host_us;
+    }
+
+    printf("\nSimulated %llu reads in %.3f s of host time, %.2f us each\n", (unsigned long long)total_reads, (double)total_host_us / 1000000.0, (double)total_host_us / (double)total_reads);
+
+    return 0;
+}
@@ -4,4 +4,4 @@ set CFLAGS=-I../ -DLW_DEBUG_LEVEL=1 -O3 -s -Weverything -Wno-declaration-after-s
 set SHARED_SOURCES_LINUX=../lw_i2c_api.c ../lw_i2c_api_grf500.c
 
 zig cc -o ./bin/example_basic example_basic.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
-
+zig cc -o ./bin/example_bus example_bus.c ../lw_i2c_bus.c ../lw_i2c_grf500_distance_decoder.c lw_platform_linux_i2c_bus.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------------------
+// LightWare I2C API bus example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lw_platform_linux_i2c_bus.h"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Platform related setup.
+    // ----------------------------------------------------------------------------
+    lw_platform_i2c_bus platform_bus;
+    check_success(lw_platform_create_i2c_bus("/dev/i2c-1", &platform_bus), "Failed to open I2C bus");
+
+    // ----------------------------------------------------------------------------
+    // Add every sensor on the bus. Each device must already have been given
+    // its own address, distance config and update rate.
+    // ----------------------------------------------------------------------------
+    uint8_t addresses[] = {0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D};
+    uint32_t sensor_count = sizeof(addresses) / sizeof(addresses[0]);
+    lw_grf500_distance_config distance_config = LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW | LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_STRENGTH;
+
+    for (uint32_t i = 0; i < sensor_count; ++i) {
+        check_success(lw_i2c_bus_add_sensor(&platform_bus.bus, addresses[i], distance_config, 10, NULL), "Failed to add sensor");
+    }
+
+    // ----------------------------------------------------------------------------
+    // Poll all sensors for 5 seconds.
+    // ----------------------------------------------------------------------------
+    uint64_t end_time_us = lw_platform_get_time_us() + 5000000;
+
+    while (lw_platform_get_time_us() < end_time_us) {
+        uint64_t now_us = lw_platform_get_time_us();
+        uint64_t next_due_us = lw_i2c_bus_next_due_us(&platform_bus.bus);
+
+        if (next_due_us > now_us) {
+            lw_platform_sleep_us(next_due_us - now_us);
+            continue;
+        }
+
+        uint32_t completed = 0;
+        lw_i2c_bus_poll(&platform_bus.bus, now_us, &completed);
+
+        for (uint32_t i = 0; i < sensor_count; ++i) {
+            lw_grf500_distance_data_cm distance_data;
+
+            if (lw_i2c_bus_get_distance_data(&platform_bus.bus, i, &distance_data, NULL) == LW_RESULT_SUCCESS) {
+                printf("0x%02X: %d cm, strength %d\n", addresses[i], distance_data.first_return_raw_cm, distance_data.first_return_strength);
+            }
+        }
+    }
+
+    printf("Transfers: %llu, reads: %llu, errors: %llu\n",
+           (unsigned long long)platform_bus.bus.transfers,
+           (unsigned long long)platform_bus.bus.reads,
+           (unsigned long long)platform_bus.bus.errors);
+
+    lw_platform_i2c_bus_close(&platform_bus);
+
+    printf("Sample completed\n");
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "lw_platform_linux_i2c_bus.h"
+
+#include <fcntl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+// Platform specific functions.
+// ----------------------------------------------------------------------------
+uint64_t lw_platform_get_time_us(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000 + (uint64_t)time.tv_nsec / 1000;
+}
+
+void lw_platform_sleep_us(uint64_t time_us) {
+    usleep((useconds_t)time_us);
+}
+
+// ----------------------------------------------------------------------------
+// Bus service callbacks.
+// ----------------------------------------------------------------------------
+lw_result lw_platform_i2c_bus_transfer_callback(lw_i2c_bus *bus, lw_i2c_bus_message *messages, uint32_t count) {
+    lw_platform_i2c_bus *platform_bus = (lw_platform_i2c_bus *)bus->user_data;
+    struct i2c_msg i2c_messages[LW_I2C_BUS_MAX_MESSAGES];
+
+    if (count > LW_I2C_BUS_MAX_MESSAGES) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        i2c_messages[i].addr = messages[i].address;
+        i2c_messages[i].flags = (messages[i].flags & LW_I2C_BUS_MESSAGE_READ) ? I2C_M_RD : 0;
+        i2c_messages[i].len = messages[i].size;
+        i2c_messages[i].buf = messages[i].buffer;
+    }
+
+    struct i2c_rdwr_ioctl_data ioctl_data = {i2c_messages, count};
+    int result = ioctl(platform_bus->handle, I2C_RDWR, &ioctl_data);
+
+    if (result != (int)count) {
+        return LW_RESULT_ERROR;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+// Platform context creation.
+// ----------------------------------------------------------------------------
+lw_result lw_platform_create_i2c_bus(const char *bus_device, lw_platform_i2c_bus *platform_bus) {
+    platform_bus->bus = lw_create_i2c_bus(platform_bus, &lw_platform_i2c_bus_transfer_callback);
+    platform_bus->handle = open(bus_device, O_RDWR);
+
+    if (platform_bus->handle < 0) {
+        LW_DEBUG_LVL_1("I2C bus: Failed to open %s\n", bus_device);
+        return LW_RESULT_ERROR;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_platform_i2c_bus_close(lw_platform_i2c_bus *platform_bus) {
+    if (platform_bus->handle >= 0) {
+        close(platform_bus->handle);
+    }
+
+    platform_bus->handle = -1;
+}
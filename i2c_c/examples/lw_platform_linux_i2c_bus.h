@@ -0,0 +1,24 @@
+#ifndef LW_PLATFORM_LINUX_I2C_BUS_H
+#define LW_PLATFORM_LINUX_I2C_BUS_H
+
+#include "lw_i2c_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    lw_i2c_bus bus;
+    int handle;
+} lw_platform_i2c_bus;
+
+lw_result lw_platform_create_i2c_bus(const char *bus_device, lw_platform_i2c_bus *platform_bus);
+void lw_platform_i2c_bus_close(lw_platform_i2c_bus *platform_bus);
+uint64_t lw_platform_get_time_us(void);
+void lw_platform_sleep_us(uint64_t time_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_PLATFORM_LINUX_I2C_BUS_H
@@ -463,7 +463,7 @@ lw_result lw_grf500_create_request_write_stream(lw_request *request, lw_grf500_s
 }
 
 lw_result lw_grf500_create_request_read_distance_data(lw_request *request, lw_grf500_distance_config config) {
-    uint32_t read_size = lw_count_bits(config);
+    uint32_t read_size = lw_count_bits(config) * sizeof(int32_t);
     lw_create_request_read_data(request, LW_GRF500_COMMAND_DISTANCE_DATA, read_size);
     return LW_RESULT_SUCCESS;
 }
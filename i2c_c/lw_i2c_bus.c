@@ -0,0 +1,205 @@
+// ----------------------------------------------------------------------------
+// LightWare I2C API Bus Scheduler
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_i2c_bus.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint16_t lw_i2c_bus_read_size(lw_grf500_distance_config config) {
+    uint16_t size = 0;
+
+    for (uint32_t bit = 0; bit < 8; ++bit) {
+        if (config & (1u << bit)) {
+            size += sizeof(int32_t);
+        }
+    }
+
+    return size;
+}
+
+static void lw_i2c_bus_add_messages(lw_i2c_bus_sensor *sensor, lw_i2c_bus_message *messages) {
+    messages[0].address = sensor->address;
+    messages[0].flags = LW_I2C_BUS_MESSAGE_WRITE;
+    messages[0].size = 1;
+    messages[0].buffer = &sensor->reg;
+
+    messages[1].address = sensor->address;
+    messages[1].flags = LW_I2C_BUS_MESSAGE_READ;
+    messages[1].size = (uint16_t)sensor->response.data_size;
+    messages[1].buffer = sensor->response.data;
+}
+
+static void lw_i2c_bus_schedule(lw_i2c_bus_sensor *sensor, uint64_t now_us) {
+    sensor->next_due_us += sensor->period_us;
+
+    // Don't try to catch up on missed polls, that would only burst the bus.
+    if (sensor->next_due_us <= now_us) {
+        sensor->next_due_us = now_us + sensor->period_us;
+    }
+}
+
+static void lw_i2c_bus_complete(lw_i2c_bus *bus, lw_i2c_bus_sensor *sensor, uint64_t now_us) {
+    sensor->response.command_id = sensor->reg;
+
+    if (lw_grf500_decode_response_distance_data(&sensor->response, sensor->decoder, &sensor->data) == LW_RESULT_SUCCESS) {
+        sensor->timestamp_us = now_us;
+        sensor->fresh = LW_TRUE;
+        bus->reads++;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Bus scheduler.
+// ----------------------------------------------------------------------------
+lw_i2c_bus lw_create_i2c_bus(void *user_data, lw_bus_callback_transfer transfer) {
+    lw_i2c_bus bus;
+    memset(&bus, 0, sizeof(bus));
+    bus.user_data = user_data;
+    bus.transfer = transfer;
+
+    return bus;
+}
+
+lw_result lw_i2c_bus_add_sensor(lw_i2c_bus *bus, uint8_t address, lw_grf500_distance_config config, float update_rate_hz, uint32_t *index) {
+    uint16_t read_size = lw_i2c_bus_read_size(config);
+
+    if (bus->sensor_count >= LW_I2C_BUS_MAX_SENSORS || update_rate_hz <= 0 || read_size == 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_i2c_bus_sensor *sensor = &bus->sensors[bus->sensor_count];
+    memset(sensor, 0, sizeof(*sensor));
+    sensor->address = address;
+    sensor->reg = LW_GRF500_COMMAND_DISTANCE_DATA;
+    sensor->config = config;
+    sensor->decoder = lw_grf500_get_distance_decoder(config);
+    sensor->period_us = (uint32_t)(1000000.0f / update_rate_hz);
+    lw_init_response(&sensor->response);
+    sensor->response.data_size = read_size;
+
+    if (index) {
+        *index = bus->sensor_count;
+    }
+
+    bus->sensor_count++;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_i2c_bus_poll(lw_i2c_bus *bus, uint64_t now_us, uint32_t *completed) {
+    uint32_t batch[LW_I2C_BUS_MAX_MESSAGES / 2];
+    uint32_t batch_count = 0;
+    uint32_t last_sensor = 0;
+
+    *completed = 0;
+
+    // Gather due sensors starting after the last one served, so that when
+    // more sensors are due than fit in one transfer nobody is starved.
+    for (uint32_t n = 0; n < bus->sensor_count && batch_count < LW_I2C_BUS_MAX_MESSAGES / 2; ++n) {
+        uint32_t i = (bus->next_sensor + n) % bus->sensor_count;
+
+        if (bus->sensors[i].next_due_us > now_us) {
+            continue;
+        }
+
+        lw_i2c_bus_add_messages(&bus->sensors[i], &bus->messages[batch_count * 2]);
+        batch[batch_count++] = i;
+        last_sensor = i;
+    }
+
+    if (batch_count == 0) {
+        return LW_RESULT_AGAIN;
+    }
+
+    bus->next_sensor = (last_sensor + 1) % bus->sensor_count;
+    bus->transfers++;
+
+    if (bus->transfer(bus, bus->messages, batch_count * 2) == LW_RESULT_SUCCESS) {
+        for (uint32_t n = 0; n < batch_count; ++n) {
+            lw_i2c_bus_sensor *sensor = &bus->sensors[batch[n]];
+            lw_i2c_bus_complete(bus, sensor, now_us);
+            lw_i2c_bus_schedule(sensor, now_us);
+        }
+
+        *completed = batch_count;
+        return LW_RESULT_SUCCESS;
+    }
+
+    LW_DEBUG_LVL_2("I2C bus: combined transfer of %u sensors failed, retrying individually\n", batch_count);
+
+    for (uint32_t n = 0; n < batch_count; ++n) {
+        lw_i2c_bus_sensor *sensor = &bus->sensors[batch[n]];
+        lw_i2c_bus_add_messages(sensor, bus->messages);
+        bus->transfers++;
+
+        if (bus->transfer(bus, bus->messages, 2) == LW_RESULT_SUCCESS) {
+            lw_i2c_bus_complete(bus, sensor, now_us);
+            (*completed)++;
+        } else {
+            LW_DEBUG_LVL_1("I2C bus: read failed for address 0x%02X\n", sensor->address);
+            sensor->errors++;
+            bus->errors++;
+        }
+
+        lw_i2c_bus_schedule(sensor, now_us);
+    }
+
+    return (*completed > 0) ? LW_RESULT_SUCCESS : LW_RESULT_ERROR;
+}
+
+uint64_t lw_i2c_bus_next_due_us(lw_i2c_bus *bus) {
+    uint64_t next_due_us = UINT64_MAX;
+
+    for (uint32_t i = 0; i < bus->sensor_count; ++i) {
+        if (bus->sensors[i].next_due_us < next_due_us) {
+            next_due_us = bus->sensors[i].next_due_us;
+        }
+    }
+
+    return next_due_us;
+}
+
+lw_result lw_i2c_bus_get_distance_data(lw_i2c_bus *bus, uint32_t index, lw_grf500_distance_data_cm *data, uint64_t *timestamp_us) {
+    if (index >= bus->sensor_count) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_i2c_bus_sensor *sensor = &bus->sensors[index];
+
+    if (!sensor->fresh) {
+        return LW_RESULT_AGAIN;
+    }
+
+    *data = sensor->data;
+
+    if (timestamp_us) {
+        *timestamp_us = sensor->timestamp_us;
+    }
+
+    sensor->fresh = LW_FALSE;
+
+    return LW_RESULT_SUCCESS;
+}
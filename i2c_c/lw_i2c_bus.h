@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// LightWare I2C API Bus Scheduler
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_I2C_BUS_H
+#define LW_I2C_BUS_H
+
+#include "lw_i2c_grf500_distance_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Multi-sensor bus scheduler.
+//
+// The bus scheduler polls distance data from several devices at different
+// addresses on the same I2C bus. Every poll gathers the sensors that are due,
+// in round-robin order, and packs a write-register/read-data message pair for
+// each of them into a single combined transfer. On Linux this maps to one
+// I2C_RDWR ioctl for up to LW_I2C_BUS_MAX_MESSAGES messages.
+//
+// If a combined transfer fails, for example because one device NAKs, the
+// pairs are retried one at a time so a single faulty device does not stall
+// the rest of the bus.
+// ----------------------------------------------------------------------------
+#ifndef LW_I2C_BUS_MAX_SENSORS
+#define LW_I2C_BUS_MAX_SENSORS 16
+#endif
+
+// Matches I2C_RDWR_IOCTL_MAX_MSGS on Linux.
+#ifndef LW_I2C_BUS_MAX_MESSAGES
+#define LW_I2C_BUS_MAX_MESSAGES 42
+#endif
+
+#define LW_I2C_BUS_MESSAGE_WRITE 0x0000
+#define LW_I2C_BUS_MESSAGE_READ 0x0001
+
+typedef struct {
+    uint16_t address;
+    uint16_t flags;
+    uint16_t size;
+    uint8_t *buffer;
+} lw_i2c_bus_message;
+
+typedef struct lw_i2c_bus_s lw_i2c_bus;
+
+/*
+ * Bus transfer callback. This callback is called when the scheduler wants to
+ * execute several messages as one combined transfer, with a repeated start
+ * between messages.
+ *
+ * @param bus The bus.
+ * @param messages The messages to transfer.
+ * @param count The number of messages.
+ * @return LW_RESULT_SUCCESS if all messages were transferred, or an error code on failure.
+ */
+typedef lw_result (*lw_bus_callback_transfer)(lw_i2c_bus *bus, lw_i2c_bus_message *messages, uint32_t count);
+
+typedef struct {
+    uint8_t address;
+    uint8_t reg;
+    lw_grf500_distance_config config;
+    lw_grf500_distance_decoder decoder;
+    uint32_t period_us;
+    uint64_t next_due_us;
+    uint64_t timestamp_us;
+    lw_bool fresh;
+    uint32_t errors;
+    lw_response response;
+    lw_grf500_distance_data_cm data;
+} lw_i2c_bus_sensor;
+
+struct lw_i2c_bus_s {
+    void *user_data;
+    lw_bus_callback_transfer transfer;
+
+    uint32_t sensor_count;
+    uint32_t next_sensor;
+    lw_i2c_bus_sensor sensors[LW_I2C_BUS_MAX_SENSORS];
+    lw_i2c_bus_message messages[LW_I2C_BUS_MAX_MESSAGES];
+
+    uint64_t transfers;
+    uint64_t reads;
+    uint64_t errors;
+};
+
+/*
+ * Create a bus scheduler.
+ *
+ * @param user_data User data to pass to the transfer callback.
+ * @param transfer Bus transfer callback.
+ * @return The created bus.
+ */
+lw_i2c_bus lw_create_i2c_bus(void *user_data, lw_bus_callback_transfer transfer);
+
+/*
+ * Add a sensor to the bus schedule.
+ *
+ * @param bus The bus.
+ * @param address The I2C address of the device.
+ * @param config The distance configuration set on the device.
+ * @param update_rate_hz The rate at which to poll the device.
+ * @param index The index of the sensor on the bus is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER.
+ */
+lw_result lw_i2c_bus_add_sensor(lw_i2c_bus *bus, uint8_t address, lw_grf500_distance_config config, float update_rate_hz, uint32_t *index);
+
+/*
+ * Poll every sensor that is due, using as few bus transfers as possible.
+ *
+ * @param bus The bus.
+ * @param now_us The current time in microseconds.
+ * @param completed The number of sensors read is written here.
+ * @return LW_RESULT_SUCCESS if at least one sensor was read, or
+ *         LW_RESULT_AGAIN if no sensor was due, or
+ *         LW_RESULT_ERROR if every due sensor failed.
+ */
+lw_result lw_i2c_bus_poll(lw_i2c_bus *bus, uint64_t now_us, uint32_t *completed);
+
+/*
+ * Get the time the next sensor becomes due.
+ *
+ * @param bus The bus.
+ * @return The time in microseconds.
+ */
+uint64_t lw_i2c_bus_next_due_us(lw_i2c_bus *bus);
+
+/*
+ * Take the latest distance data read from a sensor.
+ *
+ * @param bus The bus.
+ * @param index The index of the sensor.
+ * @param data The distance data is written here.
+ * @param timestamp_us The time the data was read is written here, can be NULL.
+ * @return LW_RESULT_SUCCESS if new data was written, or
+ *         LW_RESULT_AGAIN if there is no new data since the last call, or
+ *         LW_RESULT_INVALID_PARAMETER if the index is out of range.
+ */
+lw_result lw_i2c_bus_get_distance_data(lw_i2c_bus *bus, uint32_t index, lw_grf500_distance_data_cm *data, uint64_t *timestamp_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_I2C_BUS_H
@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------------
+// LightWare I2C API GRF-500 Distance Decoders
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_i2c_grf500_distance_decoder.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Decoder generation.
+//
+// LW_DECODER_FIELDS lists every distance data field with its config bit and
+// scale. LW_DECODER_CONFIGS expands once for each of the 256 configs, split
+// into high and low nibbles so each decoder gets a unique name.
+// ----------------------------------------------------------------------------
+#define LW_DECODER_FIELDS(X, config)                  \
+    X(config, 0, first_return_raw_cm, 10)             \
+    X(config, 1, first_return_filtered_cm, 10)        \
+    X(config, 2, first_return_strength, 1)            \
+    X(config, 3, last_return_raw_cm, 10)              \
+    X(config, 4, last_return_filtered_cm, 10)         \
+    X(config, 5, last_return_strength, 1)             \
+    X(config, 6, temperature, 1)                      \
+    X(config, 7, alarm_status, 1)
+
+#define LW_DECODER_CONFIGS_LOW(X, high)                                               \
+    X(high, 0) X(high, 1) X(high, 2) X(high, 3) X(high, 4) X(high, 5) X(high, 6)      \
+    X(high, 7) X(high, 8) X(high, 9) X(high, 10) X(high, 11) X(high, 12) X(high, 13)  \
+    X(high, 14) X(high, 15)
+
+#define LW_DECODER_CONFIGS(X)                                                                              \
+    LW_DECODER_CONFIGS_LOW(X, 0) LW_DECODER_CONFIGS_LOW(X, 1) LW_DECODER_CONFIGS_LOW(X, 2)               \
+    LW_DECODER_CONFIGS_LOW(X, 3) LW_DECODER_CONFIGS_LOW(X, 4) LW_DECODER_CONFIGS_LOW(X, 5)               \
+    LW_DECODER_CONFIGS_LOW(X, 6) LW_DECODER_CONFIGS_LOW(X, 7) LW_DECODER_CONFIGS_LOW(X, 8)               \
+    LW_DECODER_CONFIGS_LOW(X, 9) LW_DECODER_CONFIGS_LOW(X, 10) LW_DECODER_CONFIGS_LOW(X, 11)             \
+    LW_DECODER_CONFIGS_LOW(X, 12) LW_DECODER_CONFIGS_LOW(X, 13) LW_DECODER_CONFIGS_LOW(X, 14)            \
+    LW_DECODER_CONFIGS_LOW(X, 15)
+
+#define LW_DECODER_CONFIG(high, low) ((high) * 16 + (low))
+
+// Number of config bits set below a bit, as a constant expression.
+#define LW_DECODER_BITS_BELOW(config, bit)    \
+    (((bit) > 0 && ((config) & 0x01)) +       \
+     ((bit) > 1 && ((config) & 0x02)) +       \
+     ((bit) > 2 && ((config) & 0x04)) +       \
+     ((bit) > 3 && ((config) & 0x08)) +       \
+     ((bit) > 4 && ((config) & 0x10)) +       \
+     ((bit) > 5 && ((config) & 0x20)) +       \
+     ((bit) > 6 && ((config) & 0x40)))
+
+#define LW_DECODER_OFFSET(config, bit) (LW_DECODER_BITS_BELOW(config, bit) * (uint32_t)sizeof(int32_t))
+
+static inline int32_t lw_decoder_load(const uint8_t *data) {
+    int32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// The config tests below are constant, so the compiler drops the fields that
+// are not in the config and keeps straight-line loads for the rest.
+#define LW_DECODER_DECODE_FIELD(config, bit, field, scale)                             \
+    if ((config) & (1u << (bit))) {                                                    \
+        out->field = lw_decoder_load(data + LW_DECODER_OFFSET(config, bit)) * (scale); \
+    }
+
+#define LW_DECODER_DEFINE(high, low)                                                                             \
+    static void lw_grf500_decode_distance_##high##_##low(const uint8_t *data, lw_grf500_distance_data_cm *out) { \
+        LW_DECODER_FIELDS(LW_DECODER_DECODE_FIELD, LW_DECODER_CONFIG(high, low))                                \
+    }
+
+#define LW_DECODER_ENTRY(high, low) &lw_grf500_decode_distance_##high##_##low,
+
+LW_DECODER_CONFIGS(LW_DECODER_DEFINE)
+
+static const lw_grf500_distance_decoder lw_grf500_distance_decoders[256] = {
+    LW_DECODER_CONFIGS(LW_DECODER_ENTRY)
+};
+
+// ----------------------------------------------------------------------------
+// Decoder selection.
+// ----------------------------------------------------------------------------
+lw_grf500_distance_decoder lw_grf500_get_distance_decoder(lw_grf500_distance_config config) {
+    return lw_grf500_distance_decoders[config & LW_GRF500_DISTANCE_CONFIG_ALL];
+}
+
+lw_result lw_grf500_decode_response_distance_data(lw_response *response, lw_grf500_distance_decoder decoder, lw_grf500_distance_data_cm *data) {
+    LW_CHECK_COMMAND_ID(response, LW_GRF500_COMMAND_DISTANCE_DATA)
+    decoder(response->data, data);
+    return LW_RESULT_SUCCESS;
+}
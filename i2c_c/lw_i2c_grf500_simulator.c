@@ -0,0 +1,870 @@
+// ----------------------------------------------------------------------------
+// LightWare I2C API GRF-500 Bus Simulator
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_i2c_grf500_simulator.h"
+#include <string.h>
+
+// Lost signal distance as sent on the wire, the API reports it as -1000.
+#define LW_SIMULATOR_LOST_SIGNAL -100
+
+// Readings are skipped rather than caught up when the device falls this many
+// readings behind.
+#define LW_SIMULATOR_MAX_CATCH_UP 64
+
+// Longest message the callback device writes: the register and its data.
+#define LW_SIMULATOR_WRITE_SIZE (LW_PACKET_SEND_SIZE + 1)
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint32_t lw_simulator_random(lw_i2c_grf500_simulator *simulator) {
+    uint32_t x = simulator->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    simulator->random = x;
+
+    return x;
+}
+
+static float lw_simulator_random_unit(lw_i2c_grf500_simulator *simulator) {
+    return (float)(lw_simulator_random(simulator) >> 8) / 16777216.0f;
+}
+
+// Roughly gaussian with unit variance, from the sum of four uniforms.
+static float lw_simulator_random_gaussian(lw_i2c_grf500_simulator *simulator) {
+    float sum = 0;
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        sum += lw_simulator_random_unit(simulator);
+    }
+
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+static lw_bool lw_simulator_chance(lw_i2c_grf500_simulator *simulator, float probability) {
+    return (probability > 0 && lw_simulator_random_unit(simulator) < probability) ? LW_TRUE : LW_FALSE;
+}
+
+static int32_t lw_simulator_round(float value) {
+    return (value < 0) ? -(int32_t)(0.5f - value) : (int32_t)(value + 0.5f);
+}
+
+static uint64_t lw_simulator_reading_period_us(const lw_i2c_grf500_simulator *simulator) {
+    return 10000000 / simulator->registers.update_rate;
+}
+
+static void lw_simulator_factory_registers(lw_i2c_grf500_simulator_registers *registers) {
+    memset(registers, 0, sizeof(*registers));
+    registers->distance_config = LW_GRF500_DISTANCE_CONFIG_ALL;
+    registers->laser_firing = 1;
+    registers->auto_exposure = 1;
+    registers->update_rate = 50;
+    registers->alarm_return_mode = LW_GRF500_RETURN_MODE_FIRST;
+    registers->lost_signal_counter = 1;
+    registers->gpio_mode = LW_GRF500_GPIO_MODE_NO_OUTPUT;
+    registers->gpio_alarm_confirm_count = 1;
+    registers->median_filter_size = 5;
+    registers->smooth_filter_factor = 50;
+    registers->baud_rate = LW_GRF500_BAUD_RATE_115200;
+    registers->i2c_address = 0x66;
+    registers->rolling_average_size = 4;
+    registers->led_state = 1;
+}
+
+// ----------------------------------------------------------------------------
+// Readings.
+// ----------------------------------------------------------------------------
+
+// Target distance at a time, moving back and forth over the period.
+static float lw_simulator_target_cm(const lw_i2c_grf500_simulator *simulator, uint64_t time_us) {
+    const lw_i2c_grf500_simulator_config *config = &simulator->config;
+    uint64_t period_us = (uint64_t)config->period_ms * 1000;
+
+    if (period_us < 2 || config->amplitude_cm == 0) {
+        return (float)config->distance_cm;
+    }
+
+    uint64_t phase_us = time_us % period_us;
+    uint64_t half_us = period_us / 2;
+    float fraction = (phase_us < half_us) ? (float)phase_us / (float)half_us : (float)(period_us - phase_us) / (float)(period_us - half_us);
+
+    return (float)config->distance_cm + (float)config->amplitude_cm * fraction;
+}
+
+static void lw_simulator_reset_filter(lw_i2c_grf500_simulator_filter *filter) {
+    memset(filter, 0, sizeof(*filter));
+    filter->last_raw = LW_SIMULATOR_LOST_SIGNAL;
+    filter->last_filtered = LW_SIMULATOR_LOST_SIGNAL;
+}
+
+// Median of the newest count values before index in a ring.
+static int32_t lw_simulator_median(const int32_t *history, uint32_t index, uint32_t count) {
+    int32_t values[LW_I2C_GRF500_SIMULATOR_FILTER_SIZE];
+
+    for (uint32_t i = 0; i < count; ++i) {
+        int32_t value = history[(index + LW_I2C_GRF500_SIMULATOR_FILTER_SIZE - 1 - i) % LW_I2C_GRF500_SIMULATOR_FILTER_SIZE];
+        uint32_t j = i;
+
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+
+        values[j] = value;
+    }
+
+    return values[count / 2];
+}
+
+// Run a raw reading through the enabled filters, in the device order of
+// median, rolling average, then smoothing.
+static int32_t lw_simulator_filter(lw_i2c_grf500_simulator *simulator, lw_i2c_grf500_simulator_filter *filter, int32_t raw) {
+    const lw_i2c_grf500_simulator_registers *registers = &simulator->registers;
+    uint32_t index = filter->index;
+    int32_t value = raw;
+
+    filter->index = (index + 1) % LW_I2C_GRF500_SIMULATOR_FILTER_SIZE;
+    filter->count = (filter->count < LW_I2C_GRF500_SIMULATOR_FILTER_SIZE) ? filter->count + 1 : filter->count;
+
+    filter->median_history[index] = raw;
+
+    if (registers->median_filter_enable) {
+        uint32_t count = (filter->count < registers->median_filter_size) ? filter->count : registers->median_filter_size;
+        value = lw_simulator_median(filter->median_history, filter->index, count);
+    }
+
+    filter->average_history[index] = value;
+
+    if (registers->rolling_average_enable) {
+        uint32_t count = (filter->count < registers->rolling_average_size) ? filter->count : registers->rolling_average_size;
+        int64_t sum = 0;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            sum += filter->average_history[(filter->index + LW_I2C_GRF500_SIMULATOR_FILTER_SIZE - 1 - i) % LW_I2C_GRF500_SIMULATOR_FILTER_SIZE];
+        }
+
+        value = lw_simulator_round((float)sum / (float)count);
+    }
+
+    if (filter->count == 1 || !registers->smooth_filter_enable) {
+        filter->smoothed = value;
+    } else {
+        int32_t factor = (int32_t)registers->smooth_filter_factor;
+        filter->smoothed = lw_simulator_round(((float)filter->smoothed * (float)factor + (float)value * (float)(100 - factor)) / 100.0f);
+    }
+
+    return filter->smoothed;
+}
+
+static void lw_simulator_update_alarms(lw_i2c_grf500_simulator *simulator, int32_t distance) {
+    const lw_i2c_grf500_simulator_registers *registers = &simulator->registers;
+    uint32_t thresholds[2] = {registers->alarm_a_distance, registers->alarm_b_distance};
+    uint32_t confirm_count = (registers->gpio_alarm_confirm_count > 0) ? registers->gpio_alarm_confirm_count : 1;
+
+    for (uint32_t a = 0; a < 2; ++a) {
+        int64_t threshold = (int64_t)thresholds[a];
+
+        if (simulator->alarm_active[a]) {
+            if (threshold == 0 || distance < 0 || distance > threshold + (int64_t)registers->alarm_hysteresis) {
+                simulator->alarm_active[a] = LW_FALSE;
+                simulator->alarm_count[a] = 0;
+            }
+        } else if (threshold > 0 && distance >= 0 && distance <= threshold) {
+            if (++simulator->alarm_count[a] >= confirm_count) {
+                simulator->alarm_active[a] = LW_TRUE;
+            }
+        } else {
+            simulator->alarm_count[a] = 0;
+        }
+    }
+}
+
+static void lw_simulator_take_reading(lw_i2c_grf500_simulator *simulator, uint64_t time_us) {
+    const lw_i2c_grf500_simulator_config *config = &simulator->config;
+    const lw_i2c_grf500_simulator_registers *registers = &simulator->registers;
+    lw_bool lost = (!registers->laser_firing || lw_simulator_chance(simulator, config->lost_probability)) ? LW_TRUE : LW_FALSE;
+    float target_cm = lw_simulator_target_cm(simulator, time_us);
+
+    simulator->lost_count = lost ? simulator->lost_count + 1 : 0;
+    lw_bool report_lost = (lost && simulator->lost_count >= registers->lost_signal_counter) ? LW_TRUE : LW_FALSE;
+
+    for (uint32_t r = 0; r < 2; ++r) {
+        lw_i2c_grf500_simulator_filter *filter = &simulator->filters[r];
+        int32_t *fields = simulator->reading + r * 3;
+
+        if (!lost) {
+            float offset_cm = (r == 1) ? (float)config->last_return_offset_cm : 0;
+            float distance_cm = target_cm + offset_cm + lw_simulator_random_gaussian(simulator) * config->noise_cm;
+            int32_t raw = lw_simulator_round(distance_cm / 10.0f) + registers->zero_offset;
+
+            filter->last_raw = raw;
+            filter->last_filtered = lw_simulator_filter(simulator, filter, raw);
+            simulator->multi_distance_mm[r] = lw_simulator_round(distance_cm * 10.0f) + registers->zero_offset * 100;
+            fields[2] = (r == 1 && config->last_return_offset_cm != 0) ? config->strength / 2 : config->strength;
+        } else if (report_lost) {
+            fields[2] = 0;
+        }
+
+        fields[0] = report_lost ? LW_SIMULATOR_LOST_SIGNAL : filter->last_raw;
+        fields[1] = report_lost ? LW_SIMULATOR_LOST_SIGNAL : filter->last_filtered;
+    }
+
+    lw_simulator_update_alarms(simulator, simulator->reading[registers->alarm_return_mode == LW_GRF500_RETURN_MODE_LAST ? 4 : 1]);
+
+    simulator->reading[6] = config->temperature;
+    simulator->reading[7] = (simulator->alarm_active[0] ? 1 : 0) | (simulator->alarm_active[1] ? 1 << 8 : 0);
+    simulator->stats.readings++;
+}
+
+// Take the readings due by a time.
+static void lw_simulator_advance(lw_i2c_grf500_simulator *simulator, uint64_t now_us) {
+    if (simulator->asleep || now_us < simulator->busy_until_us) {
+        return;
+    }
+
+    uint64_t period_us = lw_simulator_reading_period_us(simulator);
+
+    if (simulator->next_reading_us + LW_SIMULATOR_MAX_CATCH_UP * period_us < now_us) {
+        uint64_t skipped = (now_us - simulator->next_reading_us) / period_us - LW_SIMULATOR_MAX_CATCH_UP;
+        simulator->next_reading_us += skipped * period_us;
+    }
+
+    while (simulator->next_reading_us <= now_us) {
+        lw_simulator_take_reading(simulator, simulator->next_reading_us);
+        simulator->next_reading_us += lw_simulator_reading_period_us(simulator);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Registers.
+// ----------------------------------------------------------------------------
+
+// Restart as after power on, from the saved registers.
+static void lw_simulator_restart(lw_i2c_grf500_simulator *simulator, uint64_t time_us, uint32_t boot_time_ms) {
+    simulator->registers = simulator->saved;
+    simulator->stream = LW_GRF500_STREAM_ID_NONE;
+    simulator->token_valid = LW_FALSE;
+    simulator->asleep = LW_FALSE;
+    simulator->busy_until_us = time_us + (uint64_t)boot_time_ms * 1000;
+    simulator->pointer = 0;
+    simulator->next_reading_us = simulator->busy_until_us;
+    simulator->lost_count = 0;
+
+    for (uint32_t r = 0; r < 2; ++r) {
+        lw_simulator_reset_filter(&simulator->filters[r]);
+        simulator->multi_distance_mm[r] = 0;
+        simulator->alarm_count[r] = 0;
+        simulator->alarm_active[r] = LW_FALSE;
+    }
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        simulator->reading[i] = 0;
+    }
+
+    simulator->reading[0] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[1] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[3] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[4] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[6] = simulator->config.temperature;
+}
+
+static lw_bool lw_simulator_get_u8(const uint8_t *data, uint32_t size, uint32_t min, uint32_t max, uint8_t *value) {
+    if (size != 1 || data[0] < min || data[0] > max) {
+        return LW_FALSE;
+    }
+
+    *value = data[0];
+    return LW_TRUE;
+}
+
+static lw_bool lw_simulator_get_u32(const uint8_t *data, uint32_t size, uint32_t min, uint32_t max, uint32_t *value) {
+    uint32_t temp_value;
+
+    if (size != 4) {
+        return LW_FALSE;
+    }
+
+    memcpy(&temp_value, data, 4);
+
+    if (temp_value < min || temp_value > max) {
+        return LW_FALSE;
+    }
+
+    *value = temp_value;
+    return LW_TRUE;
+}
+
+// Check and use up the token for a save or reset.
+static lw_bool lw_simulator_check_token(lw_i2c_grf500_simulator *simulator, const uint8_t *data, uint32_t size) {
+    uint16_t token;
+    lw_bool valid = simulator->token_valid;
+
+    simulator->token_valid = LW_FALSE;
+
+    if (size != 2) {
+        return LW_FALSE;
+    }
+
+    memcpy(&token, data, 2);
+
+    return (valid && token == simulator->token) ? LW_TRUE : LW_FALSE;
+}
+
+static lw_bool lw_simulator_known_register(uint8_t reg) {
+    switch (reg) {
+        case LW_GRF500_COMMAND_PRODUCT_NAME:
+        case LW_GRF500_COMMAND_HARDWARE_VERSION:
+        case LW_GRF500_COMMAND_FIRMWARE_VERSION:
+        case LW_GRF500_COMMAND_SERIAL_NUMBER:
+        case LW_GRF500_COMMAND_USER_DATA:
+        case LW_GRF500_COMMAND_TOKEN:
+        case LW_GRF500_COMMAND_SAVE_PARAMETERS:
+        case LW_GRF500_COMMAND_RESET:
+        case LW_GRF500_COMMAND_DISTANCE_CONFIG:
+        case LW_GRF500_COMMAND_STREAM:
+        case LW_GRF500_COMMAND_DISTANCE_DATA:
+        case LW_GRF500_COMMAND_MULTI_DATA:
+        case LW_GRF500_COMMAND_LASER_FIRING:
+        case LW_GRF500_COMMAND_TEMPERATURE:
+        case LW_GRF500_COMMAND_AUTO_EXPOSURE:
+        case LW_GRF500_COMMAND_UPDATE_RATE:
+        case LW_GRF500_COMMAND_ALARM_STATUS:
+        case LW_GRF500_COMMAND_ALARM_RETURN_MODE:
+        case LW_GRF500_COMMAND_LOST_SIGNAL_COUNTER:
+        case LW_GRF500_COMMAND_ALARM_A_DISTANCE:
+        case LW_GRF500_COMMAND_ALARM_B_DISTANCE:
+        case LW_GRF500_COMMAND_ALARM_HYSTERESIS:
+        case LW_GRF500_COMMAND_GPIO_MODE:
+        case LW_GRF500_COMMAND_GPIO_ALARM_CONFIRM_COUNT:
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_ENABLE:
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_SIZE:
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_ENABLE:
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_FACTOR:
+        case LW_GRF500_COMMAND_BAUD_RATE:
+        case LW_GRF500_COMMAND_I2C_ADDRESS:
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_ENABLE:
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_SIZE:
+        case LW_GRF500_COMMAND_SLEEP:
+        case LW_GRF500_COMMAND_LED_STATE:
+        case LW_GRF500_COMMAND_ZERO_OFFSET: return LW_TRUE;
+
+        default: return LW_FALSE;
+    }
+}
+
+static lw_bool lw_simulator_write_register(lw_i2c_grf500_simulator *simulator, uint64_t time_us, uint8_t reg, const uint8_t *data, uint32_t size) {
+    lw_i2c_grf500_simulator_registers *registers = &simulator->registers;
+    lw_bool accepted = LW_FALSE;
+
+    switch (reg) {
+        case LW_GRF500_COMMAND_USER_DATA: {
+            accepted = (size == 16) ? LW_TRUE : LW_FALSE;
+
+            if (accepted) {
+                memcpy(registers->user_data, data, 16);
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_SAVE_PARAMETERS: {
+            accepted = lw_simulator_check_token(simulator, data, size);
+
+            if (accepted) {
+                simulator->saved = *registers;
+                simulator->busy_until_us = time_us + (uint64_t)simulator->config.save_time_ms * 1000;
+                simulator->stats.saves++;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_RESET: {
+            accepted = lw_simulator_check_token(simulator, data, size);
+
+            if (accepted) {
+                lw_simulator_restart(simulator, time_us, simulator->config.boot_time_ms);
+                simulator->stats.resets++;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_STREAM: {
+            uint32_t stream;
+            accepted = lw_simulator_get_u32(data, size, 0, LW_GRF500_STREAM_ID_MULTI_DATA, &stream);
+
+            if (accepted && stream != LW_GRF500_STREAM_ID_NONE && stream != LW_GRF500_STREAM_ID_DISTANCE_DATA && stream != LW_GRF500_STREAM_ID_MULTI_DATA) {
+                accepted = LW_FALSE;
+            }
+
+            if (accepted) {
+                simulator->stream = stream;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_SLEEP: {
+            uint8_t value;
+            accepted = lw_simulator_get_u8(data, size, 123, 123, &value);
+
+            if (accepted) {
+                simulator->asleep = LW_TRUE;
+                simulator->stats.sleeps++;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_ZERO_OFFSET: {
+            accepted = (size == 4) ? LW_TRUE : LW_FALSE;
+
+            if (accepted) {
+                memcpy(&registers->zero_offset, data, 4);
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_DISTANCE_CONFIG: accepted = lw_simulator_get_u32(data, size, 0, LW_GRF500_DISTANCE_CONFIG_ALL, &registers->distance_config); break;
+        case LW_GRF500_COMMAND_LASER_FIRING: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->laser_firing); break;
+        case LW_GRF500_COMMAND_AUTO_EXPOSURE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->auto_exposure); break;
+        case LW_GRF500_COMMAND_UPDATE_RATE: accepted = lw_simulator_get_u32(data, size, 5, 100, &registers->update_rate); break;
+        case LW_GRF500_COMMAND_ALARM_RETURN_MODE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->alarm_return_mode); break;
+        case LW_GRF500_COMMAND_LOST_SIGNAL_COUNTER: accepted = lw_simulator_get_u32(data, size, 1, 250, &registers->lost_signal_counter); break;
+        case LW_GRF500_COMMAND_ALARM_A_DISTANCE: accepted = lw_simulator_get_u32(data, size, 0, 3000, &registers->alarm_a_distance); break;
+        case LW_GRF500_COMMAND_ALARM_B_DISTANCE: accepted = lw_simulator_get_u32(data, size, 0, 3000, &registers->alarm_b_distance); break;
+        case LW_GRF500_COMMAND_ALARM_HYSTERESIS: accepted = lw_simulator_get_u32(data, size, 0, 300, &registers->alarm_hysteresis); break;
+        case LW_GRF500_COMMAND_GPIO_MODE: accepted = lw_simulator_get_u8(data, size, 0, 2, &registers->gpio_mode); break;
+        case LW_GRF500_COMMAND_GPIO_ALARM_CONFIRM_COUNT: accepted = lw_simulator_get_u32(data, size, 0, 1000, &registers->gpio_alarm_confirm_count); break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_ENABLE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->median_filter_enable); break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_SIZE: accepted = lw_simulator_get_u32(data, size, 3, 32, &registers->median_filter_size); break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_ENABLE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->smooth_filter_enable); break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_FACTOR: accepted = lw_simulator_get_u32(data, size, 1, 99, &registers->smooth_filter_factor); break;
+        case LW_GRF500_COMMAND_BAUD_RATE: accepted = lw_simulator_get_u8(data, size, 0, 7, &registers->baud_rate); break;
+        case LW_GRF500_COMMAND_I2C_ADDRESS: accepted = lw_simulator_get_u8(data, size, 0x08, 0x77, &registers->i2c_address); break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_ENABLE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->rolling_average_enable); break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_SIZE: accepted = lw_simulator_get_u32(data, size, 2, 32, &registers->rolling_average_size); break;
+        case LW_GRF500_COMMAND_LED_STATE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->led_state); break;
+
+        // Read only.
+        default: break;
+    }
+
+    return accepted;
+}
+
+#define LW_SIMULATOR_VALUE(value)              \
+    *data = (const uint8_t *)&(value);        \
+    *size = sizeof(value);
+
+// Find the bytes of a register. Write only registers read as zeros.
+static void lw_simulator_read_register(lw_i2c_grf500_simulator *simulator, uint8_t reg, const uint8_t **data, uint32_t *size) {
+    static const uint8_t zeros[4] = {0};
+    const lw_i2c_grf500_simulator_registers *registers = &simulator->registers;
+
+    switch (reg) {
+        case LW_GRF500_COMMAND_PRODUCT_NAME: LW_SIMULATOR_VALUE(simulator->config.product_name) break;
+        case LW_GRF500_COMMAND_HARDWARE_VERSION: LW_SIMULATOR_VALUE(simulator->config.hardware_version) break;
+        case LW_GRF500_COMMAND_FIRMWARE_VERSION: LW_SIMULATOR_VALUE(simulator->config.firmware_version) break;
+        case LW_GRF500_COMMAND_SERIAL_NUMBER: LW_SIMULATOR_VALUE(simulator->config.serial_number) break;
+        case LW_GRF500_COMMAND_USER_DATA: LW_SIMULATOR_VALUE(registers->user_data) break;
+        case LW_GRF500_COMMAND_DISTANCE_CONFIG: LW_SIMULATOR_VALUE(registers->distance_config) break;
+        case LW_GRF500_COMMAND_STREAM: LW_SIMULATOR_VALUE(simulator->stream) break;
+        case LW_GRF500_COMMAND_LASER_FIRING: LW_SIMULATOR_VALUE(registers->laser_firing) break;
+        case LW_GRF500_COMMAND_TEMPERATURE: LW_SIMULATOR_VALUE(simulator->reading[6]) break;
+        case LW_GRF500_COMMAND_AUTO_EXPOSURE: LW_SIMULATOR_VALUE(registers->auto_exposure) break;
+        case LW_GRF500_COMMAND_UPDATE_RATE: LW_SIMULATOR_VALUE(registers->update_rate) break;
+        case LW_GRF500_COMMAND_ALARM_STATUS: LW_SIMULATOR_VALUE(simulator->reading[7]) break;
+        case LW_GRF500_COMMAND_ALARM_RETURN_MODE: LW_SIMULATOR_VALUE(registers->alarm_return_mode) break;
+        case LW_GRF500_COMMAND_LOST_SIGNAL_COUNTER: LW_SIMULATOR_VALUE(registers->lost_signal_counter) break;
+        case LW_GRF500_COMMAND_ALARM_A_DISTANCE: LW_SIMULATOR_VALUE(registers->alarm_a_distance) break;
+        case LW_GRF500_COMMAND_ALARM_B_DISTANCE: LW_SIMULATOR_VALUE(registers->alarm_b_distance) break;
+        case LW_GRF500_COMMAND_ALARM_HYSTERESIS: LW_SIMULATOR_VALUE(registers->alarm_hysteresis) break;
+        case LW_GRF500_COMMAND_GPIO_MODE: LW_SIMULATOR_VALUE(registers->gpio_mode) break;
+        case LW_GRF500_COMMAND_GPIO_ALARM_CONFIRM_COUNT: LW_SIMULATOR_VALUE(registers->gpio_alarm_confirm_count) break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_ENABLE: LW_SIMULATOR_VALUE(registers->median_filter_enable) break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_SIZE: LW_SIMULATOR_VALUE(registers->median_filter_size) break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_ENABLE: LW_SIMULATOR_VALUE(registers->smooth_filter_enable) break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_FACTOR: LW_SIMULATOR_VALUE(registers->smooth_filter_factor) break;
+        case LW_GRF500_COMMAND_BAUD_RATE: LW_SIMULATOR_VALUE(registers->baud_rate) break;
+        case LW_GRF500_COMMAND_I2C_ADDRESS: LW_SIMULATOR_VALUE(registers->i2c_address) break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_ENABLE: LW_SIMULATOR_VALUE(registers->rolling_average_enable) break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_SIZE: LW_SIMULATOR_VALUE(registers->rolling_average_size) break;
+        case LW_GRF500_COMMAND_LED_STATE: LW_SIMULATOR_VALUE(registers->led_state) break;
+        case LW_GRF500_COMMAND_ZERO_OFFSET: LW_SIMULATOR_VALUE(registers->zero_offset) break;
+
+        case LW_GRF500_COMMAND_TOKEN: {
+            simulator->token = (uint16_t)(lw_simulator_random(simulator) | 1);
+            simulator->token_valid = LW_TRUE;
+            LW_SIMULATOR_VALUE(simulator->token)
+        } break;
+
+        default: {
+            *data = zeros;
+            *size = sizeof(zeros);
+        } break;
+    }
+}
+
+// Fill a read with the readings of the distance config, or the multi data.
+static uint32_t lw_simulator_read_data(lw_i2c_grf500_simulator *simulator, uint8_t reg, uint8_t *buffer) {
+    uint32_t size = 0;
+
+    if (reg == LW_GRF500_COMMAND_DISTANCE_DATA) {
+        for (uint32_t i = 0; i < 8; ++i) {
+            if (simulator->registers.distance_config & (1u << i)) {
+                memcpy(buffer + size, &simulator->reading[i], sizeof(int32_t));
+                size += sizeof(int32_t);
+            }
+        }
+    } else {
+        int32_t values[11];
+        uint32_t returns = (simulator->config.last_return_offset_cm != 0) ? 2 : 1;
+
+        memset(values, 0, sizeof(values));
+
+        for (uint32_t r = 0; r < returns; ++r) {
+            if (simulator->reading[r * 3] != LW_SIMULATOR_LOST_SIGNAL) {
+                values[r * 2] = simulator->multi_distance_mm[r];
+                values[r * 2 + 1] = simulator->reading[r * 3 + 2];
+            }
+        }
+
+        values[10] = simulator->reading[6];
+        memcpy(buffer, values, sizeof(values));
+        size = sizeof(values);
+    }
+
+    return size;
+}
+
+// ----------------------------------------------------------------------------
+// Device simulator.
+// ----------------------------------------------------------------------------
+void lw_i2c_grf500_simulator_get_default_config(lw_i2c_grf500_simulator_config *config) {
+    memset(config, 0, sizeof(*config));
+    memcpy(config->product_name, "GRF500", 7);
+    memcpy(config->serial_number, "SIM00000001", 12);
+    config->hardware_version = 1;
+    config->firmware_version = (1 << 16) | (0 << 8) | 0;
+    config->distance_cm = 1000;
+    config->amplitude_cm = 200;
+    config->period_ms = 10000;
+    config->noise_cm = 5;
+    config->strength = 80;
+    config->temperature = 2500;
+    config->read_stretch_us = 20;
+    config->stretch_jitter_us = 30;
+    config->save_time_ms = 20;
+    config->boot_time_ms = 500;
+    config->stretch_fault_us = 50000;
+    config->seed = 1;
+}
+
+lw_result lw_i2c_grf500_simulator_init(lw_i2c_grf500_simulator *simulator, const lw_i2c_grf500_simulator_config *config) {
+    memset(simulator, 0, sizeof(*simulator));
+
+    if (config) {
+        simulator->config = *config;
+    } else {
+        lw_i2c_grf500_simulator_get_default_config(&simulator->config);
+    }
+
+    const lw_i2c_grf500_simulator_config *c = &simulator->config;
+
+    if (c->noise_cm < 0 || c->lost_probability < 0 || c->lost_probability > 1 || c->nak_probability < 0 || c->nak_probability > 1 ||
+        c->corrupt_probability < 0 || c->corrupt_probability > 1 || c->stretch_fault_probability < 0 || c->stretch_fault_probability > 1) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    simulator->random = c->seed ? c->seed : 1;
+
+    lw_simulator_factory_registers(&simulator->saved);
+    lw_simulator_restart(simulator, 0, 0);
+
+    return LW_RESULT_SUCCESS;
+}
+
+uint8_t lw_i2c_grf500_simulator_get_address(const lw_i2c_grf500_simulator *simulator) {
+    return simulator->registers.i2c_address;
+}
+
+lw_result lw_i2c_grf500_simulator_address(lw_i2c_grf500_simulator *simulator, uint64_t now_us) {
+    if (simulator->asleep) {
+        simulator->asleep = LW_FALSE;
+        simulator->next_reading_us = now_us;
+        simulator->stats.busy_naks++;
+        return LW_RESULT_ERROR;
+    }
+
+    if (now_us < simulator->busy_until_us) {
+        simulator->stats.busy_naks++;
+        return LW_RESULT_ERROR;
+    }
+
+    if (lw_simulator_chance(simulator, simulator->config.nak_probability)) {
+        simulator->stats.naks++;
+        return LW_RESULT_ERROR;
+    }
+
+    lw_simulator_advance(simulator, now_us);
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_i2c_grf500_simulator_write(lw_i2c_grf500_simulator *simulator, uint64_t now_us, const uint8_t *data, uint32_t size) {
+    if (size == 0) {
+        return LW_RESULT_SUCCESS;
+    }
+
+    simulator->stats.bytes_written += size;
+
+    if (!lw_simulator_known_register(data[0])) {
+        simulator->stats.unknown_registers++;
+        return LW_RESULT_ERROR;
+    }
+
+    simulator->pointer = data[0];
+
+    if (size == 1) {
+        return LW_RESULT_SUCCESS;
+    }
+
+    simulator->stats.writes++;
+
+    if (!lw_simulator_write_register(simulator, now_us, data[0], data + 1, size - 1)) {
+        simulator->stats.rejected_writes++;
+        return LW_RESULT_ERROR;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+uint32_t lw_i2c_grf500_simulator_read(lw_i2c_grf500_simulator *simulator, uint64_t now_us, uint8_t *buffer, uint32_t size) {
+    const lw_i2c_grf500_simulator_config *config = &simulator->config;
+    uint8_t data_buffer[11 * sizeof(int32_t)];
+    const uint8_t *data = data_buffer;
+    uint32_t data_size;
+
+    lw_simulator_advance(simulator, now_us);
+
+    if (simulator->pointer == LW_GRF500_COMMAND_DISTANCE_DATA || simulator->pointer == LW_GRF500_COMMAND_MULTI_DATA) {
+        data_size = lw_simulator_read_data(simulator, simulator->pointer, data_buffer);
+    } else {
+        lw_simulator_read_register(simulator, simulator->pointer, &data, &data_size);
+    }
+
+    for (uint32_t i = 0; i < size; ++i) {
+        buffer[i] = (i < data_size) ? data[i] : 0xFF;
+    }
+
+    if (size > 0 && lw_simulator_chance(simulator, config->corrupt_probability)) {
+        buffer[lw_simulator_random(simulator) % size] ^= (uint8_t)(1u << (lw_simulator_random(simulator) % 8));
+        simulator->stats.corrupted_bytes++;
+    }
+
+    simulator->stats.reads++;
+    simulator->stats.bytes_read += size;
+
+    if (lw_simulator_chance(simulator, config->stretch_fault_probability)) {
+        simulator->stats.stretch_faults++;
+        return config->stretch_fault_us;
+    }
+
+    uint32_t jitter_us = config->stretch_jitter_us ? lw_simulator_random(simulator) % (config->stretch_jitter_us + 1) : 0;
+
+    return config->read_stretch_us + jitter_us;
+}
+
+// ----------------------------------------------------------------------------
+// Bus simulator.
+// ----------------------------------------------------------------------------
+static lw_i2c_grf500_simulator *lw_simulator_bus_find(lw_i2c_simulator_bus *bus, uint16_t address) {
+    for (uint32_t i = 0; i < bus->device_count; ++i) {
+        if (lw_i2c_grf500_simulator_get_address(bus->devices[i]) == address) {
+            return bus->devices[i];
+        }
+    }
+
+    return NULL;
+}
+
+// Clock out a number of bytes with their ACKs.
+static void lw_simulator_bus_clock_bytes(lw_i2c_simulator_bus *bus, uint32_t bytes) {
+    uint64_t time_ns = (uint64_t)bytes * (9 * (uint64_t)bus->bit_ns + (uint64_t)bus->config.byte_gap_us * 1000);
+    bus->time_ns += time_ns;
+    bus->stats.busy_ns += time_ns;
+}
+
+// A start, repeated start or stop condition, about one clock each.
+static void lw_simulator_bus_condition(lw_i2c_simulator_bus *bus) {
+    bus->time_ns += bus->bit_ns;
+    bus->stats.busy_ns += bus->bit_ns;
+}
+
+static lw_result lw_simulator_bus_fail(lw_i2c_simulator_bus *bus) {
+    lw_simulator_bus_condition(bus);
+    bus->stats.failed_transfers++;
+
+    return LW_RESULT_ERROR;
+}
+
+static lw_result lw_simulator_bus_transfer_callback(lw_i2c_bus *scheduler, lw_i2c_bus_message *messages, uint32_t count) {
+    return lw_i2c_simulator_bus_transfer((lw_i2c_simulator_bus *)scheduler->user_data, messages, count);
+}
+
+void lw_i2c_simulator_bus_get_default_config(lw_i2c_simulator_bus_config *config) {
+    memset(config, 0, sizeof(*config));
+    config->clock_hz = 100000;
+    config->transfer_overhead_us = 50;
+    config->byte_gap_us = 0;
+    config->stretch_timeout_us = 25000;
+}
+
+lw_result lw_i2c_simulator_bus_init(lw_i2c_simulator_bus *bus, const lw_i2c_simulator_bus_config *config) {
+    memset(bus, 0, sizeof(*bus));
+
+    if (config) {
+        bus->config = *config;
+    } else {
+        lw_i2c_simulator_bus_get_default_config(&bus->config);
+    }
+
+    if (bus->config.clock_hz == 0 || bus->config.clock_hz > 5000000) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    bus->bit_ns = (1000000000 + bus->config.clock_hz / 2) / bus->config.clock_hz;
+    bus->bus = lw_create_i2c_bus(bus, lw_simulator_bus_transfer_callback);
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_i2c_simulator_bus_attach(lw_i2c_simulator_bus *bus, lw_i2c_grf500_simulator *simulator) {
+    if (bus->device_count >= LW_I2C_SIMULATOR_MAX_DEVICES) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    bus->devices[bus->device_count++] = simulator;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_i2c_simulator_bus_transfer(lw_i2c_simulator_bus *bus, lw_i2c_bus_message *messages, uint32_t count) {
+    if (count == 0 || count > LW_I2C_BUS_MAX_MESSAGES) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    bus->stats.transfers++;
+    bus->time_ns += (uint64_t)bus->config.transfer_overhead_us * 1000;
+    lw_simulator_bus_condition(bus);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        lw_i2c_bus_message *message = &messages[i];
+
+        if (i > 0) {
+            lw_simulator_bus_condition(bus);
+        }
+
+        lw_simulator_bus_clock_bytes(bus, 1);
+        bus->stats.messages++;
+
+        lw_i2c_grf500_simulator *device = lw_simulator_bus_find(bus, message->address);
+
+        if (device == NULL || lw_i2c_grf500_simulator_address(device, bus->time_ns / 1000) != LW_RESULT_SUCCESS) {
+            bus->stats.address_naks++;
+            return lw_simulator_bus_fail(bus);
+        }
+
+        if (message->flags & LW_I2C_BUS_MESSAGE_READ) {
+            uint64_t stretch_ns = (uint64_t)lw_i2c_grf500_simulator_read(device, bus->time_ns / 1000, message->buffer, message->size) * 1000;
+
+            if (message->size > 0 && bus->config.stretch_timeout_us > 0 && stretch_ns > (uint64_t)bus->config.stretch_timeout_us * 1000) {
+                stretch_ns = (uint64_t)bus->config.stretch_timeout_us * 1000;
+                bus->time_ns += stretch_ns;
+                bus->stats.busy_ns += stretch_ns;
+                bus->stats.stretch_ns += stretch_ns;
+                bus->stats.stretch_timeouts++;
+                return lw_simulator_bus_fail(bus);
+            }
+
+            if (message->size > 0) {
+                bus->time_ns += stretch_ns;
+                bus->stats.busy_ns += stretch_ns;
+                bus->stats.stretch_ns += stretch_ns;
+            }
+
+            lw_simulator_bus_clock_bytes(bus, message->size);
+        } else {
+            lw_simulator_bus_clock_bytes(bus, message->size);
+
+            if (lw_i2c_grf500_simulator_write(device, bus->time_ns / 1000, message->buffer, message->size) != LW_RESULT_SUCCESS) {
+                bus->stats.data_naks++;
+                return lw_simulator_bus_fail(bus);
+            }
+        }
+
+        bus->stats.bytes += message->size;
+    }
+
+    lw_simulator_bus_condition(bus);
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_i2c_simulator_bus_idle(lw_i2c_simulator_bus *bus, uint64_t time_us) {
+    bus->time_ns += time_us * 1000;
+}
+
+uint64_t lw_i2c_simulator_bus_get_time_us(const lw_i2c_simulator_bus *bus) {
+    return bus->time_ns / 1000;
+}
+
+// ----------------------------------------------------------------------------
+// Callback device.
+// ----------------------------------------------------------------------------
+static lw_result lw_simulator_i2c_read(lw_callback_device *device, uint8_t reg, uint8_t *buffer, uint32_t size) {
+    lw_i2c_simulator_device *simulator_device = (lw_i2c_simulator_device *)device->user_data;
+    uint8_t command[] = {reg};
+
+    lw_i2c_bus_message messages[] = {
+        {simulator_device->address, LW_I2C_BUS_MESSAGE_WRITE, sizeof(command), command},
+        {simulator_device->address, LW_I2C_BUS_MESSAGE_READ, (uint16_t)size, buffer},
+    };
+
+    return lw_i2c_simulator_bus_transfer(simulator_device->bus, messages, 2);
+}
+
+static lw_result lw_simulator_i2c_write(lw_callback_device *device, uint8_t reg, uint8_t *buffer, uint32_t size) {
+    lw_i2c_simulator_device *simulator_device = (lw_i2c_simulator_device *)device->user_data;
+    uint8_t data[LW_SIMULATOR_WRITE_SIZE];
+
+    if (size + 1 > sizeof(data)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    data[0] = reg;
+    memcpy(data + 1, buffer, size);
+
+    lw_i2c_bus_message message = {simulator_device->address, LW_I2C_BUS_MESSAGE_WRITE, (uint16_t)(size + 1), data};
+
+    return lw_i2c_simulator_bus_transfer(simulator_device->bus, &message, 1);
+}
+
+void lw_i2c_simulator_device_init(lw_i2c_simulator_device *device, lw_i2c_simulator_bus *bus, uint8_t address) {
+    device->bus = bus;
+    device->address = address;
+    device->device = lw_create_callback_device(device, lw_simulator_i2c_read, lw_simulator_i2c_write);
+}
@@ -0,0 +1,405 @@
+// ----------------------------------------------------------------------------
+// LightWare I2C API GRF-500 Bus Simulator
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_I2C_GRF500_SIMULATOR_H
+#define LW_I2C_GRF500_SIMULATOR_H
+
+#include "lw_i2c_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Device simulator.
+//
+// A simulated GRF-500 plays the device side of the I2C register map. A write
+// message sets the register pointer with its first byte, and any further
+// bytes are written to that register. A read message returns the register
+// the pointer is on. Writes are checked against the same limits as the
+// request generators; a write that is out of range, has the wrong size,
+// targets a read only register, or carries a stale token is NAKed on its last
+// byte and changes nothing. A pointer to an unknown register is NAKed. Reading
+// past the end of a register returns 0xFF, as the bus idles high.
+//
+// Save parameters and reset need the token from the last token read, and
+// either one uses up the token. While a save is written to flash, and while
+// the device boots after a reset, it NAKs its address. Sleep stops measuring
+// until the device is next addressed, and that first address is NAKed.
+//
+// The simulated target moves back and forth between distance_cm and
+// distance_cm + amplitude_cm over period_ms, with gaussian noise on the raw
+// readings. Readings are taken at the update rate and run through the median,
+// rolling average and smoothing filters when they are enabled. A lost reading
+// is only reported as a lost signal once the lost signal counter is reached,
+// until then the last reading is repeated. The alarms follow the filtered
+// distance of the alarm return mode, with hysteresis and the confirm count.
+//
+// Registers and readings hold values as they are sent on the wire. Distances
+// are in tenths of the centimetre values the API reports, except multi data,
+// which is in millimetres.
+//
+// The device holds the clock low for read_stretch_us, plus up to
+// stretch_jitter_us, before the first byte of every read while it fetches the
+// register. Faults can be injected: the device can NAK its address, flip a bit
+// in a byte it sends, or stretch the clock for stretch_fault_us. There is no
+// checksum on I2C, so a flipped bit reaches the host unnoticed.
+// ----------------------------------------------------------------------------
+
+// History kept for the median and rolling average filters.
+#define LW_I2C_GRF500_SIMULATOR_FILTER_SIZE 32
+
+typedef struct {
+    // Identity reported by the device.
+    char product_name[16];
+    char serial_number[16];
+    uint32_t hardware_version;
+    uint32_t firmware_version;
+
+    // Target motion, noise and return strength.
+    int32_t distance_cm;
+    int32_t amplitude_cm;
+    uint32_t period_ms;
+    float noise_cm;
+    int32_t strength;
+
+    // Distance of the last return behind the first, or 0 for a single return.
+    int32_t last_return_offset_cm;
+
+    // Chance that a reading is lost.
+    float lost_probability;
+
+    // Temperature reported, in hundredths of a degree.
+    int32_t temperature;
+
+    // Clock stretch before the first byte of a read, plus a uniform random
+    // jitter up to stretch_jitter_us.
+    uint32_t read_stretch_us;
+    uint32_t stretch_jitter_us;
+
+    // Time the address is NAKed while saving parameters, and after a reset.
+    uint32_t save_time_ms;
+    uint32_t boot_time_ms;
+
+    // Chance that the device NAKs its address, that a byte it sends has a bit
+    // flipped, or that a read is stretched by stretch_fault_us instead.
+    float nak_probability;
+    float corrupt_probability;
+    float stretch_fault_probability;
+    uint32_t stretch_fault_us;
+
+    uint32_t seed;
+} lw_i2c_grf500_simulator_config;
+
+// Writable registers, as sent on the wire. These are saved and restored.
+typedef struct {
+    uint8_t user_data[16];
+    uint32_t distance_config;
+    uint8_t laser_firing;
+    uint8_t auto_exposure;
+    uint32_t update_rate;
+    uint8_t alarm_return_mode;
+    uint32_t lost_signal_counter;
+    uint32_t alarm_a_distance;
+    uint32_t alarm_b_distance;
+    uint32_t alarm_hysteresis;
+    uint8_t gpio_mode;
+    uint32_t gpio_alarm_confirm_count;
+    uint8_t median_filter_enable;
+    uint32_t median_filter_size;
+    uint8_t smooth_filter_enable;
+    uint32_t smooth_filter_factor;
+    uint8_t baud_rate;
+    uint8_t i2c_address;
+    uint8_t rolling_average_enable;
+    uint32_t rolling_average_size;
+    uint8_t led_state;
+    int32_t zero_offset;
+} lw_i2c_grf500_simulator_registers;
+
+typedef struct {
+    int32_t median_history[LW_I2C_GRF500_SIMULATOR_FILTER_SIZE];
+    int32_t average_history[LW_I2C_GRF500_SIMULATOR_FILTER_SIZE];
+    uint32_t count;
+    uint32_t index;
+    int32_t smoothed;
+    int32_t last_raw;
+    int32_t last_filtered;
+} lw_i2c_grf500_simulator_filter;
+
+typedef struct {
+    uint64_t reads;
+    uint64_t writes;
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t readings;
+
+    // Writes refused for a bad value, size, register or token, and pointers
+    // to registers the device doesn't know.
+    uint64_t rejected_writes;
+    uint64_t unknown_registers;
+
+    // Addresses NAKed while saving, booting or asleep.
+    uint64_t busy_naks;
+
+    // Injected faults.
+    uint64_t naks;
+    uint64_t corrupted_bytes;
+    uint64_t stretch_faults;
+
+    uint32_t saves;
+    uint32_t resets;
+    uint32_t sleeps;
+} lw_i2c_grf500_simulator_stats;
+
+typedef struct {
+    lw_i2c_grf500_simulator_config config;
+    lw_i2c_grf500_simulator_registers registers;
+    lw_i2c_grf500_simulator_registers saved;
+    uint32_t stream;
+    uint16_t token;
+    lw_bool token_valid;
+    lw_bool asleep;
+    uint64_t busy_until_us;
+    uint8_t pointer;
+    uint32_t random;
+
+    // Reading state.
+    uint64_t next_reading_us;
+    uint32_t lost_count;
+    lw_i2c_grf500_simulator_filter filters[2];
+    int32_t reading[8];
+    int32_t multi_distance_mm[2];
+    uint32_t alarm_count[2];
+    lw_bool alarm_active[2];
+
+    lw_i2c_grf500_simulator_stats stats;
+} lw_i2c_grf500_simulator;
+
+/*
+ * Get a simulator config with defaults: a GRF-500 with a target at 10 m
+ * moving 2 m over 10 s, 5 cm of noise, a short clock stretch on reads, and
+ * no faults.
+ *
+ * @param config The config is written here.
+ */
+void lw_i2c_grf500_simulator_get_default_config(lw_i2c_grf500_simulator_config *config);
+
+/*
+ * Initialize a simulated device. The registers start at their factory
+ * defaults, which are also the saved set, so the device answers on 0x66.
+ *
+ * @param simulator The simulator to initialize.
+ * @param config The config, or NULL for the defaults.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the config is invalid.
+ */
+lw_result lw_i2c_grf500_simulator_init(lw_i2c_grf500_simulator *simulator, const lw_i2c_grf500_simulator_config *config);
+
+/*
+ * Get the address the device currently answers on.
+ *
+ * @param simulator The simulator.
+ * @return The 7-bit I2C address.
+ */
+uint8_t lw_i2c_grf500_simulator_get_address(const lw_i2c_grf500_simulator *simulator);
+
+/*
+ * Address the device at the start of a message.
+ *
+ * @param simulator The simulator.
+ * @param now_us The current bus time in microseconds, which must not go backwards.
+ * @return LW_RESULT_SUCCESS if the device ACKs, or LW_RESULT_ERROR if it NAKs.
+ */
+lw_result lw_i2c_grf500_simulator_address(lw_i2c_grf500_simulator *simulator, uint64_t now_us);
+
+/*
+ * Receive the bytes of a write message, after the device has ACKed its address.
+ *
+ * @param simulator The simulator.
+ * @param now_us The time the last byte was received in microseconds.
+ * @param data The register pointer, followed by any data to write to it.
+ * @param size The number of bytes, at least 1.
+ * @return LW_RESULT_SUCCESS if every byte was ACKed, or LW_RESULT_ERROR if one was NAKed.
+ */
+lw_result lw_i2c_grf500_simulator_write(lw_i2c_grf500_simulator *simulator, uint64_t now_us, const uint8_t *data, uint32_t size);
+
+/*
+ * Send the bytes of a read message, after the device has ACKed its address.
+ *
+ * @param simulator The simulator.
+ * @param now_us The current bus time in microseconds.
+ * @param buffer The bytes sent by the device are written here.
+ * @param size The number of bytes to read.
+ * @return The time the device stretches the clock before the first byte, in microseconds.
+ */
+uint32_t lw_i2c_grf500_simulator_read(lw_i2c_grf500_simulator *simulator, uint64_t now_us, uint8_t *buffer, uint32_t size);
+
+// ----------------------------------------------------------------------------
+// Bus simulator.
+//
+// A simulated bus connects a host to several simulated devices and keeps the
+// bus time. Every transfer costs transfer_overhead_us of host time to set up,
+// then a start, 9 clocks for every address and data byte with its ACK, a
+// repeated start between messages, and a stop, at clock_hz. Devices can
+// stretch the clock before a read; if a stretch outlasts stretch_timeout_us
+// the controller gives up on the transfer. A NAK, from a missing or busy
+// device or a rejected write, ends the transfer with a stop, and the messages
+// before it stay done, as on Linux.
+//
+// Time is virtual: it only moves with transfers and lw_i2c_simulator_bus_idle,
+// so a run is the same on any host and much faster than the real bus.
+// ----------------------------------------------------------------------------
+#ifndef LW_I2C_SIMULATOR_MAX_DEVICES
+#define LW_I2C_SIMULATOR_MAX_DEVICES 32
+#endif
+
+typedef struct {
+    // Clock rate, for example 100000, 400000 or 1000000.
+    uint32_t clock_hz;
+
+    // Host time to set up each transfer, such as the ioctl and driver.
+    uint32_t transfer_overhead_us;
+
+    // Idle time the controller leaves between bytes.
+    uint32_t byte_gap_us;
+
+    // Longest clock stretch before the controller gives up, or 0 to wait forever.
+    uint32_t stretch_timeout_us;
+} lw_i2c_simulator_bus_config;
+
+typedef struct {
+    uint64_t transfers;
+    uint64_t failed_transfers;
+    uint64_t messages;
+    uint64_t bytes;
+
+    // NAKs on an address with no device, or from a device.
+    uint64_t address_naks;
+    uint64_t data_naks;
+    uint64_t stretch_timeouts;
+
+    // Time the clock was running or held low, and time spent stretched.
+    uint64_t busy_ns;
+    uint64_t stretch_ns;
+} lw_i2c_simulator_bus_stats;
+
+typedef struct {
+    // The bus scheduler on the simulated bus, use this like the platform bus.
+    lw_i2c_bus bus;
+
+    lw_i2c_simulator_bus_config config;
+    uint32_t bit_ns;
+    uint64_t time_ns;
+
+    uint32_t device_count;
+    lw_i2c_grf500_simulator *devices[LW_I2C_SIMULATOR_MAX_DEVICES];
+
+    lw_i2c_simulator_bus_stats stats;
+} lw_i2c_simulator_bus;
+
+/*
+ * Get a bus config with defaults: 100 kHz, 50 us of transfer overhead, no gap
+ * between bytes, and the 25 ms SMBus clock stretch timeout.
+ *
+ * @param config The config is written here.
+ */
+void lw_i2c_simulator_bus_get_default_config(lw_i2c_simulator_bus_config *config);
+
+/*
+ * Initialize a simulated bus with no devices.
+ *
+ * @param bus The bus to initialize. It must not be moved after this call.
+ * @param config The config, or NULL for the defaults.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the config is invalid.
+ */
+lw_result lw_i2c_simulator_bus_init(lw_i2c_simulator_bus *bus, const lw_i2c_simulator_bus_config *config);
+
+/*
+ * Connect a simulated device to the bus. It answers on whatever address its
+ * registers hold, so several devices must be given different addresses.
+ *
+ * @param bus The bus.
+ * @param simulator The device, which must outlive the bus.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the bus is full.
+ */
+lw_result lw_i2c_simulator_bus_attach(lw_i2c_simulator_bus *bus, lw_i2c_grf500_simulator *simulator);
+
+/*
+ * Run messages as one combined transfer, with a repeated start between them,
+ * and move the bus time past it.
+ *
+ * @param bus The bus.
+ * @param messages The messages to transfer.
+ * @param count The number of messages.
+ * @return LW_RESULT_SUCCESS if all messages were transferred, or
+ *         LW_RESULT_ERROR on a NAK or clock stretch timeout, or
+ *         LW_RESULT_INVALID_PARAMETER if there are no or too many messages.
+ */
+lw_result lw_i2c_simulator_bus_transfer(lw_i2c_simulator_bus *bus, lw_i2c_bus_message *messages, uint32_t count);
+
+/*
+ * Let bus time pass with the bus idle, as the host would by sleeping.
+ *
+ * @param bus The bus.
+ * @param time_us The time to pass in microseconds.
+ */
+void lw_i2c_simulator_bus_idle(lw_i2c_simulator_bus *bus, uint64_t time_us);
+
+/*
+ * Get the current bus time.
+ *
+ * @param bus The bus.
+ * @return The time in microseconds since the bus was initialized.
+ */
+uint64_t lw_i2c_simulator_bus_get_time_us(const lw_i2c_simulator_bus *bus);
+
+// ----------------------------------------------------------------------------
+// Callback device.
+//
+// A callback device for one address on a simulated bus, for use with the
+// managed API. Reads are a combined write-register/read-data transfer and
+// writes are a single message, as on a real bus.
+// ----------------------------------------------------------------------------
+typedef struct {
+    // The device to use with the API.
+    lw_callback_device device;
+
+    lw_i2c_simulator_bus *bus;
+    uint8_t address;
+} lw_i2c_simulator_device;
+
+/*
+ * Initialize a callback device on a simulated bus.
+ *
+ * @param device The device to initialize. It must not be moved after this call.
+ * @param bus The bus the device is on.
+ * @param address The I2C address to talk to.
+ */
+void lw_i2c_simulator_device_init(lw_i2c_simulator_device *device, lw_i2c_simulator_bus *bus, uint8_t address);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_I2C_GRF500_SIMULATOR_H
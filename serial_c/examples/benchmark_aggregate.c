@@ -0,0 +1,217 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API aggregation benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_aggregate.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_SAMPLES 200000
+#define BENCHMARK_REPEATS 10
+
+// 100 Hz samples in 1 s windows, small enough for exact medians.
+#define BENCHMARK_PERIOD_US 10000
+#define BENCHMARK_WINDOW_US 1000000
+#define BENCHMARK_MAX_SUMMARIES (BENCHMARK_SAMPLES / 50 + 2)
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static lw_grf500_distance_sample samples[BENCHMARK_SAMPLES];
+static lw_grf500_aggregate_summary summaries[BENCHMARK_MAX_SUMMARIES];
+static lw_grf500_aggregator aggregator;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static int compare_i32(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// The mean is a float, so allow for its rounding.
+static lw_bool close_to(double value, double expected) {
+    double error = (value > expected) ? value - expected : expected - value;
+    double scale = (expected < 0) ? -expected : expected;
+    return (error <= scale * 1e-6 + 0.01) ? LW_TRUE : LW_FALSE;
+}
+
+static uint32_t run(uint32_t window_samples, uint64_t window_us) {
+    lw_grf500_aggregate_init(&aggregator, LW_GRF500_DISTANCE_CONFIG_ALL, window_samples, window_us);
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+        if (lw_grf500_aggregate_push(&aggregator, &samples[i], &summaries[count]) == LW_RESULT_SUCCESS) {
+            count++;
+        }
+    }
+
+    if (lw_grf500_aggregate_flush(&aggregator, &summaries[count]) == LW_RESULT_SUCCESS) {
+        count++;
+    }
+
+    return count;
+}
+
+// Check every summary against a sort of the samples in its window. The
+// windows are taken in order, each summary covering the next sample_count
+// samples.
+static lw_bool check_summaries(uint32_t count) {
+    static int32_t values[BENCHMARK_SAMPLES];
+    uint32_t first = 0;
+
+    for (uint32_t s = 0; s < count; ++s) {
+        const lw_grf500_aggregate_summary *summary = &summaries[s];
+
+        for (uint32_t f = 0; f < LW_GRF500_DISTANCE_FIELD_COUNT; ++f) {
+            lw_bool distance = (f == 0 || f == 1 || f == 3 || f == 4) ? LW_TRUE : LW_FALSE;
+            uint32_t valid = 0;
+            uint32_t lost = 0;
+            int64_t sum = 0;
+
+            for (uint32_t i = first; i < first + summary->sample_count; ++i) {
+                int32_t value = lw_grf500_get_distance_field(&samples[i].data, f);
+
+                if (distance && value == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+                    lost++;
+                    continue;
+                }
+
+                values[valid++] = value;
+                sum += value;
+            }
+
+            const lw_grf500_aggregate_field *field = &summary->fields[f];
+
+            if (field->valid_count != valid || field->lost_count != lost) {
+                printf("Summary %u field %u: counts %u/%u, expected %u/%u\n", s, f, field->valid_count, field->lost_count, valid, lost);
+                return LW_FALSE;
+            }
+
+            if (valid == 0) {
+                continue;
+            }
+
+            qsort(values, valid, sizeof(values[0]), compare_i32);
+            double mean = (double)sum / valid;
+
+            if (field->min != values[0] || field->max != values[valid - 1] || !close_to(field->mean, mean) ||
+                (summary->median_exact && field->median != values[(valid - 1) / 2] && field->median != values[valid / 2])) {
+                printf("Summary %u field %u: min %d max %d median %d mean %.2f, expected %d %d %d %.2f\n", s, f, field->min, field->max, field->median, field->mean, values[0], values[valid - 1], values[(valid - 1) / 2], mean);
+                return LW_FALSE;
+            }
+        }
+
+        first += summary->sample_count;
+    }
+
+    if (first != BENCHMARK_SAMPLES) {
+        printf("Summaries cover %u of %d samples\n", first, BENCHMARK_SAMPLES);
+        return LW_FALSE;
+    }
+
+    return LW_TRUE;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus: a target wandering in range, lost signals, and a
+    // few dropped samples that leave gaps in time.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+    uint64_t time_us = 1000000;
+    int32_t target = 5000;
+
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+        lw_grf500_distance_sample *sample = &samples[i];
+        time_us += BENCHMARK_PERIOD_US * (((next_random(&seed) % 100) == 0) ? 3 : 1);
+        target += (int32_t)(next_random(&seed) % 41) - 20;
+        target = (target < 100) ? 200 - target : target;
+
+        sample->timestamp_us = time_us;
+        sample->sequence = i;
+        sample->data.first_return_raw_cm = ((next_random(&seed) % 20) == 0) ? LW_GRF500_LOST_SIGNAL_DISTANCE : target + (int32_t)(next_random(&seed) % 21) - 10;
+        sample->data.first_return_filtered_cm = target;
+        sample->data.first_return_strength = (int32_t)(next_random(&seed) % 100);
+        sample->data.last_return_raw_cm = ((next_random(&seed) % 5) == 0) ? LW_GRF500_LOST_SIGNAL_DISTANCE : target + 500;
+        sample->data.last_return_filtered_cm = target + 500;
+        sample->data.last_return_strength = (int32_t)(next_random(&seed) % 50);
+        sample->data.temperature = 2500 + (int32_t)(i / 10000);
+        sample->data.alarm_status = (int32_t)(next_random(&seed) % 2);
+    }
+
+    printf("Samples: %d x %d, all distance config fields\n\n", BENCHMARK_SAMPLES, BENCHMARK_REPEATS);
+    printf("%-24s %12s %12s\n", "window", "ns/sample", "summaries");
+
+    // ----------------------------------------------------------------------------
+    // Time sample count and time windows, and check both against a sort of
+    // every window.
+    // ----------------------------------------------------------------------------
+    struct {
+        const char *name;
+        uint32_t window_samples;
+        uint64_t window_us;
+    } windows[] = {
+        {"50 samples", 50, 0},
+        {"1 s", 0, BENCHMARK_WINDOW_US},
+        {"80 samples or 1 s", 80, BENCHMARK_WINDOW_US},
+    };
+
+    for (uint32_t w = 0; w < sizeof(windows) / sizeof(windows[0]); ++w) {
+        uint64_t start_ns = lw_platform_get_time_ns();
+        uint32_t count = 0;
+
+        for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+            count = run(windows[w].window_samples, windows[w].window_us);
+        }
+
+        double ns_per_sample = (double)(lw_platform_get_time_ns() - start_ns) / ((double)BENCHMARK_SAMPLES * BENCHMARK_REPEATS);
+        printf("%-24s %12.1f %12u\n", windows[w].name, ns_per_sample, count);
+
+        if (!check_summaries(count)) {
+            return 1;
+        }
+    }
+
+    printf("\nEvery summary matches a sort of its window\n");
+
+    return 0;
+}
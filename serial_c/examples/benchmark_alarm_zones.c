@@ -0,0 +1,163 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API alarm zones benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_alarm_zones.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_SENSORS 64
+#define BENCHMARK_ZONES 32
+#define BENCHMARK_TICKS 4096
+#define BENCHMARK_REPEATS 50
+
+// Update rate the fleet load is reported at.
+#define BENCHMARK_UPDATE_RATE_HZ 10
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static int32_t inputs[BENCHMARK_TICKS][BENCHMARK_SENSORS];
+static uint32_t active[2][BENCHMARK_TICKS][BENCHMARK_SENSORS];
+static uint64_t tick_ns[BENCHMARK_TICKS * BENCHMARK_REPEATS];
+static lw_grf500_alarm_zones zones;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus: every sensor wanders through its zones, with some
+    // lost signals.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+
+    for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+        int32_t distance = (int32_t)(next_random(&seed) % 5000);
+
+        for (uint32_t t = 0; t < BENCHMARK_TICKS; ++t) {
+            distance += (int32_t)(next_random(&seed) % 201) - 100;
+            distance = (distance < 0) ? -distance : distance;
+            distance = (distance > 5000) ? 10000 - distance : distance;
+            inputs[t][s] = ((next_random(&seed) & 0xFF) < 8) ? LW_GRF500_LOST_SIGNAL_DISTANCE : distance;
+        }
+    }
+
+    lw_simd_level levels[] = {LW_SIMD_LEVEL_SCALAR, lw_simd_detect()};
+    uint32_t level_count = (levels[1] == LW_SIMD_LEVEL_SCALAR) ? 1 : 2;
+
+    printf("Sensors: %d, zones: %d, ticks: %d x %d, best SIMD level: %s\n\n", BENCHMARK_SENSORS, BENCHMARK_ZONES, BENCHMARK_TICKS, BENCHMARK_REPEATS, lw_simd_level_name(lw_simd_detect()));
+    printf("%-8s %12s %12s %12s %12s %12s %10s %14s\n", "level", "ns/sample", "Msamples/s", "tick p50 ns", "tick p99 ns", "tick max ns", "events", "load at rate");
+
+    // ----------------------------------------------------------------------------
+    // Time every code path over the same readings. One tick is one reading
+    // from every sensor, and its time is the latency of the last event.
+    // ----------------------------------------------------------------------------
+    for (uint32_t l = 0; l < level_count; ++l) {
+        lw_grf500_alarm_event events[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+        uint64_t total_ns = 0;
+        uint64_t event_total = 0;
+
+        for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+            uint32_t zone_seed = 6789;
+            lw_grf500_alarm_zones_init(&zones, BENCHMARK_SENSORS);
+            lw_grf500_alarm_zones_set_simd_level(&zones, levels[l]);
+
+            for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+                for (uint32_t z = 0; z < BENCHMARK_ZONES; ++z) {
+                    lw_grf500_alarm_zone zone;
+                    zone.near_distance = (int32_t)(next_random(&zone_seed) % 4500);
+                    zone.far_distance = zone.near_distance + 50 + (int32_t)(next_random(&zone_seed) % 500);
+                    zone.hysteresis = (int32_t)(next_random(&zone_seed) % 50);
+                    zone.confirm_count = next_random(&zone_seed) % 5;
+                    lw_grf500_alarm_zones_set_zone(&zones, s, z, &zone);
+                }
+            }
+
+            for (uint32_t t = 0; t < BENCHMARK_TICKS; ++t) {
+                uint64_t start_ns = lw_platform_get_time_ns();
+
+                for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+                    uint32_t event_count;
+                    lw_grf500_alarm_zones_update(&zones, s, inputs[t][s], t, events, &event_count);
+                    event_total += event_count;
+                }
+
+                uint64_t elapsed_ns = lw_platform_get_time_ns() - start_ns;
+                tick_ns[n * BENCHMARK_TICKS + t] = elapsed_ns;
+                total_ns += elapsed_ns;
+
+                for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+                    active[l][t][s] = lw_grf500_alarm_zones_get_active(&zones, s);
+                }
+            }
+        }
+
+        uint32_t tick_count = BENCHMARK_TICKS * BENCHMARK_REPEATS;
+        qsort(tick_ns, tick_count, sizeof(tick_ns[0]), compare_u64);
+
+        double ns_per_sample = (double)total_ns / ((double)tick_count * BENCHMARK_SENSORS);
+        double load = ns_per_sample * BENCHMARK_SENSORS * BENCHMARK_UPDATE_RATE_HZ / 1e9;
+
+        printf("%-8s %12.1f %12.1f %12llu %12llu %12llu %10llu %13.4f%%\n", lw_simd_level_name(levels[l]), ns_per_sample, 1000.0 / ns_per_sample, (unsigned long long)tick_ns[tick_count / 2], (unsigned long long)tick_ns[(uint64_t)tick_count * 99 / 100], (unsigned long long)tick_ns[tick_count - 1], (unsigned long long)(event_total / BENCHMARK_REPEATS), load * 100.0);
+    }
+
+    printf("\nLoad is the share of one core used by %d sensors at %d Hz.\n", BENCHMARK_SENSORS, BENCHMARK_UPDATE_RATE_HZ);
+
+    // ----------------------------------------------------------------------------
+    // Check the vector path against the scalar reference.
+    // ----------------------------------------------------------------------------
+    if (level_count == 2) {
+        if (memcmp(active[0], active[1], sizeof(active[0])) != 0) {
+            printf("Mismatch against the scalar reference\n");
+            return 1;
+        }
+
+        printf("\nZone states match the scalar reference\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API clock model benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_clock_model.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_SAMPLES 100000
+#define BENCHMARK_REPEATS 20
+
+// Samples skipped while the loop locks.
+#define BENCHMARK_SETTLE_SAMPLES 200
+
+// A 10 Hz device whose clock runs 50 ppm slow against the host, behind 2 ms
+// of fixed latency and up to 6 ms of transport jitter.
+#define BENCHMARK_UPDATE_RATE_HZ 10
+#define BENCHMARK_DRIFT_PPM 50.0
+#define BENCHMARK_LATENCY_US 2000
+#define BENCHMARK_JITTER_US 6000
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static uint64_t acquisitions[BENCHMARK_SAMPLES];
+static uint64_t arrivals[BENCHMARK_SAMPLES];
+static uint32_t arrival_count;
+static lw_grf500_clock_estimate estimates[BENCHMARK_SAMPLES];
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus of arrival times. Jitter is skewed towards small
+    // delays, as on a USB serial adapter, and about 1 in 100 samples is lost.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+    double period_us = 1000000.0 / BENCHMARK_UPDATE_RATE_HZ * (1.0 + BENCHMARK_DRIFT_PPM / 1e6);
+    uint32_t dropped = 0;
+
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+        uint64_t acquisition_us = 1000000 + (uint64_t)(i * period_us);
+        double u = (double)(next_random(&seed) % 1000) / 1000.0;
+
+        if (i > 0 && (next_random(&seed) % 100) == 0) {
+            dropped++;
+            continue;
+        }
+
+        acquisitions[arrival_count] = acquisition_us;
+        arrivals[arrival_count] = acquisition_us + BENCHMARK_LATENCY_US + (uint64_t)(u * u * BENCHMARK_JITTER_US);
+        arrival_count++;
+    }
+
+    printf("Samples: %d x %d at %d Hz, drift: %.1f ppm, latency: %d us, jitter: up to %d us\n\n", BENCHMARK_SAMPLES, BENCHMARK_REPEATS, BENCHMARK_UPDATE_RATE_HZ, BENCHMARK_DRIFT_PPM, BENCHMARK_LATENCY_US, BENCHMARK_JITTER_US);
+
+    // ----------------------------------------------------------------------------
+    // Time the model over the same arrivals.
+    // ----------------------------------------------------------------------------
+    lw_grf500_clock_model model;
+    uint64_t total_ns = 0;
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        lw_grf500_clock_model_init(&model, BENCHMARK_UPDATE_RATE_HZ, BENCHMARK_LATENCY_US);
+        uint64_t start_ns = lw_platform_get_time_ns();
+
+        for (uint32_t i = 0; i < arrival_count; ++i) {
+            lw_grf500_clock_model_update(&model, arrivals[i], &estimates[i]);
+        }
+
+        total_ns += lw_platform_get_time_ns() - start_ns;
+    }
+
+    // ----------------------------------------------------------------------------
+    // Compare raw and de-jittered times against the true acquisition times.
+    // ----------------------------------------------------------------------------
+    double raw_sum = 0;
+    double raw_max = 0;
+    double estimate_sum = 0;
+    double estimate_max = 0;
+    uint32_t detected = 0;
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < arrival_count; ++i) {
+        detected += estimates[i].dropped;
+
+        if (i < BENCHMARK_SETTLE_SAMPLES) {
+            continue;
+        }
+
+        double raw_error = (double)arrivals[i] - BENCHMARK_LATENCY_US - (double)acquisitions[i];
+        double estimate_error = (double)estimates[i].acquisition_us - (double)acquisitions[i];
+
+        raw_sum += raw_error * raw_error;
+        raw_max = fmax(raw_max, fabs(raw_error));
+        estimate_sum += estimate_error * estimate_error;
+        estimate_max = fmax(estimate_max, fabs(estimate_error));
+        count++;
+    }
+
+    double raw_rms = sqrt(raw_sum / count);
+    double estimate_rms = sqrt(estimate_sum / count);
+    double drift_ppm = lw_grf500_clock_model_drift_ppm(&model);
+
+    printf("%-24s %12.1f\n", "ns/update", (double)total_ns / ((double)arrival_count * BENCHMARK_REPEATS));
+    printf("%-24s %12.1f\n", "raw rms error us", raw_rms);
+    printf("%-24s %12.1f\n", "raw max error us", raw_max);
+    printf("%-24s %12.1f\n", "model rms error us", estimate_rms);
+    printf("%-24s %12.1f\n", "model max error us", estimate_max);
+    printf("%-24s %12.2f\n", "drift ppm", drift_ppm);
+    printf("%-24s %12u\n", "dropped samples", dropped);
+    printf("%-24s %12u\n", "detected drops", detected);
+    printf("%-24s %12llu\n", "relocks", (unsigned long long)model.relocks);
+
+    // ----------------------------------------------------------------------------
+    // The model must remove most of the jitter, find every drop and track the
+    // drift.
+    // ----------------------------------------------------------------------------
+    if (estimate_rms * 4 > raw_rms || detected != dropped || fabs(drift_ppm - BENCHMARK_DRIFT_PPM) > 5.0 || model.relocks != 0) {
+        printf("\nCheck failed\n");
+        return 1;
+    }
+
+    printf("\nModel error, drops and drift are within bounds\n");
+
+    return 0;
+}
@@ -0,0 +1,255 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API codec benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_codec.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_CHUNKS 32
+#define BENCHMARK_REPEATS 20
+#define BENCHMARK_RECORDING_SIZE (LW_GRF500_RECORDER_ALIGNMENT + (BENCHMARK_CHUNKS + 1) * LW_GRF500_RECORDER_CHUNK_SIZE)
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static uint8_t recording_data[BENCHMARK_RECORDING_SIZE];
+static uint64_t recording_size;
+static uint8_t encoded[BENCHMARK_CHUNKS][LW_GRF500_CODEC_MAX_CHUNK_SIZE];
+static uint32_t encoded_sizes[BENCHMARK_CHUNKS];
+static lw_grf500_chunk decoded;
+static lw_grf500_recorder recorder;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static lw_result write_recording(lw_grf500_recorder *device_recorder, const void *data, uint32_t size, uint64_t offset) {
+    (void)device_recorder;
+
+    if (offset + size > sizeof(recording_data)) {
+        return LW_RESULT_ERROR;
+    }
+
+    memcpy(recording_data + offset, data, size);
+    recording_size = (offset + size > recording_size) ? offset + size : recording_size;
+    return LW_RESULT_SUCCESS;
+}
+
+// Compare the used samples and the footer of two chunks.
+static lw_bool chunks_match(const lw_grf500_chunk *a, const lw_grf500_chunk *b, uint32_t column_count) {
+    uint32_t count = a->footer.sample_count;
+
+    if (memcmp(&a->footer, &b->footer, sizeof(a->footer)) != 0 ||
+        memcmp(a->timestamp_us, b->timestamp_us, count * sizeof(uint64_t)) != 0 ||
+        memcmp(a->sequence, b->sequence, count * sizeof(uint32_t)) != 0) {
+        return LW_FALSE;
+    }
+
+    for (uint32_t c = 0; c < column_count; ++c) {
+        if (memcmp(a->columns[c], b->columns[c], count * sizeof(int32_t)) != 0) {
+            return LW_FALSE;
+        }
+    }
+
+    return LW_TRUE;
+}
+
+// Round trip a column, and check that every truncated copy is rejected.
+static lw_bool check_column(const char *name, const int32_t *values, uint32_t count) {
+    static uint8_t buffer[LW_GRF500_CODEC_MAX_COLUMN_SIZE(LW_GRF500_CODEC_MAX_VALUES)];
+    static int32_t output[LW_GRF500_CODEC_MAX_VALUES];
+    uint32_t size;
+    uint32_t output_count;
+    uint32_t consumed;
+
+    if (lw_grf500_codec_encode_int32(values, count, buffer, sizeof(buffer), &size) != LW_RESULT_SUCCESS ||
+        lw_grf500_codec_decode_int32(buffer, size, output, count, &output_count, &consumed) != LW_RESULT_SUCCESS ||
+        output_count != count || consumed != size || memcmp(values, output, count * sizeof(int32_t)) != 0) {
+        printf("Round trip failed: %s\n", name);
+        return LW_FALSE;
+    }
+
+    for (uint32_t truncated = 0; truncated < size; ++truncated) {
+        if (lw_grf500_codec_decode_int32(buffer, truncated, output, count, &output_count, &consumed) == LW_RESULT_SUCCESS) {
+            printf("Truncated column accepted: %s at %u of %u bytes\n", name, truncated, size);
+            return LW_FALSE;
+        }
+    }
+
+    // The first byte holds the method in the low nibble and the difference
+    // order in the high nibble.
+    static const char *method_names[] = {"rle", "varint", "bitpack"};
+    printf("%-20s %8u bytes for %4u values, %s, order %u\n", name, size, count, method_names[(buffer[0] & 0x0F) % 3], buffer[0] >> 4);
+    return LW_TRUE;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Record a fixed corpus of 10 Hz distance data: a slowly moving target
+    // with noise, some lost signals and a few dropped samples.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+    uint32_t sequence = 0;
+    int32_t target = 15000;
+
+    lw_grf500_recorder_init(&recorder, LW_GRF500_RECORDING_DISTANCE, LW_GRF500_DISTANCE_CONFIG_ALL, NULL, &write_recording);
+
+    for (uint32_t i = 0; i < BENCHMARK_CHUNKS * LW_GRF500_RECORDER_CHUNK_SAMPLES; ++i) {
+        lw_grf500_distance_sample sample;
+        sequence += ((next_random(&seed) % 200) == 0) ? 2 : 1;
+        target += (int32_t)(next_random(&seed) % 21) - 10;
+
+        sample.timestamp_us = 1000000 + (uint64_t)sequence * 100000 + next_random(&seed) % 50;
+        sample.sequence = sequence;
+        sample.data.first_return_raw_cm = ((next_random(&seed) % 100) == 0) ? LW_GRF500_LOST_SIGNAL_DISTANCE : target + (int32_t)(next_random(&seed) % 11) - 5;
+        sample.data.first_return_filtered_cm = target;
+        sample.data.first_return_strength = 60 + (int32_t)(next_random(&seed) % 5);
+        sample.data.last_return_raw_cm = target + 300 + (int32_t)(next_random(&seed) % 11) - 5;
+        sample.data.last_return_filtered_cm = target + 300;
+        sample.data.last_return_strength = 20 + (int32_t)(next_random(&seed) % 5);
+        sample.data.temperature = 2500 + (int32_t)(i / 4096);
+        sample.data.alarm_status = 0;
+
+        if (lw_grf500_recorder_append_distance(&recorder, &sample) != LW_RESULT_SUCCESS) {
+            printf("Failed to record sample\n");
+            return 1;
+        }
+    }
+
+    lw_grf500_recorder_flush(&recorder);
+
+    lw_grf500_recording recording;
+
+    if (lw_grf500_recording_open(&recording, recording_data, recording_size) != LW_RESULT_SUCCESS) {
+        printf("Failed to open recording\n");
+        return 1;
+    }
+
+    uint32_t column_count = recording.header->column_count;
+    printf("Chunks: %d of %d samples, columns: %u, repeats: %d\n\n", BENCHMARK_CHUNKS, LW_GRF500_RECORDER_CHUNK_SAMPLES, column_count, BENCHMARK_REPEATS);
+
+    // ----------------------------------------------------------------------------
+    // Time encoding and decoding of every chunk, and check the round trip.
+    // ----------------------------------------------------------------------------
+    uint64_t encode_ns = 0;
+    uint64_t decode_ns = 0;
+    uint64_t encoded_total = 0;
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        uint64_t start_ns = lw_platform_get_time_ns();
+
+        for (uint32_t c = 0; c < BENCHMARK_CHUNKS; ++c) {
+            lw_grf500_codec_encode_chunk(lw_grf500_recording_get_chunk(&recording, c), column_count, encoded[c], sizeof(encoded[c]), &encoded_sizes[c]);
+        }
+
+        encode_ns += lw_platform_get_time_ns() - start_ns;
+        start_ns = lw_platform_get_time_ns();
+
+        for (uint32_t c = 0; c < BENCHMARK_CHUNKS; ++c) {
+            uint32_t consumed;
+
+            if (lw_grf500_codec_decode_chunk(encoded[c], encoded_sizes[c], column_count, &decoded, &consumed) != LW_RESULT_SUCCESS ||
+                consumed != encoded_sizes[c] || !chunks_match(lw_grf500_recording_get_chunk(&recording, c), &decoded, column_count)) {
+                printf("Chunk %u does not round trip\n", c);
+                return 1;
+            }
+        }
+
+        decode_ns += lw_platform_get_time_ns() - start_ns;
+    }
+
+    for (uint32_t c = 0; c < BENCHMARK_CHUNKS; ++c) {
+        encoded_total += encoded_sizes[c];
+    }
+
+    double raw_total = (double)BENCHMARK_CHUNKS * LW_GRF500_RECORDER_CHUNK_SAMPLES * (sizeof(uint64_t) + sizeof(uint32_t) + column_count * sizeof(int32_t));
+    double samples = (double)BENCHMARK_CHUNKS * LW_GRF500_RECORDER_CHUNK_SAMPLES * BENCHMARK_REPEATS;
+
+    printf("%-20s %12.0f\n", "raw bytes", raw_total);
+    printf("%-20s %12llu\n", "encoded bytes", (unsigned long long)encoded_total);
+    printf("%-20s %12.2f\n", "ratio", raw_total / (double)encoded_total);
+    printf("%-20s %12.1f\n", "encode ns/sample", (double)encode_ns / samples);
+    printf("%-20s %12.1f\n", "decode ns/sample", (double)decode_ns / samples);
+    printf("%-20s %12.1f\n", "encode MB/s", raw_total * BENCHMARK_REPEATS / ((double)encode_ns / 1e3));
+    printf("%-20s %12.1f\n", "decode MB/s", raw_total * BENCHMARK_REPEATS / ((double)decode_ns / 1e3));
+
+    // ----------------------------------------------------------------------------
+    // Round trip columns that push each method to its limits.
+    // ----------------------------------------------------------------------------
+    static int32_t column[LW_GRF500_CODEC_MAX_VALUES];
+    uint32_t count = LW_GRF500_CODEC_MAX_VALUES;
+    lw_bool passed = LW_TRUE;
+
+    printf("\n");
+
+    for (uint32_t i = 0; i < count; ++i) {
+        column[i] = 1234;
+    }
+
+    passed &= check_column("constant", column, count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        column[i] = (int32_t)(i * 7) - 3000;
+    }
+
+    passed &= check_column("ramp", column, count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        column[i] = (i & 1) ? INT32_MAX : INT32_MIN;
+    }
+
+    passed &= check_column("alternating extremes", column, count);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        column[i] = (int32_t)(next_random(&seed) ^ (next_random(&seed) << 24));
+    }
+
+    passed &= check_column("random", column, count);
+    passed &= check_column("single value", column, 1);
+    passed &= check_column("partial block", column, LW_GRF500_CODEC_BLOCK_VALUES + 3);
+
+    if (!passed) {
+        return 1;
+    }
+
+    printf("\nEvery chunk and column round trips, and truncated columns are rejected\n");
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API filter bank benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_filter_bank.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_SENSORS 64
+#define BENCHMARK_TICKS 4096
+#define BENCHMARK_REPEATS 200
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static int32_t inputs[BENCHMARK_TICKS][BENCHMARK_SENSORS];
+static int32_t averages[2][BENCHMARK_TICKS][BENCHMARK_SENSORS];
+static int32_t smoothed[2][BENCHMARK_TICKS][BENCHMARK_SENSORS];
+static lw_grf500_filter_bank bank;
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus of readings, with some lost signals.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+
+    for (uint32_t t = 0; t < BENCHMARK_TICKS; ++t) {
+        for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+            seed = seed * 1103515245 + 12345;
+            inputs[t][s] = ((seed >> 24) < 8) ? LW_GRF500_LOST_SIGNAL_DISTANCE : (int32_t)((seed >> 8) % 50000);
+        }
+    }
+
+    lw_simd_level levels[] = {LW_SIMD_LEVEL_SCALAR, lw_simd_detect()};
+    uint32_t level_count = (levels[1] == LW_SIMD_LEVEL_SCALAR) ? 1 : 2;
+
+    printf("Sensors: %d, ticks: %d x %d, best SIMD level: %s\n\n", BENCHMARK_SENSORS, BENCHMARK_TICKS, BENCHMARK_REPEATS, lw_simd_level_name(lw_simd_detect()));
+
+    // ----------------------------------------------------------------------------
+    // Time every code path over the same readings.
+    // ----------------------------------------------------------------------------
+    for (uint32_t l = 0; l < level_count; ++l) {
+        uint64_t start_us = lw_platform_get_time_us();
+
+        for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+            lw_grf500_filter_bank_init(&bank, BENCHMARK_SENSORS, 16, 80);
+            lw_grf500_filter_bank_set_simd_level(&bank, levels[l]);
+
+            for (uint32_t t = 0; t < BENCHMARK_TICKS; ++t) {
+                lw_grf500_filter_bank_step(&bank, inputs[t], averages[l][t], smoothed[l][t]);
+            }
+        }
+
+        double elapsed_ns = (double)(lw_platform_get_time_us() - start_us) * 1000.0;
+        uint32_t ticks = BENCHMARK_TICKS * BENCHMARK_REPEATS;
+        printf("%-16s %10.1f ns/tick %8.2f ns/sensor\n", lw_simd_level_name(levels[l]), elapsed_ns / ticks, elapsed_ns / ticks / BENCHMARK_SENSORS);
+    }
+
+    // ----------------------------------------------------------------------------
+    // Check the vector path against the scalar reference.
+    // ----------------------------------------------------------------------------
+    if (level_count == 2) {
+        if (memcmp(averages[0], averages[1], sizeof(averages[0])) != 0 || memcmp(smoothed[0], smoothed[1], sizeof(smoothed[0])) != 0) {
+            printf("Mismatch against the scalar reference\n");
+            return 1;
+        }
+
+        printf("\nOutputs match the scalar reference\n");
+    }
+
+    return 0;
+}
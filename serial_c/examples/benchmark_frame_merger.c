@@ -0,0 +1,165 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API frame merger benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_frame_merger.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_SENSORS 16
+#define BENCHMARK_TICKS 4096
+#define BENCHMARK_REPEATS 50
+
+// Every sensor streams at 100 Hz with its own phase, jitter and dropouts.
+#define BENCHMARK_PERIOD_US 10000
+#define BENCHMARK_WINDOW_US 10000
+#define BENCHMARK_MAX_LATENCY_US 5000
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static uint64_t timestamps[BENCHMARK_TICKS][BENCHMARK_SENSORS];
+static lw_bool dropped[BENCHMARK_TICKS][BENCHMARK_SENSORS];
+static lw_grf500_frame_merger merger;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+// Every sample in a frame must fall inside the frame window.
+static lw_bool check_frame(const lw_grf500_frame *frame) {
+    uint32_t count = 0;
+
+    for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+        if ((frame->sensor_mask & ((uint32_t)1 << s)) == 0) {
+            continue;
+        }
+
+        const lw_grf500_distance_sample *sample = &frame->samples[s];
+
+        if (sample->timestamp_us < frame->start_us || sample->timestamp_us >= frame->end_us) {
+            return LW_FALSE;
+        }
+
+        count++;
+    }
+
+    return (count == frame->sensor_count) ? LW_TRUE : LW_FALSE;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus of sample times. Each sensor has a phase within the
+    // first half of the period and up to 2 ms of jitter, and drops about 1 in
+    // 50 samples.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+    uint32_t pushed = 0;
+
+    for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+        uint64_t phase_us = next_random(&seed) % (BENCHMARK_PERIOD_US / 2);
+
+        for (uint32_t t = 0; t < BENCHMARK_TICKS; ++t) {
+            timestamps[t][s] = 1000000 + (uint64_t)t * BENCHMARK_PERIOD_US + phase_us + next_random(&seed) % 2000;
+            dropped[t][s] = ((next_random(&seed) % 50) == 0) ? LW_TRUE : LW_FALSE;
+            pushed += dropped[t][s] ? 0 : 1;
+        }
+    }
+
+    printf("Sensors: %d, ticks: %d x %d, window: %d us, max latency: %d us\n\n", BENCHMARK_SENSORS, BENCHMARK_TICKS, BENCHMARK_REPEATS, BENCHMARK_WINDOW_US, BENCHMARK_MAX_LATENCY_US);
+
+    // ----------------------------------------------------------------------------
+    // Push every tick in arrival order and take frames as they complete, on a
+    // host clock that runs one window behind the newest sample.
+    // ----------------------------------------------------------------------------
+    lw_grf500_frame frame;
+    uint64_t total_ns = 0;
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        lw_grf500_frame_merger_init(&merger, BENCHMARK_SENSORS, BENCHMARK_WINDOW_US, BENCHMARK_MAX_LATENCY_US);
+        lw_grf500_distance_sample sample;
+        memset(&sample, 0, sizeof(sample));
+        uint32_t frame_errors = 0;
+        uint64_t start_ns = lw_platform_get_time_ns();
+
+        for (uint32_t t = 0; t < BENCHMARK_TICKS; ++t) {
+            for (uint32_t s = 0; s < BENCHMARK_SENSORS; ++s) {
+                if (dropped[t][s]) {
+                    continue;
+                }
+
+                sample.timestamp_us = timestamps[t][s];
+                sample.sequence = t;
+                sample.data.first_return_raw_cm = (int32_t)(s * 100 + t % 100);
+                lw_grf500_frame_merger_push(&merger, s, &sample);
+            }
+
+            uint64_t now_us = 1000000 + (uint64_t)t * BENCHMARK_PERIOD_US;
+
+            while (lw_grf500_frame_merger_next_frame(&merger, now_us, &frame) == LW_RESULT_SUCCESS) {
+                frame_errors += check_frame(&frame) ? 0 : 1;
+            }
+        }
+
+        while (lw_grf500_frame_merger_flush(&merger, &frame) == LW_RESULT_SUCCESS) {
+            frame_errors += check_frame(&frame) ? 0 : 1;
+        }
+
+        total_ns += lw_platform_get_time_ns() - start_ns;
+
+        // ----------------------------------------------------------------------------
+        // Every pushed sample must come out in a frame or be counted as late.
+        // ----------------------------------------------------------------------------
+        if (frame_errors != 0 || merger.stats.merged_samples + merger.stats.late_samples != pushed) {
+            printf("Check failed: %u bad frames, %llu merged + %llu late of %u pushed\n", frame_errors, (unsigned long long)merger.stats.merged_samples, (unsigned long long)merger.stats.late_samples, pushed);
+            return 1;
+        }
+    }
+
+    double ns_per_sample = (double)total_ns / ((double)pushed * BENCHMARK_REPEATS);
+
+    printf("%-20s %12.1f\n", "ns/sample", ns_per_sample);
+    printf("%-20s %12llu\n", "frames", (unsigned long long)merger.stats.frames);
+    printf("%-20s %12llu\n", "complete frames", (unsigned long long)merger.stats.complete_frames);
+    printf("%-20s %12llu\n", "merged samples", (unsigned long long)merger.stats.merged_samples);
+    printf("%-20s %12llu\n", "late samples", (unsigned long long)merger.stats.late_samples);
+    printf("\nEvery sample was merged into its window or counted as late\n");
+
+    return 0;
+}
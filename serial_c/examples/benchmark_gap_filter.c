@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API gap filter benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_gap_filter.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_SAMPLES 100000
+#define BENCHMARK_REPEATS 20
+#define BENCHMARK_MAX_GAP 3
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static lw_grf500_distance_sample samples[BENCHMARK_SAMPLES];
+static lw_grf500_gap_filter filter;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+// ----------------------------------------------------------------------------
+// Push the corpus through a filter, checking that every sample comes out once
+// and in order, and that the fill statistics match the gaps in the corpus.
+// ----------------------------------------------------------------------------
+static lw_bool check_fill(const char *name, lw_grf500_gap_fill fill, uint64_t expected_gaps, uint64_t expected_samples) {
+    lw_grf500_gap_filter_config config;
+    lw_grf500_gap_output outputs[LW_GRF500_GAP_FILTER_MAX_OUTPUTS];
+    uint32_t output_count;
+    uint32_t next_sequence = 0;
+
+    lw_grf500_gap_filter_get_default_config(&config);
+    config.fill = fill;
+    config.max_gap = BENCHMARK_MAX_GAP;
+    config.min_strength = 5;
+    lw_grf500_gap_filter_init(&filter, &config);
+
+    for (uint32_t i = 0; i <= BENCHMARK_SAMPLES; ++i) {
+        if (i < BENCHMARK_SAMPLES) {
+            lw_grf500_gap_filter_push(&filter, &samples[i], outputs, &output_count);
+        } else {
+            lw_grf500_gap_filter_flush(&filter, outputs, &output_count);
+        }
+
+        for (uint32_t o = 0; o < output_count; ++o) {
+            if (outputs[o].sample.sequence != next_sequence++) {
+                printf("Samples out of order with %s fill\n", name);
+                return LW_FALSE;
+            }
+        }
+    }
+
+    const lw_grf500_gap_stats *stats = &filter.stats;
+
+    if (next_sequence != BENCHMARK_SAMPLES) {
+        printf("Samples lost with %s fill\n", name);
+        return LW_FALSE;
+    }
+
+    if (fill != LW_GRF500_GAP_FILL_NONE && (stats->filled_gaps != expected_gaps || stats->filled_samples != expected_samples)) {
+        printf("Filled %llu gaps and %llu samples with %s fill, expected %llu and %llu\n", (unsigned long long)stats->filled_gaps, (unsigned long long)stats->filled_samples, name, (unsigned long long)expected_gaps, (unsigned long long)expected_samples);
+        return LW_FALSE;
+    }
+
+    uint64_t start_ns = lw_platform_get_time_ns();
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        lw_grf500_gap_filter_init(&filter, &config);
+
+        for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+            lw_grf500_gap_filter_push(&filter, &samples[i], outputs, &output_count);
+        }
+    }
+
+    double ns_per_sample = (double)(lw_platform_get_time_ns() - start_ns) / ((double)BENCHMARK_SAMPLES * BENCHMARK_REPEATS);
+
+    printf("%-8s %12.1f %12llu %12llu %12llu\n", name, ns_per_sample, (unsigned long long)stats->gaps, (unsigned long long)stats->filled_gaps, (unsigned long long)stats->filled_samples);
+
+    return LW_TRUE;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus of a slowly moving target, with gaps of 1 to 8
+    // samples of lost signal or weak returns.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+    int32_t distance = 2000;
+    uint32_t gap_left = 0;
+    uint32_t gap_length = 0;
+    lw_bool previous_valid = LW_FALSE;
+    uint64_t expected_gaps = 0;
+    uint64_t expected_samples = 0;
+
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+        lw_grf500_distance_sample *sample = &samples[i];
+
+        distance += (int32_t)(next_random(&seed) % 21) - 10;
+        distance = (distance < 100) ? 200 - distance : distance;
+
+        memset(sample, 0, sizeof(*sample));
+        sample->timestamp_us = (uint64_t)i * 100000;
+        sample->sequence = i;
+        sample->data.first_return_raw_cm = distance;
+        sample->data.first_return_strength = 50;
+        sample->data.temperature = 2500;
+
+        // Gaps are apart from each other and all end before the corpus does,
+        // so each one is counted on its own.
+        if (gap_left == 0 && previous_valid && i + 8 < BENCHMARK_SAMPLES && next_random(&seed) % 100 < 3) {
+            gap_left = 1 + next_random(&seed) % 8;
+            gap_length = gap_left;
+        }
+
+        previous_valid = (gap_left == 0);
+
+        if (gap_left > 0) {
+            if (next_random(&seed) % 2) {
+                sample->data.first_return_raw_cm = LW_GRF500_LOST_SIGNAL_DISTANCE;
+                sample->data.first_return_strength = 0;
+            } else {
+                sample->data.first_return_strength = 2;
+            }
+
+            if (--gap_left == 0 && gap_length <= BENCHMARK_MAX_GAP) {
+                expected_gaps++;
+                expected_samples += gap_length;
+            }
+        }
+    }
+
+    printf("Samples: %d, max gap: %d\n\n", BENCHMARK_SAMPLES, BENCHMARK_MAX_GAP);
+    printf("%-8s %12s %12s %12s %12s\n", "fill", "ns/sample", "gaps", "filled gaps", "filled");
+
+    // ----------------------------------------------------------------------------
+    // Every fill mode over the same samples.
+    // ----------------------------------------------------------------------------
+    if (!check_fill("none", LW_GRF500_GAP_FILL_NONE, expected_gaps, expected_samples) || !check_fill("hold", LW_GRF500_GAP_FILL_HOLD, expected_gaps, expected_samples) || !check_fill("linear", LW_GRF500_GAP_FILL_LINEAR, expected_gaps, expected_samples)) {
+        return 1;
+    }
+
+    return 0;
+}
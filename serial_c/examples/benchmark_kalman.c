@@ -0,0 +1,235 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API range Kalman filter benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_kalman.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_SAMPLES 100000
+#define BENCHMARK_REPEATS 20
+
+// Samples skipped while the filter settles.
+#define BENCHMARK_SETTLE_SAMPLES 50
+
+// A 10 Hz stream with 10% lost samples, from a target that picks a new
+// acceleration every 2 s.
+#define BENCHMARK_UPDATE_RATE_HZ 10
+#define BENCHMARK_LOST_PERCENT 10
+#define BENCHMARK_MANOEUVRE_SAMPLES 20
+#define BENCHMARK_MAX_ACCELERATION 30.0
+#define BENCHMARK_MAX_SPEED 300.0
+
+// Noise standard deviation in cm at the reference strength, which grows as
+// the strength drops.
+#define BENCHMARK_NOISE_CM 10.0
+#define BENCHMARK_REFERENCE_STRENGTH 50.0
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static lw_grf500_distance_sample samples[BENCHMARK_SAMPLES];
+static double true_range[BENCHMARK_SAMPLES];
+static double true_rate[BENCHMARK_SAMPLES];
+static lw_grf500_kalman filter;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static double next_uniform(uint32_t *seed) {
+    return ((double)next_random(seed) + 0.5) / 16777216.0;
+}
+
+static double next_gaussian(uint32_t *seed) {
+    double u = next_uniform(seed);
+    double v = next_uniform(seed);
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+// ----------------------------------------------------------------------------
+// Run the filter over the corpus and report its errors against the truth.
+// ----------------------------------------------------------------------------
+static lw_bool check_model(const char *name, lw_grf500_kalman_model model, double raw_range_rms, double raw_rate_rms) {
+    lw_grf500_kalman_config config;
+    double range_sum = 0;
+    double rate_sum = 0;
+    uint32_t count = 0;
+    uint32_t within = 0;
+
+    lw_grf500_kalman_get_default_config(&config);
+    config.model = model;
+    config.measurement_noise_cm = (float)BENCHMARK_NOISE_CM;
+    config.reference_strength = (float)BENCHMARK_REFERENCE_STRENGTH;
+    lw_grf500_kalman_init(&filter, &config);
+
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+        lw_grf500_kalman_estimate estimate;
+
+        if (lw_grf500_kalman_update_sample(&filter, &samples[i], &estimate) != LW_RESULT_SUCCESS || i < BENCHMARK_SETTLE_SAMPLES) {
+            continue;
+        }
+
+        double range_error = estimate.range_cm - true_range[i];
+        double rate_error = estimate.range_rate_cm_per_s - true_rate[i];
+
+        range_sum += range_error * range_error;
+        rate_sum += rate_error * rate_error;
+        within += (range_error * range_error <= 4.0 * estimate.covariance[0][0]);
+        count++;
+    }
+
+    uint64_t start_ns = lw_platform_get_time_ns();
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        lw_grf500_kalman_init(&filter, &config);
+
+        for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+            lw_grf500_kalman_update_sample(&filter, &samples[i], NULL);
+        }
+    }
+
+    double ns_per_sample = (double)(lw_platform_get_time_ns() - start_ns) / ((double)BENCHMARK_SAMPLES * BENCHMARK_REPEATS);
+
+    double range_rms = sqrt(range_sum / count);
+    double rate_rms = sqrt(rate_sum / count);
+
+    printf("%-14s %14.2f %14.2f %12.1f%% %12.1f\n", name, range_rms, rate_rms, 100.0 * within / count, ns_per_sample);
+
+    return (range_rms < raw_range_rms && rate_rms < raw_rate_rms);
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Simulate the target and the stream, with the noise of every reading
+    // scaled by its strength.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+    double dt = 1.0 / BENCHMARK_UPDATE_RATE_HZ;
+    double range = 2000;
+    double rate = 0;
+    double acceleration = 0;
+    double strength = BENCHMARK_REFERENCE_STRENGTH;
+
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; ++i) {
+        lw_grf500_distance_sample *sample = &samples[i];
+
+        if (i % BENCHMARK_MANOEUVRE_SAMPLES == 0) {
+            acceleration = (2.0 * next_uniform(&seed) - 1.0) * BENCHMARK_MAX_ACCELERATION;
+        }
+
+        // Turn the target around before it leaves the range or speed limits.
+        if ((range < 500 && acceleration < 0) || (range > 5000 && acceleration > 0) || (rate < -BENCHMARK_MAX_SPEED && acceleration < 0) || (rate > BENCHMARK_MAX_SPEED && acceleration > 0)) {
+            acceleration = -acceleration;
+        }
+
+        range += rate * dt + 0.5 * acceleration * dt * dt;
+        rate += acceleration * dt;
+        true_range[i] = range;
+        true_rate[i] = rate;
+
+        strength += next_gaussian(&seed) * 2.0;
+        strength = (strength < 10) ? 10 : (strength > 100) ? 100 : strength;
+
+        memset(sample, 0, sizeof(*sample));
+        sample->timestamp_us = (uint64_t)i * 1000000 / BENCHMARK_UPDATE_RATE_HZ;
+        sample->sequence = i;
+
+        if (next_random(&seed) % 100 < BENCHMARK_LOST_PERCENT) {
+            sample->data.first_return_raw_cm = LW_GRF500_LOST_SIGNAL_DISTANCE;
+            sample->data.first_return_strength = 0;
+        } else {
+            double noise = BENCHMARK_NOISE_CM * sqrt(BENCHMARK_REFERENCE_STRENGTH / (int32_t)strength);
+            sample->data.first_return_raw_cm = (int32_t)lround(range + next_gaussian(&seed) * noise);
+            sample->data.first_return_strength = (int32_t)strength;
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // The raw readings, and the range rate from differencing them, as the
+    // baseline.
+    // ----------------------------------------------------------------------------
+    double raw_range_sum = 0;
+    double raw_rate_sum = 0;
+    uint32_t raw_range_count = 0;
+    uint32_t raw_rate_count = 0;
+    int32_t previous = -1;
+
+    for (uint32_t i = BENCHMARK_SETTLE_SAMPLES; i < BENCHMARK_SAMPLES; ++i) {
+        int32_t distance = samples[i].data.first_return_raw_cm;
+
+        if (distance == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+            continue;
+        }
+
+        double range_error = distance - true_range[i];
+        raw_range_sum += range_error * range_error;
+        raw_range_count++;
+
+        if (previous >= 0) {
+            double elapsed = (double)(samples[i].timestamp_us - samples[previous].timestamp_us) / 1e6;
+            double rate_error = (distance - samples[previous].data.first_return_raw_cm) / elapsed - true_rate[i];
+            raw_rate_sum += rate_error * rate_error;
+            raw_rate_count++;
+        }
+
+        previous = (int32_t)i;
+    }
+
+    printf("Samples: %d at %d Hz, %d%% lost, noise %.0f cm at strength %.0f\n\n", BENCHMARK_SAMPLES, BENCHMARK_UPDATE_RATE_HZ, BENCHMARK_LOST_PERCENT, BENCHMARK_NOISE_CM, BENCHMARK_REFERENCE_STRENGTH);
+    printf("%-14s %14s %14s %13s %12s\n", "source", "range rms cm", "rate rms cm/s", "within 2 sd", "ns/sample");
+    double raw_range_rms = sqrt(raw_range_sum / raw_range_count);
+    double raw_rate_rms = sqrt(raw_rate_sum / raw_rate_count);
+
+    printf("%-14s %14.2f %14.2f %13s %12s\n", "raw", raw_range_rms, raw_rate_rms, "-", "-");
+
+    // ----------------------------------------------------------------------------
+    // Both models over the same stream, each expected to beat the raw readings.
+    // ----------------------------------------------------------------------------
+    lw_bool velocity_ok = check_model("velocity", LW_GRF500_KALMAN_CONSTANT_VELOCITY, raw_range_rms, raw_rate_rms);
+    lw_bool acceleration_ok = check_model("acceleration", LW_GRF500_KALMAN_CONSTANT_ACCELERATION, raw_range_rms, raw_rate_rms);
+
+    if (!velocity_ok || !acceleration_ok) {
+        printf("\nThe filter does worse than the raw readings\n");
+        return 1;
+    }
+
+    return 0;
+}
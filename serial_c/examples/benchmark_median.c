@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API sliding median benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_median.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_VALUES 100000
+#define BENCHMARK_MAX_WINDOW 4096
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static int32_t inputs[BENCHMARK_VALUES];
+static int32_t storage[LW_GRF500_MEDIAN_STORAGE_SIZE(BENCHMARK_MAX_WINDOW) / sizeof(int32_t)];
+static int32_t sorted[BENCHMARK_MAX_WINDOW];
+static lw_grf500_median median;
+static volatile int32_t sink = 0;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+// ----------------------------------------------------------------------------
+// Sort-based reference: the window kept as a sorted array, with the oldest
+// value removed and the new one inserted on every step.
+// ----------------------------------------------------------------------------
+static uint32_t sorted_find(uint32_t count, int32_t value) {
+    uint32_t low = 0;
+    uint32_t high = count;
+
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+
+        if (sorted[middle] < value) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+static lw_bool check_window(const char *name, uint32_t window_size) {
+    uint32_t count = 0;
+
+    lw_grf500_median_init(&median, window_size, storage, sizeof(storage));
+
+    for (uint32_t i = 0; i < BENCHMARK_VALUES; ++i) {
+        if (count == window_size) {
+            uint32_t position = sorted_find(count, inputs[i - window_size]);
+            memmove(&sorted[position], &sorted[position + 1], (count - position - 1) * sizeof(int32_t));
+            count--;
+        }
+
+        uint32_t position = sorted_find(count, inputs[i]);
+        memmove(&sorted[position + 1], &sorted[position], (count - position) * sizeof(int32_t));
+        sorted[position] = inputs[i];
+        count++;
+
+        int32_t value = lw_grf500_median_push(&median, inputs[i]);
+        int32_t expected = sorted[(count - 1) / 2];
+
+        if (value != expected || lw_grf500_median_get_count(&median) != count) {
+            printf("Mismatch on %s, window %u, step %u: %d, expected %d\n", name, window_size, i, value, expected);
+            return LW_FALSE;
+        }
+    }
+
+    return LW_TRUE;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Check every step against the reference, over inputs that stress the
+    // heaps: random, rising, falling, constant and heavily repeated values.
+    // ----------------------------------------------------------------------------
+    static const uint32_t window_sizes[] = {1, 2, 3, 4, 15, 16, 255, 4096};
+    static const char *pattern_names[] = {"random", "rising", "falling", "constant", "repeated"};
+    uint32_t seed = 12345;
+
+    for (uint32_t p = 0; p < sizeof(pattern_names) / sizeof(pattern_names[0]); ++p) {
+        for (uint32_t i = 0; i < BENCHMARK_VALUES; ++i) {
+            switch (p) {
+                case 0:
+                    inputs[i] = (int32_t)next_random(&seed) - (1 << 23);
+                    break;
+                case 1:
+                    inputs[i] = (int32_t)i;
+                    break;
+                case 2:
+                    inputs[i] = -(int32_t)i;
+                    break;
+                case 3:
+                    inputs[i] = 1000;
+                    break;
+                default:
+                    inputs[i] = (int32_t)(next_random(&seed) % 4);
+                    break;
+            }
+        }
+
+        for (uint32_t w = 0; w < sizeof(window_sizes) / sizeof(window_sizes[0]); ++w) {
+            if (!check_window(pattern_names[p], window_sizes[w])) {
+                return 1;
+            }
+        }
+    }
+
+    printf("Every step of %u patterns and %u window sizes matches the sort-based reference\n\n", (uint32_t)(sizeof(pattern_names) / sizeof(pattern_names[0])), (uint32_t)(sizeof(window_sizes) / sizeof(window_sizes[0])));
+
+    // ----------------------------------------------------------------------------
+    // Time pushes on random data.
+    // ----------------------------------------------------------------------------
+    for (uint32_t i = 0; i < BENCHMARK_VALUES; ++i) {
+        inputs[i] = (int32_t)next_random(&seed) - (1 << 23);
+    }
+
+    printf("%-12s %12s\n", "window", "ns/push");
+
+    for (uint32_t window_size = 16; window_size <= BENCHMARK_MAX_WINDOW; window_size *= 4) {
+        lw_grf500_median_init(&median, window_size, storage, sizeof(storage));
+        uint64_t start_ns = lw_platform_get_time_ns();
+
+        for (uint32_t n = 0; n < 10; ++n) {
+            for (uint32_t i = 0; i < BENCHMARK_VALUES; ++i) {
+                sink = lw_grf500_median_push(&median, inputs[i]);
+            }
+        }
+
+        double ns_per_push = (double)(lw_platform_get_time_ns() - start_ns) / (BENCHMARK_VALUES * 10.0);
+        printf("%-12u %12.1f\n", window_size, ns_per_push);
+    }
+
+    return 0;
+}
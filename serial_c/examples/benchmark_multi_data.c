@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API multi data benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_batch.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_PACKETS 4096
+#define BENCHMARK_REPEATS 500
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static lw_response responses[BENCHMARK_PACKETS];
+static lw_grf500_multi_data samples[BENCHMARK_PACKETS];
+static int32_t column_data[11][BENCHMARK_PACKETS];
+static uint8_t capture[BENCHMARK_PACKETS * 64];
+
+static void print_result(const char *name, uint64_t elapsed_us, uint32_t packets) {
+    double seconds = (double)elapsed_us / 1000000.0;
+    printf("%-32s %10.2f Mpackets/s %8.2f ns/packet\n", name, (double)packets / seconds / 1000000.0, seconds * 1000000000.0 / (double)packets);
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus of multi data packets, both as completed responses
+    // and as a raw capture.
+    // ----------------------------------------------------------------------------
+    uint32_t capture_size = 0;
+    uint32_t seed = 12345;
+
+    for (uint32_t i = 0; i < BENCHMARK_PACKETS; ++i) {
+        int32_t values[11];
+
+        for (uint32_t f = 0; f < 11; ++f) {
+            seed = seed * 1103515245 + 12345;
+            values[f] = (int32_t)(seed >> 8) % 100000;
+        }
+
+        uint32_t size = lw_create_packet(capture + capture_size, LW_GRF500_COMMAND_MULTI_DATA, 0, (uint8_t *)values, sizeof(values));
+        lw_init_response(&responses[i]);
+
+        for (uint32_t b = 0; b < size; ++b) {
+            lw_feed_response(&responses[i], capture[capture_size + b]);
+        }
+
+        capture_size += size;
+    }
+
+    lw_grf500_multi_columns columns;
+
+    for (uint32_t r = 0; r < 5; ++r) {
+        columns.distance_mm[r] = column_data[r * 2];
+        columns.strength[r] = column_data[r * 2 + 1];
+    }
+
+    columns.temperature = column_data[10];
+
+    int32_t offsets[LW_GRF500_BATCH_CHUNK_SIZE];
+    const uint8_t *base = responses[0].data + 4;
+
+    for (uint32_t i = 0; i < LW_GRF500_BATCH_CHUNK_SIZE; ++i) {
+        offsets[i] = (int32_t)((responses[i].data + 4) - base);
+    }
+
+    uint32_t total_packets = BENCHMARK_PACKETS * BENCHMARK_REPEATS;
+    uint64_t start_us;
+    uint32_t decoded = 0;
+    uint32_t consumed = 0;
+
+    printf("Packets: %d x %d, best SIMD level: %s\n\n", BENCHMARK_PACKETS, BENCHMARK_REPEATS, lw_simd_level_name(lw_simd_detect()));
+
+    // ----------------------------------------------------------------------------
+    // Per packet parsing into structs.
+    // ----------------------------------------------------------------------------
+    start_us = lw_platform_get_time_us();
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        for (uint32_t i = 0; i < BENCHMARK_PACKETS; ++i) {
+            lw_grf500_parse_response_multi_data(&responses[i], &samples[i]);
+        }
+    }
+
+    print_result("parse_response_multi_data", lw_platform_get_time_us() - start_us, total_packets);
+
+    // ----------------------------------------------------------------------------
+    // Column decoders on their own, per SIMD level.
+    // ----------------------------------------------------------------------------
+    lw_simd_level levels[] = {LW_SIMD_LEVEL_SCALAR, lw_simd_detect()};
+
+    for (uint32_t l = 0; l < sizeof(levels) / sizeof(levels[0]); ++l) {
+        lw_grf500_multi_column_decoder decoder = lw_grf500_get_multi_column_decoder(levels[l]);
+        char name[64];
+
+        if (l > 0 && levels[l] == LW_SIMD_LEVEL_SCALAR) {
+            break;
+        }
+
+        start_us = lw_platform_get_time_us();
+
+        for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+            for (uint32_t row = 0; row < BENCHMARK_PACKETS; row += LW_GRF500_BATCH_CHUNK_SIZE) {
+                decoder(responses[row].data + 4, offsets, LW_GRF500_BATCH_CHUNK_SIZE, &columns, row);
+            }
+        }
+
+        snprintf(name, sizeof(name), "column decoder (%s)", lw_simd_level_name(levels[l]));
+        print_result(name, lw_platform_get_time_us() - start_us, total_packets);
+    }
+
+    // ----------------------------------------------------------------------------
+    // Full batch functions.
+    // ----------------------------------------------------------------------------
+    start_us = lw_platform_get_time_us();
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        lw_grf500_batch_decode_multi_data(responses, BENCHMARK_PACKETS, &columns, &decoded);
+    }
+
+    print_result("batch_decode_multi_data", lw_platform_get_time_us() - start_us, total_packets);
+
+    start_us = lw_platform_get_time_us();
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        lw_grf500_batch_decode_multi_capture(capture, capture_size, &columns, BENCHMARK_PACKETS, &decoded, &consumed);
+    }
+
+    print_result("batch_decode_multi_capture", lw_platform_get_time_us() - start_us, total_packets);
+
+    // ----------------------------------------------------------------------------
+    // Check the columns against the per packet results.
+    // ----------------------------------------------------------------------------
+    for (uint32_t i = 0; i < BENCHMARK_PACKETS; ++i) {
+        if (columns.distance_mm[4][i] != samples[i].signals[4].distance_mm || columns.temperature[i] != samples[i].temperature) {
+            printf("Mismatch at packet %u\n", i);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,534 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API protocol benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_serial_api_grf500.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#include <intrin.h>
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+// ----------------------------------------------------------------------------
+// Protocol core benchmark.
+//
+// Times the CRC, packet and request builders, the response byte parser on
+// clean and noisy streams, and the GRF-500 response parsers, including
+// distance data for all 256 distance config masks. Every corpus is built
+// from a fixed seed, so runs are comparable.
+//
+// Each benchmark is run in batches sized to take about a millisecond, and
+// the fastest and median batch are reported per call or per byte, in
+// nanoseconds and in ticks of a CPU counter. The counter is the timestamp
+// counter on x86 and the generic timer on aarch64, neither of which counts
+// core cycles, and its rate is printed first. Output is CSV on stdout, with
+// lines starting with # as comments.
+//
+// Usage: benchmark_protocol [name filter]
+// ----------------------------------------------------------------------------
+#define BENCHMARK_BATCHES 15
+#define BENCHMARK_BATCH_NS 1000000
+#define BENCHMARK_CORPUS_SIZE 1024
+#define BENCHMARK_STREAM_PACKETS 1024
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+typedef void (*benchmark_function)(uint32_t iterations);
+
+static const char *name_filter = NULL;
+static double counter_hz = 0;
+static uint32_t failures = 0;
+static volatile uint32_t sink = 0;
+
+// Corpora.
+static uint8_t payloads[BENCHMARK_CORPUS_SIZE][256];
+static uint8_t packet_buffer[LW_PACKET_SEND_SIZE];
+static lw_request request;
+static lw_response response;
+static lw_response mask_responses[256];
+static lw_response reply_responses[LW_GRF500_COMMAND_ZERO_OFFSET + 1];
+static lw_grf500_distance_config current_mask;
+static uint32_t current_size;
+
+static uint8_t clean_stream[BENCHMARK_STREAM_PACKETS * 64];
+static uint32_t clean_stream_size;
+static uint8_t noisy_stream[BENCHMARK_STREAM_PACKETS * 96];
+static uint32_t noisy_stream_size;
+static uint8_t multi_stream[BENCHMARK_STREAM_PACKETS * 64];
+static uint32_t multi_stream_size;
+static const uint8_t *current_stream;
+static uint32_t current_stream_size;
+
+// ----------------------------------------------------------------------------
+// Timing.
+// ----------------------------------------------------------------------------
+static uint64_t read_counter(void) {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return lw_platform_get_time_ns();
+#endif
+}
+
+static void calibrate_counter(void) {
+    uint64_t start_ns = lw_platform_get_time_ns();
+    uint64_t start = read_counter();
+
+    while (lw_platform_get_time_ns() - start_ns < 100000000) {
+    }
+
+    counter_hz = (double)(read_counter() - start) * 1e9 / (double)(lw_platform_get_time_ns() - start_ns);
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_benchmark(const char *name, const char *unit, uint32_t units_per_iteration, benchmark_function function) {
+    double ns[BENCHMARK_BATCHES];
+    double ticks[BENCHMARK_BATCHES];
+    uint32_t iterations = 1;
+
+    if (name_filter && strstr(name, name_filter) == NULL) {
+        return;
+    }
+
+    // Grow the batch until it takes long enough to time well.
+    while (1) {
+        uint64_t start_ns = lw_platform_get_time_ns();
+        function(iterations);
+
+        if (lw_platform_get_time_ns() - start_ns >= BENCHMARK_BATCH_NS || iterations >= (1u << 30)) {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    for (uint32_t b = 0; b < BENCHMARK_BATCHES; ++b) {
+        uint64_t start_ns = lw_platform_get_time_ns();
+        uint64_t start = read_counter();
+        function(iterations);
+        uint64_t end = read_counter();
+        uint64_t end_ns = lw_platform_get_time_ns();
+        double units = (double)iterations * units_per_iteration;
+
+        ns[b] = (double)(end_ns - start_ns) / units;
+        ticks[b] = (double)(end - start) / units;
+    }
+
+    qsort(ns, BENCHMARK_BATCHES, sizeof(ns[0]), compare_double);
+    qsort(ticks, BENCHMARK_BATCHES, sizeof(ticks[0]), compare_double);
+
+    printf("%s,%s,%u,%u,%.3f,%.3f,%.2f,%.2f\n", name, unit, BENCHMARK_BATCHES, iterations, ns[0], ns[BENCHMARK_BATCHES / 2], ticks[0], ticks[BENCHMARK_BATCHES / 2]);
+}
+
+#define BENCHMARK_CALLS(function, statement)         \
+    static void function(uint32_t iterations) {     \
+        for (uint32_t i = 0; i < iterations; ++i) { \
+            statement;                              \
+        }                                           \
+    }
+
+#define BENCHMARK_CHECK(statement) failures += ((statement) != LW_RESULT_SUCCESS)
+
+// ----------------------------------------------------------------------------
+// Benchmarks.
+// ----------------------------------------------------------------------------
+BENCHMARK_CALLS(bench_crc, sink += lw_create_crc(payloads[i % BENCHMARK_CORPUS_SIZE], (uint16_t)current_size))
+BENCHMARK_CALLS(bench_packet, sink += lw_create_packet(packet_buffer, LW_GRF500_COMMAND_USER_DATA, 1, payloads[i % BENCHMARK_CORPUS_SIZE], current_size))
+
+BENCHMARK_CALLS(bench_request_read, lw_create_request_read(&request, (uint8_t)i))
+BENCHMARK_CALLS(bench_request_write_int8, lw_create_request_write_int8(&request, 100, (int8_t)i))
+BENCHMARK_CALLS(bench_request_write_int16, lw_create_request_write_int16(&request, 100, (int16_t)i))
+BENCHMARK_CALLS(bench_request_write_int32, lw_create_request_write_int32(&request, 100, (int32_t)i))
+BENCHMARK_CALLS(bench_request_write_uint8, lw_create_request_write_uint8(&request, 100, (uint8_t)i))
+BENCHMARK_CALLS(bench_request_write_uint16, lw_create_request_write_uint16(&request, 100, (uint16_t)i))
+BENCHMARK_CALLS(bench_request_write_uint32, lw_create_request_write_uint32(&request, 100, i))
+BENCHMARK_CALLS(bench_request_write_string, lw_create_request_write_string(&request, 100, (char *)"GRF-500 bench"))
+BENCHMARK_CALLS(bench_request_write_data, lw_create_request_write_data(&request, 100, payloads[i % BENCHMARK_CORPUS_SIZE], 16))
+
+BENCHMARK_CALLS(bench_grf500_write_user_data, BENCHMARK_CHECK(lw_grf500_create_request_write_user_data(&request, payloads[i % BENCHMARK_CORPUS_SIZE], 16)))
+BENCHMARK_CALLS(bench_grf500_write_save_parameters, BENCHMARK_CHECK(lw_grf500_create_request_write_save_parameters(&request, (uint16_t)i)))
+BENCHMARK_CALLS(bench_grf500_write_reset, BENCHMARK_CHECK(lw_grf500_create_request_write_reset(&request, (uint16_t)i)))
+BENCHMARK_CALLS(bench_grf500_write_distance_config, BENCHMARK_CHECK(lw_grf500_create_request_write_distance_config(&request, i & LW_GRF500_DISTANCE_CONFIG_ALL)))
+BENCHMARK_CALLS(bench_grf500_write_stream, BENCHMARK_CHECK(lw_grf500_create_request_write_stream(&request, (i & 1) ? LW_GRF500_STREAM_ID_DISTANCE_DATA : LW_GRF500_STREAM_ID_MULTI_DATA)))
+BENCHMARK_CALLS(bench_grf500_write_laser_firing, BENCHMARK_CHECK(lw_grf500_create_request_write_laser_firing(&request, (lw_bool)(i & 1))))
+BENCHMARK_CALLS(bench_grf500_write_auto_exposure, BENCHMARK_CHECK(lw_grf500_create_request_write_auto_exposure(&request, (lw_bool)(i & 1))))
+BENCHMARK_CALLS(bench_grf500_write_update_rate, BENCHMARK_CHECK(lw_grf500_create_request_write_update_rate(&request, 0.5f + (float)(i % 95) / 10.0f)))
+BENCHMARK_CALLS(bench_grf500_write_alarm_return_mode, BENCHMARK_CHECK(lw_grf500_create_request_write_alarm_return_mode(&request, (lw_grf500_return_mode)(i & 1))))
+BENCHMARK_CALLS(bench_grf500_write_lost_signal_counter, BENCHMARK_CHECK(lw_grf500_create_request_write_lost_signal_counter(&request, 1 + i % 250)))
+BENCHMARK_CALLS(bench_grf500_write_alarm_a_distance, BENCHMARK_CHECK(lw_grf500_create_request_write_alarm_a_distance(&request, i % 30000)))
+BENCHMARK_CALLS(bench_grf500_write_alarm_b_distance, BENCHMARK_CHECK(lw_grf500_create_request_write_alarm_b_distance(&request, i % 30000)))
+BENCHMARK_CALLS(bench_grf500_write_alarm_hysteresis, BENCHMARK_CHECK(lw_grf500_create_request_write_alarm_hysteresis(&request, i % 3000)))
+BENCHMARK_CALLS(bench_grf500_write_gpio_mode, BENCHMARK_CHECK(lw_grf500_create_request_write_gpio_mode(&request, (lw_grf500_gpio_mode)(i % 3))))
+BENCHMARK_CALLS(bench_grf500_write_gpio_alarm_confirm_count, BENCHMARK_CHECK(lw_grf500_create_request_write_gpio_alarm_confirm_count(&request, i % 1000)))
+BENCHMARK_CALLS(bench_grf500_write_median_filter_enable, BENCHMARK_CHECK(lw_grf500_create_request_write_median_filter_enable(&request, (lw_bool)(i & 1))))
+BENCHMARK_CALLS(bench_grf500_write_median_filter_size, BENCHMARK_CHECK(lw_grf500_create_request_write_median_filter_size(&request, 3 + i % 30)))
+BENCHMARK_CALLS(bench_grf500_write_smooth_filter_enable, BENCHMARK_CHECK(lw_grf500_create_request_write_smooth_filter_enable(&request, (lw_bool)(i & 1))))
+BENCHMARK_CALLS(bench_grf500_write_smooth_filter_factor, BENCHMARK_CHECK(lw_grf500_create_request_write_smooth_filter_factor(&request, 1 + i % 99)))
+BENCHMARK_CALLS(bench_grf500_write_baud_rate, BENCHMARK_CHECK(lw_grf500_create_request_write_baud_rate(&request, (lw_grf500_baud_rate)(i % 8))))
+BENCHMARK_CALLS(bench_grf500_write_i2c_address, BENCHMARK_CHECK(lw_grf500_create_request_write_i2c_address(&request, (uint8_t)(0x08 + i % 0x70))))
+BENCHMARK_CALLS(bench_grf500_write_rolling_average_enable, BENCHMARK_CHECK(lw_grf500_create_request_write_rolling_average_enable(&request, (lw_bool)(i & 1))))
+BENCHMARK_CALLS(bench_grf500_write_rolling_average_size, BENCHMARK_CHECK(lw_grf500_create_request_write_rolling_average_size(&request, 2 + i % 31)))
+BENCHMARK_CALLS(bench_grf500_write_sleep, BENCHMARK_CHECK(lw_grf500_create_request_write_sleep(&request)))
+BENCHMARK_CALLS(bench_grf500_write_led_state, BENCHMARK_CHECK(lw_grf500_create_request_write_led_state(&request, (lw_bool)(i & 1))))
+BENCHMARK_CALLS(bench_grf500_write_zero_offset, BENCHMARK_CHECK(lw_grf500_create_request_write_zero_offset(&request, (int32_t)(i % 1000) - 500)))
+
+// Feed a whole stream per iteration, counting the packets found.
+static void bench_feed_response(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; ++i) {
+        lw_init_response(&response);
+
+        for (uint32_t b = 0; b < current_stream_size; ++b) {
+            if (lw_feed_response(&response, current_stream[b]) == LW_RESULT_SUCCESS) {
+                sink++;
+                lw_init_response(&response);
+            }
+        }
+    }
+}
+
+static lw_grf500_distance_data_cm distance_data;
+static lw_grf500_multi_data multi_data;
+static char text[32];
+static uint8_t user_data[16];
+static uint32_t value_u32;
+static int32_t value_i32;
+static uint16_t value_u16;
+static float value_float;
+static lw_bool value_bool;
+static uint8_t value_u8;
+static lw_firmware_version firmware_version;
+static lw_grf500_distance_config distance_config;
+static lw_grf500_stream_id stream_id;
+static lw_grf500_alarm_status alarm_status;
+static lw_grf500_return_mode return_mode;
+static lw_grf500_gpio_mode gpio_mode;
+static lw_grf500_baud_rate baud_rate;
+
+#define REPLY(command) &reply_responses[LW_GRF500_COMMAND_##command]
+
+BENCHMARK_CALLS(bench_parse_distance_data, BENCHMARK_CHECK(lw_grf500_parse_response_distance_data(&mask_responses[current_mask], current_mask, &distance_data)))
+BENCHMARK_CALLS(bench_parse_multi_data, BENCHMARK_CHECK(lw_grf500_parse_response_multi_data(REPLY(MULTI_DATA), &multi_data)))
+BENCHMARK_CALLS(bench_parse_product_name, BENCHMARK_CHECK(lw_grf500_parse_response_product_name(REPLY(PRODUCT_NAME), text)))
+BENCHMARK_CALLS(bench_parse_hardware_version, BENCHMARK_CHECK(lw_grf500_parse_response_hardware_version(REPLY(HARDWARE_VERSION), &value_u32)))
+BENCHMARK_CALLS(bench_parse_firmware_version, BENCHMARK_CHECK(lw_grf500_parse_response_firmware_version(REPLY(FIRMWARE_VERSION), &firmware_version)))
+BENCHMARK_CALLS(bench_parse_serial_number, BENCHMARK_CHECK(lw_grf500_parse_response_serial_number(REPLY(SERIAL_NUMBER), text)))
+BENCHMARK_CALLS(bench_parse_user_data, BENCHMARK_CHECK(lw_grf500_parse_response_user_data(REPLY(USER_DATA), user_data, 16)))
+BENCHMARK_CALLS(bench_parse_token, BENCHMARK_CHECK(lw_grf500_parse_response_token(REPLY(TOKEN), &value_u16)))
+BENCHMARK_CALLS(bench_parse_distance_config, BENCHMARK_CHECK(lw_grf500_parse_response_distance_config(REPLY(DISTANCE_CONFIG), &distance_config)))
+BENCHMARK_CALLS(bench_parse_stream, BENCHMARK_CHECK(lw_grf500_parse_response_stream(REPLY(STREAM), &stream_id)))
+BENCHMARK_CALLS(bench_parse_laser_firing, BENCHMARK_CHECK(lw_grf500_parse_response_laser_firing(REPLY(LASER_FIRING), &value_bool)))
+BENCHMARK_CALLS(bench_parse_temperature, BENCHMARK_CHECK(lw_grf500_parse_response_temperature(REPLY(TEMPERATURE), &value_i32)))
+BENCHMARK_CALLS(bench_parse_auto_exposure, BENCHMARK_CHECK(lw_grf500_parse_response_auto_exposure(REPLY(AUTO_EXPOSURE), &value_bool)))
+BENCHMARK_CALLS(bench_parse_update_rate, BENCHMARK_CHECK(lw_grf500_parse_response_update_rate(REPLY(UPDATE_RATE), &value_float)))
+BENCHMARK_CALLS(bench_parse_alarm_status, BENCHMARK_CHECK(lw_grf500_parse_response_alarm_status(REPLY(ALARM_STATUS), &alarm_status)))
+BENCHMARK_CALLS(bench_parse_alarm_return_mode, BENCHMARK_CHECK(lw_grf500_parse_response_alarm_return_mode(REPLY(ALARM_RETURN_MODE), &return_mode)))
+BENCHMARK_CALLS(bench_parse_lost_signal_counter, BENCHMARK_CHECK(lw_grf500_parse_response_lost_signal_counter(REPLY(LOST_SIGNAL_COUNTER), &value_u32)))
+BENCHMARK_CALLS(bench_parse_alarm_a_distance, BENCHMARK_CHECK(lw_grf500_parse_response_alarm_a_distance(REPLY(ALARM_A_DISTANCE), &value_u32)))
+BENCHMARK_CALLS(bench_parse_alarm_b_distance, BENCHMARK_CHECK(lw_grf500_parse_response_alarm_b_distance(REPLY(ALARM_B_DISTANCE), &value_u32)))
+BENCHMARK_CALLS(bench_parse_alarm_hysteresis, BENCHMARK_CHECK(lw_grf500_parse_response_alarm_hysteresis(REPLY(ALARM_HYSTERESIS), &value_u32)))
+BENCHMARK_CALLS(bench_parse_gpio_mode, BENCHMARK_CHECK(lw_grf500_parse_response_gpio_mode(REPLY(GPIO_MODE), &gpio_mode)))
+BENCHMARK_CALLS(bench_parse_gpio_alarm_confirm_count, BENCHMARK_CHECK(lw_grf500_parse_response_gpio_alarm_confirm_count(REPLY(GPIO_ALARM_CONFIRM_COUNT), &value_u32)))
+BENCHMARK_CALLS(bench_parse_median_filter_enable, BENCHMARK_CHECK(lw_grf500_parse_response_median_filter_enable(REPLY(MEDIAN_FILTER_ENABLE), &value_bool)))
+BENCHMARK_CALLS(bench_parse_median_filter_size, BENCHMARK_CHECK(lw_grf500_parse_response_median_filter_size(REPLY(MEDIAN_FILTER_SIZE), &value_u32)))
+BENCHMARK_CALLS(bench_parse_smooth_filter_enable, BENCHMARK_CHECK(lw_grf500_parse_response_smooth_filter_enable(REPLY(SMOOTH_FILTER_ENABLE), &value_bool)))
+BENCHMARK_CALLS(bench_parse_smooth_filter_factor, BENCHMARK_CHECK(lw_grf500_parse_response_smooth_filter_factor(REPLY(SMOOTH_FILTER_FACTOR), &value_u32)))
+BENCHMARK_CALLS(bench_parse_baud_rate, BENCHMARK_CHECK(lw_grf500_parse_response_baud_rate(REPLY(BAUD_RATE), &baud_rate)))
+BENCHMARK_CALLS(bench_parse_i2c_address, BENCHMARK_CHECK(lw_grf500_parse_response_i2c_address(REPLY(I2C_ADDRESS), &value_u8)))
+BENCHMARK_CALLS(bench_parse_rolling_average_enable, BENCHMARK_CHECK(lw_grf500_parse_response_rolling_average_enable(REPLY(ROLLING_AVERAGE_ENABLE), &value_bool)))
+BENCHMARK_CALLS(bench_parse_rolling_average_size, BENCHMARK_CHECK(lw_grf500_parse_response_rolling_average_size(REPLY(ROLLING_AVERAGE_SIZE), &value_u32)))
+BENCHMARK_CALLS(bench_parse_led_state, BENCHMARK_CHECK(lw_grf500_parse_response_led_state(REPLY(LED_STATE), &value_bool)))
+BENCHMARK_CALLS(bench_parse_zero_offset, BENCHMARK_CHECK(lw_grf500_parse_response_zero_offset(REPLY(ZERO_OFFSET), &value_i32)))
+
+typedef struct {
+    const char *name;
+    benchmark_function function;
+} benchmark_entry;
+
+#define BENCHMARK_ENTRY(name) {#name, bench_##name}
+
+static const benchmark_entry request_benchmarks[] = {
+    BENCHMARK_ENTRY(request_read),
+    BENCHMARK_ENTRY(request_write_int8),
+    BENCHMARK_ENTRY(request_write_int16),
+    BENCHMARK_ENTRY(request_write_int32),
+    BENCHMARK_ENTRY(request_write_uint8),
+    BENCHMARK_ENTRY(request_write_uint16),
+    BENCHMARK_ENTRY(request_write_uint32),
+    BENCHMARK_ENTRY(request_write_string),
+    BENCHMARK_ENTRY(request_write_data),
+    BENCHMARK_ENTRY(grf500_write_user_data),
+    BENCHMARK_ENTRY(grf500_write_save_parameters),
+    BENCHMARK_ENTRY(grf500_write_reset),
+    BENCHMARK_ENTRY(grf500_write_distance_config),
+    BENCHMARK_ENTRY(grf500_write_stream),
+    BENCHMARK_ENTRY(grf500_write_laser_firing),
+    BENCHMARK_ENTRY(grf500_write_auto_exposure),
+    BENCHMARK_ENTRY(grf500_write_update_rate),
+    BENCHMARK_ENTRY(grf500_write_alarm_return_mode),
+    BENCHMARK_ENTRY(grf500_write_lost_signal_counter),
+    BENCHMARK_ENTRY(grf500_write_alarm_a_distance),
+    BENCHMARK_ENTRY(grf500_write_alarm_b_distance),
+    BENCHMARK_ENTRY(grf500_write_alarm_hysteresis),
+    BENCHMARK_ENTRY(grf500_write_gpio_mode),
+    BENCHMARK_ENTRY(grf500_write_gpio_alarm_confirm_count),
+    BENCHMARK_ENTRY(grf500_write_median_filter_enable),
+    BENCHMARK_ENTRY(grf500_write_median_filter_size),
+    BENCHMARK_ENTRY(grf500_write_smooth_filter_enable),
+    BENCHMARK_ENTRY(grf500_write_smooth_filter_factor),
+    BENCHMARK_ENTRY(grf500_write_baud_rate),
+    BENCHMARK_ENTRY(grf500_write_i2c_address),
+    BENCHMARK_ENTRY(grf500_write_rolling_average_enable),
+    BENCHMARK_ENTRY(grf500_write_rolling_average_size),
+    BENCHMARK_ENTRY(grf500_write_sleep),
+    BENCHMARK_ENTRY(grf500_write_led_state),
+    BENCHMARK_ENTRY(grf500_write_zero_offset),
+};
+
+static const benchmark_entry parse_benchmarks[] = {
+    BENCHMARK_ENTRY(parse_multi_data),
+    BENCHMARK_ENTRY(parse_product_name),
+    BENCHMARK_ENTRY(parse_hardware_version),
+    BENCHMARK_ENTRY(parse_firmware_version),
+    BENCHMARK_ENTRY(parse_serial_number),
+    BENCHMARK_ENTRY(parse_user_data),
+    BENCHMARK_ENTRY(parse_token),
+    BENCHMARK_ENTRY(parse_distance_config),
+    BENCHMARK_ENTRY(parse_stream),
+    BENCHMARK_ENTRY(parse_laser_firing),
+    BENCHMARK_ENTRY(parse_temperature),
+    BENCHMARK_ENTRY(parse_auto_exposure),
+    BENCHMARK_ENTRY(parse_update_rate),
+    BENCHMARK_ENTRY(parse_alarm_status),
+    BENCHMARK_ENTRY(parse_alarm_return_mode),
+    BENCHMARK_ENTRY(parse_lost_signal_counter),
+    BENCHMARK_ENTRY(parse_alarm_a_distance),
+    BENCHMARK_ENTRY(parse_alarm_b_distance),
+    BENCHMARK_ENTRY(parse_alarm_hysteresis),
+    BENCHMARK_ENTRY(parse_gpio_mode),
+    BENCHMARK_ENTRY(parse_gpio_alarm_confirm_count),
+    BENCHMARK_ENTRY(parse_median_filter_enable),
+    BENCHMARK_ENTRY(parse_median_filter_size),
+    BENCHMARK_ENTRY(parse_smooth_filter_enable),
+    BENCHMARK_ENTRY(parse_smooth_filter_factor),
+    BENCHMARK_ENTRY(parse_baud_rate),
+    BENCHMARK_ENTRY(parse_i2c_address),
+    BENCHMARK_ENTRY(parse_rolling_average_enable),
+    BENCHMARK_ENTRY(parse_rolling_average_size),
+    BENCHMARK_ENTRY(parse_led_state),
+    BENCHMARK_ENTRY(parse_zero_offset),
+};
+
+// ----------------------------------------------------------------------------
+// Corpus generation.
+// ----------------------------------------------------------------------------
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static void make_response(lw_response *target, uint8_t command_id, const uint8_t *data, uint32_t size) {
+    uint8_t buffer[LW_PACKET_RECV_SIZE];
+    uint32_t packet_size = lw_create_packet(buffer, command_id, 0, (uint8_t *)data, size);
+
+    lw_init_response(target);
+
+    for (uint32_t b = 0; b < packet_size; ++b) {
+        lw_feed_response(target, buffer[b]);
+    }
+}
+
+static uint32_t count_bits(uint32_t value) {
+    uint32_t count = 0;
+
+    for (; value; value &= value - 1) {
+        count++;
+    }
+
+    return count;
+}
+
+static void build_corpora(void) {
+    uint32_t seed = 12345;
+    uint8_t data[64];
+
+    for (uint32_t i = 0; i < BENCHMARK_CORPUS_SIZE; ++i) {
+        for (uint32_t b = 0; b < sizeof(payloads[i]); ++b) {
+            payloads[i][b] = (uint8_t)next_random(&seed);
+        }
+    }
+
+    // A distance data response for every distance config mask.
+    for (uint32_t mask = 0; mask < 256; ++mask) {
+        for (uint32_t b = 0; b < sizeof(data); ++b) {
+            data[b] = (uint8_t)next_random(&seed);
+        }
+
+        make_response(&mask_responses[mask], LW_GRF500_COMMAND_DISTANCE_DATA, data, count_bits(mask) * 4);
+    }
+
+    // One reply of a plausible size for every command.
+    for (uint32_t command = 0; command <= LW_GRF500_COMMAND_ZERO_OFFSET; ++command) {
+        uint32_t size = 4;
+
+        if (command == LW_GRF500_COMMAND_PRODUCT_NAME || command == LW_GRF500_COMMAND_SERIAL_NUMBER) {
+            memcpy(data, "GRF-500\0\0\0\0\0\0\0\0\0", 16);
+            size = 16;
+        } else if (command == LW_GRF500_COMMAND_USER_DATA) {
+            size = 16;
+        } else if (command == LW_GRF500_COMMAND_MULTI_DATA) {
+            size = 44;
+        }
+
+        if (command != LW_GRF500_COMMAND_PRODUCT_NAME && command != LW_GRF500_COMMAND_SERIAL_NUMBER) {
+            for (uint32_t b = 0; b < size; ++b) {
+                data[b] = (uint8_t)(next_random(&seed) & 0x7F);
+            }
+        }
+
+        make_response(&reply_responses[command], (uint8_t)command, data, size);
+    }
+
+    // Streams as they come off the wire: distance data with every field,
+    // multi data, and distance data with corrupted bytes and line noise
+    // between packets.
+    for (uint32_t p = 0; p < BENCHMARK_STREAM_PACKETS; ++p) {
+        for (uint32_t b = 0; b < sizeof(data); ++b) {
+            data[b] = (uint8_t)next_random(&seed);
+        }
+
+        uint32_t size = lw_create_packet(clean_stream + clean_stream_size, LW_GRF500_COMMAND_DISTANCE_DATA, 0, data, 32);
+        memcpy(noisy_stream + noisy_stream_size, clean_stream + clean_stream_size, size);
+
+        for (uint32_t b = 0; b < size; ++b) {
+            if ((next_random(&seed) & 0xFF) < 3) {
+                noisy_stream[noisy_stream_size + b] ^= (uint8_t)(1 + next_random(&seed) % 255);
+            }
+        }
+
+        clean_stream_size += size;
+        noisy_stream_size += size;
+
+        uint32_t junk = ((next_random(&seed) & 0x0F) == 0) ? next_random(&seed) % 24 : 0;
+
+        for (uint32_t b = 0; b < junk; ++b) {
+            noisy_stream[noisy_stream_size++] = (uint8_t)next_random(&seed);
+        }
+
+        multi_stream_size += lw_create_packet(multi_stream + multi_stream_size, LW_GRF500_COMMAND_MULTI_DATA, 0, data, 44);
+    }
+}
+
+static void run_stream(const char *name, const uint8_t *stream, uint32_t size) {
+    if (name_filter && strstr(name, name_filter) == NULL) {
+        return;
+    }
+
+    current_stream = stream;
+    current_stream_size = size;
+
+    uint32_t before = sink;
+    bench_feed_response(1);
+    printf("# %s: %u bytes, %u packets per pass\n", name, size, sink - before);
+
+    run_benchmark(name, "byte", size, bench_feed_response);
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    char name[64];
+
+    if (argc > 1) {
+        name_filter = argv[1];
+    }
+
+    build_corpora();
+    calibrate_counter();
+
+    printf("# counter: %.1f MHz\n", counter_hz / 1e6);
+    printf("benchmark,unit,batches,iterations,ns_min,ns_median,ticks_min,ticks_median\n");
+
+    static const uint32_t sizes[] = {4, 16, 44, 128, 256};
+
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        current_size = sizes[s];
+        sprintf(name, "create_crc_%u", current_size);
+        run_benchmark(name, "call", 1, bench_crc);
+    }
+
+    for (uint32_t s = 0; s < 4; ++s) {
+        current_size = sizes[s] - 4;
+        sprintf(name, "create_packet_%u", current_size);
+        run_benchmark(name, "call", 1, bench_packet);
+    }
+
+    for (uint32_t i = 0; i < sizeof(request_benchmarks) / sizeof(request_benchmarks[0]); ++i) {
+        sprintf(name, "create_%s", request_benchmarks[i].name);
+        run_benchmark(name, "call", 1, request_benchmarks[i].function);
+    }
+
+    run_stream("feed_response_distance_stream", clean_stream, clean_stream_size);
+    run_stream("feed_response_multi_stream", multi_stream, multi_stream_size);
+    run_stream("feed_response_noisy_stream", noisy_stream, noisy_stream_size);
+
+    for (uint32_t mask = 0; mask < 256; ++mask) {
+        current_mask = mask;
+        sprintf(name, "parse_distance_data_0x%02X", mask);
+        run_benchmark(name, "call", 1, bench_parse_distance_data);
+    }
+
+    for (uint32_t i = 0; i < sizeof(parse_benchmarks) / sizeof(parse_benchmarks[0]); ++i) {
+        run_benchmark(parse_benchmarks[i].name, "call", 1, parse_benchmarks[i].function);
+    }
+
+    if (failures > 0) {
+        printf("# %u calls failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}
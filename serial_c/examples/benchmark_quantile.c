@@ -0,0 +1,194 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API quantile sketch benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_quantile.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_VALUES 2000000
+#define BENCHMARK_PARTS 16
+#define BENCHMARK_FRACTIONS 99
+
+// Largest rank error accepted, as a fraction of the value count. The default
+// sketch size gives about 1%.
+#define BENCHMARK_MAX_RANK_ERROR 0.015
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static int32_t inputs[BENCHMARK_VALUES];
+static int32_t sorted[BENCHMARK_VALUES];
+static lw_grf500_quantile_sketch sketch;
+static lw_grf500_quantile_sketch parts[BENCHMARK_PARTS];
+static lw_grf500_quantile_sketch merged;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static int compare_i32(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Number of sorted values below a value, or at or below it.
+static uint32_t count_below(int32_t value, lw_bool inclusive) {
+    uint32_t low = 0;
+    uint32_t high = BENCHMARK_VALUES;
+
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+
+        if (sorted[middle] < value || (inclusive && sorted[middle] == value)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+// ----------------------------------------------------------------------------
+// Worst rank error of a sketch over a grid of fractions. The true rank of a
+// value spans the ranks of all values equal to it.
+// ----------------------------------------------------------------------------
+static double worst_rank_error(const lw_grf500_quantile_sketch *target) {
+    float fractions[BENCHMARK_FRACTIONS];
+    int32_t values[BENCHMARK_FRACTIONS];
+    double worst = 0;
+
+    for (uint32_t i = 0; i < BENCHMARK_FRACTIONS; ++i) {
+        fractions[i] = (float)(i + 1) / (BENCHMARK_FRACTIONS + 1);
+    }
+
+    lw_grf500_quantile_get(target, fractions, BENCHMARK_FRACTIONS, values);
+
+    for (uint32_t i = 0; i < BENCHMARK_FRACTIONS; ++i) {
+        double low = (double)count_below(values[i], LW_FALSE) / BENCHMARK_VALUES;
+        double high = (double)count_below(values[i], LW_TRUE) / BENCHMARK_VALUES;
+        double error = (fractions[i] < low) ? low - fractions[i] : (fractions[i] > high) ? fractions[i] - high : 0;
+        worst = (error > worst) ? error : worst;
+    }
+
+    return worst;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    static const char *pattern_names[] = {"uniform", "sawtooth", "skewed"};
+    uint32_t seed = 12345;
+    lw_bool passed = LW_TRUE;
+
+    printf("Values: %d, parts merged: %d, sketch size: %u bytes\n\n", BENCHMARK_VALUES, BENCHMARK_PARTS, (uint32_t)sizeof(lw_grf500_quantile_sketch));
+    printf("%-10s %14s %14s %12s\n", "input", "direct error", "merged error", "ns/add");
+
+    for (uint32_t p = 0; p < sizeof(pattern_names) / sizeof(pattern_names[0]); ++p) {
+        // ----------------------------------------------------------------------------
+        // Uniform distances, a ramp that repeats, and a long tail of far
+        // values over mostly near ones.
+        // ----------------------------------------------------------------------------
+        for (uint32_t i = 0; i < BENCHMARK_VALUES; ++i) {
+            double u = (double)next_random(&seed) / 16777216.0;
+
+            switch (p) {
+                case 0:
+                    inputs[i] = (int32_t)(u * 100000);
+                    break;
+                case 1:
+                    inputs[i] = (int32_t)(i % 10007) * 10;
+                    break;
+                default:
+                    inputs[i] = (int32_t)(u * u * u * u * 100000);
+                    break;
+            }
+        }
+
+        memcpy(sorted, inputs, sizeof(inputs));
+        qsort(sorted, BENCHMARK_VALUES, sizeof(sorted[0]), compare_i32);
+
+        // ----------------------------------------------------------------------------
+        // One sketch fed every value, timed, and the same values split in
+        // order over partial sketches that are then merged.
+        // ----------------------------------------------------------------------------
+        lw_grf500_quantile_init(&sketch);
+        uint64_t start_ns = lw_platform_get_time_ns();
+
+        for (uint32_t i = 0; i < BENCHMARK_VALUES; ++i) {
+            lw_grf500_quantile_add(&sketch, inputs[i]);
+        }
+
+        double ns_per_add = (double)(lw_platform_get_time_ns() - start_ns) / BENCHMARK_VALUES;
+
+        for (uint32_t part = 0; part < BENCHMARK_PARTS; ++part) {
+            lw_grf500_quantile_init(&parts[part]);
+        }
+
+        for (uint32_t i = 0; i < BENCHMARK_VALUES; ++i) {
+            lw_grf500_quantile_add(&parts[i / (BENCHMARK_VALUES / BENCHMARK_PARTS)], inputs[i]);
+        }
+
+        lw_grf500_quantile_init(&merged);
+
+        for (uint32_t part = 0; part < BENCHMARK_PARTS; ++part) {
+            lw_grf500_quantile_merge(&merged, &parts[part]);
+        }
+
+        if (sketch.count != BENCHMARK_VALUES || merged.count != BENCHMARK_VALUES || sketch.min != sorted[0] || sketch.max != sorted[BENCHMARK_VALUES - 1] || merged.min != sorted[0] || merged.max != sorted[BENCHMARK_VALUES - 1]) {
+            printf("Count, minimum or maximum wrong for %s input\n", pattern_names[p]);
+            return 1;
+        }
+
+        double direct_error = worst_rank_error(&sketch);
+        double merged_error = worst_rank_error(&merged);
+        passed = passed && direct_error <= BENCHMARK_MAX_RANK_ERROR && merged_error <= BENCHMARK_MAX_RANK_ERROR;
+
+        printf("%-10s %13.3f%% %13.3f%% %12.1f\n", pattern_names[p], direct_error * 100.0, merged_error * 100.0, ns_per_add);
+    }
+
+    if (!passed) {
+        printf("\nRank error over %.1f%%\n", BENCHMARK_MAX_RANK_ERROR * 100.0);
+        return 1;
+    }
+
+    printf("\nRank errors are the worst over the P1 to P99 quantiles, against a full sort.\n");
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API multi-return tracker benchmark for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lw_grf500_tracker.h"
+
+#ifdef _WIN32
+#include "lw_platform_win_serial.h"
+#elif __linux__
+#include "lw_platform_linux_serial.h"
+#endif
+
+#define BENCHMARK_FRAMES 100000
+#define BENCHMARK_REPEATS 10
+
+// Update rate of the simulated sensor, and the fleet the load is reported for.
+#define BENCHMARK_UPDATE_RATE_HZ 10
+#define BENCHMARK_FLEET_SENSORS 500
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+static lw_grf500_multi_sample frames[BENCHMARK_FRAMES];
+
+// Return slot of the wall and the moving target in every frame, -1 if missing.
+static int32_t wall_slot[BENCHMARK_FRAMES];
+static int32_t target_slot[BENCHMARK_FRAMES];
+
+static lw_grf500_tracker tracker;
+
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static int32_t noise(uint32_t *seed, int32_t amplitude) {
+    return (int32_t)(next_random(seed) % (uint32_t)(amplitude * 2 + 1)) - amplitude;
+}
+
+// ----------------------------------------------------------------------------
+// Count the times the track ID of an object changes once it has a confirmed
+// track, ignoring frames where the object was not seen.
+// ----------------------------------------------------------------------------
+typedef struct {
+    uint32_t id;
+    uint32_t switches;
+    uint32_t untracked;
+} object_track;
+
+static void follow_object(object_track *object, uint32_t id) {
+    const lw_grf500_track *track = lw_grf500_tracker_find_track(&tracker, id);
+
+    if (!track || !track->confirmed) {
+        object->untracked += (object->id != 0);
+        return;
+    }
+
+    if (object->id != 0 && object->id != id) {
+        object->switches++;
+    }
+
+    object->id = id;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Build a fixed corpus: a wall, a target swinging back and forth in front
+    // of it and close range rain clutter, in shuffled return slots with some
+    // missed returns.
+    // ----------------------------------------------------------------------------
+    uint32_t seed = 12345;
+    float target_offset_mm = 3500;
+    float target_speed_mm_per_s = 0;
+    float dt = 1.0f / BENCHMARK_UPDATE_RATE_HZ;
+
+    for (uint32_t f = 0; f < BENCHMARK_FRAMES; ++f) {
+        lw_grf500_multi_sample *frame = &frames[f];
+        uint32_t slots[LW_GRF500_TRACKER_RETURN_COUNT] = {0, 1, 2, 3, 4};
+
+        memset(frame, 0, sizeof(*frame));
+        frame->timestamp_us = (uint64_t)f * 1000000 / BENCHMARK_UPDATE_RATE_HZ;
+        frame->sequence = f;
+
+        for (uint32_t i = LW_GRF500_TRACKER_RETURN_COUNT - 1; i > 0; --i) {
+            uint32_t j = next_random(&seed) % (i + 1);
+            uint32_t slot = slots[i];
+            slots[i] = slots[j];
+            slots[j] = slot;
+        }
+
+        // The target swings between 3 m and 10 m with a period of about 20 s.
+        target_speed_mm_per_s -= 0.0987f * target_offset_mm * dt;
+        target_offset_mm += target_speed_mm_per_s * dt;
+
+        wall_slot[f] = -1;
+        target_slot[f] = -1;
+
+        if (next_random(&seed) % 100 >= 5) {
+            wall_slot[f] = (int32_t)slots[0];
+            frame->data.signals[slots[0]].distance_mm = 12000 + noise(&seed, 20);
+            frame->data.signals[slots[0]].strength = 80 + noise(&seed, 10);
+        }
+
+        if (next_random(&seed) % 100 >= 5) {
+            target_slot[f] = (int32_t)slots[1];
+            frame->data.signals[slots[1]].distance_mm = 6500 + (int32_t)target_offset_mm + noise(&seed, 30);
+            frame->data.signals[slots[1]].strength = 50 + noise(&seed, 10);
+        }
+
+        for (uint32_t r = 2; r < 2 + next_random(&seed) % 3; ++r) {
+            frame->data.signals[slots[r]].distance_mm = 300 + (int32_t)(next_random(&seed) % 2000);
+            frame->data.signals[slots[r]].strength = 5 + (int32_t)(next_random(&seed) % 20);
+        }
+
+        frame->data.temperature = 2500;
+    }
+
+    // ----------------------------------------------------------------------------
+    // Check that the wall and target keep their track IDs through the clutter.
+    // ----------------------------------------------------------------------------
+    object_track wall = {0, 0, 0};
+    object_track target = {0, 0, 0};
+
+    lw_grf500_tracker_init(&tracker, NULL);
+
+    for (uint32_t f = 0; f < BENCHMARK_FRAMES; ++f) {
+        uint32_t track_ids[LW_GRF500_TRACKER_RETURN_COUNT];
+        lw_grf500_tracker_update(&tracker, &frames[f], track_ids);
+
+        if (wall_slot[f] >= 0) {
+            follow_object(&wall, track_ids[wall_slot[f]]);
+        }
+
+        if (target_slot[f] >= 0) {
+            follow_object(&target, track_ids[target_slot[f]]);
+        }
+    }
+
+    printf("Frames: %d at %d Hz, tracks born: %llu, confirmed: %llu, dropped returns: %llu\n", BENCHMARK_FRAMES, BENCHMARK_UPDATE_RATE_HZ, (unsigned long long)tracker.stats.births, (unsigned long long)tracker.stats.confirmations, (unsigned long long)tracker.stats.dropped_returns);
+    printf("Wall: %u ID switches, %u untracked returns\n", wall.switches, wall.untracked);
+    printf("Target: %u ID switches, %u untracked returns\n\n", target.switches, target.untracked);
+
+    if (wall.switches != 0 || wall.untracked != 0 || target.switches != 0 || target.untracked != 0) {
+        printf("The wall and target did not keep their tracks\n");
+        return 1;
+    }
+
+    // ----------------------------------------------------------------------------
+    // Time updates over the same frames.
+    // ----------------------------------------------------------------------------
+    uint64_t total_ns = 0;
+
+    for (uint32_t n = 0; n < BENCHMARK_REPEATS; ++n) {
+        lw_grf500_tracker_init(&tracker, NULL);
+        uint64_t start_ns = lw_platform_get_time_ns();
+
+        for (uint32_t f = 0; f < BENCHMARK_FRAMES; ++f) {
+            lw_grf500_tracker_update(&tracker, &frames[f], NULL);
+        }
+
+        total_ns += lw_platform_get_time_ns() - start_ns;
+    }
+
+    double ns_per_update = (double)total_ns / ((double)BENCHMARK_FRAMES * BENCHMARK_REPEATS);
+    double load = ns_per_update * BENCHMARK_FLEET_SENSORS * BENCHMARK_UPDATE_RATE_HZ / 1e9;
+
+    printf("%12s %14s\n", "ns/update", "load at rate");
+    printf("%12.1f %13.4f%%\n", ns_per_update, load * 100.0);
+    printf("\nLoad is the share of one core used by %d sensors at %d Hz.\n", BENCHMARK_FLEET_SENSORS, BENCHMARK_UPDATE_RATE_HZ);
+
+    return 0;
+}
@@ -13,3 +13,12 @@ zig cc -o ./bin/example_unmanaged.exe example_unmanaged.c %SHARED_SOURCES_WIN% %
 zig cc -o ./bin/example_basic example_basic.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
 zig cc -o ./bin/example_callbacks example_callbacks.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
 zig cc -o ./bin/example_unmanaged example_unmanaged.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_discovery example_discovery.c lw_platform_linux_discovery.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_registry example_registry.c lw_platform_linux_registry.c lw_platform_linux_discovery.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_recorder example_recorder.c ../lw_grf500_recorder.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_replay example_replay.c ../lw_serial_capture.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_shm_publisher example_shm_publisher.c ../lw_grf500_ring.c lw_platform_linux_shm.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_shm_reader example_shm_reader.c ../lw_grf500_ring.c lw_platform_linux_shm.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_broker example_broker.c lw_platform_linux_broker.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_broker_client example_broker_client.c lw_platform_linux_broker.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s
+zig cc -o ./bin/example_latest example_latest.c ../lw_grf500_latest.c %SHARED_SOURCES_LINUX% %CFLAGS% -target native-linux -s -lpthread
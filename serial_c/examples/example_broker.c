@@ -0,0 +1,96 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API broker example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lw_platform_linux_broker.h"
+
+#define SOCKET_PATH "/tmp/grf500.sock"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+static volatile sig_atomic_t running = 1;
+
+static void handle_signal(int signal_number) {
+    (void)signal_number;
+    running = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    const char *port_name = (argc > 1) ? argv[1] : "/dev/ttyACM0";
+    const char *socket_path = (argc > 2) ? argv[2] : SOCKET_PATH;
+
+    // ----------------------------------------------------------------------------
+    // Platform related setup.
+    // ----------------------------------------------------------------------------
+    lw_platform_serial_device grf500;
+    check_success(lw_platform_create_serial_device(port_name, 115200, &grf500), "Failed to create serial device");
+    check_success(lw_grf500_initiate_serial(&grf500.device), "Failed to initiate serial");
+
+    // The broker struct is large, keep it off the stack.
+    static lw_platform_broker broker;
+    check_success(lw_platform_broker_init(&broker, &grf500, socket_path), "Failed to start broker");
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    printf("Serving %s on %s, press Ctrl+C to stop\n", port_name, socket_path);
+
+    // ----------------------------------------------------------------------------
+    // Serve clients until interrupted.
+    // ----------------------------------------------------------------------------
+    while (running) {
+        if (lw_platform_broker_poll(&broker, 100) != LW_RESULT_SUCCESS) {
+            printf("Communication error\n");
+            break;
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // Closing down.
+    // ----------------------------------------------------------------------------
+    lw_platform_broker_close(&broker);
+
+    printf("Served %llu requests, %llu timed out, streamed %llu packets\n", (unsigned long long)broker.requests_served, (unsigned long long)broker.requests_timed_out, (unsigned long long)broker.packets_streamed);
+    printf("Sample completed\n");
+
+    return 0;
+}
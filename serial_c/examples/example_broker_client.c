@@ -0,0 +1,96 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API broker client example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lw_platform_linux_broker.h"
+
+#define SOCKET_PATH "/tmp/grf500.sock"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    const char *socket_path = (argc > 1) ? argv[1] : SOCKET_PATH;
+
+    // ----------------------------------------------------------------------------
+    // Connect to the broker. From here on the device is used exactly as if it
+    // were attached directly.
+    // ----------------------------------------------------------------------------
+    lw_platform_serial_device grf500;
+    check_success(lw_platform_broker_connect(socket_path, &grf500), "Failed to connect to broker");
+
+    lw_grf500_product_info product_info;
+    check_success(lw_grf500_get_product_info(&grf500.device, &product_info), "Failed to get product info");
+
+    printf("Product name: %s\n", product_info.product_name);
+    printf("Hardware version: %d\n", product_info.hardware_version);
+    printf("Firmware version: %d.%d.%d\n", product_info.firmware_version.major, product_info.firmware_version.minor, product_info.firmware_version.patch);
+    printf("Serial number: %s\n", product_info.serial_number);
+
+    // ----------------------------------------------------------------------------
+    // Subscribe to the distance stream. The broker only changes the stream on
+    // the device, other clients keep their own subscriptions.
+    // ----------------------------------------------------------------------------
+    lw_grf500_distance_config distance_config = LW_GRF500_DISTANCE_CONFIG_ALL;
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_DISTANCE_DATA), "Failed to set stream: distance");
+
+    lw_grf500_distance_data_cm distance_data;
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        lw_result result = lw_grf500_wait_for_streamed_distance_data(&grf500.device, distance_config, &distance_data, 1000);
+
+        if (result == LW_RESULT_SUCCESS) {
+            printf("First return: %d cm, strength: %d %%\n", distance_data.first_return_raw_cm, distance_data.first_return_strength);
+        } else if (result == LW_RESULT_ERROR) {
+            printf("Communication error\n");
+            break;
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // Closing down.
+    // ----------------------------------------------------------------------------
+    lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE);
+    lw_platform_serial_disconnect(&grf500.serial_port);
+
+    printf("Sample completed\n");
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API discovery example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lw_platform_linux_discovery.h"
+#include "lw_platform_linux_serial.h"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Probe every candidate serial port across all baud rates at once.
+    // ----------------------------------------------------------------------------
+    lw_platform_discovered_device devices[LW_DISCOVERY_MAX_PORTS];
+    uint32_t device_count = 0;
+
+    uint64_t start_time_us = lw_platform_get_time_us();
+    check_success(lw_platform_discover_devices(devices, LW_DISCOVERY_MAX_PORTS, &device_count), "Failed to discover devices");
+    uint64_t elapsed_us = lw_platform_get_time_us() - start_time_us;
+
+    // ----------------------------------------------------------------------------
+    // Print the devices that answered.
+    // ----------------------------------------------------------------------------
+    printf("%-16s %-10s %-16s %-10s %-10s %s\n", "Port", "Baud rate", "Product", "Hardware", "Firmware", "Serial number");
+
+    for (uint32_t i = 0; i < device_count; ++i) {
+        lw_platform_discovered_device *device = &devices[i];
+
+        printf("%-16s %-10u %-16s %-10u %u.%u.%-6u %s\n",
+               device->port_name,
+               device->baud_rate,
+               device->product_info.product_name,
+               device->product_info.hardware_version,
+               device->product_info.firmware_version.major,
+               device->product_info.firmware_version.minor,
+               device->product_info.firmware_version.patch,
+               device->product_info.serial_number);
+    }
+
+    printf("Found %u devices in %llu ms\n", device_count, (unsigned long long)(elapsed_us / 1000));
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API latest value example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lw_grf500_latest.h"
+#include "lw_platform_linux_serial.h"
+
+#define CONTROL_RATE_HZ 200
+#define MAX_SAMPLE_AGE_US 250000
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+static lw_platform_serial_device grf500;
+static lw_grf500_latest latest;
+static volatile int running = 1;
+
+// ----------------------------------------------------------------------------
+// I/O thread, the only user of the device once streaming starts.
+// ----------------------------------------------------------------------------
+static void *io_thread(void *argument) {
+    (void)argument;
+    lw_grf500_distance_sample sample = {0};
+
+    while (running) {
+        lw_result result = lw_grf500_wait_for_streamed_distance_data(&grf500.device, LW_GRF500_DISTANCE_CONFIG_ALL, &sample.data, 100);
+
+        if (result == LW_RESULT_SUCCESS) {
+            sample.timestamp_us = lw_platform_get_time_us();
+            lw_grf500_latest_publish_distance(&latest, &sample);
+            sample.sequence++;
+        } else if (result == LW_RESULT_ERROR) {
+            printf("Communication error\n");
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Platform related setup.
+    // ----------------------------------------------------------------------------
+    check_success(lw_platform_create_serial_device("/dev/ttyACM0", 115200, &grf500), "Failed to create serial device");
+    check_success(lw_grf500_initiate_serial(&grf500.device), "Failed to initiate serial");
+
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    check_success(lw_grf500_set_update_rate(&grf500.device, 10), "Failed to set update rate");
+    check_success(lw_grf500_set_distance_config(&grf500.device, LW_GRF500_DISTANCE_CONFIG_ALL), "Failed to set distance config");
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_DISTANCE_DATA), "Failed to set stream: distance");
+
+    lw_grf500_latest_init(&latest);
+
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, io_thread, NULL) != 0) {
+        printf("Failed to start I/O thread\n");
+        return 1;
+    }
+
+    // ----------------------------------------------------------------------------
+    // Control loop, running at its own rate whatever the sensor does.
+    // ----------------------------------------------------------------------------
+    uint64_t period_us = 1000000 / CONTROL_RATE_HZ;
+    uint64_t next_us = lw_platform_get_time_us();
+    uint64_t last_sequence = 0;
+    uint32_t new_samples = 0;
+    uint32_t repeats = 0;
+    uint32_t stale = 0;
+
+    for (uint32_t tick = 0; tick < CONTROL_RATE_HZ * 5; ++tick) {
+        lw_grf500_distance_sample sample;
+        uint64_t sequence = 0;
+        lw_result result = lw_grf500_latest_read_distance(&latest, lw_platform_get_time_us(), MAX_SAMPLE_AGE_US, &sample, &sequence);
+
+        if (result == LW_RESULT_TIMEOUT) {
+            stale++;
+        } else if (result == LW_RESULT_SUCCESS) {
+            if (sequence == last_sequence) {
+                repeats++;
+            } else {
+                new_samples++;
+
+                if (tick % CONTROL_RATE_HZ == 0) {
+                    printf("Tick %u: sample %llu, first return %d cm\n", tick, (unsigned long long)sequence, sample.data.first_return_raw_cm);
+                }
+            }
+
+            last_sequence = sequence;
+        }
+
+        next_us += period_us;
+        uint64_t now_us = lw_platform_get_time_us();
+
+        if (next_us > now_us) {
+            lw_platform_sleep((uint32_t)((next_us - now_us) / 1000));
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // Closing down.
+    // ----------------------------------------------------------------------------
+    running = 0;
+    pthread_join(thread, NULL);
+    lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE);
+
+    printf("New samples: %u, repeats: %u, stale: %u\n", new_samples, repeats, stale);
+    printf("Sample completed\n");
+
+    return 0;
+}
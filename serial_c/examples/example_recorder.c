@@ -0,0 +1,151 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API recorder example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lw_grf500_recorder.h"
+#include "lw_platform_linux_serial.h"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Recorder write callback.
+// ----------------------------------------------------------------------------
+// Every write is a whole aligned block at an aligned offset, so the recording
+// file could also be opened with O_DIRECT.
+lw_result recorder_write_callback(lw_grf500_recorder *recorder, const void *data, uint32_t size, uint64_t offset) {
+    int fd = *(int *)recorder->user_data;
+
+    if (pwrite(fd, data, size, (off_t)offset) != (ssize_t)size) {
+        return LW_RESULT_ERROR;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+// The recorder holds two chunk buffers, so keep it out of the stack.
+static lw_grf500_recorder recorder;
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Platform related setup.
+    // ----------------------------------------------------------------------------
+    lw_platform_serial_device grf500;
+    check_success(lw_platform_create_serial_device("/dev/ttyACM0", 115200, &grf500), "Failed to create serial device");
+    check_success(lw_grf500_initiate_serial(&grf500.device), "Failed to initiate serial");
+
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    check_success(lw_grf500_set_update_rate(&grf500.device, 10), "Failed to set update rate");
+
+    // ----------------------------------------------------------------------------
+    // Record 30 seconds of multi signal data.
+    // ----------------------------------------------------------------------------
+    const char *file_name = "grf500_recording.bin";
+    int fd = open(file_name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0) {
+        printf("Failed to create %s\n", file_name);
+        return 1;
+    }
+
+    check_success(lw_grf500_recorder_init(&recorder, LW_GRF500_RECORDING_MULTI, 0, &fd, recorder_write_callback), "Failed to start recording");
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_MULTI_DATA), "Failed to set stream: multi data");
+
+    lw_grf500_multi_sample sample = {0};
+    uint32_t end_time_ms = lw_platform_get_time_ms() + 30000;
+
+    while ((int32_t)(end_time_ms - lw_platform_get_time_ms()) > 0) {
+        if (lw_grf500_wait_for_streamed_multi_data(&grf500.device, &sample.data, 100) != LW_RESULT_SUCCESS) {
+            continue;
+        }
+
+        sample.timestamp_us = lw_platform_get_time_us();
+        check_success(lw_grf500_recorder_append_multi(&recorder, &sample), "Failed to write recording");
+        sample.sequence++;
+    }
+
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    check_success(lw_grf500_recorder_flush(&recorder), "Failed to flush recording");
+
+    // ----------------------------------------------------------------------------
+    // Map the recording and read it back without parsing.
+    // ----------------------------------------------------------------------------
+    struct stat file_stat;
+    fstat(fd, &file_stat);
+
+    void *data = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (data == MAP_FAILED) {
+        printf("Failed to map %s\n", file_name);
+        return 1;
+    }
+
+    lw_grf500_recording recording;
+    check_success(lw_grf500_recording_open(&recording, data, (uint64_t)file_stat.st_size), "Invalid recording");
+
+    printf("Recorded %llu samples in %llu chunks\n", (unsigned long long)recording.header->sample_count, (unsigned long long)recording.chunk_count);
+
+    for (uint64_t i = 0; i < recording.chunk_count; ++i) {
+        const lw_grf500_chunk_footer *footer = &lw_grf500_recording_get_chunk(&recording, i)->footer;
+
+        // Column 0 is the distance of the first return.
+        printf("Chunk %llu: %u samples, first return %d to %d mm\n", (unsigned long long)i, footer->sample_count, footer->min[0], footer->max[0]);
+    }
+
+    // Find the sample closest to 10 seconds into the recording.
+    uint64_t chunk_index = 0;
+    uint32_t sample_index = 0;
+
+    if (lw_grf500_recording_find_time(&recording, recording.header->first_timestamp_us + 10000000, &chunk_index, &sample_index) == LW_RESULT_SUCCESS) {
+        const lw_grf500_chunk *chunk = lw_grf500_recording_get_chunk(&recording, chunk_index);
+        printf("At 10 s: sequence %u, first return %d mm\n", chunk->sequence[sample_index], chunk->columns[0][sample_index]);
+    }
+
+    munmap(data, (size_t)file_stat.st_size);
+    close(fd);
+
+    printf("Sample completed\n");
+
+    return 0;
+}
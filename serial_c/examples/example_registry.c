@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API registry example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lw_platform_linux_registry.h"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+// The registry holds the devices by address, so keep it out of the stack.
+static lw_platform_registry registry;
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Find the attached devices and hand them to the registry.
+    // ----------------------------------------------------------------------------
+    lw_platform_discovered_device devices[LW_REGISTRY_MAX_DEVICES];
+    uint32_t device_count = 0;
+
+    check_success(lw_platform_discover_devices(devices, LW_REGISTRY_MAX_DEVICES, &device_count), "Failed to discover devices");
+    check_success(lw_platform_registry_init(&registry), "Failed to initialize registry");
+
+    lw_grf500_distance_config distance_config = LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW;
+
+    for (uint32_t i = 0; i < device_count; ++i) {
+        uint32_t index = 0;
+        check_success(lw_platform_registry_add_device(&registry, &devices[i], &index), "Failed to add device");
+
+        // State set through the registry is restored after a reconnect.
+        check_success(lw_platform_registry_set_distance_config(&registry, index, distance_config), "Failed to set distance config");
+        check_success(lw_platform_registry_set_update_rate(&registry, index, 5), "Failed to set update rate");
+        check_success(lw_platform_registry_set_stream(&registry, index, LW_GRF500_STREAM_ID_DISTANCE_DATA), "Failed to set stream: distance");
+
+        printf("Registered %s on %s\n", devices[i].product_info.serial_number, devices[i].port_name);
+    }
+
+    // ----------------------------------------------------------------------------
+    // Stream for 60 seconds. Unplug and replug a device to see it come back.
+    // ----------------------------------------------------------------------------
+    uint32_t reconnects[LW_REGISTRY_MAX_DEVICES] = {0};
+    uint32_t end_time_ms = lw_platform_get_time_ms() + 60000;
+
+    while ((int32_t)(end_time_ms - lw_platform_get_time_ms()) > 0) {
+        lw_platform_registry_poll(&registry, 10, NULL);
+
+        for (uint32_t i = 0; i < registry.device_count; ++i) {
+            lw_registry_device *device = &registry.devices[i];
+            lw_grf500_distance_data_cm distance_data;
+
+            if (device->reconnects != reconnects[i]) {
+                reconnects[i] = device->reconnects;
+                printf("%s: Back on %s after %u ms\n", device->product_info.serial_number, device->port_name, device->reconnect_time_ms - device->disconnect_time_ms);
+            }
+
+            if (lw_grf500_wait_for_streamed_distance_data(&device->device, distance_config, &distance_data, 0) == LW_RESULT_SUCCESS) {
+                printf("%s: %d cm\n", device->product_info.serial_number, distance_data.first_return_raw_cm);
+            }
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // Closing down.
+    // ----------------------------------------------------------------------------
+    for (uint32_t i = 0; i < registry.device_count; ++i) {
+        lw_platform_registry_set_stream(&registry, i, LW_GRF500_STREAM_ID_NONE);
+    }
+
+    lw_platform_registry_close(&registry);
+
+    printf("Sample completed\n");
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API replay example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lw_serial_api_grf500.h"
+#include "lw_serial_capture.h"
+#include "lw_platform_linux_serial.h"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Capture and replay callbacks.
+// ----------------------------------------------------------------------------
+uint64_t capture_get_time_us_callback(lw_serial_capture *capture) {
+    (void)capture;
+    return lw_platform_get_time_us();
+}
+
+// stdio buffers the small record writes, which keeps the serial callbacks fast.
+lw_result capture_write_callback(lw_serial_capture *capture, const void *data, uint32_t size) {
+    FILE *file = (FILE *)capture->user_data;
+    return (fwrite(data, 1, size, file) == size) ? LW_RESULT_SUCCESS : LW_RESULT_ERROR;
+}
+
+uint64_t replay_get_time_us_callback(lw_serial_replay *replay) {
+    (void)replay;
+    return lw_platform_get_time_us();
+}
+
+void replay_sleep_us_callback(lw_serial_replay *replay, uint64_t time_us) {
+    (void)replay;
+    usleep((useconds_t)time_us);
+}
+
+static lw_serial_capture capture;
+static lw_serial_replay replay;
+
+// ----------------------------------------------------------------------------
+// Capture streamed distance data from a device.
+// ----------------------------------------------------------------------------
+static int run_capture(const char *port_name, const char *file_name) {
+    lw_platform_serial_device grf500;
+    check_success(lw_platform_create_serial_device(port_name, 115200, &grf500), "Failed to create serial device");
+
+    FILE *file = fopen(file_name, "wb");
+
+    if (file == NULL) {
+        printf("Failed to create %s\n", file_name);
+        return 1;
+    }
+
+    // Everything from here on goes through the capture device.
+    check_success(lw_serial_capture_init(&capture, &grf500.device, file, capture_get_time_us_callback, capture_write_callback), "Failed to start capture");
+    lw_callback_device *device = &capture.device;
+
+    check_success(lw_grf500_initiate_serial(device), "Failed to initiate serial");
+    check_success(lw_grf500_set_stream(device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    check_success(lw_grf500_set_update_rate(device, 10), "Failed to set update rate");
+    check_success(lw_grf500_set_distance_config(device, LW_GRF500_DISTANCE_CONFIG_ALL), "Failed to set distance config");
+    check_success(lw_grf500_set_stream(device, LW_GRF500_STREAM_ID_DISTANCE_DATA), "Failed to set stream: distance");
+
+    uint32_t end_time_ms = lw_platform_get_time_ms() + 10000;
+
+    while ((int32_t)(end_time_ms - lw_platform_get_time_ms()) > 0) {
+        lw_grf500_distance_data_cm distance_data;
+        lw_grf500_wait_for_streamed_distance_data(device, LW_GRF500_DISTANCE_CONFIG_ALL, &distance_data, 100);
+    }
+
+    check_success(lw_grf500_set_stream(device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    fclose(file);
+
+    printf("Captured %llu records, %llu bytes received, %u write errors\n", (unsigned long long)capture.records, (unsigned long long)capture.bytes_received, capture.write_errors);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Replay a capture through the API.
+// ----------------------------------------------------------------------------
+static int run_replay(const char *file_name, double speed) {
+    int fd = open(file_name, O_RDONLY);
+    struct stat file_stat;
+
+    if (fd < 0 || fstat(fd, &file_stat) != 0) {
+        printf("Failed to open %s\n", file_name);
+        return 1;
+    }
+
+    void *data = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED) {
+        printf("Failed to map %s\n", file_name);
+        return 1;
+    }
+
+    check_success(lw_serial_replay_init(&replay, data, (uint64_t)file_stat.st_size, speed, NULL, replay_get_time_us_callback, replay_sleep_us_callback), "Invalid capture");
+
+    uint32_t packets = 0;
+    uint32_t timeouts = 0;
+    uint64_t start_us = lw_platform_get_time_us();
+
+    // The replay reports a lost connection at the end of the capture.
+    while (1) {
+        lw_grf500_distance_data_cm distance_data;
+        lw_result result = lw_grf500_wait_for_streamed_distance_data(&replay.device, LW_GRF500_DISTANCE_CONFIG_ALL, &distance_data, 1000);
+
+        if (result == LW_RESULT_SUCCESS) {
+            packets++;
+        } else if (result == LW_RESULT_TIMEOUT) {
+            timeouts++;
+        } else if (result == LW_RESULT_ERROR) {
+            break;
+        }
+    }
+
+    uint64_t elapsed_us = lw_platform_get_time_us() - start_us;
+    uint64_t virtual_us = lw_serial_replay_get_time_us(&replay);
+    double seconds = (double)elapsed_us / 1000000.0;
+
+    printf("Replayed %u packets, %u timeouts, %llu bytes\n", packets, timeouts, (unsigned long long)replay.bytes_received);
+    printf("Capture time: %.3f s, host time: %.3f s (%.1fx)\n", (double)virtual_us / 1000000.0, seconds, (double)virtual_us / (double)(elapsed_us ? elapsed_us : 1));
+    printf("Throughput: %.2f Mpackets/s, %.2f MB/s\n", (double)packets / seconds / 1000000.0, (double)replay.bytes_received / seconds / 1000000.0);
+
+    munmap(data, (size_t)file_stat.st_size);
+    close(fd);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    if (argc >= 4 && strcmp(argv[1], "capture") == 0) {
+        return run_capture(argv[2], argv[3]);
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "replay") == 0) {
+        // Speed 0 replays as fast as possible.
+        double speed = (argc >= 4) ? atof(argv[3]) : 0;
+        return run_replay(argv[2], speed);
+    }
+
+    printf("Usage: %s capture <port> <file>\n", argv[0]);
+    printf("       %s replay <file> [speed]\n", argv[0]);
+
+    return 1;
+}
@@ -0,0 +1,119 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API shared memory publisher example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lw_grf500_ring.h"
+#include "lw_platform_linux_serial.h"
+#include "lw_platform_linux_shm.h"
+
+#define RING_NAME "/grf500"
+#define RING_SLOTS 4096
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+static volatile sig_atomic_t running = 1;
+
+static void handle_signal(int signal_number) {
+    (void)signal_number;
+    running = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Platform related setup.
+    // ----------------------------------------------------------------------------
+    lw_platform_serial_device grf500;
+    check_success(lw_platform_create_serial_device("/dev/ttyACM0", 115200, &grf500), "Failed to create serial device");
+    check_success(lw_grf500_initiate_serial(&grf500.device), "Failed to initiate serial");
+
+    lw_grf500_product_info product_info;
+    check_success(lw_grf500_get_product_info(&grf500.device, &product_info), "Failed to get product info");
+
+    float update_rate = 10;
+    lw_grf500_distance_config distance_config = LW_GRF500_DISTANCE_CONFIG_ALL;
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    check_success(lw_grf500_set_update_rate(&grf500.device, update_rate), "Failed to set update rate");
+    check_success(lw_grf500_set_distance_config(&grf500.device, distance_config), "Failed to set distance config");
+
+    // ----------------------------------------------------------------------------
+    // Create the ring in /dev/shm.
+    // ----------------------------------------------------------------------------
+    lw_platform_shm shm;
+    lw_grf500_ring_publisher publisher;
+
+    check_success(lw_platform_shm_create(RING_NAME, LW_GRF500_RING_SIZE(RING_SLOTS), &shm), "Failed to create shared memory");
+    check_success(lw_grf500_ring_create(&publisher, shm.memory, shm.size, RING_SLOTS, LW_GRF500_RECORDING_DISTANCE, distance_config, update_rate, &product_info), "Failed to create ring");
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    // ----------------------------------------------------------------------------
+    // Publish every streamed sample until interrupted.
+    // ----------------------------------------------------------------------------
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_DISTANCE_DATA), "Failed to set stream: distance");
+    printf("Publishing %s on /dev/shm%s, press Ctrl+C to stop\n", product_info.serial_number, RING_NAME);
+
+    lw_grf500_distance_sample sample = {0};
+
+    while (running) {
+        lw_result result = lw_grf500_wait_for_streamed_distance_data(&grf500.device, distance_config, &sample.data, 100);
+
+        if (result == LW_RESULT_SUCCESS) {
+            sample.timestamp_us = lw_platform_get_time_us();
+            lw_grf500_ring_publish_distance(&publisher, &sample);
+            sample.sequence++;
+        } else if (result == LW_RESULT_ERROR) {
+            printf("Communication error\n");
+            break;
+        }
+    }
+
+    // ----------------------------------------------------------------------------
+    // Closing down.
+    // ----------------------------------------------------------------------------
+    lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE);
+    lw_platform_shm_close(&shm);
+
+    printf("Published %u samples\n", sample.sequence);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API shared memory reader example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "lw_grf500_ring.h"
+#include "lw_platform_linux_serial.h"
+#include "lw_platform_linux_shm.h"
+
+#define RING_NAME "/grf500"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(void) {
+    // ----------------------------------------------------------------------------
+    // Map the ring read only. Any number of readers can do this at once.
+    // ----------------------------------------------------------------------------
+    lw_platform_shm shm;
+    lw_grf500_ring_reader reader;
+
+    check_success(lw_platform_shm_open(RING_NAME, &shm), "Failed to open shared memory, is the publisher running?");
+    check_success(lw_grf500_ring_open(&reader, shm.memory, shm.size), "Shared memory does not hold a sample ring");
+
+    const lw_grf500_ring_info *info = lw_grf500_ring_get_info(&reader);
+    printf("Sensor: %s %s at %.1f Hz, %u slots\n", info->product_info.product_name, info->product_info.serial_number, info->update_rate, info->slot_count);
+
+    // ----------------------------------------------------------------------------
+    // Read 10 seconds of samples. Reads never make a system call, this loop
+    // sleeps only to avoid spinning a core.
+    // ----------------------------------------------------------------------------
+    uint32_t end_time_ms = lw_platform_get_time_ms() + 10000;
+    uint32_t samples = 0;
+
+    while ((int32_t)(end_time_ms - lw_platform_get_time_ms()) > 0) {
+        lw_grf500_distance_sample sample;
+
+        while (lw_grf500_ring_read_distance(&reader, &sample) == LW_RESULT_SUCCESS) {
+            uint64_t age_us = lw_platform_get_time_us() - sample.timestamp_us;
+            printf("#%u: %d cm, %llu us old\n", sample.sequence, sample.data.first_return_raw_cm, (unsigned long long)age_us);
+            samples++;
+        }
+
+        usleep(1000);
+    }
+
+    printf("Read %u samples, %u overruns, %u skipped\n", samples, reader.overruns, reader.skipped);
+
+    lw_platform_shm_close(&shm);
+
+    return 0;
+}
@@ -0,0 +1,261 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API simulator example for the GRF-500
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "lw_serial_api_grf500.h"
+#include "lw_grf500_simulator.h"
+#include "lw_platform_linux_serial.h"
+#include "lw_platform_linux_simulator.h"
+
+void lw_debug_print(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void check_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s\n", error_message);
+        exit(1);
+    }
+}
+
+static lw_grf500_simulator simulator;
+static volatile sig_atomic_t running = 1;
+
+static void handle_signal(int signal_number) {
+    (void)signal_number;
+    running = 0;
+}
+
+static void print_stats(const lw_grf500_simulator_stats *stats) {
+    printf("Requests: %llu, responses: %llu, stream packets: %llu, rejected: %llu, unknown: %llu\n", (unsigned long long)stats->requests, (unsigned long long)stats->responses, (unsigned long long)stats->stream_packets, (unsigned long long)stats->rejected_requests, (unsigned long long)stats->unknown_commands);
+    printf("Faults: %llu requests dropped, %llu packets dropped, %llu corrupted, %llu junk bytes, %llu overflows\n", (unsigned long long)stats->dropped_requests, (unsigned long long)stats->dropped_packets, (unsigned long long)stats->corrupted_packets, (unsigned long long)stats->junk_bytes, (unsigned long long)stats->overflows);
+}
+
+// Faults can outlast the API retries, so the in process run counts failures
+// rather than exiting on them.
+static uint32_t failed_calls = 0;
+
+static void expect_success(lw_result result, const char *error_message) {
+    if (result != LW_RESULT_SUCCESS) {
+        printf("%s: %d\n", error_message, result);
+        failed_calls++;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Exercise the API against an in process simulator, in virtual time.
+// ----------------------------------------------------------------------------
+static int run_in_process(float fault_probability) {
+    failed_calls = 0;
+
+    lw_grf500_simulator_config config;
+    lw_grf500_simulator_get_default_config(&config);
+    config.drop_probability = fault_probability;
+    config.corrupt_probability = fault_probability;
+    config.junk_probability = fault_probability;
+    config.request_drop_probability = fault_probability;
+    config.latency_jitter_us = 2000;
+
+    check_success(lw_grf500_simulator_init(&simulator, &config, 0, NULL, NULL, NULL), "Invalid simulator config");
+    lw_callback_device *device = &simulator.device;
+
+    lw_grf500_product_info product_info;
+    memset(&product_info, 0, sizeof(product_info));
+    expect_success(lw_grf500_get_product_info(device, &product_info), "Failed to get product info");
+    printf("Product: %s, serial number: %s, fault probability: %.3f\n", product_info.product_name, product_info.serial_number, fault_probability);
+
+    // Round trips, timed in simulator time.
+    uint32_t round_trips = 1000;
+    uint32_t failures = 0;
+    uint64_t start_us = lw_grf500_simulator_get_time_us(&simulator);
+    uint64_t host_start_us = lw_platform_get_time_us();
+
+    for (uint32_t i = 0; i < round_trips; ++i) {
+        uint32_t size = 0;
+
+        if (lw_grf500_set_median_filter_size(device, 3 + i % 30) != LW_RESULT_SUCCESS || lw_grf500_get_median_filter_size(device, &size) != LW_RESULT_SUCCESS || size != 3 + i % 30) {
+            failures++;
+        }
+    }
+
+    double round_trip_ms = (double)(lw_grf500_simulator_get_time_us(&simulator) - start_us) / 1000.0 / (2 * round_trips);
+    double host_us = (double)(lw_platform_get_time_us() - host_start_us) / (2 * round_trips);
+    printf("Round trips: %u, failed: %u, %.3f ms device time, %.2f us host time each\n", 2 * round_trips, failures, round_trip_ms, host_us);
+
+    // Save, then reset back to the saved settings. With faults a retried save
+    // or reset can fail, as it carries a token the device has already used.
+    expect_success(lw_grf500_set_update_rate(device, 10), "Failed to set update rate");
+    expect_success(lw_grf500_save_parameters(device), "Failed to save parameters");
+    expect_success(lw_grf500_set_update_rate(device, 1), "Failed to set update rate");
+    expect_success(lw_grf500_reset(device), "Failed to reset");
+
+    float rate = 0;
+    expect_success(lw_grf500_get_update_rate(device, &rate), "Failed to get update rate");
+    printf("Update rate after save and reset: %.1f Hz\n", rate);
+
+    // Streaming throughput at the fastest baud rate.
+    expect_success(lw_grf500_set_baud_rate(device, LW_GRF500_BAUD_RATE_921600), "Failed to set baud rate");
+    expect_success(lw_grf500_set_stream(device, LW_GRF500_STREAM_ID_DISTANCE_DATA), "Failed to set stream: distance");
+
+    uint32_t packets = 0;
+    uint32_t lost = 0;
+    start_us = lw_grf500_simulator_get_time_us(&simulator);
+    host_start_us = lw_platform_get_time_us();
+
+    for (uint32_t i = 0; i < 10000; ++i) {
+        lw_grf500_distance_data_cm distance_data;
+
+        if (lw_grf500_wait_for_streamed_distance_data(device, LW_GRF500_DISTANCE_CONFIG_ALL, &distance_data, 1000) == LW_RESULT_SUCCESS) {
+            packets++;
+            lost += (distance_data.first_return_raw_cm == -1000) ? 1 : 0;
+        }
+    }
+
+    double device_s = (double)(lw_grf500_simulator_get_time_us(&simulator) - start_us) / 1000000.0;
+    double host_s = (double)(lw_platform_get_time_us() - host_start_us) / 1000000.0;
+    printf("Streamed %u packets, %u lost signal, %.0f s device time in %.3f s host time (%.0fx)\n", packets, lost, device_s, host_s, device_s / host_s);
+
+    expect_success(lw_grf500_set_stream(device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    print_stats(&simulator.stats);
+    printf("Failed calls: %u\n\n", failed_calls);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Serve a simulator on a pseudo-terminal until interrupted.
+// ----------------------------------------------------------------------------
+static int run_serve(void) {
+    lw_platform_simulator_pty pty;
+
+    check_success(lw_grf500_simulator_init(&simulator, NULL, 0, NULL, NULL, NULL), "Invalid simulator config");
+    check_success(lw_platform_simulator_pty_open(&pty, &simulator), "Failed to open pseudo-terminal");
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+    printf("%s\n", pty.port_name);
+    fflush(stdout);
+
+    while (running) {
+        if (lw_platform_simulator_pty_poll(&pty, 100) != LW_RESULT_SUCCESS) {
+            break;
+        }
+    }
+
+    lw_platform_simulator_pty_close(&pty);
+    print_stats(&simulator.stats);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Exercise the serial platform layer against a simulator served in a child
+// process, in real time.
+// ----------------------------------------------------------------------------
+static int run_pty(void) {
+    lw_platform_simulator_pty pty;
+
+    check_success(lw_grf500_simulator_init(&simulator, NULL, 0, NULL, NULL, NULL), "Invalid simulator config");
+    check_success(lw_platform_simulator_pty_open(&pty, &simulator), "Failed to open pseudo-terminal");
+
+    pid_t child = fork();
+
+    if (child == 0) {
+        signal(SIGTERM, handle_signal);
+
+        while (running && lw_platform_simulator_pty_poll(&pty, 100) == LW_RESULT_SUCCESS) {
+        }
+
+        _exit(0);
+    }
+
+    lw_platform_serial_device grf500;
+    check_success(lw_platform_create_serial_device(pty.port_name, 115200, &grf500), "Failed to create serial device");
+
+    lw_grf500_product_info product_info;
+    check_success(lw_grf500_get_product_info(&grf500.device, &product_info), "Failed to get product info");
+    printf("Product: %s on %s\n", product_info.product_name, pty.port_name);
+
+    uint64_t start_us = lw_platform_get_time_us();
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        int32_t temperature;
+        check_success(lw_grf500_get_temperature(&grf500.device, &temperature), "Failed to get temperature");
+    }
+
+    printf("Round trip: %.3f ms\n", (double)(lw_platform_get_time_us() - start_us) / 1000.0 / 100);
+
+    check_success(lw_grf500_set_update_rate(&grf500.device, 10), "Failed to set update rate");
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_DISTANCE_DATA), "Failed to set stream: distance");
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        lw_grf500_distance_data_cm distance_data;
+
+        if (lw_grf500_wait_for_streamed_distance_data(&grf500.device, LW_GRF500_DISTANCE_CONFIG_ALL, &distance_data, 1000) == LW_RESULT_SUCCESS) {
+            printf("Streamed distance: %d cm\n", distance_data.first_return_raw_cm);
+        }
+    }
+
+    check_success(lw_grf500_set_stream(&grf500.device, LW_GRF500_STREAM_ID_NONE), "Failed to set stream: none");
+    lw_platform_serial_disconnect(&grf500.serial_port);
+
+    kill(child, SIGTERM);
+    waitpid(child, NULL, 0);
+    lw_platform_simulator_pty_close(&pty);
+
+    return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Application entry point.
+// ----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "serve") == 0) {
+        return run_serve();
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "pty") == 0) {
+        return run_pty();
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "in-process") == 0) {
+        run_in_process(0);
+        return run_in_process((argc >= 3) ? (float)atof(argv[2]) : 0.02f);
+    }
+
+    printf("Usage: %s in-process [fault probability]\n", argv[0]);
+    printf("       %s serve\n", argv[0]);
+    printf("       %s pty\n", argv[0]);
+
+    return 1;
+}
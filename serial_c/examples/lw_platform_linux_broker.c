@@ -0,0 +1,635 @@
+#include "lw_platform_linux_broker.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define LW_BROKER_NO_CLIENT (-1)
+
+// ----------------------------------------------------------------------------
+// Client output.
+// ----------------------------------------------------------------------------
+static void lw_broker_close_client(lw_platform_broker *broker, uint32_t index);
+
+static lw_bool lw_broker_client_queue(lw_broker_client *client, const uint8_t *data, uint32_t size) {
+    if (client->buffer_size + size > LW_BROKER_CLIENT_BUFFER_SIZE) {
+        client->dropped++;
+        return LW_FALSE;
+    }
+
+    memcpy(client->buffer + client->buffer_size, data, size);
+    client->buffer_size += size;
+
+    return LW_TRUE;
+}
+
+static void lw_broker_client_flush(lw_platform_broker *broker, uint32_t index) {
+    lw_broker_client *client = &broker->clients[index];
+
+    if (client->buffer_size == 0) {
+        return;
+    }
+
+    ssize_t sent = send(client->fd, client->buffer, client->buffer_size, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+    if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            lw_broker_close_client(broker, index);
+        }
+
+        return;
+    }
+
+    memmove(client->buffer, client->buffer + sent, client->buffer_size - (uint32_t)sent);
+    client->buffer_size -= (uint32_t)sent;
+}
+
+// ----------------------------------------------------------------------------
+// Request queue.
+// ----------------------------------------------------------------------------
+static lw_broker_request *lw_broker_get_request(lw_platform_broker *broker, uint32_t n) {
+    return &broker->requests[(broker->request_head + n) % LW_BROKER_MAX_REQUESTS];
+}
+
+static lw_bool lw_broker_queue_request(lw_platform_broker *broker, int32_t client, uint8_t command_id, const uint8_t *data, uint32_t data_size) {
+    if (broker->request_count == LW_BROKER_MAX_REQUESTS || data_size > LW_PACKET_SEND_SIZE) {
+        return LW_FALSE;
+    }
+
+    lw_broker_request *request = lw_broker_get_request(broker, broker->request_count);
+    request->client = client;
+    request->command_id = command_id;
+    request->sent_time_ms = 0;
+    memcpy(request->data, data, data_size);
+    request->data_size = data_size;
+    broker->request_count++;
+
+    return LW_TRUE;
+}
+
+// Remove the n-th outstanding request, keeping the order of the others.
+static void lw_broker_remove_request(lw_platform_broker *broker, uint32_t n) {
+    for (uint32_t i = n; i > 0; --i) {
+        *lw_broker_get_request(broker, i) = *lw_broker_get_request(broker, i - 1);
+    }
+
+    broker->request_head = (broker->request_head + 1) % LW_BROKER_MAX_REQUESTS;
+    broker->request_count--;
+    broker->in_flight--;
+}
+
+static void lw_broker_send_requests(lw_platform_broker *broker, uint32_t now_ms) {
+    lw_callback_device *device = &broker->device->device;
+
+    while (broker->in_flight < LW_BROKER_PIPELINE_DEPTH && broker->in_flight < broker->request_count) {
+        lw_broker_request *request = lw_broker_get_request(broker, broker->in_flight);
+
+        if (device->serial_send(device, request->data, request->data_size) == 0) {
+            LW_DEBUG_LVL_1("Broker: Failed to send request %d\n", request->command_id);
+        }
+
+        request->sent_time_ms = now_ms;
+        broker->in_flight++;
+    }
+}
+
+// Clients retry on their own, so an unanswered request is simply dropped.
+static void lw_broker_expire_requests(lw_platform_broker *broker, uint32_t now_ms) {
+    while (broker->in_flight > 0 && now_ms - lw_broker_get_request(broker, 0)->sent_time_ms >= LW_BROKER_REQUEST_TIMEOUT_MS) {
+        LW_DEBUG_LVL_2("Broker: Request %d timed out\n", lw_broker_get_request(broker, 0)->command_id);
+        lw_broker_remove_request(broker, 0);
+        broker->requests_timed_out++;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Streams.
+// ----------------------------------------------------------------------------
+static lw_grf500_stream_id lw_broker_packet_stream(uint8_t command_id) {
+    if (command_id == LW_GRF500_COMMAND_DISTANCE_DATA) {
+        return LW_GRF500_STREAM_ID_DISTANCE_DATA;
+    }
+
+    if (command_id == LW_GRF500_COMMAND_MULTI_DATA) {
+        return LW_GRF500_STREAM_ID_MULTI_DATA;
+    }
+
+    return LW_GRF500_STREAM_ID_NONE;
+}
+
+static void lw_broker_update_stream(lw_platform_broker *broker) {
+    lw_grf500_stream_id stream = LW_GRF500_STREAM_ID_NONE;
+    uint32_t latest_order = 0;
+    lw_request request;
+
+    for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS; ++i) {
+        lw_broker_client *client = &broker->clients[i];
+
+        if (client->fd >= 0 && client->stream != LW_GRF500_STREAM_ID_NONE && client->stream_order >= latest_order) {
+            stream = client->stream;
+            latest_order = client->stream_order;
+        }
+    }
+
+    if (stream == broker->device_stream) {
+        return;
+    }
+
+    LW_DEBUG_LVL_1("Broker: Device stream %d\n", stream);
+    lw_grf500_create_request_write_stream(&request, stream);
+
+    if (lw_broker_queue_request(broker, LW_BROKER_NO_CLIENT, request.command_id, request.data, request.data_size)) {
+        broker->device_stream = stream;
+        broker->latest_size = 0;
+
+        // Reads waiting on the old stream will not be answered, the clients
+        // retry them on the wire.
+        for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS; ++i) {
+            broker->clients[i].stream_read_pending = LW_FALSE;
+        }
+    }
+}
+
+static void lw_broker_fanout(lw_platform_broker *broker) {
+    struct iovec iov[LW_BROKER_FANOUT_PACKETS];
+
+    for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS && broker->fanout_count > 0; ++i) {
+        lw_broker_client *client = &broker->clients[i];
+        uint32_t iov_count = 0;
+        uint32_t total = 0;
+
+        if (client->fd < 0 || client->stream == LW_GRF500_STREAM_ID_NONE) {
+            continue;
+        }
+
+        for (uint32_t p = 0; p < broker->fanout_count; ++p) {
+            lw_broker_packet *packet = &broker->fanout_packets[p];
+
+            if (packet->stream == client->stream) {
+                iov[iov_count].iov_base = broker->fanout_buffer + packet->offset;
+                iov[iov_count].iov_len = packet->size;
+                total += packet->size;
+                iov_count++;
+            }
+        }
+
+        if (iov_count == 0) {
+            continue;
+        }
+
+        // A client that is already behind gets the packets queued in order.
+        if (client->buffer_size > 0) {
+            for (uint32_t n = 0; n < iov_count; ++n) {
+                lw_broker_client_queue(client, (const uint8_t *)iov[n].iov_base, (uint32_t)iov[n].iov_len);
+            }
+
+            continue;
+        }
+
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = iov;
+        message.msg_iovlen = iov_count;
+
+        ssize_t sent = sendmsg(client->fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+        if (sent < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                lw_broker_close_client(broker, i);
+                continue;
+            }
+
+            sent = 0;
+        }
+
+        if ((uint32_t)sent == total) {
+            continue;
+        }
+
+        // Keep the rest for later. The tail of a partly sent packet must go
+        // out to keep the stream in sync, whole packets may be dropped.
+        uint32_t skip = (uint32_t)sent;
+
+        for (uint32_t n = 0; n < iov_count; ++n) {
+            uint32_t size = (uint32_t)iov[n].iov_len;
+
+            if (skip >= size) {
+                skip -= size;
+                continue;
+            }
+
+            lw_broker_client_queue(client, (const uint8_t *)iov[n].iov_base + skip, size - skip);
+            skip = 0;
+        }
+    }
+
+    broker->packets_streamed += broker->fanout_count;
+    broker->fanout_count = 0;
+    broker->fanout_size = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Packet handling.
+// ----------------------------------------------------------------------------
+static void lw_broker_handle_device_packet(lw_platform_broker *broker) {
+    lw_response *response = &broker->device->device.response;
+
+    // A reply to an in-flight request is not a streamed packet, even if the
+    // client that sent the request has gone.
+    for (uint32_t n = 0; n < broker->in_flight; ++n) {
+        lw_broker_request *request = lw_broker_get_request(broker, n);
+
+        if (request->command_id != response->command_id) {
+            continue;
+        }
+
+        if (request->client != LW_BROKER_NO_CLIENT) {
+            lw_broker_client_queue(&broker->clients[request->client], response->data, response->data_size);
+        }
+
+        lw_broker_remove_request(broker, n);
+        broker->requests_served++;
+        return;
+    }
+
+    lw_grf500_stream_id stream = lw_broker_packet_stream(response->command_id);
+
+    if (stream == LW_GRF500_STREAM_ID_NONE) {
+        return;
+    }
+
+    // Clients waiting on a read of the stream take this packet as the reply.
+    // Subscribers to the stream get it with the fanout below.
+    if (stream == broker->device_stream) {
+        memcpy(broker->latest_packet, response->data, response->data_size);
+        broker->latest_size = response->data_size;
+
+        for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS; ++i) {
+            lw_broker_client *client = &broker->clients[i];
+
+            if (client->fd < 0 || !client->stream_read_pending) {
+                continue;
+            }
+
+            if (client->stream != stream) {
+                lw_broker_client_queue(client, response->data, response->data_size);
+            }
+
+            client->stream_read_pending = LW_FALSE;
+            broker->requests_served++;
+        }
+    }
+
+    if (broker->fanout_count == LW_BROKER_FANOUT_PACKETS) {
+        lw_broker_fanout(broker);
+    }
+
+    lw_broker_packet *packet = &broker->fanout_packets[broker->fanout_count++];
+    packet->offset = broker->fanout_size;
+    packet->size = response->data_size;
+    packet->stream = stream;
+    memcpy(broker->fanout_buffer + broker->fanout_size, response->data, response->data_size);
+    broker->fanout_size += response->data_size;
+}
+
+static void lw_broker_handle_client_packet(lw_platform_broker *broker, uint32_t index) {
+    lw_broker_client *client = &broker->clients[index];
+    lw_response *request = &client->request;
+    uint8_t write = request->data[1] & 0x1;
+
+    // A read of the data the device is streaming is answered with the latest
+    // streamed packet, or the next one if none has arrived yet, rather than a
+    // reply that would look just like a streamed packet.
+    if (!write && broker->device_stream != LW_GRF500_STREAM_ID_NONE && lw_broker_packet_stream(request->command_id) == broker->device_stream) {
+        if (broker->latest_size > 0) {
+            lw_broker_client_queue(client, broker->latest_packet, broker->latest_size);
+            broker->requests_served++;
+        } else {
+            client->stream_read_pending = LW_TRUE;
+        }
+
+        return;
+    }
+
+    if (request->command_id != LW_GRF500_COMMAND_STREAM) {
+        if (!lw_broker_queue_request(broker, (int32_t)index, request->command_id, request->data, request->data_size)) {
+            LW_DEBUG_LVL_1("Broker: Request queue full\n");
+        }
+
+        return;
+    }
+
+    // Stream requests are answered by the broker itself.
+    if (write && request->payload_size >= 5) {
+        uint32_t stream = 0;
+        lw_parse_response_uint32(request, &stream, 0);
+
+        if (stream == LW_GRF500_STREAM_ID_DISTANCE_DATA || stream == LW_GRF500_STREAM_ID_MULTI_DATA) {
+            client->stream = (lw_grf500_stream_id)stream;
+        } else {
+            client->stream = LW_GRF500_STREAM_ID_NONE;
+        }
+
+        client->stream_order = ++broker->stream_order;
+        lw_broker_update_stream(broker);
+    }
+
+    uint8_t reply[LW_PACKET_SEND_SIZE];
+    uint32_t stream = (uint32_t)client->stream;
+    uint32_t reply_size = lw_create_packet(reply, LW_GRF500_COMMAND_STREAM, write, (uint8_t *)&stream, sizeof(stream));
+    lw_broker_client_queue(client, reply, reply_size);
+}
+
+// ----------------------------------------------------------------------------
+// Connections.
+// ----------------------------------------------------------------------------
+static void lw_broker_close_client(lw_platform_broker *broker, uint32_t index) {
+    lw_broker_client *client = &broker->clients[index];
+
+    if (client->fd < 0) {
+        return;
+    }
+
+    close(client->fd);
+    client->fd = -1;
+    client->stream = LW_GRF500_STREAM_ID_NONE;
+    client->stream_read_pending = LW_FALSE;
+    client->buffer_size = 0;
+
+    // Responses to this client's requests are still read off the wire, but discarded.
+    for (uint32_t n = 0; n < broker->request_count; ++n) {
+        lw_broker_request *request = lw_broker_get_request(broker, n);
+
+        if (request->client == (int32_t)index) {
+            request->client = LW_BROKER_NO_CLIENT;
+        }
+    }
+
+    LW_DEBUG_LVL_1("Broker: Client %u disconnected\n", index);
+    lw_broker_update_stream(broker);
+}
+
+static void lw_broker_accept(lw_platform_broker *broker) {
+    while (1) {
+        int fd = accept(broker->listen_fd, NULL, NULL);
+
+        if (fd < 0) {
+            return;
+        }
+
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+        uint32_t index = 0;
+
+        while (index < LW_BROKER_MAX_CLIENTS && broker->clients[index].fd >= 0) {
+            index++;
+        }
+
+        if (index == LW_BROKER_MAX_CLIENTS) {
+            LW_DEBUG_LVL_1("Broker: Too many clients\n");
+            close(fd);
+            continue;
+        }
+
+        lw_broker_client *client = &broker->clients[index];
+        memset(client, 0, sizeof(*client));
+        client->fd = fd;
+        client->stream = LW_GRF500_STREAM_ID_NONE;
+        lw_init_response(&client->request);
+
+        LW_DEBUG_LVL_1("Broker: Client %u connected\n", index);
+    }
+}
+
+static void lw_broker_read_client(lw_platform_broker *broker, uint32_t index) {
+    lw_broker_client *client = &broker->clients[index];
+    uint8_t buffer[256];
+
+    while (client->fd >= 0) {
+        ssize_t bytes_read = recv(client->fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+
+        if (bytes_read == 0 || (bytes_read < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            lw_broker_close_client(broker, index);
+            return;
+        }
+
+        if (bytes_read < 0) {
+            return;
+        }
+
+        // Anything that is not a packet, like the serial mode wake up, is ignored.
+        for (ssize_t i = 0; i < bytes_read; ++i) {
+            if (lw_feed_response(&client->request, buffer[i]) == LW_RESULT_SUCCESS) {
+                lw_broker_handle_client_packet(broker, index);
+            }
+        }
+    }
+}
+
+static lw_result lw_broker_read_device(lw_platform_broker *broker) {
+    lw_callback_device *device = &broker->device->device;
+    uint8_t buffer[256];
+
+    while (1) {
+        int32_t bytes_read = device->serial_receive(device, buffer, sizeof(buffer), 0);
+
+        if (bytes_read < 0) {
+            return LW_RESULT_ERROR;
+        }
+
+        if (bytes_read == 0) {
+            return LW_RESULT_SUCCESS;
+        }
+
+        for (int32_t i = 0; i < bytes_read; ++i) {
+            if (lw_feed_response(&device->response, buffer[i]) == LW_RESULT_SUCCESS) {
+                lw_broker_handle_device_packet(broker);
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Broker.
+// ----------------------------------------------------------------------------
+lw_result lw_platform_broker_init(lw_platform_broker *broker, lw_platform_serial_device *device, const char *socket_path) {
+    struct sockaddr_un address;
+
+    memset(broker, 0, sizeof(*broker));
+    broker->device = device;
+    broker->listen_fd = -1;
+    broker->device_stream = LW_GRF500_STREAM_ID_NONE;
+
+    for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS; ++i) {
+        broker->clients[i].fd = -1;
+    }
+
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+    strcpy(broker->socket_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (fd < 0) {
+        return LW_RESULT_ERROR;
+    }
+
+    unlink(socket_path);
+
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(fd, LW_BROKER_MAX_CLIENTS) != 0) {
+        LW_DEBUG_LVL_1("Broker: Failed to listen on %s\n", socket_path);
+        close(fd);
+        return LW_RESULT_ERROR;
+    }
+
+    broker->listen_fd = fd;
+    lw_init_response(&device->device.response);
+
+    // Start from a known state, the device may still be streaming to a previous owner.
+    return lw_grf500_set_stream(&device->device, LW_GRF500_STREAM_ID_NONE);
+}
+
+lw_result lw_platform_broker_poll(lw_platform_broker *broker, uint32_t timeout_ms) {
+    struct pollfd poll_fds[2 + LW_BROKER_MAX_CLIENTS];
+    uint32_t poll_clients[LW_BROKER_MAX_CLIENTS];
+    uint32_t poll_count = 0;
+    uint32_t now_ms = lw_platform_get_time_ms();
+
+    lw_broker_expire_requests(broker, now_ms);
+    lw_broker_send_requests(broker, now_ms);
+
+    if (broker->in_flight > 0) {
+        uint32_t elapsed_ms = now_ms - lw_broker_get_request(broker, 0)->sent_time_ms;
+        uint32_t remaining_ms = (elapsed_ms < LW_BROKER_REQUEST_TIMEOUT_MS) ? LW_BROKER_REQUEST_TIMEOUT_MS - elapsed_ms : 0;
+
+        if (remaining_ms < timeout_ms) {
+            timeout_ms = remaining_ms;
+        }
+    }
+
+    poll_fds[0].fd = broker->listen_fd;
+    poll_fds[0].events = POLLIN;
+    poll_fds[1].fd = broker->device->serial_port;
+    poll_fds[1].events = POLLIN;
+    poll_count = 2;
+
+    for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS; ++i) {
+        if (broker->clients[i].fd < 0) {
+            continue;
+        }
+
+        poll_fds[poll_count].fd = broker->clients[i].fd;
+        poll_fds[poll_count].events = POLLIN | (broker->clients[i].buffer_size > 0 ? POLLOUT : 0);
+        poll_clients[poll_count - 2] = i;
+        poll_count++;
+    }
+
+    for (uint32_t i = 0; i < poll_count; ++i) {
+        poll_fds[i].revents = 0;
+    }
+
+    if (poll(poll_fds, poll_count, (int)timeout_ms) < 0) {
+        return (errno == EINTR) ? LW_RESULT_SUCCESS : LW_RESULT_ERROR;
+    }
+
+    if (poll_fds[1].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+        LW_DEBUG_LVL_1("Broker: Device connection lost\n");
+        return LW_RESULT_ERROR;
+    }
+
+    if (poll_fds[1].revents & POLLIN) {
+        LW_CHECK_SUCCESS(lw_broker_read_device(broker))
+    }
+
+    if (poll_fds[0].revents & POLLIN) {
+        lw_broker_accept(broker);
+    }
+
+    for (uint32_t n = 2; n < poll_count; ++n) {
+        uint32_t index = poll_clients[n - 2];
+
+        if (poll_fds[n].revents & (POLLIN | POLLHUP | POLLERR)) {
+            lw_broker_read_client(broker, index);
+        }
+    }
+
+    lw_broker_fanout(broker);
+
+    for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS; ++i) {
+        if (broker->clients[i].fd >= 0) {
+            lw_broker_client_flush(broker, i);
+        }
+    }
+
+    lw_broker_send_requests(broker, lw_platform_get_time_ms());
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_platform_broker_close(lw_platform_broker *broker) {
+    for (uint32_t i = 0; i < LW_BROKER_MAX_CLIENTS; ++i) {
+        if (broker->clients[i].fd >= 0) {
+            close(broker->clients[i].fd);
+            broker->clients[i].fd = -1;
+        }
+    }
+
+    if (broker->listen_fd >= 0) {
+        close(broker->listen_fd);
+        broker->listen_fd = -1;
+        unlink(broker->socket_path);
+    }
+
+    lw_init_response(&broker->device->device.response);
+    lw_grf500_set_stream(&broker->device->device, LW_GRF500_STREAM_ID_NONE);
+}
+
+// ----------------------------------------------------------------------------
+// Client.
+// ----------------------------------------------------------------------------
+lw_result lw_platform_broker_connect(const char *socket_path, lw_platform_serial_device *platform_device) {
+    struct sockaddr_un address;
+
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd < 0) {
+        return LW_RESULT_ERROR;
+    }
+
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        LW_DEBUG_LVL_1("Broker: Failed to connect to %s\n", socket_path);
+        close(fd);
+        return LW_RESULT_ERROR;
+    }
+
+    // The platform serial callbacks expect a non-blocking descriptor.
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    platform_device->serial_port = fd;
+    platform_device->device = lw_create_callback_device(platform_device,
+                                                        &lw_platform_sleep_callback,
+                                                        &lw_platform_get_time_ms_callback,
+                                                        &lw_platform_serial_send_callback,
+                                                        &lw_platform_serial_receive_callback);
+
+    return LW_RESULT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+#ifndef LW_PLATFORM_LINUX_BROKER_H
+#define LW_PLATFORM_LINUX_BROKER_H
+
+#include "lw_serial_api_grf500.h"
+#include "lw_platform_linux_serial.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Device broker.
+//
+// The broker owns the serial connection to one device and shares it with any
+// number of client processes over a Unix domain stream socket. Clients talk
+// to the broker with the normal binary packet format, so they can use the
+// whole API through a callback device made by lw_platform_broker_connect.
+//
+// Client requests are queued in arrival order and pipelined onto the wire,
+// with up to LW_BROKER_PIPELINE_DEPTH requests outstanding. The device
+// answers in order, so each response goes to the oldest outstanding request
+// with the same command id.
+//
+// Stream writes are not forwarded. Instead they subscribe the client to the
+// distance or multi data stream, and the device is set to the stream of the
+// most recent subscriber, or none once nobody is subscribed. Streamed packets
+// that arrive together are sent to each subscriber with a single sendmsg
+// that gathers them from one shared buffer, with no copy per client. A
+// client that can not keep up has streamed packets queued and then dropped,
+// without holding up the device or other clients.
+//
+// A read reply looks just like a streamed packet of the same command, so a
+// read of the data the device is streaming is not sent to the device. It is
+// answered with the latest streamed packet, or the next one if none has
+// arrived yet, and every streamed packet still goes to the subscribers.
+// ----------------------------------------------------------------------------
+#ifndef LW_BROKER_MAX_CLIENTS
+#define LW_BROKER_MAX_CLIENTS 16
+#endif
+
+#ifndef LW_BROKER_MAX_REQUESTS
+#define LW_BROKER_MAX_REQUESTS 32
+#endif
+
+#define LW_BROKER_PIPELINE_DEPTH 4
+#define LW_BROKER_REQUEST_TIMEOUT_MS 500
+#define LW_BROKER_CLIENT_BUFFER_SIZE 8192
+#define LW_BROKER_FANOUT_PACKETS 64
+#define LW_BROKER_PATH_SIZE 108
+
+typedef struct {
+    int32_t fd;
+    lw_response request;
+    lw_grf500_stream_id stream;
+    uint32_t stream_order;
+    lw_bool stream_read_pending;
+
+    uint8_t buffer[LW_BROKER_CLIENT_BUFFER_SIZE];
+    uint32_t buffer_size;
+    uint32_t dropped;
+} lw_broker_client;
+
+typedef struct {
+    int32_t client;
+    uint8_t command_id;
+    uint32_t sent_time_ms;
+    uint8_t data[LW_PACKET_SEND_SIZE];
+    uint32_t data_size;
+} lw_broker_request;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+    lw_grf500_stream_id stream;
+} lw_broker_packet;
+
+typedef struct {
+    lw_platform_serial_device *device;
+    int32_t listen_fd;
+    char socket_path[LW_BROKER_PATH_SIZE];
+
+    lw_broker_client clients[LW_BROKER_MAX_CLIENTS];
+    uint32_t stream_order;
+    lw_grf500_stream_id device_stream;
+
+    // Latest packet of the device stream, used to answer reads of it.
+    uint8_t latest_packet[LW_PACKET_RECV_SIZE];
+    uint32_t latest_size;
+
+    // Requests in arrival order, the first in_flight of them are on the wire.
+    lw_broker_request requests[LW_BROKER_MAX_REQUESTS];
+    uint32_t request_head;
+    uint32_t request_count;
+    uint32_t in_flight;
+
+    // Streamed packets received in this poll, waiting to be fanned out.
+    uint8_t fanout_buffer[LW_BROKER_FANOUT_PACKETS * LW_PACKET_RECV_SIZE];
+    uint32_t fanout_size;
+    lw_broker_packet fanout_packets[LW_BROKER_FANOUT_PACKETS];
+    uint32_t fanout_count;
+
+    uint64_t requests_served;
+    uint64_t requests_timed_out;
+    uint64_t packets_streamed;
+} lw_platform_broker;
+
+/*
+ * Start a broker for a connected device, listening on a Unix socket. Any
+ * existing socket file at the path is replaced.
+ *
+ * @param broker The broker to initialize.
+ * @param device The device, already connected and in serial mode.
+ * @param socket_path The path of the Unix socket.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_broker_init(lw_platform_broker *broker, lw_platform_serial_device *device, const char *socket_path);
+
+/*
+ * Serve clients and the device for up to timeout_ms.
+ *
+ * @param broker The broker.
+ * @param timeout_ms The longest time to wait for activity.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_ERROR if the device connection is lost.
+ */
+lw_result lw_platform_broker_poll(lw_platform_broker *broker, uint32_t timeout_ms);
+
+/*
+ * Stop the device stream, disconnect all clients and remove the socket.
+ *
+ * @param broker The broker.
+ */
+void lw_platform_broker_close(lw_platform_broker *broker);
+
+/*
+ * Connect to a broker as a client. The callback device works with the whole
+ * API, exactly as if it was connected to the serial port.
+ *
+ * @param socket_path The path of the broker socket.
+ * @param platform_device The client device is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_broker_connect(const char *socket_path, lw_platform_serial_device *platform_device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_PLATFORM_LINUX_BROKER_H
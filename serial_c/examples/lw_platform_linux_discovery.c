@@ -0,0 +1,298 @@
+#include "lw_platform_linux_discovery.h"
+#include "lw_platform_linux_serial.h"
+
+#include <glob.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define LW_DISCOVERY_FOUND_PRODUCT_NAME (1 << 0)
+#define LW_DISCOVERY_FOUND_HARDWARE_VERSION (1 << 1)
+#define LW_DISCOVERY_FOUND_FIRMWARE_VERSION (1 << 2)
+#define LW_DISCOVERY_FOUND_SERIAL_NUMBER (1 << 3)
+#define LW_DISCOVERY_FOUND_ALL (0x0F)
+
+static const uint32_t lw_discovery_default_baud_rates[] = {115200, 921600, 460800, 230400, 57600, 38400, 19200, 9600};
+
+typedef struct {
+    const char *port_name;
+    lw_platform_serial_port serial_port;
+    lw_response response;
+    uint32_t found;
+    uint32_t baud_rate;
+    lw_grf500_product_info product_info;
+} lw_discovery_port;
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static lw_bool lw_discovery_send_probe(lw_discovery_port *port) {
+    static const uint8_t command_ids[] = {
+        LW_GRF500_COMMAND_PRODUCT_NAME,
+        LW_GRF500_COMMAND_HARDWARE_VERSION,
+        LW_GRF500_COMMAND_FIRMWARE_VERSION,
+        LW_GRF500_COMMAND_SERIAL_NUMBER,
+    };
+
+    // Wake up serial mode and pipeline all product info requests in one write.
+    uint8_t buffer[3 + sizeof(command_ids) * LW_PACKET_SEND_SIZE];
+    uint32_t size = 0;
+    lw_request request;
+
+    memcpy(buffer, "UUU", 3);
+    size += 3;
+
+    for (uint32_t i = 0; i < sizeof(command_ids); ++i) {
+        lw_create_request_read(&request, command_ids[i]);
+        memcpy(buffer + size, request.data, request.data_size);
+        size += request.data_size;
+    }
+
+    return lw_platform_serial_write(&port->serial_port, buffer, size) != 0;
+}
+
+static void lw_discovery_handle_response(lw_discovery_port *port) {
+    lw_response *response = &port->response;
+
+    switch (response->command_id) {
+        case LW_GRF500_COMMAND_PRODUCT_NAME: {
+            if (lw_grf500_parse_response_product_name(response, port->product_info.product_name) == LW_RESULT_SUCCESS) {
+                port->found |= LW_DISCOVERY_FOUND_PRODUCT_NAME;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_HARDWARE_VERSION: {
+            if (lw_grf500_parse_response_hardware_version(response, &port->product_info.hardware_version) == LW_RESULT_SUCCESS) {
+                port->found |= LW_DISCOVERY_FOUND_HARDWARE_VERSION;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_FIRMWARE_VERSION: {
+            if (lw_grf500_parse_response_firmware_version(response, &port->product_info.firmware_version) == LW_RESULT_SUCCESS) {
+                port->found |= LW_DISCOVERY_FOUND_FIRMWARE_VERSION;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_SERIAL_NUMBER: {
+            if (lw_grf500_parse_response_serial_number(response, port->product_info.serial_number) == LW_RESULT_SUCCESS) {
+                port->found |= LW_DISCOVERY_FOUND_SERIAL_NUMBER;
+            }
+        } break;
+    }
+}
+
+static void lw_discovery_read_port(lw_discovery_port *port) {
+    uint8_t buffer[256];
+
+    while (1) {
+        int32_t bytes_read = lw_platform_serial_read(&port->serial_port, buffer, sizeof(buffer));
+
+        if (bytes_read < 0) {
+            LW_DEBUG_LVL_1("Discovery: Read failed on %s\n", port->port_name);
+            lw_platform_serial_disconnect(&port->serial_port);
+            return;
+        }
+
+        if (bytes_read == 0) {
+            return;
+        }
+
+        for (int32_t i = 0; i < bytes_read; ++i) {
+            if (lw_feed_response(&port->response, buffer[i]) == LW_RESULT_SUCCESS) {
+                lw_discovery_handle_response(port);
+                lw_init_response(&port->response);
+            }
+        }
+    }
+}
+
+// Time in milliseconds the probe takes on the wire at a baud rate, both ways.
+static uint32_t lw_discovery_wire_time_ms(uint32_t baud_rate) {
+    // Requests plus replies of up to 16 byte strings, 10 bits per byte.
+    uint32_t bytes = 3 + 4 * 6 + 2 * (6 + 16) + 2 * (6 + 4);
+
+    return (bytes * 10 * 1000) / baud_rate + 1;
+}
+
+// ----------------------------------------------------------------------------
+// Discovery.
+// ----------------------------------------------------------------------------
+lw_result lw_platform_list_serial_ports(char port_names[][LW_DISCOVERY_PORT_NAME_SIZE], uint32_t max_ports, uint32_t *port_count) {
+    static const char *patterns[] = {"/dev/ttyUSB*", "/dev/ttyACM*"};
+
+    *port_count = 0;
+
+    for (uint32_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); ++p) {
+        glob_t result;
+
+        if (glob(patterns[p], 0, NULL, &result) != 0) {
+            continue;
+        }
+
+        for (size_t i = 0; i < result.gl_pathc && *port_count < max_ports; ++i) {
+            strncpy(port_names[*port_count], result.gl_pathv[i], LW_DISCOVERY_PORT_NAME_SIZE - 1);
+            port_names[*port_count][LW_DISCOVERY_PORT_NAME_SIZE - 1] = 0;
+            (*port_count)++;
+        }
+
+        globfree(&result);
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_platform_probe_serial_ports(const char *const *port_names, uint32_t port_count, const uint32_t *baud_rates, uint32_t baud_rate_count, uint32_t probe_timeout_ms, lw_platform_discovered_device *devices, uint32_t max_devices, uint32_t *device_count) {
+    lw_discovery_port ports[LW_DISCOVERY_MAX_PORTS];
+    struct pollfd poll_fds[LW_DISCOVERY_MAX_PORTS];
+    uint32_t poll_ports[LW_DISCOVERY_MAX_PORTS];
+
+    *device_count = 0;
+
+    if (port_count > LW_DISCOVERY_MAX_PORTS) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (baud_rates == NULL) {
+        baud_rates = lw_discovery_default_baud_rates;
+        baud_rate_count = sizeof(lw_discovery_default_baud_rates) / sizeof(lw_discovery_default_baud_rates[0]);
+    }
+
+    for (uint32_t b = 0; b < baud_rate_count; ++b) {
+        if (baud_rates[b] == 0) {
+            return LW_RESULT_INVALID_PARAMETER;
+        }
+    }
+
+    for (uint32_t i = 0; i < port_count; ++i) {
+        memset(&ports[i], 0, sizeof(ports[i]));
+        ports[i].port_name = port_names[i];
+        ports[i].serial_port = lw_platform_create_serial_port();
+    }
+
+    uint32_t remaining = port_count;
+
+    for (uint32_t b = 0; b < baud_rate_count && remaining > 0; ++b) {
+        uint32_t baud_rate = baud_rates[b];
+
+        // Open every port that has not answered yet at this baud rate, and
+        // send the probe to all of them before waiting on any.
+        for (uint32_t i = 0; i < port_count; ++i) {
+            lw_discovery_port *port = &ports[i];
+
+            if (port->found & LW_DISCOVERY_FOUND_PRODUCT_NAME) {
+                continue;
+            }
+
+            lw_platform_serial_disconnect(&port->serial_port);
+
+            if (lw_platform_serial_connect(port->port_name, baud_rate, &port->serial_port) != LW_RESULT_SUCCESS) {
+                continue;
+            }
+
+            tcflush(port->serial_port, TCIOFLUSH);
+            lw_init_response(&port->response);
+            port->found = 0;
+
+            if (!lw_discovery_send_probe(port)) {
+                lw_platform_serial_disconnect(&port->serial_port);
+            }
+        }
+
+        uint32_t start_ms = lw_platform_get_time_ms();
+        uint32_t timeout_ms = probe_timeout_ms + lw_discovery_wire_time_ms(baud_rate);
+
+        while (1) {
+            uint32_t poll_count = 0;
+            lw_bool complete = LW_TRUE;
+
+            for (uint32_t i = 0; i < port_count; ++i) {
+                if (ports[i].serial_port < 0 || ports[i].baud_rate != 0) {
+                    continue;
+                }
+
+                if (ports[i].found != LW_DISCOVERY_FOUND_ALL) {
+                    complete = LW_FALSE;
+                }
+
+                poll_fds[poll_count].fd = ports[i].serial_port;
+                poll_fds[poll_count].events = POLLIN;
+                poll_fds[poll_count].revents = 0;
+                poll_ports[poll_count] = i;
+                poll_count++;
+            }
+
+            if (poll_count == 0 || complete) {
+                break;
+            }
+
+            uint32_t elapsed_ms = lw_platform_get_time_ms() - start_ms;
+
+            if (elapsed_ms >= timeout_ms) {
+                break;
+            }
+
+            int32_t wait_ms = (int32_t)(timeout_ms - elapsed_ms);
+
+            if (poll(poll_fds, poll_count, wait_ms) < 0) {
+                break;
+            }
+
+            for (uint32_t n = 0; n < poll_count; ++n) {
+                if (poll_fds[n].revents == 0) {
+                    continue;
+                }
+
+                lw_discovery_port *port = &ports[poll_ports[n]];
+
+                if (poll_fds[n].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                    lw_platform_serial_disconnect(&port->serial_port);
+                    continue;
+                }
+
+                lw_discovery_read_port(port);
+            }
+        }
+
+        for (uint32_t i = 0; i < port_count; ++i) {
+            lw_discovery_port *port = &ports[i];
+
+            if (port->baud_rate == 0 && (port->found & LW_DISCOVERY_FOUND_PRODUCT_NAME)) {
+                LW_DEBUG_LVL_1("Discovery: Found %s on %s at %u baud\n", port->product_info.product_name, port->port_name, baud_rate);
+                port->baud_rate = baud_rate;
+                lw_platform_serial_disconnect(&port->serial_port);
+                remaining--;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < port_count; ++i) {
+        lw_discovery_port *port = &ports[i];
+        lw_platform_serial_disconnect(&port->serial_port);
+
+        if (port->baud_rate != 0 && *device_count < max_devices) {
+            lw_platform_discovered_device *device = &devices[*device_count];
+            strncpy(device->port_name, port->port_name, LW_DISCOVERY_PORT_NAME_SIZE - 1);
+            device->port_name[LW_DISCOVERY_PORT_NAME_SIZE - 1] = 0;
+            device->baud_rate = port->baud_rate;
+            device->product_info = port->product_info;
+            (*device_count)++;
+        }
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_platform_discover_devices(lw_platform_discovered_device *devices, uint32_t max_devices, uint32_t *device_count) {
+    char port_names[LW_DISCOVERY_MAX_PORTS][LW_DISCOVERY_PORT_NAME_SIZE];
+    const char *port_name_list[LW_DISCOVERY_MAX_PORTS];
+    uint32_t port_count = 0;
+
+    LW_CHECK_SUCCESS(lw_platform_list_serial_ports(port_names, LW_DISCOVERY_MAX_PORTS, &port_count))
+
+    for (uint32_t i = 0; i < port_count; ++i) {
+        port_name_list[i] = port_names[i];
+    }
+
+    return lw_platform_probe_serial_ports(port_name_list, port_count, NULL, 0, LW_DISCOVERY_PROBE_TIMEOUT_MS, devices, max_devices, device_count);
+}
@@ -0,0 +1,69 @@
+#ifndef LW_PLATFORM_LINUX_DISCOVERY_H
+#define LW_PLATFORM_LINUX_DISCOVERY_H
+
+#include "lw_serial_api_grf500.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Device discovery.
+//
+// All candidate ports are opened at once and probed concurrently. For every
+// baud rate in the sweep, each port that has not answered yet is sent the
+// serial mode wake up and pipelined product info requests, then all ports are
+// waited on together with a short timeout. A miss costs one probe timeout per
+// baud rate for all ports together, instead of the full retry budget of the
+// managed API per port.
+// ----------------------------------------------------------------------------
+#define LW_DISCOVERY_MAX_PORTS 64
+#define LW_DISCOVERY_PORT_NAME_SIZE 64
+#define LW_DISCOVERY_PROBE_TIMEOUT_MS 40
+
+typedef struct {
+    char port_name[LW_DISCOVERY_PORT_NAME_SIZE];
+    uint32_t baud_rate;
+    lw_grf500_product_info product_info;
+} lw_platform_discovered_device;
+
+/*
+ * List the serial ports that may have a device attached, /dev/ttyUSB* and /dev/ttyACM*.
+ *
+ * @param port_names The port names are written here.
+ * @param max_ports The number of entries in port_names.
+ * @param port_count The number of ports found is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_list_serial_ports(char port_names[][LW_DISCOVERY_PORT_NAME_SIZE], uint32_t max_ports, uint32_t *port_count);
+
+/*
+ * Probe a set of serial ports concurrently across a sweep of baud rates.
+ *
+ * @param port_names The ports to probe.
+ * @param port_count The number of ports to probe.
+ * @param baud_rates The baud rates to try, in order, none of them 0. NULL to use the default sweep.
+ * @param baud_rate_count The number of baud rates.
+ * @param probe_timeout_ms Time to wait for replies at each baud rate, on top of the time the bytes take on the wire.
+ * @param devices The devices that answered are written here.
+ * @param max_devices The number of entries in devices.
+ * @param device_count The number of devices found is written here.
+ * @return LW_RESULT_SUCCESS on success, LW_RESULT_INVALID_PARAMETER for too many ports or a baud rate of 0, or an error code on failure.
+ */
+lw_result lw_platform_probe_serial_ports(const char *const *port_names, uint32_t port_count, const uint32_t *baud_rates, uint32_t baud_rate_count, uint32_t probe_timeout_ms, lw_platform_discovered_device *devices, uint32_t max_devices, uint32_t *device_count);
+
+/*
+ * Find every attached device on all candidate serial ports, using the default baud rate sweep.
+ *
+ * @param devices The devices that answered are written here.
+ * @param max_devices The number of entries in devices.
+ * @param device_count The number of devices found is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_discover_devices(lw_platform_discovered_device *devices, uint32_t max_devices, uint32_t *device_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_PLATFORM_LINUX_DISCOVERY_H
@@ -0,0 +1,621 @@
+#include "lw_platform_linux_registry.h"
+
+#include <linux/netlink.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Kernel uevent multicast group, as opposed to the group udev re-broadcasts on.
+#define LW_REGISTRY_UEVENT_GROUP_KERNEL 1
+
+// ----------------------------------------------------------------------------
+// Device service callbacks.
+// ----------------------------------------------------------------------------
+static void lw_registry_disconnect(lw_registry_device *device) {
+    if (!device->connected) {
+        return;
+    }
+
+    LW_DEBUG_LVL_1("Registry: %s disconnected from %s\n", device->product_info.serial_number, device->port_name);
+
+    lw_platform_serial_disconnect(&device->serial_port);
+    device->connected = LW_FALSE;
+    device->disconnects++;
+    device->disconnect_time_ms = lw_platform_get_time_ms();
+}
+
+static uint32_t lw_registry_get_time_ms_callback(lw_callback_device *device) {
+    (void)device;
+    return lw_platform_get_time_ms();
+}
+
+static void lw_registry_sleep_callback(lw_callback_device *device, uint32_t time_ms) {
+    (void)device;
+    lw_platform_sleep(time_ms);
+}
+
+static uint32_t lw_registry_serial_send_callback(lw_callback_device *device, uint8_t *buffer, uint32_t size) {
+    lw_registry_device *registry_device = (lw_registry_device *)device->user_data;
+
+    if (!registry_device->connected) {
+        return 0;
+    }
+
+    uint32_t bytes_written = lw_platform_serial_write(&registry_device->serial_port, buffer, size);
+
+    if (bytes_written == 0) {
+        lw_registry_disconnect(registry_device);
+    }
+
+    return bytes_written;
+}
+
+static int32_t lw_registry_serial_receive_callback(lw_callback_device *device, uint8_t *buffer, uint32_t size, uint32_t timeout_ms) {
+    lw_registry_device *registry_device = (lw_registry_device *)device->user_data;
+    (void)timeout_ms;
+
+    if (!registry_device->connected) {
+        return 0;
+    }
+
+    int32_t bytes_read = lw_platform_serial_read(&registry_device->serial_port, buffer, size);
+
+    // The port has gone away. Report no data and let the registry bring the
+    // device back, rather than failing the caller.
+    if (bytes_read < 0) {
+        lw_registry_disconnect(registry_device);
+        return 0;
+    }
+
+    return bytes_read;
+}
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static lw_bool lw_registry_is_serial_port(const char *name) {
+    return strncmp(name, "ttyUSB", 6) == 0 || strncmp(name, "ttyACM", 6) == 0;
+}
+
+static lw_registry_device *lw_registry_find_connected_port(lw_platform_registry *registry, const char *port_name) {
+    for (uint32_t i = 0; i < registry->device_count; ++i) {
+        lw_registry_device *device = &registry->devices[i];
+
+        if (device->connected && strcmp(device->port_name, port_name) == 0) {
+            return device;
+        }
+    }
+
+    return NULL;
+}
+
+static lw_bool lw_registry_any_disconnected(lw_platform_registry *registry) {
+    for (uint32_t i = 0; i < registry->device_count; ++i) {
+        if (!registry->devices[i].connected) {
+            return LW_TRUE;
+        }
+    }
+
+    return LW_FALSE;
+}
+
+static void lw_registry_add_candidate(lw_platform_registry *registry, const char *port_name) {
+    uint32_t now_ms = lw_platform_get_time_ms();
+
+    for (uint32_t i = 0; i < registry->candidate_count; ++i) {
+        if (strcmp(registry->candidates[i].port_name, port_name) == 0) {
+            return;
+        }
+    }
+
+    if (registry->candidate_count >= LW_REGISTRY_MAX_CANDIDATES) {
+        LW_DEBUG_LVL_1("Registry: Candidate list full, %s not probed\n", port_name);
+        registry->dropped_candidates++;
+        return;
+    }
+
+    lw_registry_candidate *candidate = &registry->candidates[registry->candidate_count++];
+    snprintf(candidate->port_name, sizeof(candidate->port_name), "%s", port_name);
+    candidate->time_ms = now_ms;
+
+    if (!registry->rescan_pending) {
+        registry->rescan_pending = LW_TRUE;
+        registry->rescan_time_ms = now_ms + LW_REGISTRY_SETTLE_TIME_MS;
+    }
+}
+
+// Queue every present port that is not in use for probing.
+static lw_result lw_registry_add_present_ports(lw_platform_registry *registry) {
+    char port_names[LW_DISCOVERY_MAX_PORTS][LW_DISCOVERY_PORT_NAME_SIZE];
+    uint32_t port_count = 0;
+
+    LW_CHECK_SUCCESS(lw_platform_list_serial_ports(port_names, LW_DISCOVERY_MAX_PORTS, &port_count))
+
+    if (port_count == LW_DISCOVERY_MAX_PORTS) {
+        LW_DEBUG_LVL_1("Registry: Port list full at %d ports, more may not be probed\n", LW_DISCOVERY_MAX_PORTS);
+    }
+
+    for (uint32_t i = 0; i < port_count; ++i) {
+        if (!lw_registry_find_connected_port(registry, port_names[i])) {
+            lw_registry_add_candidate(registry, port_names[i]);
+        }
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+// Devices that dropped without a hot-plug event are only found again by
+// probing the ports that are already there, with a doubling backoff.
+static void lw_registry_update_retry(lw_platform_registry *registry, uint32_t now_ms) {
+    if (!lw_registry_any_disconnected(registry)) {
+        registry->retry_pending = LW_FALSE;
+        registry->retry_interval_ms = LW_REGISTRY_RETRY_MIN_MS;
+        return;
+    }
+
+    if (!registry->retry_pending) {
+        registry->retry_pending = LW_TRUE;
+        registry->retry_time_ms = now_ms + registry->retry_interval_ms;
+        return;
+    }
+
+    if ((int32_t)(now_ms - registry->retry_time_ms) < 0) {
+        return;
+    }
+
+    lw_registry_add_present_ports(registry);
+
+    registry->retry_interval_ms *= 2;
+
+    if (registry->retry_interval_ms > LW_REGISTRY_RETRY_MAX_MS) {
+        registry->retry_interval_ms = LW_REGISTRY_RETRY_MAX_MS;
+    }
+
+    registry->retry_time_ms = now_ms + registry->retry_interval_ms;
+}
+
+static void lw_registry_port_added(lw_platform_registry *registry, const char *port_name, lw_bool created) {
+    lw_registry_device *device = lw_registry_find_connected_port(registry, port_name);
+
+    if (device) {
+        // A node that is created again under the name of a connected port
+        // means the old descriptor is stale, even if no read has failed yet.
+        if (!created) {
+            return;
+        }
+
+        lw_registry_disconnect(device);
+    }
+
+    lw_registry_add_candidate(registry, port_name);
+}
+
+static void lw_registry_port_removed(lw_platform_registry *registry, const char *port_name) {
+    lw_registry_device *device = lw_registry_find_connected_port(registry, port_name);
+
+    if (device) {
+        lw_registry_disconnect(device);
+    }
+}
+
+static lw_result lw_registry_restore(lw_registry_device *device) {
+    if (device->distance_config_set) {
+        LW_CHECK_SUCCESS(lw_grf500_set_distance_config(&device->device, device->distance_config))
+    }
+
+    if (device->update_rate_set) {
+        LW_CHECK_SUCCESS(lw_grf500_set_update_rate(&device->device, device->update_rate))
+    }
+
+    if (device->stream != LW_GRF500_STREAM_ID_NONE) {
+        LW_CHECK_SUCCESS(lw_grf500_set_stream(&device->device, device->stream))
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+static lw_result lw_registry_connect(lw_registry_device *device, const char *port_name) {
+    LW_CHECK_SUCCESS(lw_platform_serial_connect(port_name, device->baud_rate, &device->serial_port))
+
+    tcflush(device->serial_port, TCIOFLUSH);
+    lw_init_response(&device->device.response);
+
+    strncpy(device->port_name, port_name, LW_DISCOVERY_PORT_NAME_SIZE - 1);
+    device->port_name[LW_DISCOVERY_PORT_NAME_SIZE - 1] = 0;
+    device->connected = LW_TRUE;
+
+    if (lw_registry_restore(device) != LW_RESULT_SUCCESS) {
+        LW_DEBUG_LVL_1("Registry: Failed to restore state of %s\n", device->product_info.serial_number);
+        lw_registry_disconnect(device);
+        return LW_RESULT_ERROR;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+static void lw_registry_rescan(lw_platform_registry *registry, uint32_t now_ms, uint32_t *reconnected) {
+    registry->rescan_pending = LW_FALSE;
+
+    if (!lw_registry_any_disconnected(registry)) {
+        registry->candidate_count = 0;
+        return;
+    }
+
+    // Take the candidates that are ready to be opened. The rest are kept
+    // until udev has given them their final permissions, or they time out.
+    char probe_names[LW_REGISTRY_MAX_CANDIDATES][LW_DISCOVERY_PORT_NAME_SIZE];
+    const char *probe_list[LW_REGISTRY_MAX_CANDIDATES];
+    uint32_t probe_count = 0;
+    uint32_t kept = 0;
+
+    for (uint32_t i = 0; i < registry->candidate_count; ++i) {
+        lw_registry_candidate *candidate = &registry->candidates[i];
+        uint32_t age_ms = now_ms - candidate->time_ms;
+
+        if (age_ms >= LW_REGISTRY_SETTLE_TIME_MS && access(candidate->port_name, R_OK | W_OK) == 0) {
+            memcpy(probe_names[probe_count], candidate->port_name, LW_DISCOVERY_PORT_NAME_SIZE);
+            probe_list[probe_count] = probe_names[probe_count];
+            probe_count++;
+        } else if (age_ms < LW_REGISTRY_CANDIDATE_TIMEOUT_MS) {
+            registry->candidates[kept++] = *candidate;
+        }
+    }
+
+    registry->candidate_count = kept;
+
+    if (kept > 0) {
+        registry->rescan_pending = LW_TRUE;
+        registry->rescan_time_ms = now_ms + LW_REGISTRY_SETTLE_TIME_MS;
+    }
+
+    if (probe_count == 0) {
+        return;
+    }
+
+    // A device keeps its baud rate across a replug, so only the baud rates of
+    // the missing devices need to be tried.
+    uint32_t baud_rates[LW_REGISTRY_MAX_DEVICES];
+    uint32_t baud_rate_count = 0;
+
+    for (uint32_t i = 0; i < registry->device_count; ++i) {
+        lw_registry_device *device = &registry->devices[i];
+        lw_bool known = LW_FALSE;
+
+        if (device->connected) {
+            continue;
+        }
+
+        for (uint32_t b = 0; b < baud_rate_count; ++b) {
+            if (baud_rates[b] == device->baud_rate) {
+                known = LW_TRUE;
+            }
+        }
+
+        if (!known) {
+            baud_rates[baud_rate_count++] = device->baud_rate;
+        }
+    }
+
+    lw_platform_discovered_device found[LW_REGISTRY_MAX_CANDIDATES];
+    uint32_t found_count = 0;
+
+    if (lw_platform_probe_serial_ports(probe_list, probe_count, baud_rates, baud_rate_count, LW_DISCOVERY_PROBE_TIMEOUT_MS, found, LW_REGISTRY_MAX_CANDIDATES, &found_count) != LW_RESULT_SUCCESS) {
+        return;
+    }
+
+    for (uint32_t f = 0; f < found_count; ++f) {
+        for (uint32_t i = 0; i < registry->device_count; ++i) {
+            lw_registry_device *device = &registry->devices[i];
+
+            if (device->connected || strcmp(device->product_info.serial_number, found[f].product_info.serial_number) != 0) {
+                continue;
+            }
+
+            device->product_info = found[f].product_info;
+
+            if (lw_registry_connect(device, found[f].port_name) == LW_RESULT_SUCCESS) {
+                LW_DEBUG_LVL_1("Registry: %s reconnected on %s\n", device->product_info.serial_number, device->port_name);
+                device->reconnects++;
+                device->reconnect_time_ms = lw_platform_get_time_ms();
+
+                if (reconnected) {
+                    (*reconnected)++;
+                }
+            }
+
+            break;
+        }
+    }
+}
+
+static uint32_t lw_registry_limit_timeout(uint32_t due_ms, uint32_t timeout_ms) {
+    int32_t until_due_ms = (int32_t)(due_ms - lw_platform_get_time_ms());
+
+    if (until_due_ms < 0) {
+        return 0;
+    }
+
+    return ((uint32_t)until_due_ms < timeout_ms) ? (uint32_t)until_due_ms : timeout_ms;
+}
+
+static void lw_registry_read_inotify(lw_platform_registry *registry) {
+    uint8_t buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    while (1) {
+        ssize_t size = read(registry->inotify_fd, buffer, sizeof(buffer));
+
+        if (size <= 0) {
+            return;
+        }
+
+        for (ssize_t offset = 0; offset < size;) {
+            struct inotify_event *event = (struct inotify_event *)(buffer + offset);
+            offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+
+            if (event->len == 0 || !lw_registry_is_serial_port(event->name)) {
+                continue;
+            }
+
+            char port_name[LW_DISCOVERY_PORT_NAME_SIZE];
+            snprintf(port_name, sizeof(port_name), "/dev/%s", event->name);
+
+            if (event->mask & IN_DELETE) {
+                lw_registry_port_removed(registry, port_name);
+            } else if (event->mask & (IN_CREATE | IN_ATTRIB)) {
+                lw_registry_port_added(registry, port_name, (event->mask & IN_CREATE) != 0);
+            }
+        }
+    }
+}
+
+static void lw_registry_read_uevent(lw_platform_registry *registry) {
+    char buffer[4096];
+
+    while (1) {
+        ssize_t size = recv(registry->uevent_fd, buffer, sizeof(buffer) - 1, 0);
+
+        if (size <= 0) {
+            return;
+        }
+
+        buffer[size] = 0;
+
+        // The message is a header followed by NUL separated KEY=VALUE pairs.
+        const char *action = NULL;
+        const char *subsystem = NULL;
+        const char *devname = NULL;
+
+        for (ssize_t offset = 0; offset < size; offset += (ssize_t)strlen(buffer + offset) + 1) {
+            const char *field = buffer + offset;
+
+            if (strncmp(field, "ACTION=", 7) == 0) {
+                action = field + 7;
+            } else if (strncmp(field, "SUBSYSTEM=", 10) == 0) {
+                subsystem = field + 10;
+            } else if (strncmp(field, "DEVNAME=", 8) == 0) {
+                devname = field + 8;
+            }
+        }
+
+        if (!action || !subsystem || !devname || strcmp(subsystem, "tty") != 0 || !lw_registry_is_serial_port(devname)) {
+            continue;
+        }
+
+        char port_name[LW_DISCOVERY_PORT_NAME_SIZE];
+        snprintf(port_name, sizeof(port_name), "/dev/%s", devname);
+
+        if (strcmp(action, "add") == 0) {
+            lw_registry_port_added(registry, port_name, LW_TRUE);
+        } else if (strcmp(action, "remove") == 0) {
+            lw_registry_port_removed(registry, port_name);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Registry.
+// ----------------------------------------------------------------------------
+lw_result lw_platform_registry_init(lw_platform_registry *registry) {
+    memset(registry, 0, sizeof(*registry));
+    registry->uevent_fd = -1;
+    registry->retry_interval_ms = LW_REGISTRY_RETRY_MIN_MS;
+
+    registry->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (registry->inotify_fd < 0) {
+        LW_DEBUG_LVL_1("Registry: Failed to create inotify instance.\n");
+        return LW_RESULT_ERROR;
+    }
+
+    if (inotify_add_watch(registry->inotify_fd, "/dev", IN_CREATE | IN_DELETE | IN_ATTRIB) < 0) {
+        LW_DEBUG_LVL_1("Registry: Failed to watch /dev.\n");
+        close(registry->inotify_fd);
+        registry->inotify_fd = -1;
+        return LW_RESULT_ERROR;
+    }
+
+    // The uevent socket is optional. It reports removal before the node is
+    // gone, but it is not available in every container or sandbox.
+    int32_t uevent_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+
+    if (uevent_fd >= 0) {
+        struct sockaddr_nl address;
+        memset(&address, 0, sizeof(address));
+        address.nl_family = AF_NETLINK;
+        address.nl_groups = LW_REGISTRY_UEVENT_GROUP_KERNEL;
+
+        if (bind(uevent_fd, (struct sockaddr *)&address, sizeof(address)) == 0) {
+            registry->uevent_fd = uevent_fd;
+        } else {
+            LW_DEBUG_LVL_1("Registry: uevent socket not available, using inotify only.\n");
+            close(uevent_fd);
+        }
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_platform_registry_close(lw_platform_registry *registry) {
+    for (uint32_t i = 0; i < registry->device_count; ++i) {
+        lw_platform_serial_disconnect(&registry->devices[i].serial_port);
+        registry->devices[i].connected = LW_FALSE;
+    }
+
+    if (registry->inotify_fd >= 0) {
+        close(registry->inotify_fd);
+        registry->inotify_fd = -1;
+    }
+
+    if (registry->uevent_fd >= 0) {
+        close(registry->uevent_fd);
+        registry->uevent_fd = -1;
+    }
+}
+
+lw_result lw_platform_registry_add_device(lw_platform_registry *registry, const lw_platform_discovered_device *discovered, uint32_t *index) {
+    if (registry->device_count >= LW_REGISTRY_MAX_DEVICES || discovered->product_info.serial_number[0] == 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_registry_device *device = &registry->devices[registry->device_count];
+    memset(device, 0, sizeof(*device));
+    device->serial_port = lw_platform_create_serial_port();
+    device->baud_rate = discovered->baud_rate;
+    device->product_info = discovered->product_info;
+    device->stream = LW_GRF500_STREAM_ID_NONE;
+    device->device = lw_create_callback_device(device,
+                                               &lw_registry_sleep_callback,
+                                               &lw_registry_get_time_ms_callback,
+                                               &lw_registry_serial_send_callback,
+                                               &lw_registry_serial_receive_callback);
+
+    if (index) {
+        *index = registry->device_count;
+    }
+
+    registry->device_count++;
+
+    if (discovered->port_name[0] == 0 || lw_registry_connect(device, discovered->port_name) != LW_RESULT_SUCCESS) {
+        // Not attached right now, look for it on the ports that exist.
+        device->disconnect_time_ms = lw_platform_get_time_ms();
+        LW_CHECK_SUCCESS(lw_registry_add_present_ports(registry))
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_callback_device *lw_platform_registry_get_device(lw_platform_registry *registry, uint32_t index) {
+    if (index >= registry->device_count) {
+        return NULL;
+    }
+
+    return &registry->devices[index].device;
+}
+
+lw_bool lw_platform_registry_is_connected(lw_platform_registry *registry, uint32_t index) {
+    if (index >= registry->device_count) {
+        return LW_FALSE;
+    }
+
+    return registry->devices[index].connected;
+}
+
+lw_result lw_platform_registry_set_distance_config(lw_platform_registry *registry, uint32_t index, lw_grf500_distance_config config) {
+    if (index >= registry->device_count) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_registry_device *device = &registry->devices[index];
+    device->distance_config_set = LW_TRUE;
+    device->distance_config = config;
+
+    if (!device->connected) {
+        return LW_RESULT_ERROR;
+    }
+
+    return lw_grf500_set_distance_config(&device->device, config);
+}
+
+lw_result lw_platform_registry_set_update_rate(lw_platform_registry *registry, uint32_t index, float rate) {
+    if (index >= registry->device_count) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_registry_device *device = &registry->devices[index];
+    device->update_rate_set = LW_TRUE;
+    device->update_rate = rate;
+
+    if (!device->connected) {
+        return LW_RESULT_ERROR;
+    }
+
+    return lw_grf500_set_update_rate(&device->device, rate);
+}
+
+lw_result lw_platform_registry_set_stream(lw_platform_registry *registry, uint32_t index, lw_grf500_stream_id stream) {
+    if (index >= registry->device_count) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_registry_device *device = &registry->devices[index];
+    device->stream = stream;
+
+    if (!device->connected) {
+        return LW_RESULT_ERROR;
+    }
+
+    return lw_grf500_set_stream(&device->device, stream);
+}
+
+lw_result lw_platform_registry_poll(lw_platform_registry *registry, uint32_t timeout_ms, uint32_t *reconnected) {
+    struct pollfd poll_fds[2];
+    uint32_t poll_count = 0;
+
+    if (reconnected) {
+        *reconnected = 0;
+    }
+
+    if (registry->rescan_pending) {
+        timeout_ms = lw_registry_limit_timeout(registry->rescan_time_ms, timeout_ms);
+    }
+
+    if (registry->retry_pending) {
+        timeout_ms = lw_registry_limit_timeout(registry->retry_time_ms, timeout_ms);
+    }
+
+    poll_fds[poll_count].fd = registry->inotify_fd;
+    poll_fds[poll_count].events = POLLIN;
+    poll_fds[poll_count].revents = 0;
+    poll_count++;
+
+    if (registry->uevent_fd >= 0) {
+        poll_fds[poll_count].fd = registry->uevent_fd;
+        poll_fds[poll_count].events = POLLIN;
+        poll_fds[poll_count].revents = 0;
+        poll_count++;
+    }
+
+    if (poll(poll_fds, poll_count, (int)timeout_ms) < 0) {
+        return LW_RESULT_ERROR;
+    }
+
+    lw_registry_read_inotify(registry);
+
+    if (registry->uevent_fd >= 0) {
+        lw_registry_read_uevent(registry);
+    }
+
+    uint32_t now_ms = lw_platform_get_time_ms();
+
+    if (registry->rescan_pending && (int32_t)(now_ms - registry->rescan_time_ms) >= 0) {
+        lw_registry_rescan(registry, now_ms, reconnected);
+    }
+
+    lw_registry_update_retry(registry, now_ms);
+
+    return LW_RESULT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+#ifndef LW_PLATFORM_LINUX_REGISTRY_H
+#define LW_PLATFORM_LINUX_REGISTRY_H
+
+#include "lw_platform_linux_discovery.h"
+#include "lw_platform_linux_serial.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Hot-plug aware device registry.
+//
+// The registry owns the serial connections of a set of devices, identified by
+// their serial numbers. It watches /dev with inotify, and the kernel uevent
+// netlink socket when it is available, for serial ports that appear and
+// disappear. When a device is unplugged its connection is dropped, and when a
+// new ttyUSB or ttyACM node shows up it is probed and matched by serial number
+// to a disconnected device, which is then reconnected.
+//
+// Distance config, update rate and stream set through the registry are
+// remembered and restored on the device after it is reconnected.
+//
+// A device can also drop without any hot-plug event, for example when a read
+// fails on a wedged adapter or the sensor is power cycled behind a hub. While
+// any device is disconnected the present ports are probed again after a
+// backoff that doubles from LW_REGISTRY_RETRY_MIN_MS to LW_REGISTRY_RETRY_MAX_MS.
+//
+// The callback device of a registry device stays valid across reconnects.
+// While disconnected, receive reports no data instead of a lost connection,
+// so streaming loops simply see timeouts until the device returns.
+// ----------------------------------------------------------------------------
+#ifndef LW_REGISTRY_MAX_DEVICES
+#define LW_REGISTRY_MAX_DEVICES 16
+#endif
+
+// Ports waiting to be probed. Ports beyond this are dropped and counted.
+#ifndef LW_REGISTRY_MAX_CANDIDATES
+#define LW_REGISTRY_MAX_CANDIDATES LW_DISCOVERY_MAX_PORTS
+#endif
+
+#if LW_REGISTRY_MAX_CANDIDATES > LW_DISCOVERY_MAX_PORTS
+#error "LW_REGISTRY_MAX_CANDIDATES must not exceed LW_DISCOVERY_MAX_PORTS"
+#endif
+
+// Time to wait after a port appears before probing it, so udev can finish
+// setting up the node.
+#define LW_REGISTRY_SETTLE_TIME_MS 50
+
+// Time a new port that can not be opened yet keeps being retried.
+#define LW_REGISTRY_CANDIDATE_TIMEOUT_MS 2000
+
+// Backoff between probes of the present ports while a device is disconnected.
+#define LW_REGISTRY_RETRY_MIN_MS 500
+#define LW_REGISTRY_RETRY_MAX_MS 8000
+
+typedef struct {
+    lw_callback_device device;
+    lw_platform_serial_port serial_port;
+    lw_bool connected;
+
+    char port_name[LW_DISCOVERY_PORT_NAME_SIZE];
+    uint32_t baud_rate;
+    lw_grf500_product_info product_info;
+
+    // Last known state, restored on reconnect.
+    lw_bool distance_config_set;
+    lw_grf500_distance_config distance_config;
+    lw_bool update_rate_set;
+    float update_rate;
+    lw_grf500_stream_id stream;
+
+    uint32_t disconnects;
+    uint32_t reconnects;
+    uint32_t disconnect_time_ms;
+    uint32_t reconnect_time_ms;
+} lw_registry_device;
+
+typedef struct {
+    char port_name[LW_DISCOVERY_PORT_NAME_SIZE];
+    uint32_t time_ms;
+} lw_registry_candidate;
+
+typedef struct {
+    int32_t inotify_fd;
+    int32_t uevent_fd;
+
+    uint32_t device_count;
+    lw_registry_device devices[LW_REGISTRY_MAX_DEVICES];
+
+    uint32_t candidate_count;
+    lw_registry_candidate candidates[LW_REGISTRY_MAX_CANDIDATES];
+    lw_bool rescan_pending;
+    uint32_t rescan_time_ms;
+    uint32_t dropped_candidates;
+
+    lw_bool retry_pending;
+    uint32_t retry_time_ms;
+    uint32_t retry_interval_ms;
+} lw_platform_registry;
+
+/*
+ * Initialize a registry and start watching for serial ports.
+ *
+ * @param registry The registry to initialize. It must not be moved after this call.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_registry_init(lw_platform_registry *registry);
+
+/*
+ * Stop watching for serial ports and close all device connections.
+ *
+ * @param registry The registry.
+ */
+void lw_platform_registry_close(lw_platform_registry *registry);
+
+/*
+ * Add a device to the registry. If the device has a port name it is connected
+ * straight away, otherwise it is connected when its serial number is found on
+ * a new port.
+ *
+ * @param registry The registry.
+ * @param discovered The device, as found by lw_platform_discover_devices. Only the serial number, baud rate and port name are required.
+ * @param index The index of the device in the registry is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_registry_add_device(lw_platform_registry *registry, const lw_platform_discovered_device *discovered, uint32_t *index);
+
+/*
+ * Get the callback device of a registry device. The callback device stays
+ * valid across disconnects and reconnects.
+ *
+ * @param registry The registry.
+ * @param index The index of the device.
+ * @return The callback device, or NULL if the index is out of range.
+ */
+lw_callback_device *lw_platform_registry_get_device(lw_platform_registry *registry, uint32_t index);
+
+/*
+ * Check if a registry device is currently connected.
+ *
+ * @param registry The registry.
+ * @param index The index of the device.
+ * @return LW_TRUE if connected.
+ */
+lw_bool lw_platform_registry_is_connected(lw_platform_registry *registry, uint32_t index);
+
+/*
+ * Set the distance config on a device and remember it for reconnects.
+ *
+ * @param registry The registry.
+ * @param index The index of the device.
+ * @param config The distance configuration flags.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure. The config is remembered even if the device is disconnected.
+ */
+lw_result lw_platform_registry_set_distance_config(lw_platform_registry *registry, uint32_t index, lw_grf500_distance_config config);
+
+/*
+ * Set the update rate on a device and remember it for reconnects.
+ *
+ * @param registry The registry.
+ * @param index The index of the device.
+ * @param rate The update rate in Hz.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure. The rate is remembered even if the device is disconnected.
+ */
+lw_result lw_platform_registry_set_update_rate(lw_platform_registry *registry, uint32_t index, float rate);
+
+/*
+ * Set the stream on a device and remember it for reconnects.
+ *
+ * @param registry The registry.
+ * @param index The index of the device.
+ * @param stream The stream to set.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure. The stream is remembered even if the device is disconnected.
+ */
+lw_result lw_platform_registry_set_stream(lw_platform_registry *registry, uint32_t index, lw_grf500_stream_id stream);
+
+/*
+ * Process hot-plug events and reconnect devices that have reappeared. Call
+ * this regularly, or when one of the registry file descriptors is readable.
+ *
+ * @param registry The registry.
+ * @param timeout_ms The time to wait for events, or 0 for non-blocking.
+ * @param reconnected The number of devices reconnected is written here, can be NULL.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_registry_poll(lw_platform_registry *registry, uint32_t timeout_ms, uint32_t *reconnected);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_PLATFORM_LINUX_REGISTRY_H
@@ -12,6 +12,18 @@
 // ----------------------------------------------------------------------------
 uint32_t convert_baud_rate(uint32_t baud_rate) {
     switch (baud_rate) {
+        case 9600: {
+            return B9600;
+        }
+        case 19200: {
+            return B19200;
+        }
+        case 38400: {
+            return B38400;
+        }
+        case 57600: {
+            return B57600;
+        }
         case 115200: {
             return B115200;
         }
@@ -58,6 +70,7 @@ lw_result lw_platform_serial_connect(const char *port_name, uint32_t baud_rate,
     memset(&tty, 0, sizeof(tty));
     if (tcgetattr(descriptor, &tty) != 0) {
         LW_DEBUG_LVL_1("Serial Connect: Failed to get attribute.\n");
+        close(descriptor);
         return LW_RESULT_ERROR;
     }
 
@@ -80,6 +93,7 @@ lw_result lw_platform_serial_connect(const char *port_name, uint32_t baud_rate,
 
     if (tcsetattr(descriptor, TCSANOW, &tty) != 0) {
         LW_DEBUG_LVL_1("Serial Connect: Failed to set attribute.\n");
+        close(descriptor);
         return LW_RESULT_ERROR;
     }
 
@@ -134,6 +148,18 @@ uint32_t lw_platform_get_time_ms(void) {
     return (uint32_t)(microsecond / 1000);
 }
 
+uint64_t lw_platform_get_time_us(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000 + (uint64_t)time.tv_nsec / 1000;
+}
+
+uint64_t lw_platform_get_time_ns(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + (uint64_t)time.tv_nsec;
+}
+
 void lw_platform_sleep(uint32_t time_ms) {
     usleep(time_ms * 1000);
 }
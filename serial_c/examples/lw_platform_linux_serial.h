@@ -20,6 +20,8 @@ lw_result lw_platform_create_serial_device(const char *port_name, uint32_t baud_
 
 lw_result lw_platform_init(void);
 uint32_t lw_platform_get_time_ms(void);
+uint64_t lw_platform_get_time_us(void);
+uint64_t lw_platform_get_time_ns(void);
 void lw_platform_sleep(uint32_t time_ms);
 
 lw_platform_serial_port lw_platform_create_serial_port(void);
@@ -28,6 +30,12 @@ void lw_platform_serial_disconnect(lw_platform_serial_port *serial_port);
 uint32_t lw_platform_serial_write(lw_platform_serial_port *serial_port, uint8_t *buffer, uint32_t size);
 int32_t lw_platform_serial_read(lw_platform_serial_port *serial_port, uint8_t *buffer, uint32_t size);
 
+// Device service callbacks, user data is the lw_platform_serial_device.
+uint32_t lw_platform_get_time_ms_callback(lw_callback_device *device);
+void lw_platform_sleep_callback(lw_callback_device *device, uint32_t time_ms);
+uint32_t lw_platform_serial_send_callback(lw_callback_device *device, uint8_t *buffer, uint32_t size);
+int32_t lw_platform_serial_receive_callback(lw_callback_device *device, uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,97 @@
+#include "lw_platform_linux_shm.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void lw_shm_set_name(lw_platform_shm *shm, const char *name) {
+    strncpy(shm->name, name, LW_SHM_NAME_SIZE - 1);
+    shm->name[LW_SHM_NAME_SIZE - 1] = 0;
+}
+
+lw_result lw_platform_shm_create(const char *name, uint64_t size, lw_platform_shm *shm) {
+    memset(shm, 0, sizeof(*shm));
+    shm->fd = -1;
+
+    shm_unlink(name);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+
+    if (fd < 0) {
+        LW_DEBUG_LVL_1("Failed to create shared memory %s\n", name);
+        return LW_RESULT_ERROR;
+    }
+
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return LW_RESULT_ERROR;
+    }
+
+    void *memory = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (memory == MAP_FAILED) {
+        close(fd);
+        shm_unlink(name);
+        return LW_RESULT_ERROR;
+    }
+
+    lw_shm_set_name(shm, name);
+    shm->fd = fd;
+    shm->memory = memory;
+    shm->size = size;
+    shm->owner = LW_TRUE;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_platform_shm_open(const char *name, lw_platform_shm *shm) {
+    struct stat shm_stat;
+
+    memset(shm, 0, sizeof(*shm));
+    shm->fd = -1;
+
+    int fd = shm_open(name, O_RDONLY, 0);
+
+    if (fd < 0) {
+        return LW_RESULT_ERROR;
+    }
+
+    if (fstat(fd, &shm_stat) != 0 || shm_stat.st_size <= 0) {
+        close(fd);
+        return LW_RESULT_ERROR;
+    }
+
+    void *memory = mmap(NULL, (size_t)shm_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (memory == MAP_FAILED) {
+        close(fd);
+        return LW_RESULT_ERROR;
+    }
+
+    lw_shm_set_name(shm, name);
+    shm->fd = fd;
+    shm->memory = memory;
+    shm->size = (uint64_t)shm_stat.st_size;
+    shm->owner = LW_FALSE;
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_platform_shm_close(lw_platform_shm *shm) {
+    if (shm->memory) {
+        munmap(shm->memory, (size_t)shm->size);
+        shm->memory = NULL;
+    }
+
+    if (shm->fd >= 0) {
+        close(shm->fd);
+        shm->fd = -1;
+    }
+
+    if (shm->owner) {
+        shm_unlink(shm->name);
+        shm->owner = LW_FALSE;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef LW_PLATFORM_LINUX_SHM_H
+#define LW_PLATFORM_LINUX_SHM_H
+
+#include "lw_serial_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// POSIX shared memory.
+//
+// Named shared memory objects live in /dev/shm. The owner creates and sizes
+// the object and maps it read and write, other processes map it read only.
+// ----------------------------------------------------------------------------
+#define LW_SHM_NAME_SIZE 64
+
+typedef struct {
+    char name[LW_SHM_NAME_SIZE];
+    int32_t fd;
+    void *memory;
+    uint64_t size;
+    lw_bool owner;
+} lw_platform_shm;
+
+/*
+ * Create a shared memory object and map it read and write. An existing
+ * object of the same name is replaced.
+ *
+ * @param name The object name, starting with a slash, e.g. "/grf500".
+ * @param size The size of the object in bytes.
+ * @param shm The mapping is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_shm_create(const char *name, uint64_t size, lw_platform_shm *shm);
+
+/*
+ * Map an existing shared memory object read only.
+ *
+ * @param name The object name.
+ * @param shm The mapping is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_shm_open(const char *name, lw_platform_shm *shm);
+
+/*
+ * Unmap a shared memory object. The owner also removes the name.
+ *
+ * @param shm The mapping.
+ */
+void lw_platform_shm_close(lw_platform_shm *shm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_PLATFORM_LINUX_SHM_H
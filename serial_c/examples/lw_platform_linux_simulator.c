@@ -0,0 +1,152 @@
+// posix_openpt and friends.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "lw_platform_linux_simulator.h"
+#include "lw_platform_linux_serial.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint64_t lw_simulator_pty_now_us(lw_platform_simulator_pty *pty) {
+    return lw_platform_get_time_us() - pty->start_us;
+}
+
+// Raw mode on the terminal side, so the line discipline passes bytes through
+// untouched and doesn't echo the simulator output back to it.
+static lw_result lw_simulator_pty_set_raw(int32_t fd) {
+    struct termios tty;
+
+    if (tcgetattr(fd, &tty) != 0) {
+        return LW_RESULT_ERROR;
+    }
+
+    tty.c_iflag = 0;
+    tty.c_oflag = 0;
+    tty.c_lflag = 0;
+    tty.c_cflag = (tty.c_cflag & ~(tcflag_t)(CSIZE | PARENB | CSTOPB)) | CS8 | CLOCAL | CREAD;
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+
+    return (tcsetattr(fd, TCSANOW, &tty) == 0) ? LW_RESULT_SUCCESS : LW_RESULT_ERROR;
+}
+
+// Write bytes to the terminal, keeping what it can't take yet.
+static lw_result lw_simulator_pty_flush(lw_platform_simulator_pty *pty) {
+    while (pty->pending_size > 0) {
+        ssize_t written = write(pty->master_fd, pty->pending, pty->pending_size);
+
+        if (written < 0) {
+            return (errno == EAGAIN || errno == EINTR) ? LW_RESULT_SUCCESS : LW_RESULT_ERROR;
+        }
+
+        pty->pending_size -= (uint32_t)written;
+        memmove(pty->pending, pty->pending + written, pty->pending_size);
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+// Pseudo-terminal runner.
+// ----------------------------------------------------------------------------
+lw_result lw_platform_simulator_pty_open(lw_platform_simulator_pty *pty, lw_grf500_simulator *simulator) {
+    memset(pty, 0, sizeof(*pty));
+    pty->simulator = simulator;
+    pty->slave_fd = -1;
+    pty->master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (pty->master_fd < 0) {
+        LW_DEBUG_LVL_1("Failed to create pseudo-terminal\n");
+        return LW_RESULT_ERROR;
+    }
+
+    const char *name = NULL;
+
+    if (grantpt(pty->master_fd) == 0 && unlockpt(pty->master_fd) == 0) {
+        name = ptsname(pty->master_fd);
+    }
+
+    if (name == NULL || strlen(name) >= LW_SIMULATOR_PORT_NAME_SIZE) {
+        lw_platform_simulator_pty_close(pty);
+        return LW_RESULT_ERROR;
+    }
+
+    strcpy(pty->port_name, name);
+    pty->slave_fd = open(pty->port_name, O_RDWR | O_NOCTTY);
+
+    if (pty->slave_fd < 0 || lw_simulator_pty_set_raw(pty->slave_fd) != LW_RESULT_SUCCESS) {
+        lw_platform_simulator_pty_close(pty);
+        return LW_RESULT_ERROR;
+    }
+
+    fcntl(pty->master_fd, F_SETFL, fcntl(pty->master_fd, F_GETFL) | O_NONBLOCK);
+    pty->start_us = lw_platform_get_time_us();
+
+    LW_DEBUG_LVL_1("Simulator serving on %s\n", pty->port_name);
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_platform_simulator_pty_poll(lw_platform_simulator_pty *pty, uint32_t timeout_ms) {
+    uint8_t buffer[256];
+    uint64_t now_us = lw_simulator_pty_now_us(pty);
+    uint64_t end_us = now_us + (uint64_t)timeout_ms * 1000;
+
+    while (1) {
+        ssize_t count = read(pty->master_fd, buffer, sizeof(buffer));
+
+        while (count > 0) {
+            lw_grf500_simulator_write(pty->simulator, now_us, buffer, (uint32_t)count);
+            count = read(pty->master_fd, buffer, sizeof(buffer));
+        }
+
+        if (count < 0 && errno != EAGAIN && errno != EINTR) {
+            return LW_RESULT_ERROR;
+        }
+
+        if (pty->pending_size == 0) {
+            pty->pending_size = lw_grf500_simulator_read(pty->simulator, now_us, pty->pending, sizeof(pty->pending));
+        }
+
+        LW_CHECK_SUCCESS(lw_simulator_pty_flush(pty))
+
+        if (now_us >= end_us) {
+            return LW_RESULT_SUCCESS;
+        }
+
+        // Wake for the next byte due, rounded up to whole milliseconds, or
+        // as soon as the terminal can take more.
+        uint64_t next_us = lw_grf500_simulator_next_byte_us(pty->simulator, now_us);
+        uint64_t wait_us = ((next_us < end_us) ? next_us : end_us) - now_us;
+        struct pollfd poll_fd = {pty->master_fd, (short)(POLLIN | (pty->pending_size ? POLLOUT : 0)), 0};
+
+        if (poll(&poll_fd, 1, (int)((wait_us + 999) / 1000)) < 0 && errno != EINTR) {
+            return LW_RESULT_ERROR;
+        }
+
+        now_us = lw_simulator_pty_now_us(pty);
+    }
+}
+
+void lw_platform_simulator_pty_close(lw_platform_simulator_pty *pty) {
+    if (pty->slave_fd >= 0) {
+        close(pty->slave_fd);
+    }
+
+    if (pty->master_fd >= 0) {
+        close(pty->master_fd);
+    }
+
+    pty->slave_fd = -1;
+    pty->master_fd = -1;
+}
@@ -0,0 +1,67 @@
+#ifndef LW_PLATFORM_LINUX_SIMULATOR_H
+#define LW_PLATFORM_LINUX_SIMULATOR_H
+
+#include "lw_grf500_simulator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Pseudo-terminal simulator runner.
+//
+// Serves a simulator on a pseudo-terminal, so any program that opens a
+// serial port can talk to it, for example with lw_platform_create_serial_device
+// and the port name of the runner. The simulator runs in real time on the host
+// clock, and the baud rate of the port is ignored in favour of the pacing of
+// the simulator.
+//
+// The runner keeps the terminal side open itself, so clients can connect and
+// disconnect at will without the port going away.
+// ----------------------------------------------------------------------------
+#define LW_SIMULATOR_PORT_NAME_SIZE 64
+
+typedef struct {
+    lw_grf500_simulator *simulator;
+    int32_t master_fd;
+    int32_t slave_fd;
+    char port_name[LW_SIMULATOR_PORT_NAME_SIZE];
+    uint64_t start_us;
+
+    // Bytes read from the simulator that the terminal did not take yet.
+    uint8_t pending[LW_GRF500_SIMULATOR_PACKET_SIZE];
+    uint32_t pending_size;
+} lw_platform_simulator_pty;
+
+/*
+ * Create a pseudo-terminal and serve a simulator on it. Simulator time starts
+ * at 0 now.
+ *
+ * @param pty The runner to open.
+ * @param simulator The simulator to serve, it must stay valid for the lifetime of the runner.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_simulator_pty_open(lw_platform_simulator_pty *pty, lw_grf500_simulator *simulator);
+
+/*
+ * Move bytes between the pseudo-terminal and the simulator, waiting up to a
+ * timeout for requests and for bytes from the simulator to become due.
+ *
+ * @param pty The runner.
+ * @param timeout_ms The longest time to wait, or 0 for non-blocking.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_platform_simulator_pty_poll(lw_platform_simulator_pty *pty, uint32_t timeout_ms);
+
+/*
+ * Close the pseudo-terminal.
+ *
+ * @param pty The runner.
+ */
+void lw_platform_simulator_pty_close(lw_platform_simulator_pty *pty);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_PLATFORM_LINUX_SIMULATOR_H
@@ -139,6 +139,22 @@ uint32_t lw_platform_get_time_ms(void) {
     return (uint32_t)(result * 1000);
 }
 
+uint64_t lw_platform_get_time_us(void) {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    int64_t time = counter.QuadPart - time_counter_start;
+
+    return (uint64_t)((time / time_frequency) * 1000000 + ((time % time_frequency) * 1000000) / time_frequency);
+}
+
+uint64_t lw_platform_get_time_ns(void) {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    int64_t time = counter.QuadPart - time_counter_start;
+
+    return (uint64_t)((time / time_frequency) * 1000000000 + ((time % time_frequency) * 1000000000) / time_frequency);
+}
+
 void lw_platform_sleep(uint32_t time_ms) {
     Sleep(time_ms);
 }
@@ -21,6 +21,8 @@ lw_result lw_platform_create_serial_device(const char *port_name, uint32_t baud_
 
 lw_result lw_platform_init(void);
 uint32_t lw_platform_get_time_ms(void);
+uint64_t lw_platform_get_time_us(void);
+uint64_t lw_platform_get_time_ns(void);
 void lw_platform_sleep(uint32_t time_ms);
 
 lw_platform_serial_port lw_platform_create_serial_port(void);
@@ -0,0 +1,258 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Windowed Aggregation
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_aggregate.h"
+#include <string.h>
+
+// Distance fields, the ones that can report a lost signal.
+#define LW_AGGREGATE_DISTANCE_FIELDS (LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW | LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_FILTERED | \
+                                      LW_GRF500_DISTANCE_CONFIG_LAST_RETURN_RAW | LW_GRF500_DISTANCE_CONFIG_LAST_RETURN_FILTERED)
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint32_t lw_aggregate_random(lw_grf500_aggregator *aggregator) {
+    uint32_t x = aggregator->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    aggregator->random = x;
+
+    return x;
+}
+
+// Rearrange values so that values[k] is the k-th smallest.
+static int32_t lw_aggregate_select(int32_t *values, uint32_t count, uint32_t k) {
+    uint32_t left = 0;
+    uint32_t right = count - 1;
+
+    while (left < right) {
+        // Median of three pivot, which keeps sorted and constant windows linear.
+        uint32_t middle = left + (right - left) / 2;
+        int32_t a = values[left];
+        int32_t b = values[middle];
+        int32_t c = values[right];
+        int32_t pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a)) : ((a < c) ? a : ((b < c) ? c : b));
+
+        uint32_t i = left;
+        uint32_t j = right;
+
+        while (i <= j) {
+            while (values[i] < pivot) {
+                i++;
+            }
+
+            while (values[j] > pivot) {
+                j--;
+            }
+
+            if (i <= j) {
+                int32_t swap = values[i];
+                values[i] = values[j];
+                values[j] = swap;
+                i++;
+
+                if (j == 0) {
+                    break;
+                }
+
+                j--;
+            }
+        }
+
+        if (k <= j) {
+            right = j;
+        } else if (k >= i) {
+            left = i;
+        } else {
+            break;
+        }
+    }
+
+    return values[k];
+}
+
+static void lw_aggregate_open(lw_grf500_aggregator *aggregator, uint64_t timestamp_us) {
+    aggregator->open = LW_TRUE;
+    aggregator->sample_count = 0;
+    aggregator->first_us = timestamp_us;
+    aggregator->last_us = timestamp_us;
+
+    if (aggregator->window_us != 0) {
+        aggregator->start_us = timestamp_us - timestamp_us % aggregator->window_us;
+        aggregator->end_us = aggregator->start_us + aggregator->window_us;
+    }
+
+    for (uint32_t f = 0; f < LW_GRF500_AGGREGATE_FIELD_COUNT; ++f) {
+        lw_grf500_aggregate_state *state = &aggregator->fields[f];
+        state->min = INT32_MAX;
+        state->max = INT32_MIN;
+        state->sum = 0;
+        state->valid_count = 0;
+        state->lost_count = 0;
+    }
+}
+
+static void lw_aggregate_close(lw_grf500_aggregator *aggregator, lw_grf500_aggregate_summary *summary) {
+    memset(summary, 0, sizeof(*summary));
+    summary->sample_count = aggregator->sample_count;
+    summary->median_exact = LW_TRUE;
+
+    if (aggregator->window_us != 0) {
+        summary->start_us = aggregator->start_us;
+        summary->end_us = aggregator->end_us;
+    } else {
+        summary->start_us = aggregator->first_us;
+        summary->end_us = aggregator->last_us;
+    }
+
+    for (uint32_t f = 0; f < LW_GRF500_AGGREGATE_FIELD_COUNT; ++f) {
+        lw_grf500_aggregate_state *state = &aggregator->fields[f];
+        lw_grf500_aggregate_field *field = &summary->fields[f];
+
+        field->valid_count = state->valid_count;
+        field->lost_count = state->lost_count;
+
+        if (state->valid_count == 0) {
+            continue;
+        }
+
+        uint32_t kept = state->valid_count;
+
+        if (kept > LW_GRF500_AGGREGATE_RESERVOIR_SIZE) {
+            kept = LW_GRF500_AGGREGATE_RESERVOIR_SIZE;
+            summary->median_exact = LW_FALSE;
+        }
+
+        field->min = state->min;
+        field->max = state->max;
+        field->mean = (float)((double)state->sum / state->valid_count);
+        field->median = lw_aggregate_select(state->reservoir, kept, (kept - 1) / 2);
+    }
+
+    aggregator->open = LW_FALSE;
+}
+
+// ----------------------------------------------------------------------------
+// Aggregator.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_aggregate_init(lw_grf500_aggregator *aggregator, lw_grf500_distance_config config, uint32_t window_samples, uint64_t window_us) {
+    memset(aggregator, 0, sizeof(*aggregator));
+
+    if (window_samples == 0 && window_us == 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    aggregator->config = config;
+    aggregator->window_samples = window_samples;
+    aggregator->window_us = window_us;
+    aggregator->random = 0x9E3779B9;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_aggregate_push(lw_grf500_aggregator *aggregator, const lw_grf500_distance_sample *sample, lw_grf500_aggregate_summary *summary) {
+    lw_result result = LW_RESULT_AGAIN;
+
+    if (aggregator->open) {
+        lw_bool time_ended = (aggregator->window_us != 0 && sample->timestamp_us >= aggregator->end_us);
+        lw_bool count_reached = (aggregator->window_samples != 0 && aggregator->sample_count >= aggregator->window_samples);
+
+        if (time_ended || count_reached) {
+            lw_aggregate_close(aggregator, summary);
+            result = LW_RESULT_SUCCESS;
+        }
+    }
+
+    if (!aggregator->open) {
+        lw_aggregate_open(aggregator, sample->timestamp_us);
+    }
+
+    int32_t values[LW_GRF500_DISTANCE_FIELD_COUNT];
+    lw_grf500_get_distance_fields(&sample->data, values);
+    aggregator->sample_count++;
+    aggregator->last_us = sample->timestamp_us;
+
+    for (uint32_t f = 0; f < LW_GRF500_AGGREGATE_FIELD_COUNT; ++f) {
+        uint32_t bit = 1u << f;
+
+        if (!(aggregator->config & bit)) {
+            continue;
+        }
+
+        lw_grf500_aggregate_state *state = &aggregator->fields[f];
+        int32_t value = values[f];
+
+        if ((bit & LW_AGGREGATE_DISTANCE_FIELDS) && value == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+            state->lost_count++;
+            continue;
+        }
+
+        state->min = (value < state->min) ? value : state->min;
+        state->max = (value > state->max) ? value : state->max;
+        state->sum += value;
+
+        // Reservoir sampling, every value of the window is equally likely to be kept.
+        if (state->valid_count < LW_GRF500_AGGREGATE_RESERVOIR_SIZE) {
+            state->reservoir[state->valid_count] = value;
+        } else {
+            uint32_t slot = (uint32_t)(((uint64_t)lw_aggregate_random(aggregator) * (state->valid_count + 1)) >> 32);
+
+            if (slot < LW_GRF500_AGGREGATE_RESERVOIR_SIZE) {
+                state->reservoir[slot] = value;
+            }
+        }
+
+        state->valid_count++;
+    }
+
+    // A sample count window closes on the sample that fills it. If a window
+    // already closed above, this one is closed by the next push instead.
+    if (result == LW_RESULT_AGAIN && aggregator->window_samples != 0 && aggregator->sample_count >= aggregator->window_samples) {
+        lw_aggregate_close(aggregator, summary);
+        result = LW_RESULT_SUCCESS;
+    }
+
+    return result;
+}
+
+lw_result lw_grf500_aggregate_poll(lw_grf500_aggregator *aggregator, uint64_t now_us, lw_grf500_aggregate_summary *summary) {
+    if (!aggregator->open || aggregator->window_us == 0 || now_us < aggregator->end_us) {
+        return LW_RESULT_AGAIN;
+    }
+
+    lw_aggregate_close(aggregator, summary);
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_aggregate_flush(lw_grf500_aggregator *aggregator, lw_grf500_aggregate_summary *summary) {
+    if (!aggregator->open) {
+        return LW_RESULT_AGAIN;
+    }
+
+    lw_aggregate_close(aggregator, summary);
+
+    return LW_RESULT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Windowed Aggregation
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_AGGREGATE_H
+#define LW_GRF500_AGGREGATE_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Windowed aggregation.
+//
+// The aggregator reduces a stream of distance samples to one summary per
+// window, with the min, max, mean, median, valid count and lost signal count
+// of every distance data field. A window closes after a number of samples,
+// after a span of time, or whichever comes first when both are set. Time
+// windows are aligned to multiples of their length on the sample clock, so
+// summaries from different sensors line up.
+//
+// Distance fields that read LW_GRF500_LOST_SIGNAL_DISTANCE are counted as
+// lost and left out of the statistics. Fields not in the distance config are
+// ignored.
+//
+// Min, max, mean and the counts are exact and cost O(1) per sample. Values
+// are also kept in a fixed reservoir per field, and the median is found with
+// quickselect when the window closes, which is O(1) amortised per sample. If
+// a window holds more samples than the reservoir, the reservoir becomes a
+// uniform random sample of the window and the median an estimate.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_AGGREGATE_RESERVOIR_SIZE
+#define LW_GRF500_AGGREGATE_RESERVOIR_SIZE 1024
+#endif
+
+// One field per distance data member, in the same order as the distance config bits.
+#define LW_GRF500_AGGREGATE_FIELD_COUNT LW_GRF500_DISTANCE_FIELD_COUNT
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int32_t median;
+    float mean;
+    uint32_t valid_count;
+    uint32_t lost_count;
+} lw_grf500_aggregate_field;
+
+typedef struct {
+    // Window bounds for time windows, otherwise the first and last sample times.
+    uint64_t start_us;
+    uint64_t end_us;
+    uint32_t sample_count;
+
+    // LW_TRUE if every valid value fit in the reservoir.
+    lw_bool median_exact;
+    lw_grf500_aggregate_field fields[LW_GRF500_AGGREGATE_FIELD_COUNT];
+} lw_grf500_aggregate_summary;
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint32_t valid_count;
+    uint32_t lost_count;
+    int32_t reservoir[LW_GRF500_AGGREGATE_RESERVOIR_SIZE];
+} lw_grf500_aggregate_state;
+
+typedef struct {
+    lw_grf500_distance_config config;
+    uint32_t window_samples;
+    uint64_t window_us;
+
+    lw_bool open;
+    uint64_t start_us;
+    uint64_t end_us;
+    uint64_t first_us;
+    uint64_t last_us;
+    uint32_t sample_count;
+    uint32_t random;
+    lw_grf500_aggregate_state fields[LW_GRF500_AGGREGATE_FIELD_COUNT];
+} lw_grf500_aggregator;
+
+/*
+ * Initialize an aggregator.
+ *
+ * @param aggregator The aggregator to initialize.
+ * @param config The distance config of the samples.
+ * @param window_samples The number of samples per window, or 0 for time windows only.
+ * @param window_us The length of a window in microseconds, or 0 for sample count windows only.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if neither window is set.
+ */
+lw_result lw_grf500_aggregate_init(lw_grf500_aggregator *aggregator, lw_grf500_distance_config config, uint32_t window_samples, uint64_t window_us);
+
+/*
+ * Add a sample. Samples must be pushed in time order. A sample past the end
+ * of the current time window first closes that window.
+ *
+ * @param aggregator The aggregator.
+ * @param sample The sample.
+ * @param summary The summary of a closed window is written here.
+ * @return LW_RESULT_SUCCESS if a window closed and the summary was written, or LW_RESULT_AGAIN otherwise.
+ */
+lw_result lw_grf500_aggregate_push(lw_grf500_aggregator *aggregator, const lw_grf500_distance_sample *sample, lw_grf500_aggregate_summary *summary);
+
+/*
+ * Close the current time window if it has ended, so that summaries keep
+ * coming when samples stop arriving.
+ *
+ * @param aggregator The aggregator.
+ * @param now_us The current time, on the same clock as the sample timestamps.
+ * @param summary The summary of the closed window is written here.
+ * @return LW_RESULT_SUCCESS if a window closed and the summary was written, or LW_RESULT_AGAIN otherwise.
+ */
+lw_result lw_grf500_aggregate_poll(lw_grf500_aggregator *aggregator, uint64_t now_us, lw_grf500_aggregate_summary *summary);
+
+/*
+ * Close the current window early, for example when the stream ends.
+ *
+ * @param aggregator The aggregator.
+ * @param summary The summary is written here.
+ * @return LW_RESULT_SUCCESS if the summary was written, or LW_RESULT_AGAIN if the window is empty.
+ */
+lw_result lw_grf500_aggregate_flush(lw_grf500_aggregator *aggregator, lw_grf500_aggregate_summary *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_AGGREGATE_H
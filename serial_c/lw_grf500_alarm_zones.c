@@ -0,0 +1,232 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Alarm Zones
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_alarm_zones.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static void lw_alarm_zones_clear(lw_grf500_alarm_zones_sensor *sensor, uint32_t index) {
+    sensor->enter_near[index] = INT32_MAX;
+    sensor->enter_far[index] = INT32_MIN;
+    sensor->exit_near[index] = INT32_MIN;
+    sensor->exit_far[index] = INT32_MAX;
+    sensor->confirm_count[index] = 1;
+    sensor->counter[index] = 0;
+    sensor->active[index] = 0;
+}
+
+// Evaluate zones from start to end. This is the reference.
+static uint32_t lw_alarm_zones_update_scalar(lw_grf500_alarm_zones_sensor *sensor, uint32_t start, uint32_t end, int32_t distance) {
+    uint32_t changed = 0;
+
+    for (uint32_t z = start; z < end; ++z) {
+        int32_t inside = -(int32_t)((distance >= sensor->enter_near[z]) & (distance < sensor->enter_far[z]));
+        int32_t outside = -(int32_t)((distance < sensor->exit_near[z]) | (distance > sensor->exit_far[z]));
+        int32_t active = sensor->active[z];
+
+        // An inactive zone waits for the confirm count of readings inside,
+        // an active zone resets at the first reading outside.
+        int32_t wanted = (outside & active) | (inside & ~active);
+        int32_t threshold = (1 & active) | (sensor->confirm_count[z] & ~active);
+        int32_t counter = (sensor->counter[z] + 1) & wanted;
+        int32_t fire = -(int32_t)(counter >= threshold);
+
+        sensor->active[z] = active ^ fire;
+        sensor->counter[z] = counter & ~fire;
+        changed |= (uint32_t)(fire & 1) << z;
+    }
+
+    return changed;
+}
+
+#if defined(LW_SIMD_AVX2)
+LW_SIMD_TARGET_AVX2 static uint32_t lw_alarm_zones_update_avx2(lw_grf500_alarm_zones_sensor *sensor, int32_t distance) {
+    __m256i value = _mm256_set1_epi32(distance);
+    __m256i one = _mm256_set1_epi32(1);
+    uint32_t changed = 0;
+
+    for (uint32_t z = 0; z < sensor->zone_limit; z += 8) {
+        __m256i enter_near = _mm256_loadu_si256((const __m256i *)(sensor->enter_near + z));
+        __m256i enter_far = _mm256_loadu_si256((const __m256i *)(sensor->enter_far + z));
+        __m256i exit_near = _mm256_loadu_si256((const __m256i *)(sensor->exit_near + z));
+        __m256i exit_far = _mm256_loadu_si256((const __m256i *)(sensor->exit_far + z));
+        __m256i confirm_count = _mm256_loadu_si256((const __m256i *)(sensor->confirm_count + z));
+        __m256i counter = _mm256_loadu_si256((const __m256i *)(sensor->counter + z));
+        __m256i active = _mm256_loadu_si256((const __m256i *)(sensor->active + z));
+
+        __m256i inside = _mm256_andnot_si256(_mm256_cmpgt_epi32(enter_near, value), _mm256_cmpgt_epi32(enter_far, value));
+        __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(exit_near, value), _mm256_cmpgt_epi32(value, exit_far));
+        __m256i wanted = _mm256_blendv_epi8(inside, outside, active);
+        __m256i threshold = _mm256_blendv_epi8(confirm_count, one, active);
+
+        counter = _mm256_and_si256(_mm256_add_epi32(counter, one), wanted);
+        __m256i fire = _mm256_xor_si256(_mm256_cmpgt_epi32(threshold, counter), _mm256_cmpeq_epi32(one, one));
+
+        _mm256_storeu_si256((__m256i *)(sensor->active + z), _mm256_xor_si256(active, fire));
+        _mm256_storeu_si256((__m256i *)(sensor->counter + z), _mm256_andnot_si256(fire, counter));
+        changed |= (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(fire)) << z;
+    }
+
+    return changed;
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Alarm zones.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_alarm_zones_init(lw_grf500_alarm_zones *zones, uint32_t sensor_count) {
+    memset(zones, 0, sizeof(*zones));
+
+    if (sensor_count == 0 || sensor_count > LW_GRF500_ALARM_ZONES_MAX_SENSORS) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    zones->sensor_count = sensor_count;
+    zones->level = lw_simd_detect();
+
+    for (uint32_t s = 0; s < sensor_count; ++s) {
+        for (uint32_t z = 0; z < LW_GRF500_ALARM_ZONES_MAX_ZONES; ++z) {
+            lw_alarm_zones_clear(&zones->sensors[s], z);
+        }
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_alarm_zones_set_zone(lw_grf500_alarm_zones *zones, uint32_t sensor, uint32_t index, const lw_grf500_alarm_zone *zone) {
+    if (sensor >= zones->sensor_count || index >= LW_GRF500_ALARM_ZONES_MAX_ZONES) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (zone) {
+        if (zone->near_distance < 0 || zone->far_distance <= zone->near_distance || zone->far_distance > LW_GRF500_ALARM_ZONES_MAX_DISTANCE) {
+            return LW_RESULT_INVALID_PARAMETER;
+        }
+
+        if (zone->hysteresis < 0 || zone->hysteresis > LW_GRF500_ALARM_ZONES_MAX_DISTANCE || zone->confirm_count > 1000) {
+            return LW_RESULT_INVALID_PARAMETER;
+        }
+    }
+
+    lw_grf500_alarm_zones_sensor *state = &zones->sensors[sensor];
+    uint32_t bit = 1u << index;
+
+    lw_alarm_zones_clear(state, index);
+    state->active_mask &= ~bit;
+    state->zone_mask &= ~bit;
+
+    if (zone) {
+        state->enter_near[index] = zone->near_distance;
+        state->enter_far[index] = zone->far_distance;
+
+        // Both limits can reach LW_GRF500_ALARM_ZONES_MAX_DISTANCE, so the far
+        // exit can be past INT32_MAX, where no distance can leave the zone.
+        int64_t exit_far = (int64_t)zone->far_distance + zone->hysteresis;
+
+        state->exit_near[index] = zone->near_distance - zone->hysteresis;
+        state->exit_far[index] = (exit_far > INT32_MAX) ? INT32_MAX : (int32_t)exit_far;
+        state->confirm_count[index] = (zone->confirm_count == 0) ? 1 : (int32_t)zone->confirm_count;
+        state->zone_mask |= bit;
+    }
+
+    state->zone_limit = 0;
+
+    for (uint32_t z = 0; z < LW_GRF500_ALARM_ZONES_MAX_ZONES; ++z) {
+        if (state->zone_mask & (1u << z)) {
+            state->zone_limit = (z + 8) & ~7u;
+        }
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_alarm_zones_reset(lw_grf500_alarm_zones *zones) {
+    for (uint32_t s = 0; s < zones->sensor_count; ++s) {
+        lw_grf500_alarm_zones_sensor *sensor = &zones->sensors[s];
+        memset(sensor->counter, 0, sizeof(sensor->counter));
+        memset(sensor->active, 0, sizeof(sensor->active));
+        sensor->active_mask = 0;
+    }
+}
+
+void lw_grf500_alarm_zones_set_simd_level(lw_grf500_alarm_zones *zones, lw_simd_level level) {
+    zones->level = (level == lw_simd_detect()) ? level : LW_SIMD_LEVEL_SCALAR;
+}
+
+lw_result lw_grf500_alarm_zones_update(lw_grf500_alarm_zones *zones, uint32_t sensor, int32_t distance, uint64_t timestamp_us, lw_grf500_alarm_event *events, uint32_t *event_count) {
+    *event_count = 0;
+
+    if (sensor >= zones->sensor_count) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (distance == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+        return LW_RESULT_SUCCESS;
+    }
+
+    lw_grf500_alarm_zones_sensor *state = &zones->sensors[sensor];
+    uint32_t changed;
+
+    switch (zones->level) {
+#if defined(LW_SIMD_AVX2)
+        case LW_SIMD_LEVEL_AVX2: {
+            changed = lw_alarm_zones_update_avx2(state, distance);
+        } break;
+#endif
+        default: {
+            changed = lw_alarm_zones_update_scalar(state, 0, state->zone_limit, distance);
+        } break;
+    }
+
+    if (changed == 0) {
+        return LW_RESULT_SUCCESS;
+    }
+
+    state->active_mask ^= changed;
+
+    for (uint32_t z = 0; z < state->zone_limit; ++z) {
+        if ((changed & (1u << z)) == 0) {
+            continue;
+        }
+
+        lw_grf500_alarm_event *event = &events[(*event_count)++];
+        event->timestamp_us = timestamp_us;
+        event->sensor = sensor;
+        event->zone = z;
+        event->active = (state->active_mask & (1u << z)) ? LW_TRUE : LW_FALSE;
+        event->distance = distance;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+uint32_t lw_grf500_alarm_zones_get_active(const lw_grf500_alarm_zones *zones, uint32_t sensor) {
+    if (sensor >= zones->sensor_count) {
+        return 0;
+    }
+
+    return zones->sensors[sensor].active_mask;
+}
@@ -0,0 +1,168 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Alarm Zones
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_ALARM_ZONES_H
+#define LW_GRF500_ALARM_ZONES_H
+
+#include "lw_grf500_sample.h"
+#include "lw_simd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Alarm zones.
+//
+// Host side alarms, following the same rules as the device alarms A and B,
+// but with up to LW_GRF500_ALARM_ZONES_MAX_ZONES distance bands per sensor
+// across many sensors.
+//
+// A zone becomes active once the reading has been inside the band
+// near <= distance < far for confirm_count readings in a row, like the
+// device GPIO alarm confirm count. It resets straight away when the reading
+// is more than the hysteresis outside the band, distance < near - hysteresis
+// or distance > far + hysteresis. A zone with a near distance of 0 and far
+// distance, hysteresis and confirm count set as on the device acts like
+// alarm A or B. Lost signal readings leave every zone as it is.
+//
+// Distances are in the unit of the readings, cm for distance data, as for
+// the device alarm settings.
+//
+// All zones of a sensor are evaluated together without branches, 8 zones per
+// instruction on the AVX2 path, and only zones that change state produce an
+// event.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_ALARM_ZONES_MAX_SENSORS
+#define LW_GRF500_ALARM_ZONES_MAX_SENSORS 64
+#endif
+
+#define LW_GRF500_ALARM_ZONES_MAX_ZONES 32
+
+// Largest distance and hysteresis a zone can use.
+#define LW_GRF500_ALARM_ZONES_MAX_DISTANCE (1 << 30)
+
+typedef struct {
+    int32_t near_distance;
+    int32_t far_distance;
+    int32_t hysteresis;
+    uint32_t confirm_count;
+} lw_grf500_alarm_zone;
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint32_t sensor;
+    uint32_t zone;
+    lw_bool active;
+    int32_t distance;
+} lw_grf500_alarm_event;
+
+typedef struct {
+    // Zone limits, with unused zones set so they are never entered.
+    int32_t enter_near[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+    int32_t enter_far[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+    int32_t exit_near[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+    int32_t exit_far[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+    int32_t confirm_count[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+
+    // Zone state. Active is 0 or -1, so it can be used as a mask.
+    int32_t counter[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+    int32_t active[LW_GRF500_ALARM_ZONES_MAX_ZONES];
+
+    // Zones set, and the zones evaluated, up to the highest zone set rounded
+    // up to a whole vector.
+    uint32_t zone_mask;
+    uint32_t zone_limit;
+    uint32_t active_mask;
+} lw_grf500_alarm_zones_sensor;
+
+typedef struct {
+    uint32_t sensor_count;
+    lw_simd_level level;
+    lw_grf500_alarm_zones_sensor sensors[LW_GRF500_ALARM_ZONES_MAX_SENSORS];
+} lw_grf500_alarm_zones;
+
+/*
+ * Initialize alarm zones with no zones set. The fastest SIMD level the CPU supports is used.
+ *
+ * @param zones The alarm zones to initialize.
+ * @param sensor_count The number of sensors, up to LW_GRF500_ALARM_ZONES_MAX_SENSORS.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER on failure.
+ */
+lw_result lw_grf500_alarm_zones_init(lw_grf500_alarm_zones *zones, uint32_t sensor_count);
+
+/*
+ * Set or clear a zone of a sensor. The zone starts inactive.
+ *
+ * @param zones The alarm zones.
+ * @param sensor The index of the sensor.
+ * @param index The index of the zone, up to LW_GRF500_ALARM_ZONES_MAX_ZONES.
+ * @param zone The zone, or NULL to clear it. The distances must be 0 to LW_GRF500_ALARM_ZONES_MAX_DISTANCE with near less than far, and the confirm count at most 1000. A confirm count of 0 acts as 1.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER on failure.
+ */
+lw_result lw_grf500_alarm_zones_set_zone(lw_grf500_alarm_zones *zones, uint32_t sensor, uint32_t index, const lw_grf500_alarm_zone *zone);
+
+/*
+ * Make every zone of every sensor inactive, keeping the zone settings.
+ *
+ * @param zones The alarm zones.
+ */
+void lw_grf500_alarm_zones_reset(lw_grf500_alarm_zones *zones);
+
+/*
+ * Choose the code path, for example to compare against the scalar reference.
+ * A level the build or CPU does not support falls back to scalar.
+ *
+ * @param zones The alarm zones.
+ * @param level The SIMD level.
+ */
+void lw_grf500_alarm_zones_set_simd_level(lw_grf500_alarm_zones *zones, lw_simd_level level);
+
+/*
+ * Evaluate every zone of a sensor against a reading.
+ *
+ * @param zones The alarm zones.
+ * @param sensor The index of the sensor.
+ * @param distance The reading.
+ * @param timestamp_us The time of the reading, copied to the events.
+ * @param events An event for each zone that changed state is written here. Must have room for LW_GRF500_ALARM_ZONES_MAX_ZONES events.
+ * @param event_count The number of events is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the sensor is out of range.
+ */
+lw_result lw_grf500_alarm_zones_update(lw_grf500_alarm_zones *zones, uint32_t sensor, int32_t distance, uint64_t timestamp_us, lw_grf500_alarm_event *events, uint32_t *event_count);
+
+/*
+ * Get the zones of a sensor that are active.
+ *
+ * @param zones The alarm zones.
+ * @param sensor The index of the sensor.
+ * @return A mask with a bit set for each active zone, 0 if the sensor is out of range.
+ */
+uint32_t lw_grf500_alarm_zones_get_active(const lw_grf500_alarm_zones *zones, uint32_t sensor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_ALARM_ZONES_H
@@ -0,0 +1,441 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Batch Decoding
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_batch.h"
+#include "lw_grf500_distance_decoder.h"
+#include <string.h>
+
+// Offset of the payload data in a packet, after the start byte, flags and
+// command ID.
+#define LW_BATCH_DATA_OFFSET 4
+
+typedef struct {
+    lw_grf500_distance_column_decoder decoder;
+    lw_grf500_distance_columns *output;
+    uint32_t field_count;
+    uint32_t data_size;
+    int32_t *columns[8];
+    uint32_t offsets[8];
+    int32_t scales[8];
+} lw_batch_plan;
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static void lw_batch_create_plan(lw_grf500_distance_config config, lw_grf500_distance_columns *columns, lw_batch_plan *plan) {
+    int32_t *field_columns[8] = {
+        columns->first_return_raw_cm,
+        columns->first_return_filtered_cm,
+        columns->first_return_strength,
+        columns->last_return_raw_cm,
+        columns->last_return_filtered_cm,
+        columns->last_return_strength,
+        columns->temperature,
+        columns->alarm_status,
+    };
+    static const int32_t field_scales[8] = {10, 10, 1, 10, 10, 1, 1, 1};
+
+    lw_bool complete = LW_TRUE;
+
+    plan->decoder = NULL;
+    plan->output = columns;
+    plan->field_count = 0;
+    plan->data_size = 0;
+
+    for (uint32_t bit = 0; bit < 8; ++bit) {
+        if (!(config & (1u << bit))) {
+            continue;
+        }
+
+        if (field_columns[bit]) {
+            plan->columns[plan->field_count] = field_columns[bit];
+            plan->offsets[plan->field_count] = plan->data_size;
+            plan->scales[plan->field_count] = field_scales[bit];
+            plan->field_count++;
+        } else {
+            complete = LW_FALSE;
+        }
+
+        plan->data_size += sizeof(int32_t);
+    }
+
+    // The specialised decoder writes every field in the config, so it can
+    // only be used when no column is skipped.
+    if (complete) {
+        plan->decoder = lw_grf500_get_distance_column_decoder(config);
+    }
+}
+
+static void lw_batch_fill_columns(const lw_batch_plan *plan, const uint8_t *const *data, uint32_t count, uint32_t row) {
+    if (plan->decoder) {
+        plan->decoder(data, count, plan->output, row);
+        return;
+    }
+
+    for (uint32_t f = 0; f < plan->field_count; ++f) {
+        int32_t *column = plan->columns[f] + row;
+        uint32_t offset = plan->offsets[f];
+        int32_t scale = plan->scales[f];
+
+        for (uint32_t i = 0; i < count; ++i) {
+            int32_t value;
+            memcpy(&value, data[i] + offset, sizeof(value));
+            column[i] = value * scale;
+        }
+    }
+}
+
+// Find the next packet with a valid CRC at or after offset. On success the
+// offset is moved past the packet. Otherwise the offset is left at the first
+// byte that could still start a packet once more data is captured.
+//
+// A start byte whose claimed packet runs past the end of the buffer may just
+// be noise, so scanning goes on past it. A complete packet found later wins,
+// and the cut off candidate is only carried over when nothing follows it.
+static lw_bool lw_batch_scan_packet(const uint8_t *buffer, uint32_t size, uint32_t *offset, const uint8_t **packet_out, uint32_t *payload_size_out) {
+    lw_bool has_partial = LW_FALSE;
+    uint32_t partial_offset = 0;
+
+    // A packet is the start byte, two flag bytes, the payload and two CRC bytes.
+    while (*offset + 6 <= size) {
+        const uint8_t *packet = buffer + *offset;
+
+        if (packet[0] != LW_PACKET_START_BYTE) {
+            (*offset)++;
+            continue;
+        }
+
+        uint32_t payload_size = (uint32_t)(packet[1] | (packet[2] << 8)) >> 6;
+
+        if (payload_size < 1 || payload_size > LW_PACKET_RECV_SIZE - 5) {
+            (*offset)++;
+            continue;
+        }
+
+        uint32_t packet_size = payload_size + 5;
+
+        if (*offset + packet_size > size) {
+            if (!has_partial) {
+                has_partial = LW_TRUE;
+                partial_offset = *offset;
+            }
+
+            (*offset)++;
+            continue;
+        }
+
+        uint16_t crc = (uint16_t)(packet[packet_size - 2] | (packet[packet_size - 1] << 8));
+
+        if (crc != lw_create_crc((uint8_t *)packet, (uint16_t)(packet_size - 2))) {
+            (*offset)++;
+            continue;
+        }
+
+        *packet_out = packet;
+        *payload_size_out = payload_size;
+        *offset += packet_size;
+
+        return LW_TRUE;
+    }
+
+    if (has_partial) {
+        *offset = partial_offset;
+    }
+
+    return LW_FALSE;
+}
+
+// ----------------------------------------------------------------------------
+// Multi data column decoders.
+//
+// The payload is 11 int32 values: a distance and strength pair for each of
+// the 5 returns, then the temperature. Field f of the payload goes to the
+// distance column of return f / 2 when f is even, the strength column when f
+// is odd, and the temperature column for f = 10.
+// ----------------------------------------------------------------------------
+#define LW_MULTI_FIELD_COUNT 11
+#define LW_MULTI_PAYLOAD_SIZE (LW_MULTI_FIELD_COUNT * sizeof(int32_t) + 1)
+
+static void lw_multi_get_columns(lw_grf500_multi_columns *columns, int32_t **field_columns) {
+    for (uint32_t i = 0; i < 5; ++i) {
+        field_columns[i * 2] = columns->distance_mm[i];
+        field_columns[i * 2 + 1] = columns->strength[i];
+    }
+
+    field_columns[10] = columns->temperature;
+}
+
+static void lw_multi_decode_scalar_range(const uint8_t *base, const int32_t *offsets, uint32_t start, uint32_t count, int32_t **field_columns, uint32_t row) {
+    for (uint32_t f = 0; f < LW_MULTI_FIELD_COUNT; ++f) {
+        int32_t *column = field_columns[f];
+
+        if (!column) {
+            continue;
+        }
+
+        for (uint32_t i = start; i < count; ++i) {
+            int32_t value;
+            memcpy(&value, base + offsets[i] + f * sizeof(int32_t), sizeof(value));
+            column[row + i] = value;
+        }
+    }
+}
+
+static void lw_multi_decode_scalar(const uint8_t *base, const int32_t *offsets, uint32_t count, lw_grf500_multi_columns *columns, uint32_t row) {
+    int32_t *field_columns[LW_MULTI_FIELD_COUNT];
+    lw_multi_get_columns(columns, field_columns);
+    lw_multi_decode_scalar_range(base, offsets, 0, count, field_columns, row);
+}
+
+#if defined(LW_SIMD_AVX2)
+// Each field is gathered from 8 packets at once, which writes 8 rows of a
+// column with a single store.
+LW_SIMD_TARGET_AVX2 static void lw_multi_decode_avx2(const uint8_t *base, const int32_t *offsets, uint32_t count, lw_grf500_multi_columns *columns, uint32_t row) {
+    int32_t *field_columns[LW_MULTI_FIELD_COUNT];
+    uint32_t i = 0;
+
+    lw_multi_get_columns(columns, field_columns);
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i packet_offsets = _mm256_loadu_si256((const __m256i *)(offsets + i));
+
+        for (uint32_t f = 0; f < LW_MULTI_FIELD_COUNT; ++f) {
+            if (!field_columns[f]) {
+                continue;
+            }
+
+            __m256i values = _mm256_i32gather_epi32((const int *)(const void *)(base + f * sizeof(int32_t)), packet_offsets, 1);
+            _mm256_storeu_si256((__m256i *)(field_columns[f] + row + i), values);
+        }
+    }
+
+    lw_multi_decode_scalar_range(base, offsets, i, count, field_columns, row);
+}
+#endif
+
+#if defined(LW_SIMD_NEON)
+// Fields 0 to 7 of 4 packets are loaded as two 4x4 blocks and transposed, so
+// each column gets 4 rows with a single store. The temperature and last
+// return are done by the scalar loop, to avoid reading past the payload.
+static void lw_multi_decode_neon(const uint8_t *base, const int32_t *offsets, uint32_t count, lw_grf500_multi_columns *columns, uint32_t row) {
+    int32_t *field_columns[LW_MULTI_FIELD_COUNT];
+    int32_t *tail_columns[LW_MULTI_FIELD_COUNT] = {0};
+    uint32_t i = 0;
+
+    lw_multi_get_columns(columns, field_columns);
+
+    for (uint32_t f = 8; f < LW_MULTI_FIELD_COUNT; ++f) {
+        tail_columns[f] = field_columns[f];
+    }
+
+    for (; i + 4 <= count; i += 4) {
+        for (uint32_t block = 0; block < 2; ++block) {
+            uint32_t field = block * 4;
+            int32x4_t p0 = vreinterpretq_s32_u8(vld1q_u8(base + offsets[i + 0] + field * sizeof(int32_t)));
+            int32x4_t p1 = vreinterpretq_s32_u8(vld1q_u8(base + offsets[i + 1] + field * sizeof(int32_t)));
+            int32x4_t p2 = vreinterpretq_s32_u8(vld1q_u8(base + offsets[i + 2] + field * sizeof(int32_t)));
+            int32x4_t p3 = vreinterpretq_s32_u8(vld1q_u8(base + offsets[i + 3] + field * sizeof(int32_t)));
+
+            int32x4x2_t t01 = vtrnq_s32(p0, p1);
+            int32x4x2_t t23 = vtrnq_s32(p2, p3);
+            int32x4_t fields[4];
+            fields[0] = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+            fields[1] = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+            fields[2] = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+            fields[3] = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+
+            for (uint32_t f = 0; f < 4; ++f) {
+                if (field_columns[field + f]) {
+                    vst1q_s32(field_columns[field + f] + row + i, fields[f]);
+                }
+            }
+        }
+    }
+
+    lw_multi_decode_scalar_range(base, offsets, i, count, field_columns, row);
+    lw_multi_decode_scalar_range(base, offsets, 0, i, tail_columns, row);
+}
+#endif
+
+lw_grf500_multi_column_decoder lw_grf500_get_multi_column_decoder(lw_simd_level level) {
+    switch (level) {
+#if defined(LW_SIMD_AVX2)
+        case LW_SIMD_LEVEL_AVX2: {
+            return &lw_multi_decode_avx2;
+        }
+#endif
+#if defined(LW_SIMD_NEON)
+        case LW_SIMD_LEVEL_NEON: {
+            return &lw_multi_decode_neon;
+        }
+#endif
+        default: {
+            return &lw_multi_decode_scalar;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Batch decoding.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_batch_decode_distance_data(lw_response *responses, uint32_t count, lw_grf500_distance_config config, lw_grf500_distance_columns *columns, uint32_t *decoded) {
+    const uint8_t *data[LW_GRF500_BATCH_CHUNK_SIZE];
+    uint32_t data_count = 0;
+    uint32_t row = 0;
+    lw_batch_plan plan;
+
+    lw_batch_create_plan(config, columns, &plan);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        lw_response *response = &responses[i];
+
+        if (response->command_id != LW_GRF500_COMMAND_DISTANCE_DATA || response->payload_size != plan.data_size + 1) {
+            continue;
+        }
+
+        data[data_count++] = response->data + LW_BATCH_DATA_OFFSET;
+
+        if (data_count == LW_GRF500_BATCH_CHUNK_SIZE) {
+            lw_batch_fill_columns(&plan, data, data_count, row);
+            row += data_count;
+            data_count = 0;
+        }
+    }
+
+    lw_batch_fill_columns(&plan, data, data_count, row);
+    *decoded = row + data_count;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_batch_decode_distance_capture(const uint8_t *buffer, uint32_t size, lw_grf500_distance_config config, lw_grf500_distance_columns *columns, uint32_t max_rows, uint32_t *decoded, uint32_t *consumed) {
+    const uint8_t *data[LW_GRF500_BATCH_CHUNK_SIZE];
+    uint32_t data_count = 0;
+    uint32_t row = 0;
+    uint32_t offset = 0;
+    lw_batch_plan plan;
+
+    lw_batch_create_plan(config, columns, &plan);
+
+    const uint8_t *packet;
+    uint32_t payload_size;
+
+    while (row + data_count < max_rows && lw_batch_scan_packet(buffer, size, &offset, &packet, &payload_size)) {
+        if (packet[3] != LW_GRF500_COMMAND_DISTANCE_DATA || payload_size != plan.data_size + 1) {
+            continue;
+        }
+
+        data[data_count++] = packet + LW_BATCH_DATA_OFFSET;
+
+        if (data_count == LW_GRF500_BATCH_CHUNK_SIZE) {
+            lw_batch_fill_columns(&plan, data, data_count, row);
+            row += data_count;
+            data_count = 0;
+        }
+    }
+
+    lw_batch_fill_columns(&plan, data, data_count, row);
+    *decoded = row + data_count;
+    *consumed = offset;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_batch_decode_multi_data(lw_response *responses, uint32_t count, lw_grf500_multi_columns *columns, uint32_t *decoded) {
+    lw_grf500_multi_column_decoder decoder = lw_grf500_get_multi_column_decoder(lw_simd_detect());
+    int32_t offsets[LW_GRF500_BATCH_CHUNK_SIZE];
+    const uint8_t *base = NULL;
+    uint32_t data_count = 0;
+    uint32_t row = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        lw_response *response = &responses[i];
+
+        if (response->command_id != LW_GRF500_COMMAND_MULTI_DATA || response->payload_size != LW_MULTI_PAYLOAD_SIZE) {
+            continue;
+        }
+
+        const uint8_t *data = response->data + LW_BATCH_DATA_OFFSET;
+
+        if (data_count == 0) {
+            base = data;
+        }
+
+        offsets[data_count++] = (int32_t)(data - base);
+
+        if (data_count == LW_GRF500_BATCH_CHUNK_SIZE) {
+            decoder(base, offsets, data_count, columns, row);
+            row += data_count;
+            data_count = 0;
+        }
+    }
+
+    if (data_count > 0) {
+        decoder(base, offsets, data_count, columns, row);
+    }
+
+    *decoded = row + data_count;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_batch_decode_multi_capture(const uint8_t *buffer, uint32_t size, lw_grf500_multi_columns *columns, uint32_t max_rows, uint32_t *decoded, uint32_t *consumed) {
+    lw_grf500_multi_column_decoder decoder = lw_grf500_get_multi_column_decoder(lw_simd_detect());
+    int32_t offsets[LW_GRF500_BATCH_CHUNK_SIZE];
+    const uint8_t *base = NULL;
+    uint32_t data_count = 0;
+    uint32_t row = 0;
+    uint32_t offset = 0;
+    const uint8_t *packet;
+    uint32_t payload_size;
+
+    while (row + data_count < max_rows && lw_batch_scan_packet(buffer, size, &offset, &packet, &payload_size)) {
+        if (packet[3] != LW_GRF500_COMMAND_MULTI_DATA || payload_size != LW_MULTI_PAYLOAD_SIZE) {
+            continue;
+        }
+
+        const uint8_t *data = packet + LW_BATCH_DATA_OFFSET;
+
+        if (data_count == 0) {
+            base = data;
+        }
+
+        offsets[data_count++] = (int32_t)(data - base);
+
+        if (data_count == LW_GRF500_BATCH_CHUNK_SIZE) {
+            decoder(base, offsets, data_count, columns, row);
+            row += data_count;
+            data_count = 0;
+        }
+    }
+
+    if (data_count > 0) {
+        decoder(base, offsets, data_count, columns, row);
+    }
+
+    *decoded = row + data_count;
+    *consumed = offset;
+
+    return LW_RESULT_SUCCESS;
+}
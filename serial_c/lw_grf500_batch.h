@@ -0,0 +1,159 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Batch Decoding
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_BATCH_H
+#define LW_GRF500_BATCH_H
+
+#include "lw_serial_api_grf500.h"
+#include "lw_simd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Batch decoding.
+//
+// The batch decoders turn many distance data packets into structure-of-arrays
+// columns, one array per field, with the unit scaling applied on the way.
+// The field layout is worked out once per batch from the distance config,
+// instead of once per packet, and every column is then filled in a single
+// pass over the packets.
+//
+// Packets can come from an array of completed responses, or straight from a
+// raw capture buffer which is scanned for valid packets in place.
+//
+// Any column can be NULL, in which case that field is skipped. Fields not in
+// the distance config are never written. When every field in the config has
+// a column, the specialised decoder for the config is used.
+//
+// Multi data packets have a fixed layout, and are transposed into per-return
+// columns with AVX2 or NEON where the CPU supports it.
+// ----------------------------------------------------------------------------
+
+// Number of packets gathered before the columns are filled.
+#ifndef LW_GRF500_BATCH_CHUNK_SIZE
+#define LW_GRF500_BATCH_CHUNK_SIZE 256
+#endif
+
+typedef struct {
+    int32_t *first_return_raw_cm;
+    int32_t *first_return_filtered_cm;
+    int32_t *first_return_strength;
+    int32_t *last_return_raw_cm;
+    int32_t *last_return_filtered_cm;
+    int32_t *last_return_strength;
+    int32_t *temperature;
+    int32_t *alarm_status;
+} lw_grf500_distance_columns;
+
+typedef struct {
+    int32_t *distance_mm[5];
+    int32_t *strength[5];
+    int32_t *temperature;
+} lw_grf500_multi_columns;
+
+/*
+ * Decoder for a run of multi data payloads into columns.
+ *
+ * @param base The payload data of the first packet, after the command ID.
+ * @param offsets The offset of the payload data of each packet from base.
+ * @param count The number of packets.
+ * @param columns The output columns.
+ * @param row The row of the columns to start writing at.
+ */
+typedef void (*lw_grf500_multi_column_decoder)(const uint8_t *base, const int32_t *offsets, uint32_t count, lw_grf500_multi_columns *columns, uint32_t row);
+
+/*
+ * Decode distance data from an array of completed responses into columns.
+ * Responses that are not distance data, or do not match the distance config
+ * in size, are skipped.
+ *
+ * @param responses The responses to decode.
+ * @param count The number of responses.
+ * @param config The distance config the device was streaming with.
+ * @param columns The output columns, each with room for count values.
+ * @param decoded The number of rows written is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_grf500_batch_decode_distance_data(lw_response *responses, uint32_t count, lw_grf500_distance_config config, lw_grf500_distance_columns *columns, uint32_t *decoded);
+
+/*
+ * Decode distance data from a raw capture of the serial byte stream into
+ * columns. The buffer is scanned for packets with a valid CRC, without
+ * copying them out. Other packets and noise are skipped.
+ *
+ * @param buffer The captured bytes.
+ * @param size The number of captured bytes.
+ * @param config The distance config the device was streaming with.
+ * @param columns The output columns, each with room for max_rows values.
+ * @param max_rows The maximum number of rows to decode.
+ * @param decoded The number of rows written is written here.
+ * @param consumed The number of bytes used is written here. A packet cut off at the end of the buffer is not consumed, so the caller can carry it over to the next call.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_grf500_batch_decode_distance_capture(const uint8_t *buffer, uint32_t size, lw_grf500_distance_config config, lw_grf500_distance_columns *columns, uint32_t max_rows, uint32_t *decoded, uint32_t *consumed);
+
+/*
+ * Decode multi data from an array of completed responses into columns.
+ * Responses that are not multi data are skipped.
+ *
+ * @param responses The responses to decode.
+ * @param count The number of responses.
+ * @param columns The output columns, each with room for count values.
+ * @param decoded The number of rows written is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_grf500_batch_decode_multi_data(lw_response *responses, uint32_t count, lw_grf500_multi_columns *columns, uint32_t *decoded);
+
+/*
+ * Decode multi data from a raw capture of the serial byte stream into
+ * columns. The buffer is scanned for packets with a valid CRC, without
+ * copying them out. Other packets and noise are skipped.
+ *
+ * @param buffer The captured bytes.
+ * @param size The number of captured bytes.
+ * @param columns The output columns, each with room for max_rows values.
+ * @param max_rows The maximum number of rows to decode.
+ * @param decoded The number of rows written is written here.
+ * @param consumed The number of bytes used is written here.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_grf500_batch_decode_multi_capture(const uint8_t *buffer, uint32_t size, lw_grf500_multi_columns *columns, uint32_t max_rows, uint32_t *decoded, uint32_t *consumed);
+
+/*
+ * Get the multi data column decoder for a SIMD level. Levels not built into
+ * the library fall back to the scalar decoder. The batch functions use the
+ * decoder for lw_simd_detect().
+ *
+ * @param level The SIMD level.
+ * @return The column decoder.
+ */
+lw_grf500_multi_column_decoder lw_grf500_get_multi_column_decoder(lw_simd_level level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_BATCH_H
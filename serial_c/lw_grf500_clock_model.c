@@ -0,0 +1,149 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Clock Model
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_clock_model.h"
+#include <string.h>
+
+// Loop gains. Early arrivals are pulled in hard, late arrivals gently, so the
+// estimate settles near the lower envelope of the arrival times.
+#define LW_CLOCK_MODEL_EARLY_GAIN 0.5
+#define LW_CLOCK_MODEL_LATE_GAIN 0.02
+#define LW_CLOCK_MODEL_FREQUENCY_GAIN 0.01
+
+// Number of updates over which the loop converges from wide to normal gains.
+#define LW_CLOCK_MODEL_WARMUP 16
+
+// Limit of the period estimate around the nominal period.
+#define LW_CLOCK_MODEL_MAX_PERIOD_DEVIATION 0.02
+
+// ----------------------------------------------------------------------------
+// Clock model.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_clock_model_init(lw_grf500_clock_model *model, float update_rate_hz, uint32_t fixed_latency_us) {
+    if (update_rate_hz <= 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    memset(model, 0, sizeof(*model));
+    model->nominal_period_us = 1000000.0 / (double)update_rate_hz;
+    model->period_us = model->nominal_period_us;
+    model->fixed_latency_us = (double)fixed_latency_us;
+    model->early_gain = LW_CLOCK_MODEL_EARLY_GAIN;
+    model->late_gain = LW_CLOCK_MODEL_LATE_GAIN;
+    model->frequency_gain = LW_CLOCK_MODEL_FREQUENCY_GAIN;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_clock_model_update(lw_grf500_clock_model *model, uint64_t arrival_us, lw_grf500_clock_estimate *estimate) {
+    if (model->locked && arrival_us < model->last_arrival_us) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    model->last_arrival_us = arrival_us;
+
+    uint32_t steps = 1;
+    double error_us = 0;
+
+    if (!model->locked) {
+        model->origin_us = arrival_us;
+        model->estimate_us = 0;
+        model->sequence = 0;
+        model->updates = 0;
+        model->locked = LW_TRUE;
+        steps = 0;
+    } else {
+        double arrival = (double)(arrival_us - model->origin_us);
+        double elapsed_periods = (arrival - model->estimate_us) / model->period_us;
+
+        if (elapsed_periods > LW_GRF500_CLOCK_MODEL_MAX_GAP) {
+            // Too long a silence to count periods reliably, so start again
+            // from this arrival. The silence can be any length, so clamp the
+            // step count before it is converted.
+            steps = (elapsed_periods >= (double)UINT32_MAX) ? UINT32_MAX : (uint32_t)(elapsed_periods + 0.5);
+            model->origin_us = arrival_us;
+            model->estimate_us = 0;
+            model->updates = 0;
+            model->relocks++;
+        } else {
+            if (elapsed_periods > 1.5) {
+                steps = (uint32_t)(elapsed_periods + 0.5);
+            }
+
+            double predicted_us = model->estimate_us + model->period_us * steps;
+            error_us = arrival - predicted_us;
+
+            double early_gain = model->early_gain;
+            double late_gain = model->late_gain;
+
+            if (model->updates < LW_CLOCK_MODEL_WARMUP) {
+                double warmup_gain = 1.0 / (double)(model->updates + 2);
+
+                if (warmup_gain > late_gain) {
+                    late_gain = warmup_gain;
+                }
+            }
+
+            double correction_us = error_us * (error_us < 0 ? early_gain : late_gain);
+            model->estimate_us = predicted_us + correction_us;
+            model->period_us += model->frequency_gain * correction_us / steps;
+
+            double min_period_us = model->nominal_period_us * (1.0 - LW_CLOCK_MODEL_MAX_PERIOD_DEVIATION);
+            double max_period_us = model->nominal_period_us * (1.0 + LW_CLOCK_MODEL_MAX_PERIOD_DEVIATION);
+
+            if (model->period_us < min_period_us) {
+                model->period_us = min_period_us;
+            } else if (model->period_us > max_period_us) {
+                model->period_us = max_period_us;
+            }
+        }
+
+        model->sequence += steps;
+        model->dropped_samples += steps - 1;
+        model->updates++;
+    }
+
+    double acquisition_us = (double)model->origin_us + model->estimate_us - model->fixed_latency_us;
+
+    estimate->acquisition_us = acquisition_us > 0 ? (uint64_t)(acquisition_us + 0.5) : 0;
+    estimate->sequence = model->sequence;
+    estimate->dropped = steps > 1 ? steps - 1 : 0;
+    estimate->error_us = error_us;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_clock_model_stamp(lw_grf500_clock_model *model, uint64_t arrival_us, lw_grf500_distance_sample *sample) {
+    lw_grf500_clock_estimate estimate;
+    LW_CHECK_SUCCESS(lw_grf500_clock_model_update(model, arrival_us, &estimate))
+
+    sample->timestamp_us = estimate.acquisition_us;
+    sample->sequence = estimate.sequence;
+
+    return LW_RESULT_SUCCESS;
+}
+
+double lw_grf500_clock_model_drift_ppm(lw_grf500_clock_model *model) {
+    return (model->period_us / model->nominal_period_us - 1.0) * 1000000.0;
+}
@@ -0,0 +1,122 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Clock Model
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_CLOCK_MODEL_H
+#define LW_GRF500_CLOCK_MODEL_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Sensor clock model.
+//
+// Streamed packets reach the host with several milliseconds of USB and UART
+// jitter, while the device samples on a stable clock set by the update rate.
+// The clock model is a second order tracking loop (a PLL) over the arrival
+// times of streamed packets. It estimates the sensor period as seen by the
+// host clock, and produces a de-jittered acquisition time for every sample.
+//
+// Transport delays only ever make packets late, so the loop corrects quickly
+// towards early arrivals and slowly towards late ones. The estimate therefore
+// follows the lower envelope of the arrival times, which sits a constant
+// transport latency after the true acquisition time. That constant can be
+// removed with the fixed latency parameter.
+//
+// Gaps of more than one period between arrivals are counted as dropped
+// samples, and the sample sequence number is advanced to match.
+// ----------------------------------------------------------------------------
+
+// Arrival gaps longer than this many periods re-lock the loop.
+#define LW_GRF500_CLOCK_MODEL_MAX_GAP 100
+
+typedef struct {
+    uint64_t acquisition_us;
+    uint32_t sequence;
+    uint32_t dropped;
+    double error_us;
+} lw_grf500_clock_estimate;
+
+typedef struct {
+    double nominal_period_us;
+    double period_us;
+    double estimate_us;
+    double fixed_latency_us;
+    double early_gain;
+    double late_gain;
+    double frequency_gain;
+    uint64_t origin_us;
+    uint64_t last_arrival_us;
+    uint32_t sequence;
+    uint32_t updates;
+    lw_bool locked;
+    uint64_t dropped_samples;
+    uint64_t relocks;
+} lw_grf500_clock_model;
+
+/*
+ * Initialize a clock model for a device streaming at a known update rate.
+ *
+ * @param model The clock model to initialize.
+ * @param update_rate_hz The update rate set with lw_grf500_set_update_rate.
+ * @param fixed_latency_us Constant transport latency to subtract from the estimates.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER.
+ */
+lw_result lw_grf500_clock_model_init(lw_grf500_clock_model *model, float update_rate_hz, uint32_t fixed_latency_us);
+
+/*
+ * Feed the host arrival time of the next streamed packet into the model.
+ *
+ * @param model The clock model.
+ * @param arrival_us Host time in microseconds when the packet was completed.
+ * @param estimate The de-jittered acquisition time, sequence number and the number of samples dropped before this one are written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if arrival times go backwards.
+ */
+lw_result lw_grf500_clock_model_update(lw_grf500_clock_model *model, uint64_t arrival_us, lw_grf500_clock_estimate *estimate);
+
+/*
+ * Stamp a distance sample with its de-jittered acquisition time and sequence number.
+ *
+ * @param model The clock model.
+ * @param arrival_us Host time in microseconds when the packet was completed.
+ * @param sample The sample to stamp.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_grf500_clock_model_stamp(lw_grf500_clock_model *model, uint64_t arrival_us, lw_grf500_distance_sample *sample);
+
+/*
+ * Get the drift between the sensor clock and the host clock.
+ *
+ * @param model The clock model.
+ * @return The drift in parts per million. Positive when the sensor runs slow relative to the host.
+ */
+double lw_grf500_clock_model_drift_ppm(lw_grf500_clock_model *model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_CLOCK_MODEL_H
@@ -0,0 +1,684 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Codec
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_codec.h"
+#include <string.h>
+
+// Bitpack widths are limited so any value can be read with one unaligned 64
+// bit load. Wider residuals fall back to varint.
+#define LW_CODEC_MAX_BITPACK_WIDTH 56
+
+#define LW_CODEC_INVALID_SIZE 0xFFFFFFFF
+
+typedef struct {
+    uint32_t order;
+    uint32_t count;
+    uint64_t first_value;
+    uint64_t first_delta;
+    uint32_t residual_count;
+    uint64_t residuals[LW_GRF500_CODEC_MAX_VALUES];
+} lw_codec_column;
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint64_t lw_codec_zigzag(uint64_t value) {
+    return (value << 1) ^ (uint64_t)((int64_t)value >> 63);
+}
+
+static uint64_t lw_codec_unzigzag(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+static uint32_t lw_codec_varint_size(uint64_t value) {
+    uint32_t size = 1;
+
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+
+    return size;
+}
+
+static uint32_t lw_codec_put_varint(uint8_t *output, uint64_t value) {
+    uint32_t size = 0;
+
+    while (value >= 0x80) {
+        output[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+
+    output[size++] = (uint8_t)value;
+
+    return size;
+}
+
+static lw_bool lw_codec_get_varint(const uint8_t *input, uint32_t size, uint32_t *offset, uint64_t *value) {
+    uint64_t result = 0;
+
+    for (uint32_t shift = 0; shift < 64 && *offset < size; shift += 7) {
+        uint8_t byte = input[(*offset)++];
+        result |= (uint64_t)(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return LW_TRUE;
+        }
+    }
+
+    return LW_FALSE;
+}
+
+static uint32_t lw_codec_bit_width(uint64_t value) {
+    uint32_t width = 0;
+
+    while (value) {
+        value >>= 1;
+        width++;
+    }
+
+    return width;
+}
+
+static uint64_t lw_codec_load64(const uint8_t *input) {
+    uint64_t value;
+    memcpy(&value, input, sizeof(value));
+    return value;
+}
+
+// Loads up to 8 bytes near the end of the input without reading past it.
+static uint64_t lw_codec_load64_tail(const uint8_t *input, uint32_t available) {
+    uint64_t value = 0;
+
+    for (uint32_t i = 0; i < available && i < 8; ++i) {
+        value |= (uint64_t)input[i] << (i * 8);
+    }
+
+    return value;
+}
+
+// ----------------------------------------------------------------------------
+// Method sizes.
+// ----------------------------------------------------------------------------
+static uint32_t lw_codec_size_rle(const lw_codec_column *column) {
+    uint32_t size = 0;
+    uint32_t i = 0;
+
+    while (i < column->residual_count) {
+        uint64_t value = column->residuals[i];
+        uint32_t run = 1;
+
+        while (i + run < column->residual_count && column->residuals[i + run] == value) {
+            run++;
+        }
+
+        size += lw_codec_varint_size(value) + lw_codec_varint_size(run);
+        i += run;
+    }
+
+    return size;
+}
+
+static uint32_t lw_codec_size_varint(const lw_codec_column *column) {
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i < column->residual_count; ++i) {
+        size += lw_codec_varint_size(column->residuals[i]);
+    }
+
+    return size;
+}
+
+static uint32_t lw_codec_size_bitpack(const lw_codec_column *column) {
+    uint32_t size = 0;
+
+    for (uint32_t start = 0; start < column->residual_count; start += LW_GRF500_CODEC_BLOCK_VALUES) {
+        uint32_t count = column->residual_count - start;
+        uint64_t bits = 0;
+
+        if (count > LW_GRF500_CODEC_BLOCK_VALUES) {
+            count = LW_GRF500_CODEC_BLOCK_VALUES;
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            bits |= column->residuals[start + i];
+        }
+
+        uint32_t width = lw_codec_bit_width(bits);
+
+        if (width > LW_CODEC_MAX_BITPACK_WIDTH) {
+            return LW_CODEC_INVALID_SIZE;
+        }
+
+        size += 1 + (count * width + 7) / 8;
+    }
+
+    return size;
+}
+
+// ----------------------------------------------------------------------------
+// Method encoders.
+// ----------------------------------------------------------------------------
+static uint32_t lw_codec_write_rle(const lw_codec_column *column, uint8_t *output) {
+    uint32_t size = 0;
+    uint32_t i = 0;
+
+    while (i < column->residual_count) {
+        uint64_t value = column->residuals[i];
+        uint32_t run = 1;
+
+        while (i + run < column->residual_count && column->residuals[i + run] == value) {
+            run++;
+        }
+
+        size += lw_codec_put_varint(output + size, value);
+        size += lw_codec_put_varint(output + size, run);
+        i += run;
+    }
+
+    return size;
+}
+
+static uint32_t lw_codec_write_varint(const lw_codec_column *column, uint8_t *output) {
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i < column->residual_count; ++i) {
+        size += lw_codec_put_varint(output + size, column->residuals[i]);
+    }
+
+    return size;
+}
+
+static uint32_t lw_codec_write_bitpack(const lw_codec_column *column, uint8_t *output) {
+    uint32_t size = 0;
+
+    for (uint32_t start = 0; start < column->residual_count; start += LW_GRF500_CODEC_BLOCK_VALUES) {
+        uint32_t count = column->residual_count - start;
+        uint64_t bits = 0;
+
+        if (count > LW_GRF500_CODEC_BLOCK_VALUES) {
+            count = LW_GRF500_CODEC_BLOCK_VALUES;
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            bits |= column->residuals[start + i];
+        }
+
+        uint32_t width = lw_codec_bit_width(bits);
+        uint64_t accumulator = 0;
+        uint32_t accumulated = 0;
+
+        output[size++] = (uint8_t)width;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            accumulator |= column->residuals[start + i] << accumulated;
+            accumulated += width;
+
+            while (accumulated >= 8) {
+                output[size++] = (uint8_t)accumulator;
+                accumulator >>= 8;
+                accumulated -= 8;
+            }
+        }
+
+        if (accumulated > 0) {
+            output[size++] = (uint8_t)accumulator;
+        }
+    }
+
+    return size;
+}
+
+// ----------------------------------------------------------------------------
+// Method decoders.
+// ----------------------------------------------------------------------------
+static lw_bool lw_codec_read_rle(const uint8_t *input, uint32_t size, uint32_t *offset, lw_codec_column *column) {
+    uint32_t i = 0;
+
+    while (i < column->residual_count) {
+        uint64_t value;
+        uint64_t run;
+
+        if (!lw_codec_get_varint(input, size, offset, &value) || !lw_codec_get_varint(input, size, offset, &run)) {
+            return LW_FALSE;
+        }
+
+        if (run == 0 || run > column->residual_count - i) {
+            return LW_FALSE;
+        }
+
+        for (uint32_t n = 0; n < (uint32_t)run; ++n) {
+            column->residuals[i + n] = value;
+        }
+
+        i += (uint32_t)run;
+    }
+
+    return LW_TRUE;
+}
+
+static lw_bool lw_codec_read_varint(const uint8_t *input, uint32_t size, uint32_t *offset, lw_codec_column *column) {
+    for (uint32_t i = 0; i < column->residual_count; ++i) {
+        if (!lw_codec_get_varint(input, size, offset, &column->residuals[i])) {
+            return LW_FALSE;
+        }
+    }
+
+    return LW_TRUE;
+}
+
+static lw_bool lw_codec_read_bitpack(const uint8_t *input, uint32_t size, uint32_t *offset, lw_codec_column *column) {
+    for (uint32_t start = 0; start < column->residual_count; start += LW_GRF500_CODEC_BLOCK_VALUES) {
+        uint32_t count = column->residual_count - start;
+
+        if (count > LW_GRF500_CODEC_BLOCK_VALUES) {
+            count = LW_GRF500_CODEC_BLOCK_VALUES;
+        }
+
+        if (*offset >= size) {
+            return LW_FALSE;
+        }
+
+        uint32_t width = input[(*offset)++];
+        uint32_t block_size = (count * width + 7) / 8;
+
+        if (width > LW_CODEC_MAX_BITPACK_WIDTH || size - *offset < block_size) {
+            return LW_FALSE;
+        }
+
+        const uint8_t *block = input + *offset;
+        uint32_t available = size - *offset;
+        uint64_t mask = ((uint64_t)1 << width) - 1;
+        uint64_t *residuals = column->residuals + start;
+        uint32_t fast_count = count;
+        uint32_t i = 0;
+
+        // Whole 8 byte loads while they stay inside the input, which is every
+        // value except the last few of the final block.
+        if (width == 0) {
+            memset(residuals, 0, count * sizeof(residuals[0]));
+            fast_count = 0;
+            i = count;
+        } else if (available < 8) {
+            fast_count = 0;
+        } else if (((available - 8) * 8 + 7) / width + 1 < count) {
+            fast_count = ((available - 8) * 8 + 7) / width + 1;
+        }
+
+        for (; i < fast_count; ++i) {
+            uint32_t bit = i * width;
+            residuals[i] = (lw_codec_load64(block + (bit >> 3)) >> (bit & 7)) & mask;
+        }
+
+        for (; i < count; ++i) {
+            uint32_t bit = i * width;
+            residuals[i] = (lw_codec_load64_tail(block + (bit >> 3), available - (bit >> 3)) >> (bit & 7)) & mask;
+        }
+
+        *offset += block_size;
+    }
+
+    return LW_TRUE;
+}
+
+// ----------------------------------------------------------------------------
+// Column encoding.
+// ----------------------------------------------------------------------------
+static void lw_codec_make_residuals(lw_codec_column *column, const uint64_t *values, uint32_t count, uint32_t order) {
+    column->order = order;
+    column->count = count;
+    column->first_value = values[0];
+    column->first_delta = (count > 1) ? values[1] - values[0] : 0;
+    column->residual_count = 0;
+
+    if (order == 1) {
+        for (uint32_t i = 1; i < count; ++i) {
+            column->residuals[column->residual_count++] = lw_codec_zigzag(values[i] - values[i - 1]);
+        }
+    } else {
+        for (uint32_t i = 2; i < count; ++i) {
+            uint64_t delta = values[i] - values[i - 1];
+            uint64_t previous_delta = values[i - 1] - values[i - 2];
+            column->residuals[column->residual_count++] = lw_codec_zigzag(delta - previous_delta);
+        }
+    }
+}
+
+static uint32_t lw_codec_header_size(const lw_codec_column *column) {
+    uint32_t size = 1 + lw_codec_varint_size(column->count) + lw_codec_varint_size(lw_codec_zigzag(column->first_value));
+
+    if (column->order == 2) {
+        size += lw_codec_varint_size(lw_codec_zigzag(column->first_delta));
+    }
+
+    return size;
+}
+
+static uint32_t lw_codec_method_size(const lw_codec_column *column, lw_grf500_codec_method method) {
+    switch (method) {
+        case LW_GRF500_CODEC_RLE:
+            return lw_codec_size_rle(column);
+        case LW_GRF500_CODEC_VARINT:
+            return lw_codec_size_varint(column);
+        case LW_GRF500_CODEC_BITPACK:
+            return lw_codec_size_bitpack(column);
+    }
+
+    return LW_CODEC_INVALID_SIZE;
+}
+
+static lw_result lw_codec_encode(const uint64_t *values, uint32_t count, uint8_t *output, uint32_t capacity, uint32_t *size) {
+    lw_codec_column column;
+    uint32_t best_size = LW_CODEC_INVALID_SIZE;
+    uint32_t best_order = 1;
+    lw_grf500_codec_method best_method = LW_GRF500_CODEC_VARINT;
+
+    *size = 0;
+
+    if (count == 0 || count > LW_GRF500_CODEC_MAX_VALUES) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    // Second order only pays off with at least one residual.
+    uint32_t max_order = (count >= 3) ? 2 : 1;
+
+    for (uint32_t order = 1; order <= max_order; ++order) {
+        lw_codec_make_residuals(&column, values, count, order);
+
+        uint32_t header_size = lw_codec_header_size(&column);
+
+        for (uint32_t method = LW_GRF500_CODEC_RLE; method <= LW_GRF500_CODEC_BITPACK; ++method) {
+            uint32_t method_size = lw_codec_method_size(&column, (lw_grf500_codec_method)method);
+
+            if (method_size != LW_CODEC_INVALID_SIZE && header_size + method_size < best_size) {
+                best_size = header_size + method_size;
+                best_order = order;
+                best_method = (lw_grf500_codec_method)method;
+            }
+        }
+    }
+
+    if (best_size > capacity) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (column.order != best_order) {
+        lw_codec_make_residuals(&column, values, count, best_order);
+    }
+
+    uint32_t offset = 0;
+    output[offset++] = (uint8_t)(best_method | (best_order << 4));
+    offset += lw_codec_put_varint(output + offset, count);
+    offset += lw_codec_put_varint(output + offset, lw_codec_zigzag(column.first_value));
+
+    if (best_order == 2) {
+        offset += lw_codec_put_varint(output + offset, lw_codec_zigzag(column.first_delta));
+    }
+
+    switch (best_method) {
+        case LW_GRF500_CODEC_RLE:
+            offset += lw_codec_write_rle(&column, output + offset);
+            break;
+        case LW_GRF500_CODEC_VARINT:
+            offset += lw_codec_write_varint(&column, output + offset);
+            break;
+        case LW_GRF500_CODEC_BITPACK:
+            offset += lw_codec_write_bitpack(&column, output + offset);
+            break;
+    }
+
+    *size = offset;
+
+    return LW_RESULT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+// Column decoding.
+// ----------------------------------------------------------------------------
+static lw_result lw_codec_decode(const uint8_t *input, uint32_t size, uint32_t max_count, lw_codec_column *column, uint32_t *consumed) {
+    uint32_t offset = 0;
+    uint64_t count;
+    uint64_t value;
+
+    if (size < 1) {
+        return LW_RESULT_ERROR;
+    }
+
+    uint32_t method = input[offset] & 0x0F;
+    column->order = input[offset] >> 4;
+    offset++;
+
+    if (method > LW_GRF500_CODEC_BITPACK || column->order < 1 || column->order > 2) {
+        return LW_RESULT_ERROR;
+    }
+
+    if (!lw_codec_get_varint(input, size, &offset, &count) || count == 0 || count > max_count || count > LW_GRF500_CODEC_MAX_VALUES) {
+        return LW_RESULT_ERROR;
+    }
+
+    if (column->order == 2 && count < 3) {
+        return LW_RESULT_ERROR;
+    }
+
+    column->count = (uint32_t)count;
+    column->residual_count = column->count - ((column->count > column->order) ? column->order : column->count);
+
+    if (!lw_codec_get_varint(input, size, &offset, &value)) {
+        return LW_RESULT_ERROR;
+    }
+
+    column->first_value = lw_codec_unzigzag(value);
+    column->first_delta = 0;
+
+    if (column->order == 2) {
+        if (!lw_codec_get_varint(input, size, &offset, &value)) {
+            return LW_RESULT_ERROR;
+        }
+
+        column->first_delta = lw_codec_unzigzag(value);
+    }
+
+    lw_bool valid = LW_FALSE;
+
+    switch (method) {
+        case LW_GRF500_CODEC_RLE:
+            valid = lw_codec_read_rle(input, size, &offset, column);
+            break;
+        case LW_GRF500_CODEC_VARINT:
+            valid = lw_codec_read_varint(input, size, &offset, column);
+            break;
+        case LW_GRF500_CODEC_BITPACK:
+            valid = lw_codec_read_bitpack(input, size, &offset, column);
+            break;
+    }
+
+    if (!valid) {
+        return LW_RESULT_ERROR;
+    }
+
+    *consumed = offset;
+
+    return LW_RESULT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+// Codec.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_codec_encode_int32(const int32_t *values, uint32_t count, uint8_t *output, uint32_t capacity, uint32_t *size) {
+    uint64_t wide[LW_GRF500_CODEC_MAX_VALUES];
+
+    if (count > LW_GRF500_CODEC_MAX_VALUES) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        wide[i] = (uint64_t)(int64_t)values[i];
+    }
+
+    return lw_codec_encode(wide, count, output, capacity, size);
+}
+
+lw_result lw_grf500_codec_encode_uint64(const uint64_t *values, uint32_t count, uint8_t *output, uint32_t capacity, uint32_t *size) {
+    return lw_codec_encode(values, count, output, capacity, size);
+}
+
+lw_result lw_grf500_codec_decode_int32(const uint8_t *input, uint32_t size, int32_t *values, uint32_t max_count, uint32_t *count, uint32_t *consumed) {
+    lw_codec_column column;
+
+    LW_CHECK_SUCCESS(lw_codec_decode(input, size, max_count, &column, consumed))
+
+    // Sums wrap modulo 2^64, so narrowing gives back the exact 32 bit values.
+    uint64_t value = column.first_value;
+    uint64_t delta = column.first_delta;
+    const uint64_t *residuals = column.residuals;
+
+    values[0] = (int32_t)(uint32_t)value;
+
+    if (column.order == 1) {
+        for (uint32_t i = 0; i < column.residual_count; ++i) {
+            value += lw_codec_unzigzag(residuals[i]);
+            values[i + 1] = (int32_t)(uint32_t)value;
+        }
+    } else {
+        value += delta;
+        values[1] = (int32_t)(uint32_t)value;
+
+        for (uint32_t i = 0; i < column.residual_count; ++i) {
+            delta += lw_codec_unzigzag(residuals[i]);
+            value += delta;
+            values[i + 2] = (int32_t)(uint32_t)value;
+        }
+    }
+
+    *count = column.count;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_codec_decode_uint64(const uint8_t *input, uint32_t size, uint64_t *values, uint32_t max_count, uint32_t *count, uint32_t *consumed) {
+    lw_codec_column column;
+
+    LW_CHECK_SUCCESS(lw_codec_decode(input, size, max_count, &column, consumed))
+
+    uint64_t value = column.first_value;
+    uint64_t delta = column.first_delta;
+    const uint64_t *residuals = column.residuals;
+
+    values[0] = value;
+
+    if (column.order == 1) {
+        for (uint32_t i = 0; i < column.residual_count; ++i) {
+            value += lw_codec_unzigzag(residuals[i]);
+            values[i + 1] = value;
+        }
+    } else {
+        value += delta;
+        values[1] = value;
+
+        for (uint32_t i = 0; i < column.residual_count; ++i) {
+            delta += lw_codec_unzigzag(residuals[i]);
+            value += delta;
+            values[i + 2] = value;
+        }
+    }
+
+    *count = column.count;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_codec_encode_chunk(const lw_grf500_chunk *chunk, uint32_t column_count, uint8_t *output, uint32_t capacity, uint32_t *size) {
+    uint32_t count = chunk->footer.sample_count;
+    uint32_t offset = sizeof(chunk->footer);
+    uint32_t column_size = 0;
+
+    *size = 0;
+
+    if (count == 0 || count > LW_GRF500_RECORDER_CHUNK_SAMPLES || column_count > LW_GRF500_RECORDER_MAX_COLUMNS || capacity < offset) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    memcpy(output, &chunk->footer, sizeof(chunk->footer));
+
+    LW_CHECK_SUCCESS(lw_grf500_codec_encode_uint64(chunk->timestamp_us, count, output + offset, capacity - offset, &column_size))
+    offset += column_size;
+
+    // Sequence numbers only ever wrap, so they code the same as signed values.
+    LW_CHECK_SUCCESS(lw_grf500_codec_encode_int32((const int32_t *)chunk->sequence, count, output + offset, capacity - offset, &column_size))
+    offset += column_size;
+
+    for (uint32_t c = 0; c < column_count; ++c) {
+        LW_CHECK_SUCCESS(lw_grf500_codec_encode_int32(chunk->columns[c], count, output + offset, capacity - offset, &column_size))
+        offset += column_size;
+    }
+
+    *size = offset;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_codec_decode_chunk(const uint8_t *input, uint32_t size, uint32_t column_count, lw_grf500_chunk *chunk, uint32_t *consumed) {
+    uint32_t offset = sizeof(chunk->footer);
+    uint32_t column_size = 0;
+    uint32_t count = 0;
+
+    if (size < offset || column_count > LW_GRF500_RECORDER_MAX_COLUMNS) {
+        return LW_RESULT_ERROR;
+    }
+
+    memcpy(&chunk->footer, input, sizeof(chunk->footer));
+    uint32_t sample_count = chunk->footer.sample_count;
+
+    if (sample_count == 0 || sample_count > LW_GRF500_RECORDER_CHUNK_SAMPLES) {
+        return LW_RESULT_ERROR;
+    }
+
+    LW_CHECK_SUCCESS(lw_grf500_codec_decode_uint64(input + offset, size - offset, chunk->timestamp_us, sample_count, &count, &column_size))
+    offset += column_size;
+
+    if (count != sample_count) {
+        return LW_RESULT_ERROR;
+    }
+
+    LW_CHECK_SUCCESS(lw_grf500_codec_decode_int32(input + offset, size - offset, (int32_t *)chunk->sequence, sample_count, &count, &column_size))
+    offset += column_size;
+
+    if (count != sample_count) {
+        return LW_RESULT_ERROR;
+    }
+
+    for (uint32_t c = 0; c < column_count; ++c) {
+        LW_CHECK_SUCCESS(lw_grf500_codec_decode_int32(input + offset, size - offset, chunk->columns[c], sample_count, &count, &column_size))
+        offset += column_size;
+
+        if (count != sample_count) {
+            return LW_RESULT_ERROR;
+        }
+    }
+
+    *consumed = offset;
+
+    return LW_RESULT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Codec
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_CODEC_H
+#define LW_GRF500_CODEC_H
+
+#include "lw_grf500_recorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Sample compression codec.
+//
+// Columns of recorded samples change slowly from one sample to the next, so
+// each column is stored as the difference from the previous value (order 1),
+// or the difference from the previous difference (order 2), which suits
+// evenly spaced timestamps. The signed residuals are zig-zag mapped so small
+// negative values stay small, and are then stored with whichever of these
+// methods gives the fewest bytes:
+//
+// RLE: Runs of equal residuals as varint value and run length pairs. A
+//      constant column, or one that rises by a constant step, takes a few
+//      bytes.
+// Varint: Each residual as a LEB128 varint.
+// Bitpack: Blocks of 128 residuals, each packed at the bit width of the
+//          largest residual in the block.
+//
+// An encoded column starts with a method byte, the value count and the first
+// values needed to undo the differences. Decoding is a single pass without
+// any branches on the data in the bitpack case. The bitpack layout assumes a
+// little endian host, as does the rest of the API.
+// ----------------------------------------------------------------------------
+#define LW_GRF500_CODEC_MAX_VALUES LW_GRF500_RECORDER_CHUNK_SAMPLES
+#define LW_GRF500_CODEC_BLOCK_VALUES 128
+
+// Largest encoded size of a column, the varint worst case.
+#define LW_GRF500_CODEC_MAX_COLUMN_SIZE(count) (1 + 3 * 10 + (count) * 10)
+
+// Largest encoded size of a full recorder chunk.
+#define LW_GRF500_CODEC_MAX_CHUNK_SIZE \
+    (sizeof(lw_grf500_chunk_footer) + (2 + LW_GRF500_RECORDER_MAX_COLUMNS) * LW_GRF500_CODEC_MAX_COLUMN_SIZE(LW_GRF500_RECORDER_CHUNK_SAMPLES))
+
+typedef enum {
+    LW_GRF500_CODEC_RLE = 0,
+    LW_GRF500_CODEC_VARINT = 1,
+    LW_GRF500_CODEC_BITPACK = 2,
+} lw_grf500_codec_method;
+
+/*
+ * Encode a column of 32 bit values, picking the difference order and method
+ * that give the smallest output.
+ *
+ * @param values The values to encode.
+ * @param count The number of values, up to LW_GRF500_CODEC_MAX_VALUES.
+ * @param output The encoded column is written here.
+ * @param capacity The size of the output buffer. LW_GRF500_CODEC_MAX_COLUMN_SIZE(count) is always enough.
+ * @param size The number of bytes written is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the count or capacity is too small.
+ */
+lw_result lw_grf500_codec_encode_int32(const int32_t *values, uint32_t count, uint8_t *output, uint32_t capacity, uint32_t *size);
+
+/*
+ * Encode a column of 64 bit timestamps.
+ *
+ * @param values The values to encode.
+ * @param count The number of values, up to LW_GRF500_CODEC_MAX_VALUES.
+ * @param output The encoded column is written here.
+ * @param capacity The size of the output buffer. LW_GRF500_CODEC_MAX_COLUMN_SIZE(count) is always enough.
+ * @param size The number of bytes written is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the count or capacity is too small.
+ */
+lw_result lw_grf500_codec_encode_uint64(const uint64_t *values, uint32_t count, uint8_t *output, uint32_t capacity, uint32_t *size);
+
+/*
+ * Decode a column of 32 bit values.
+ *
+ * @param input The encoded column.
+ * @param size The number of bytes available.
+ * @param values The decoded values are written here.
+ * @param max_count The number of entries in values.
+ * @param count The number of values decoded is written here.
+ * @param consumed The number of input bytes used is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_ERROR if the input is corrupt or truncated.
+ */
+lw_result lw_grf500_codec_decode_int32(const uint8_t *input, uint32_t size, int32_t *values, uint32_t max_count, uint32_t *count, uint32_t *consumed);
+
+/*
+ * Decode a column of 64 bit timestamps.
+ *
+ * @param input The encoded column.
+ * @param size The number of bytes available.
+ * @param values The decoded values are written here.
+ * @param max_count The number of entries in values.
+ * @param count The number of values decoded is written here.
+ * @param consumed The number of input bytes used is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_ERROR if the input is corrupt or truncated.
+ */
+lw_result lw_grf500_codec_decode_uint64(const uint8_t *input, uint32_t size, uint64_t *values, uint32_t max_count, uint32_t *count, uint32_t *consumed);
+
+/*
+ * Encode a recorder chunk. The footer is stored as is, followed by the
+ * timestamp, sequence and data columns.
+ *
+ * @param chunk The chunk to encode.
+ * @param column_count The number of data columns, from the recording header.
+ * @param output The encoded chunk is written here.
+ * @param capacity The size of the output buffer. LW_GRF500_CODEC_MAX_CHUNK_SIZE is always enough.
+ * @param size The number of bytes written is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the chunk or capacity is invalid.
+ */
+lw_result lw_grf500_codec_encode_chunk(const lw_grf500_chunk *chunk, uint32_t column_count, uint8_t *output, uint32_t capacity, uint32_t *size);
+
+/*
+ * Decode a recorder chunk. Only the used samples of each column are written.
+ *
+ * @param input The encoded chunk.
+ * @param size The number of bytes available.
+ * @param column_count The number of data columns, from the recording header.
+ * @param chunk The decoded chunk is written here.
+ * @param consumed The number of input bytes used is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_ERROR if the input is corrupt or truncated.
+ */
+lw_result lw_grf500_codec_decode_chunk(const uint8_t *input, uint32_t size, uint32_t column_count, lw_grf500_chunk *chunk, uint32_t *consumed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_CODEC_H
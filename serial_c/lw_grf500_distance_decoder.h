@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Distance Decoders
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_DISTANCE_DECODER_H
+#define LW_GRF500_DISTANCE_DECODER_H
+
+#include "lw_grf500_batch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Specialised distance data decoders.
+//
+// The distance config of a device rarely changes once it is streaming, so
+// instead of testing every config bit for every packet, a decoder can be
+// picked once for the config in use. There is one generated decoder for each
+// of the 256 possible configs, with every field offset and scale a compile
+// time constant and no branches.
+//
+// The decoders write the same fields, in the same units, as
+// lw_grf500_parse_response_distance_data. Fields not in the config are left
+// untouched.
+// ----------------------------------------------------------------------------
+
+/*
+ * Decoder for a single distance data payload.
+ *
+ * @param data The payload data, after the command ID.
+ * @param out The distance data is written here.
+ */
+typedef void (*lw_grf500_distance_decoder)(const uint8_t *data, lw_grf500_distance_data_cm *out);
+
+/*
+ * Decoder for a run of distance data payloads into columns. Every column for
+ * a field in the config must be valid.
+ *
+ * @param data The payload data of each packet, after the command ID.
+ * @param count The number of packets.
+ * @param columns The output columns.
+ * @param row The row of the columns to start writing at.
+ */
+typedef void (*lw_grf500_distance_column_decoder)(const uint8_t *const *data, uint32_t count, lw_grf500_distance_columns *columns, uint32_t row);
+
+/*
+ * Get the decoder for a distance config.
+ *
+ * @param config The distance config the device is streaming with.
+ * @return The decoder.
+ */
+lw_grf500_distance_decoder lw_grf500_get_distance_decoder(lw_grf500_distance_config config);
+
+/*
+ * Get the column decoder for a distance config.
+ *
+ * @param config The distance config the device is streaming with.
+ * @return The column decoder.
+ */
+lw_grf500_distance_column_decoder lw_grf500_get_distance_column_decoder(lw_grf500_distance_config config);
+
+/*
+ * Decode a distance data response with a decoder picked for its config.
+ *
+ * @param response The response to decode.
+ * @param decoder The decoder returned by lw_grf500_get_distance_decoder.
+ * @param data The distance data is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INCORRECT_COMMAND_ID.
+ */
+lw_result lw_grf500_decode_response_distance_data(lw_response *response, lw_grf500_distance_decoder decoder, lw_grf500_distance_data_cm *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_DISTANCE_DECODER_H
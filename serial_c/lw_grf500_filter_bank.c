@@ -0,0 +1,211 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Filter Bank
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_filter_bank.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static void lw_filter_bank_prime(lw_grf500_filter_bank *bank, uint32_t sensor, int32_t value) {
+    for (uint32_t i = 0; i < bank->window_size; ++i) {
+        bank->history[i][sensor] = value;
+    }
+
+    bank->held[sensor] = value;
+    bank->sum[sensor] = value * (int32_t)bank->window_size;
+    bank->smoothed[sensor] = value * 256;
+}
+
+static int32_t lw_filter_bank_floor_div(int64_t numerator, int64_t denominator) {
+    int64_t quotient = numerator / denominator;
+
+    if ((numerator % denominator) != 0 && numerator < 0) {
+        quotient--;
+    }
+
+    return (int32_t)quotient;
+}
+
+// Filter sensors from start to end, one at a time. This is the reference.
+static void lw_filter_bank_step_scalar(lw_grf500_filter_bank *bank, uint32_t start, uint32_t end, const int32_t *input, int32_t *average, int32_t *smoothed) {
+    int32_t *history = bank->history[bank->index];
+    int32_t window_size = (int32_t)bank->window_size;
+
+    for (uint32_t s = start; s < end; ++s) {
+        int32_t value = input[s];
+
+        if (value == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+            value = bank->held[s];
+        } else if (bank->held[s] == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+            lw_filter_bank_prime(bank, s, value);
+        }
+
+        bank->held[s] = value;
+
+        bank->sum[s] += value - history[s];
+        history[s] = value;
+
+        int64_t delta = (int64_t)value * 256 - bank->smoothed[s];
+        bank->smoothed[s] += (int32_t)((delta * bank->alpha) >> 16);
+
+        lw_bool primed = (value != LW_GRF500_LOST_SIGNAL_DISTANCE);
+
+        if (average) {
+            average[s] = primed ? lw_filter_bank_floor_div(2 * (int64_t)bank->sum[s] + window_size, 2 * (int64_t)window_size) : LW_GRF500_LOST_SIGNAL_DISTANCE;
+        }
+
+        if (smoothed) {
+            smoothed[s] = primed ? (bank->smoothed[s] + 128) >> 8 : LW_GRF500_LOST_SIGNAL_DISTANCE;
+        }
+    }
+}
+
+#if defined(LW_SIMD_AVX2)
+// floor((2 * sum + n) / (2 * n)) for 8 sums. The numerator and denominator
+// are exact in double, and the quotient is at least 1 / (2 * n) away from the
+// next integer, far more than the rounding error of the division, so the
+// floor matches the integer reference exactly.
+LW_SIMD_TARGET_AVX2 static __m128i lw_filter_bank_average_avx2(__m128i sum, __m256d window_size, __m256d denominator) {
+    __m256d numerator = _mm256_add_pd(_mm256_add_pd(_mm256_cvtepi32_pd(sum), _mm256_cvtepi32_pd(sum)), window_size);
+    return _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_div_pd(numerator, denominator)));
+}
+
+// floor((delta * alpha) / 65536) for 8 lanes, from the 64 bit products of the
+// even and odd lanes.
+LW_SIMD_TARGET_AVX2 static __m256i lw_filter_bank_scale_avx2(__m256i delta, __m256i alpha) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(delta, alpha), 16);
+    __m256i odd = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(delta, 32), alpha), 16);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+LW_SIMD_TARGET_AVX2 static void lw_filter_bank_step_avx2(lw_grf500_filter_bank *bank, const int32_t *input, int32_t *average, int32_t *smoothed) {
+    int32_t *history = bank->history[bank->index];
+    __m256i lost = _mm256_set1_epi32(LW_GRF500_LOST_SIGNAL_DISTANCE);
+    __m256i alpha = _mm256_set1_epi32(bank->alpha);
+    __m256i rounding = _mm256_set1_epi32(128);
+    __m256d window_size = _mm256_set1_pd((double)bank->window_size);
+    __m256d denominator = _mm256_set1_pd(2.0 * (double)bank->window_size);
+    uint32_t s = 0;
+
+    for (; s + 8 <= bank->sensor_count; s += 8) {
+        __m256i value = _mm256_loadu_si256((const __m256i *)(input + s));
+        __m256i held = _mm256_loadu_si256((const __m256i *)(bank->held + s));
+        __m256i value_lost = _mm256_cmpeq_epi32(value, lost);
+
+        // First valid reading of a sensor, rare enough to do one at a time.
+        uint32_t first = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_andnot_si256(value_lost, _mm256_cmpeq_epi32(held, lost))));
+
+        while (first) {
+            uint32_t lane = (uint32_t)__builtin_ctz(first);
+            lw_filter_bank_prime(bank, s + lane, input[s + lane]);
+            first &= first - 1;
+        }
+
+        value = _mm256_blendv_epi8(value, _mm256_loadu_si256((const __m256i *)(bank->held + s)), value_lost);
+        _mm256_storeu_si256((__m256i *)(bank->held + s), value);
+
+        __m256i sum = _mm256_loadu_si256((const __m256i *)(bank->sum + s));
+        sum = _mm256_add_epi32(sum, _mm256_sub_epi32(value, _mm256_loadu_si256((const __m256i *)(history + s))));
+        _mm256_storeu_si256((__m256i *)(bank->sum + s), sum);
+        _mm256_storeu_si256((__m256i *)(history + s), value);
+
+        __m256i state = _mm256_loadu_si256((const __m256i *)(bank->smoothed + s));
+        __m256i delta = _mm256_sub_epi32(_mm256_slli_epi32(value, 8), state);
+        state = _mm256_add_epi32(state, lw_filter_bank_scale_avx2(delta, alpha));
+        _mm256_storeu_si256((__m256i *)(bank->smoothed + s), state);
+
+        __m256i unprimed = _mm256_cmpeq_epi32(value, lost);
+
+        if (average) {
+            __m128i low = lw_filter_bank_average_avx2(_mm256_castsi256_si128(sum), window_size, denominator);
+            __m128i high = lw_filter_bank_average_avx2(_mm256_extracti128_si256(sum, 1), window_size, denominator);
+            __m256i result = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+            _mm256_storeu_si256((__m256i *)(average + s), _mm256_blendv_epi8(result, lost, unprimed));
+        }
+
+        if (smoothed) {
+            __m256i result = _mm256_srai_epi32(_mm256_add_epi32(state, rounding), 8);
+            _mm256_storeu_si256((__m256i *)(smoothed + s), _mm256_blendv_epi8(result, lost, unprimed));
+        }
+    }
+
+    lw_filter_bank_step_scalar(bank, s, bank->sensor_count, input, average, smoothed);
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Filter bank.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_filter_bank_init(lw_grf500_filter_bank *bank, uint32_t sensor_count, uint32_t window_size, uint32_t smoothing_factor) {
+    memset(bank, 0, sizeof(*bank));
+
+    if (sensor_count == 0 || sensor_count > LW_GRF500_FILTER_BANK_MAX_SENSORS) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (window_size == 0 || window_size > LW_GRF500_FILTER_BANK_MAX_WINDOW || smoothing_factor > 99) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    bank->sensor_count = sensor_count;
+    bank->window_size = window_size;
+    bank->smoothing_factor = smoothing_factor;
+    bank->alpha = (int32_t)((65536 * (100 - smoothing_factor) + 50) / 100);
+    bank->level = lw_simd_detect();
+    lw_grf500_filter_bank_reset(bank);
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_filter_bank_reset(lw_grf500_filter_bank *bank) {
+    bank->index = 0;
+
+    for (uint32_t s = 0; s < LW_GRF500_FILTER_BANK_STRIDE; ++s) {
+        bank->held[s] = LW_GRF500_LOST_SIGNAL_DISTANCE;
+        bank->sum[s] = 0;
+        bank->smoothed[s] = 0;
+    }
+
+    memset(bank->history, 0, sizeof(bank->history));
+}
+
+void lw_grf500_filter_bank_set_simd_level(lw_grf500_filter_bank *bank, lw_simd_level level) {
+    bank->level = (level == lw_simd_detect()) ? level : LW_SIMD_LEVEL_SCALAR;
+}
+
+void lw_grf500_filter_bank_step(lw_grf500_filter_bank *bank, const int32_t *input, int32_t *average, int32_t *smoothed) {
+    switch (bank->level) {
+#if defined(LW_SIMD_AVX2)
+        case LW_SIMD_LEVEL_AVX2: {
+            lw_filter_bank_step_avx2(bank, input, average, smoothed);
+        } break;
+#endif
+        default: {
+            lw_filter_bank_step_scalar(bank, 0, bank->sensor_count, input, average, smoothed);
+        } break;
+    }
+
+    bank->index = (bank->index + 1 == bank->window_size) ? 0 : bank->index + 1;
+}
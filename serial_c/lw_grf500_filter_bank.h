@@ -0,0 +1,126 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Filter Bank
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_FILTER_BANK_H
+#define LW_GRF500_FILTER_BANK_H
+
+#include "lw_grf500_sample.h"
+#include "lw_simd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Filter bank.
+//
+// Host side equivalents of the device rolling average and smooth filter,
+// run on one field of many sensors at once. Each step takes one value per
+// sensor and produces the rolling average and the smoothed value of every
+// sensor. The state is kept as structure-of-arrays across sensors, so the
+// AVX2 path updates 8 sensors per instruction.
+//
+// Both paths give bit-identical results, defined by the scalar reference:
+//
+//   Lost signal readings are replaced by the last valid reading of the same
+//   sensor. Until a sensor has had a valid reading, both its outputs are
+//   LW_GRF500_LOST_SIGNAL_DISTANCE. The first valid reading fills the whole
+//   window and the smoothing state.
+//
+//   The rolling average of window N is floor((2 * sum + N) / (2 * N)), the
+//   mean rounded to nearest with halves rounded up.
+//
+//   The smoothing state s holds the output in 1/256 units. With a smoothing
+//   factor f, the share of the previous output kept each step in percent,
+//   a = round(65536 * (100 - f) / 100), and each step does
+//   s += floor(((x * 256 - s) * a) / 65536). The output is
+//   floor((s + 128) / 256).
+//
+// Inputs must be within +-2^22, which covers distances in mm up to 4 km.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_FILTER_BANK_MAX_SENSORS
+#define LW_GRF500_FILTER_BANK_MAX_SENSORS 64
+#endif
+
+#define LW_GRF500_FILTER_BANK_MAX_WINDOW 32
+
+// Room for whole vectors past the last sensor.
+#define LW_GRF500_FILTER_BANK_STRIDE ((LW_GRF500_FILTER_BANK_MAX_SENSORS + 7) & ~7)
+
+typedef struct {
+    uint32_t sensor_count;
+    uint32_t window_size;
+    uint32_t smoothing_factor;
+    int32_t alpha;
+    uint32_t index;
+    lw_simd_level level;
+
+    int32_t held[LW_GRF500_FILTER_BANK_STRIDE];
+    int32_t sum[LW_GRF500_FILTER_BANK_STRIDE];
+    int32_t smoothed[LW_GRF500_FILTER_BANK_STRIDE];
+    int32_t history[LW_GRF500_FILTER_BANK_MAX_WINDOW][LW_GRF500_FILTER_BANK_STRIDE];
+} lw_grf500_filter_bank;
+
+/*
+ * Initialize a filter bank. The fastest SIMD level the CPU supports is used.
+ *
+ * @param bank The bank to initialize.
+ * @param sensor_count The number of sensors, up to LW_GRF500_FILTER_BANK_MAX_SENSORS.
+ * @param window_size The rolling average window, 1 to LW_GRF500_FILTER_BANK_MAX_WINDOW.
+ * @param smoothing_factor The smoothing factor in percent, 0 to 99, where 0 passes readings through.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER on failure.
+ */
+lw_result lw_grf500_filter_bank_init(lw_grf500_filter_bank *bank, uint32_t sensor_count, uint32_t window_size, uint32_t smoothing_factor);
+
+/*
+ * Forget all readings, as if no sensor had a valid reading yet.
+ *
+ * @param bank The bank.
+ */
+void lw_grf500_filter_bank_reset(lw_grf500_filter_bank *bank);
+
+/*
+ * Choose the code path, for example to compare against the scalar reference.
+ * A level the build or CPU does not support falls back to scalar.
+ *
+ * @param bank The bank.
+ * @param level The SIMD level.
+ */
+void lw_grf500_filter_bank_set_simd_level(lw_grf500_filter_bank *bank, lw_simd_level level);
+
+/*
+ * Filter one reading from every sensor.
+ *
+ * @param bank The bank.
+ * @param input One reading per sensor.
+ * @param average The rolling average of each sensor is written here, can be NULL.
+ * @param smoothed The smoothed value of each sensor is written here, can be NULL.
+ */
+void lw_grf500_filter_bank_step(lw_grf500_filter_bank *bank, const int32_t *input, int32_t *average, int32_t *smoothed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_FILTER_BANK_H
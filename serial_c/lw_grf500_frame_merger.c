@@ -0,0 +1,193 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Frame Merger
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_frame_merger.h"
+#include <string.h>
+
+#define LW_GRF500_MERGER_QUEUE_MASK (LW_GRF500_MERGER_QUEUE_SIZE - 1)
+
+#if (LW_GRF500_MERGER_QUEUE_SIZE & LW_GRF500_MERGER_QUEUE_MASK) != 0
+#error "LW_GRF500_MERGER_QUEUE_SIZE must be a power of two"
+#endif
+
+// Frames report the sensors they hold as bits in a uint32_t.
+#if LW_GRF500_MERGER_MAX_SENSORS > 32
+#error "LW_GRF500_MERGER_MAX_SENSORS must be 32 or less"
+#endif
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint32_t lw_merger_queue_count(lw_grf500_merger_queue *queue) {
+    return queue->tail - queue->head;
+}
+
+static lw_grf500_distance_sample *lw_merger_queue_front(lw_grf500_merger_queue *queue) {
+    return &queue->samples[queue->head & LW_GRF500_MERGER_QUEUE_MASK];
+}
+
+// Find the earliest pending sample across all streams. This is the head of
+// the k-way merge and the start of the next frame.
+static lw_bool lw_merger_earliest(lw_grf500_frame_merger *merger, uint64_t *start_us) {
+    lw_bool found = LW_FALSE;
+
+    for (uint32_t i = 0; i < merger->sensor_count; ++i) {
+        lw_grf500_merger_queue *queue = &merger->queues[i];
+
+        if (lw_merger_queue_count(queue) == 0) {
+            continue;
+        }
+
+        uint64_t timestamp_us = lw_merger_queue_front(queue)->timestamp_us;
+
+        if (!found || timestamp_us < *start_us) {
+            *start_us = timestamp_us;
+            found = LW_TRUE;
+        }
+    }
+
+    return found;
+}
+
+// A stream is resolved for a window when it either has a sample inside the
+// window, or its watermark has moved past the end of the window.
+static lw_bool lw_merger_window_resolved(lw_grf500_frame_merger *merger, uint64_t end_us) {
+    for (uint32_t i = 0; i < merger->sensor_count; ++i) {
+        lw_grf500_merger_queue *queue = &merger->queues[i];
+
+        if (lw_merger_queue_count(queue) > 0 && lw_merger_queue_front(queue)->timestamp_us < end_us) {
+            continue;
+        }
+
+        if (queue->has_timestamp && queue->last_timestamp_us >= end_us) {
+            continue;
+        }
+
+        return LW_FALSE;
+    }
+
+    return LW_TRUE;
+}
+
+static void lw_merger_emit(lw_grf500_frame_merger *merger, uint64_t start_us, uint64_t end_us, lw_grf500_frame *frame) {
+    frame->start_us = start_us;
+    frame->end_us = end_us;
+    frame->sensor_mask = 0;
+    frame->sensor_count = 0;
+
+    for (uint32_t i = 0; i < merger->sensor_count; ++i) {
+        lw_grf500_merger_queue *queue = &merger->queues[i];
+
+        if (lw_merger_queue_count(queue) == 0 || lw_merger_queue_front(queue)->timestamp_us >= end_us) {
+            continue;
+        }
+
+        frame->samples[i] = *lw_merger_queue_front(queue);
+        frame->sensor_mask |= (uint32_t)1 << i;
+        frame->sensor_count++;
+        queue->head++;
+    }
+
+    merger->last_frame_start_us = start_us;
+    merger->has_emitted = LW_TRUE;
+
+    merger->stats.frames++;
+    merger->stats.merged_samples += frame->sensor_count;
+
+    if (frame->sensor_count == merger->sensor_count) {
+        merger->stats.complete_frames++;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Frame merger.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_frame_merger_init(lw_grf500_frame_merger *merger, uint32_t sensor_count, uint32_t window_us, uint32_t max_latency_us) {
+    if (sensor_count == 0 || sensor_count > LW_GRF500_MERGER_MAX_SENSORS || window_us == 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    memset(merger, 0, sizeof(*merger));
+    merger->sensor_count = sensor_count;
+    merger->window_us = window_us;
+    merger->max_latency_us = max_latency_us;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_frame_merger_push(lw_grf500_frame_merger *merger, uint32_t sensor_index, const lw_grf500_distance_sample *sample) {
+    if (sensor_index >= merger->sensor_count) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_grf500_merger_queue *queue = &merger->queues[sensor_index];
+
+    // Samples older than an emitted frame, or out of order within their own
+    // stream, can no longer be merged in time order.
+    if ((merger->has_emitted && sample->timestamp_us < merger->last_frame_start_us) ||
+        (queue->has_timestamp && sample->timestamp_us < queue->last_timestamp_us)) {
+        merger->stats.late_samples++;
+        return LW_RESULT_TIMEOUT;
+    }
+
+    if (lw_merger_queue_count(queue) == LW_GRF500_MERGER_QUEUE_SIZE) {
+        return LW_RESULT_AGAIN;
+    }
+
+    queue->samples[queue->tail & LW_GRF500_MERGER_QUEUE_MASK] = *sample;
+    queue->tail++;
+    queue->last_timestamp_us = sample->timestamp_us;
+    queue->has_timestamp = LW_TRUE;
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_frame_merger_next_frame(lw_grf500_frame_merger *merger, uint64_t now_us, lw_grf500_frame *frame) {
+    uint64_t start_us = 0;
+
+    if (!lw_merger_earliest(merger, &start_us)) {
+        return LW_RESULT_AGAIN;
+    }
+
+    uint64_t end_us = start_us + merger->window_us;
+    lw_bool expired = (now_us >= end_us && now_us - end_us >= merger->max_latency_us) ? LW_TRUE : LW_FALSE;
+
+    if (!expired && !lw_merger_window_resolved(merger, end_us)) {
+        return LW_RESULT_AGAIN;
+    }
+
+    lw_merger_emit(merger, start_us, end_us, frame);
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_frame_merger_flush(lw_grf500_frame_merger *merger, lw_grf500_frame *frame) {
+    uint64_t start_us = 0;
+
+    if (!lw_merger_earliest(merger, &start_us)) {
+        return LW_RESULT_AGAIN;
+    }
+
+    lw_merger_emit(merger, start_us, start_us + merger->window_us, frame);
+    return LW_RESULT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Frame Merger
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_FRAME_MERGER_H
+#define LW_GRF500_FRAME_MERGER_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Multi-sensor frame merger.
+//
+// The merger takes timestamped sample streams from several devices, each
+// running on its own cadence, and assembles them into time-ordered frames.
+// A frame holds at most one sample per sensor, all falling inside the
+// alignment window that starts at the earliest pending sample.
+//
+// Each sensor stream must be pushed in its own time order. The latest
+// timestamp seen on every stream acts as that stream's watermark: once every
+// stream has moved past the end of a window, or the maximum latency has
+// elapsed since the end of the window, the frame is emitted. Samples that
+// arrive after a later frame has already been emitted are counted as late
+// and discarded.
+//
+// All storage is held inside the merger, nothing is allocated per sample.
+// ----------------------------------------------------------------------------
+
+// Maximum number of sensor streams. At most 32, one bit per sensor in the
+// frame sensor mask.
+#ifndef LW_GRF500_MERGER_MAX_SENSORS
+#define LW_GRF500_MERGER_MAX_SENSORS 16
+#endif
+
+// Number of pending samples held per sensor. Must be a power of two.
+#ifndef LW_GRF500_MERGER_QUEUE_SIZE
+#define LW_GRF500_MERGER_QUEUE_SIZE 32
+#endif
+
+typedef struct {
+    lw_grf500_distance_sample samples[LW_GRF500_MERGER_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint64_t last_timestamp_us;
+    lw_bool has_timestamp;
+} lw_grf500_merger_queue;
+
+typedef struct {
+    uint64_t start_us;
+    uint64_t end_us;
+    uint32_t sensor_mask;
+    uint32_t sensor_count;
+    lw_grf500_distance_sample samples[LW_GRF500_MERGER_MAX_SENSORS];
+} lw_grf500_frame;
+
+typedef struct {
+    uint64_t frames;
+    uint64_t complete_frames;
+    uint64_t merged_samples;
+    uint64_t late_samples;
+} lw_grf500_merger_stats;
+
+typedef struct {
+    uint32_t sensor_count;
+    uint32_t window_us;
+    uint32_t max_latency_us;
+    uint64_t last_frame_start_us;
+    lw_bool has_emitted;
+    lw_grf500_merger_queue queues[LW_GRF500_MERGER_MAX_SENSORS];
+    lw_grf500_merger_stats stats;
+} lw_grf500_frame_merger;
+
+/*
+ * Initialize a frame merger.
+ *
+ * @param merger The merger to initialize.
+ * @param sensor_count The number of sensor streams, up to LW_GRF500_MERGER_MAX_SENSORS.
+ * @param window_us The alignment window in microseconds.
+ * @param max_latency_us The maximum time in microseconds to wait for slow streams after a window closes.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER.
+ */
+lw_result lw_grf500_frame_merger_init(lw_grf500_frame_merger *merger, uint32_t sensor_count, uint32_t window_us, uint32_t max_latency_us);
+
+/*
+ * Push a sample from one sensor stream into the merger.
+ *
+ * @param merger The merger.
+ * @param sensor_index The index of the sensor stream the sample belongs to.
+ * @param sample The timestamped sample.
+ * @return LW_RESULT_SUCCESS if the sample was queued, or
+ *         LW_RESULT_TIMEOUT if the sample was late and has been discarded, or
+ *         LW_RESULT_AGAIN if the sensor queue is full and frames must be taken first, or
+ *         LW_RESULT_INVALID_PARAMETER if the sensor index is out of range.
+ */
+lw_result lw_grf500_frame_merger_push(lw_grf500_frame_merger *merger, uint32_t sensor_index, const lw_grf500_distance_sample *sample);
+
+/*
+ * Take the next completed frame, if any.
+ *
+ * @param merger The merger.
+ * @param now_us The current time in microseconds, on the same clock as the sample timestamps.
+ * @param frame The frame is written here.
+ * @return LW_RESULT_SUCCESS if a frame was written, or LW_RESULT_AGAIN if no frame is ready yet.
+ */
+lw_result lw_grf500_frame_merger_next_frame(lw_grf500_frame_merger *merger, uint64_t now_us, lw_grf500_frame *frame);
+
+/*
+ * Take the next frame without waiting for the watermark. Used to drain the
+ * merger when the streams have ended.
+ *
+ * @param merger The merger.
+ * @param frame The frame is written here.
+ * @return LW_RESULT_SUCCESS if a frame was written, or LW_RESULT_AGAIN if the merger is empty.
+ */
+lw_result lw_grf500_frame_merger_flush(lw_grf500_frame_merger *merger, lw_grf500_frame *frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_FRAME_MERGER_H
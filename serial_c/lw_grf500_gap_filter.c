@@ -0,0 +1,246 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Gap Filter
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_gap_filter.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+
+static int32_t lw_gap_filter_get_distance(const lw_grf500_gap_filter *filter, const lw_grf500_distance_sample *sample) {
+    return lw_grf500_get_distance_field(&sample->data, filter->distance_index);
+}
+
+static void lw_gap_filter_set_distance(const lw_grf500_gap_filter *filter, lw_grf500_distance_sample *sample, int32_t distance) {
+    lw_grf500_set_distance_field(&sample->data, filter->distance_index, distance);
+}
+
+// A gap held as it arrived is filled if it ended within max_gap samples.
+static lw_bool lw_gap_filter_held(const lw_grf500_gap_filter *filter) {
+    return (filter->config.fill == LW_GRF500_GAP_FILL_HOLD && filter->has_valid && filter->stats.gap_run <= filter->config.max_gap);
+}
+
+static void lw_gap_filter_end_gap(lw_grf500_gap_filter *filter, lw_bool filled) {
+    lw_grf500_gap_stats *stats = &filter->stats;
+    uint32_t length = stats->gap_run;
+    uint32_t bucket = 0;
+
+    while ((1u << bucket) < length && bucket < LW_GRF500_GAP_FILTER_HISTOGRAM_SIZE - 1) {
+        bucket++;
+    }
+
+    stats->gaps++;
+    stats->gap_histogram[bucket]++;
+    stats->longest_gap = (length > stats->longest_gap) ? length : stats->longest_gap;
+    stats->gap_run = 0;
+
+    if (filled) {
+        stats->filled_gaps++;
+    }
+}
+
+static int32_t lw_gap_filter_round(double value) {
+    return (value < 0) ? -(int32_t)(0.5 - value) : (int32_t)(value + 0.5);
+}
+
+// Fill the samples waiting on a gap between the last valid distance and the
+// one that closed the gap.
+static void lw_gap_filter_interpolate(lw_grf500_gap_filter *filter, int32_t distance, uint64_t timestamp_us) {
+    double start = (double)filter->last_distance;
+    double delta = (double)distance - start;
+    double span_us = (double)(timestamp_us - filter->last_us);
+
+    for (uint32_t i = 0; i < filter->pending_count; ++i) {
+        lw_grf500_gap_output *output = &filter->pending[i];
+        double fraction;
+
+        // Fall back to sample spacing if the timestamps don't advance.
+        if (timestamp_us > filter->last_us && output->sample.timestamp_us >= filter->last_us) {
+            fraction = (double)(output->sample.timestamp_us - filter->last_us) / span_us;
+        } else {
+            fraction = (double)(i + 1) / (double)(filter->pending_count + 1);
+        }
+
+        lw_gap_filter_set_distance(filter, &output->sample, lw_gap_filter_round(start + delta * fraction));
+        output->filled = LW_TRUE;
+    }
+
+    filter->stats.filled_samples += filter->pending_count;
+}
+
+static uint32_t lw_gap_filter_take_pending(lw_grf500_gap_filter *filter, lw_grf500_gap_output *outputs) {
+    uint32_t count = filter->pending_count;
+
+    memcpy(outputs, filter->pending, count * sizeof(filter->pending[0]));
+    filter->pending_count = 0;
+
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+// Gap filter.
+// ----------------------------------------------------------------------------
+void lw_grf500_gap_filter_get_default_config(lw_grf500_gap_filter_config *config) {
+    config->distance_field = LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW;
+    config->strength_field = LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_STRENGTH;
+    config->min_distance_cm = 0;
+    config->max_distance_cm = INT32_MAX;
+    config->min_strength = 0;
+    config->fill = LW_GRF500_GAP_FILL_HOLD;
+    config->max_gap = 3;
+}
+
+lw_result lw_grf500_gap_filter_init(lw_grf500_gap_filter *filter, const lw_grf500_gap_filter_config *config) {
+    memset(filter, 0, sizeof(*filter));
+
+    if (config) {
+        filter->config = *config;
+    } else {
+        lw_grf500_gap_filter_get_default_config(&filter->config);
+    }
+
+    config = &filter->config;
+
+    int32_t distance_index = lw_grf500_get_distance_field_index(config->distance_field);
+    filter->strength_index = (config->strength_field != 0) ? lw_grf500_get_distance_field_index(config->strength_field) : -1;
+
+    if (distance_index < 0 || (config->strength_field != 0 && filter->strength_index < 0)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (config->min_distance_cm > config->max_distance_cm || config->fill > LW_GRF500_GAP_FILL_LINEAR || config->max_gap > LW_GRF500_GAP_FILTER_MAX_GAP) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    filter->distance_index = (uint32_t)distance_index;
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_gap_filter_reset(lw_grf500_gap_filter *filter) {
+    filter->has_valid = LW_FALSE;
+    filter->pending_count = 0;
+    filter->stats.valid_run = 0;
+    filter->stats.gap_run = 0;
+}
+
+lw_grf500_sample_class lw_grf500_gap_filter_classify(const lw_grf500_gap_filter *filter, const lw_grf500_distance_sample *sample) {
+    int32_t distance = lw_gap_filter_get_distance(filter, sample);
+
+    if (distance == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+        return LW_GRF500_SAMPLE_LOST;
+    }
+
+    if (distance < filter->config.min_distance_cm || distance > filter->config.max_distance_cm) {
+        return LW_GRF500_SAMPLE_OUT_OF_RANGE;
+    }
+
+    if (filter->strength_index >= 0 && lw_grf500_get_distance_field(&sample->data, (uint32_t)filter->strength_index) < filter->config.min_strength) {
+        return LW_GRF500_SAMPLE_LOW_STRENGTH;
+    }
+
+    return LW_GRF500_SAMPLE_VALID;
+}
+
+void lw_grf500_gap_filter_push(lw_grf500_gap_filter *filter, const lw_grf500_distance_sample *sample, lw_grf500_gap_output *outputs, uint32_t *output_count) {
+    const lw_grf500_gap_filter_config *config = &filter->config;
+    lw_grf500_gap_stats *stats = &filter->stats;
+    lw_grf500_sample_class sample_class = lw_grf500_gap_filter_classify(filter, sample);
+    uint32_t count = 0;
+
+    stats->samples++;
+    stats->class_counts[sample_class]++;
+
+    if (sample_class == LW_GRF500_SAMPLE_VALID) {
+        int32_t distance = lw_gap_filter_get_distance(filter, sample);
+
+        if (stats->gap_run > 0) {
+            lw_bool filled = LW_FALSE;
+
+            if (filter->pending_count > 0) {
+                lw_gap_filter_interpolate(filter, distance, sample->timestamp_us);
+                count = lw_gap_filter_take_pending(filter, outputs);
+                filled = LW_TRUE;
+            } else if (lw_gap_filter_held(filter)) {
+                stats->filled_samples += stats->gap_run;
+                filled = LW_TRUE;
+            }
+
+            lw_gap_filter_end_gap(filter, filled);
+        }
+
+        filter->has_valid = LW_TRUE;
+        filter->last_distance = distance;
+        filter->last_us = sample->timestamp_us;
+        stats->valid_run++;
+    } else {
+        stats->valid_run = 0;
+        stats->gap_run++;
+
+        lw_bool fillable = (filter->has_valid && stats->gap_run <= config->max_gap);
+
+        if (config->fill == LW_GRF500_GAP_FILL_LINEAR && fillable) {
+            lw_grf500_gap_output *output = &filter->pending[filter->pending_count++];
+            output->sample = *sample;
+            output->sample_class = sample_class;
+            output->filled = LW_FALSE;
+            *output_count = 0;
+            return;
+        }
+
+        // The gap got too long to fill, let the samples held back go.
+        count = lw_gap_filter_take_pending(filter, outputs);
+
+        if (config->fill == LW_GRF500_GAP_FILL_HOLD && fillable) {
+            lw_grf500_gap_output *output = &outputs[count++];
+            output->sample = *sample;
+            output->sample_class = sample_class;
+            output->filled = LW_TRUE;
+            lw_gap_filter_set_distance(filter, &output->sample, filter->last_distance);
+            *output_count = count;
+            return;
+        }
+    }
+
+    lw_grf500_gap_output *output = &outputs[count++];
+    output->sample = *sample;
+    output->sample_class = sample_class;
+    output->filled = LW_FALSE;
+    *output_count = count;
+}
+
+void lw_grf500_gap_filter_flush(lw_grf500_gap_filter *filter, lw_grf500_gap_output *outputs, uint32_t *output_count) {
+    *output_count = lw_gap_filter_take_pending(filter, outputs);
+
+    if (filter->stats.gap_run > 0) {
+        lw_bool held = lw_gap_filter_held(filter);
+
+        if (held) {
+            filter->stats.filled_samples += filter->stats.gap_run;
+        }
+
+        lw_gap_filter_end_gap(filter, held);
+    }
+}
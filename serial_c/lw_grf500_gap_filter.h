@@ -0,0 +1,193 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Gap Filter
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_GAP_FILTER_H
+#define LW_GRF500_GAP_FILTER_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Gap filter.
+//
+// A stream stage that classifies one distance field of every sample as
+// valid, lost signal, out of range or low strength, keeps gap statistics,
+// and can fill short gaps so that consumers don't have to check for the lost
+// signal value themselves. A gap is a run of samples that are not valid.
+//
+// Hold fill replaces each of the first max_gap samples of a gap with the
+// last valid distance as they arrive. Linear fill waits for the gap to end,
+// then interpolates between the valid distances on either side by sample
+// time, so samples in a gap come out delayed until it closes. A gap longer
+// than max_gap is not counted as filled, and linear fill leaves it as it is.
+// Neither fills a gap before the first valid sample.
+//
+// Samples always come out in order, with their classification. Filled
+// samples have the distance field replaced and the filled flag set, and all
+// other fields kept. Samples not filled keep their original distance.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_GAP_FILTER_MAX_GAP
+#define LW_GRF500_GAP_FILTER_MAX_GAP 16
+#endif
+
+// Most samples a push can output.
+#define LW_GRF500_GAP_FILTER_MAX_OUTPUTS (LW_GRF500_GAP_FILTER_MAX_GAP + 1)
+
+// Gap lengths of 1, 2, 3-4, 5-8, ... with the last bucket holding the rest.
+#define LW_GRF500_GAP_FILTER_HISTOGRAM_SIZE 8
+
+typedef enum {
+    LW_GRF500_SAMPLE_VALID = 0,
+    LW_GRF500_SAMPLE_LOST = 1,
+    LW_GRF500_SAMPLE_OUT_OF_RANGE = 2,
+    LW_GRF500_SAMPLE_LOW_STRENGTH = 3,
+    LW_GRF500_SAMPLE_CLASS_COUNT = 4,
+} lw_grf500_sample_class;
+
+typedef enum {
+    LW_GRF500_GAP_FILL_NONE = 0,
+    LW_GRF500_GAP_FILL_HOLD = 1,
+    LW_GRF500_GAP_FILL_LINEAR = 2,
+} lw_grf500_gap_fill;
+
+typedef struct {
+    // The distance and strength fields checked, each a single distance
+    // config flag. A strength field of 0 skips the strength check.
+    lw_grf500_distance_config distance_field;
+    lw_grf500_distance_config strength_field;
+
+    // Distances outside min to max are out of range.
+    int32_t min_distance_cm;
+    int32_t max_distance_cm;
+
+    // Returns weaker than this are low strength.
+    int32_t min_strength;
+
+    lw_grf500_gap_fill fill;
+
+    // Longest gap filled, in samples, up to LW_GRF500_GAP_FILTER_MAX_GAP.
+    uint32_t max_gap;
+} lw_grf500_gap_filter_config;
+
+typedef struct {
+    lw_grf500_distance_sample sample;
+    lw_grf500_sample_class sample_class;
+    lw_bool filled;
+} lw_grf500_gap_output;
+
+typedef struct {
+    uint64_t samples;
+    uint64_t class_counts[LW_GRF500_SAMPLE_CLASS_COUNT];
+
+    // Gaps that have ended, split by whether they were filled, and the
+    // samples in the filled ones. Samples held in a gap that then grows too
+    // long to fill are not counted.
+    uint64_t gaps;
+    uint64_t filled_gaps;
+    uint64_t filled_samples;
+    uint32_t longest_gap;
+    uint64_t gap_histogram[LW_GRF500_GAP_FILTER_HISTOGRAM_SIZE];
+
+    // Current run of valid samples, or of samples in a gap.
+    uint32_t valid_run;
+    uint32_t gap_run;
+} lw_grf500_gap_stats;
+
+typedef struct {
+    lw_grf500_gap_filter_config config;
+    uint32_t distance_index;
+    int32_t strength_index;
+
+    lw_bool has_valid;
+    int32_t last_distance;
+    uint64_t last_us;
+
+    uint32_t pending_count;
+    lw_grf500_gap_output pending[LW_GRF500_GAP_FILTER_MAX_GAP];
+
+    lw_grf500_gap_stats stats;
+} lw_grf500_gap_filter;
+
+/*
+ * Get a gap filter config with defaults: first return raw distance and
+ * strength, the full distance range, and hold fill of up to 3 samples.
+ *
+ * @param config The config is written here.
+ */
+void lw_grf500_gap_filter_get_default_config(lw_grf500_gap_filter_config *config);
+
+/*
+ * Initialize a gap filter.
+ *
+ * @param filter The filter to initialize.
+ * @param config The config, NULL for the defaults.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the config is out of range.
+ */
+lw_result lw_grf500_gap_filter_init(lw_grf500_gap_filter *filter, const lw_grf500_gap_filter_config *config);
+
+/*
+ * Forget the last valid sample and drop any samples waiting on a gap. The
+ * statistics are kept.
+ *
+ * @param filter The filter.
+ */
+void lw_grf500_gap_filter_reset(lw_grf500_gap_filter *filter);
+
+/*
+ * Classify a sample without changing the filter.
+ *
+ * @param filter The filter.
+ * @param sample The sample.
+ * @return The class of the sample.
+ */
+lw_grf500_sample_class lw_grf500_gap_filter_classify(const lw_grf500_gap_filter *filter, const lw_grf500_distance_sample *sample);
+
+/*
+ * Add a sample. Samples must be pushed in time order.
+ *
+ * @param filter The filter.
+ * @param sample The sample.
+ * @param outputs The samples ready are written here, in order. Must have room for LW_GRF500_GAP_FILTER_MAX_OUTPUTS samples.
+ * @param output_count The number of samples written is returned here, 0 while linear fill waits for a gap to close.
+ */
+void lw_grf500_gap_filter_push(lw_grf500_gap_filter *filter, const lw_grf500_distance_sample *sample, lw_grf500_gap_output *outputs, uint32_t *output_count);
+
+/*
+ * Output the samples waiting on a gap without filling them, for example
+ * when the stream ends.
+ *
+ * @param filter The filter.
+ * @param outputs The samples are written here. Must have room for LW_GRF500_GAP_FILTER_MAX_GAP samples.
+ * @param output_count The number of samples written is returned here.
+ */
+void lw_grf500_gap_filter_flush(lw_grf500_gap_filter *filter, lw_grf500_gap_output *outputs, uint32_t *output_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_GAP_FILTER_H
@@ -0,0 +1,243 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Range Kalman Filter
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_kalman.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+
+static void lw_kalman_start(lw_grf500_kalman *filter, uint64_t timestamp_us, float distance, float noise) {
+    const lw_grf500_kalman_config *config = &filter->config;
+
+    memset(filter->x, 0, sizeof(filter->x));
+    memset(filter->p, 0, sizeof(filter->p));
+    filter->x[0] = distance;
+    filter->p[0][0] = noise;
+    filter->p[1][1] = config->initial_rate_noise * config->initial_rate_noise;
+
+    if (filter->states == 3) {
+        filter->p[2][2] = config->initial_acceleration_noise * config->initial_acceleration_noise;
+    }
+
+    filter->started = LW_TRUE;
+    filter->timestamp_us = timestamp_us;
+    filter->measurement_us = timestamp_us;
+}
+
+// x = F x, P = F P F' + Q, with F the constant velocity or acceleration
+// transition and Q the matching discrete white noise.
+static void lw_kalman_predict(lw_grf500_kalman *filter, float dt) {
+    float f[LW_GRF500_KALMAN_MAX_STATES][LW_GRF500_KALMAN_MAX_STATES] = {{1, dt, 0.5f * dt * dt}, {0, 1, dt}, {0, 0, 1}};
+    float q[LW_GRF500_KALMAN_MAX_STATES][LW_GRF500_KALMAN_MAX_STATES];
+    float fp[LW_GRF500_KALMAN_MAX_STATES][LW_GRF500_KALMAN_MAX_STATES];
+    float x[LW_GRF500_KALMAN_MAX_STATES];
+    uint32_t n = filter->states;
+    float s = filter->config.process_noise;
+    float dt2 = dt * dt;
+    float dt3 = dt2 * dt;
+
+    if (n == 2) {
+        q[0][0] = s * dt3 / 3;
+        q[0][1] = s * dt2 / 2;
+        q[1][1] = s * dt;
+    } else {
+        q[0][0] = s * dt3 * dt2 / 20;
+        q[0][1] = s * dt2 * dt2 / 8;
+        q[0][2] = s * dt3 / 6;
+        q[1][1] = s * dt3 / 3;
+        q[1][2] = s * dt2 / 2;
+        q[2][2] = s * dt;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        x[i] = 0;
+
+        for (uint32_t k = i; k < n; ++k) {
+            x[i] += f[i][k] * filter->x[k];
+        }
+
+        for (uint32_t j = 0; j < n; ++j) {
+            fp[i][j] = 0;
+
+            for (uint32_t k = i; k < n; ++k) {
+                fp[i][j] += f[i][k] * filter->p[k][j];
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        filter->x[i] = x[i];
+
+        for (uint32_t j = i; j < n; ++j) {
+            float value = q[i][j];
+
+            for (uint32_t k = j; k < n; ++k) {
+                value += fp[i][k] * f[j][k];
+            }
+
+            filter->p[i][j] = value;
+            filter->p[j][i] = value;
+        }
+    }
+}
+
+// Correct with a range measurement, H = [1 0 0].
+static void lw_kalman_correct(lw_grf500_kalman *filter, float distance, float noise) {
+    float k[LW_GRF500_KALMAN_MAX_STATES];
+    float p0[LW_GRF500_KALMAN_MAX_STATES];
+    uint32_t n = filter->states;
+    float innovation = distance - filter->x[0];
+    float s = filter->p[0][0] + noise;
+
+    for (uint32_t i = 0; i < n; ++i) {
+        p0[i] = filter->p[0][i];
+        k[i] = filter->p[i][0] / s;
+        filter->x[i] += k[i] * innovation;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        for (uint32_t j = i; j < n; ++j) {
+            float value = filter->p[i][j] - k[i] * p0[j];
+            filter->p[i][j] = value;
+            filter->p[j][i] = value;
+        }
+    }
+}
+
+static void lw_kalman_get_estimate(const lw_grf500_kalman *filter, lw_bool measured, lw_grf500_kalman_estimate *estimate) {
+    memset(estimate, 0, sizeof(*estimate));
+    estimate->timestamp_us = filter->timestamp_us;
+    estimate->range_cm = filter->x[0];
+    estimate->range_rate_cm_per_s = filter->x[1];
+    estimate->acceleration_cm_per_s2 = filter->x[2];
+    estimate->measured = measured;
+
+    for (uint32_t i = 0; i < filter->states; ++i) {
+        for (uint32_t j = 0; j < filter->states; ++j) {
+            estimate->covariance[i][j] = filter->p[i][j];
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Range Kalman filter.
+// ----------------------------------------------------------------------------
+void lw_grf500_kalman_get_default_config(lw_grf500_kalman_config *config) {
+    config->model = LW_GRF500_KALMAN_CONSTANT_VELOCITY;
+    config->distance_field = LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW;
+    config->strength_field = LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_STRENGTH;
+    config->process_noise = 1000;
+    config->measurement_noise_cm = 10;
+    config->reference_strength = 50;
+    config->initial_rate_noise = 1000;
+    config->initial_acceleration_noise = 1000;
+    config->max_gap_us = 1000000;
+}
+
+lw_result lw_grf500_kalman_init(lw_grf500_kalman *filter, const lw_grf500_kalman_config *config) {
+    memset(filter, 0, sizeof(*filter));
+
+    if (config) {
+        filter->config = *config;
+    } else {
+        lw_grf500_kalman_get_default_config(&filter->config);
+    }
+
+    config = &filter->config;
+
+    if (config->model != LW_GRF500_KALMAN_CONSTANT_VELOCITY && config->model != LW_GRF500_KALMAN_CONSTANT_ACCELERATION) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (lw_grf500_get_distance_field_index(config->distance_field) < 0 || (config->strength_field != 0 && lw_grf500_get_distance_field_index(config->strength_field) < 0)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (!(config->process_noise > 0) || !(config->measurement_noise_cm > 0) || !(config->reference_strength > 0)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    filter->states = (uint32_t)config->model;
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_kalman_reset(lw_grf500_kalman *filter) {
+    filter->started = LW_FALSE;
+}
+
+lw_result lw_grf500_kalman_update(lw_grf500_kalman *filter, uint64_t timestamp_us, int32_t distance_cm, int32_t strength, lw_grf500_kalman_estimate *estimate) {
+    const lw_grf500_kalman_config *config = &filter->config;
+    lw_bool measured = (distance_cm != LW_GRF500_LOST_SIGNAL_DISTANCE);
+
+    if (filter->started && timestamp_us > filter->measurement_us + config->max_gap_us) {
+        LW_DEBUG_LVL_2("Kalman: No measurement for %d ms, starting over\n", (int32_t)((timestamp_us - filter->measurement_us) / 1000));
+        filter->started = LW_FALSE;
+    }
+
+    float noise = config->measurement_noise_cm * config->measurement_noise_cm;
+
+    if (strength > 0 && (float)strength < config->reference_strength) {
+        noise *= config->reference_strength / (float)strength;
+    }
+
+    if (!filter->started) {
+        if (!measured) {
+            return LW_RESULT_AGAIN;
+        }
+
+        lw_kalman_start(filter, timestamp_us, (float)distance_cm, noise);
+    } else {
+        if (timestamp_us > filter->timestamp_us) {
+            lw_kalman_predict(filter, (float)(timestamp_us - filter->timestamp_us) / 1000000.0f);
+            filter->timestamp_us = timestamp_us;
+        }
+
+        if (measured) {
+            lw_kalman_correct(filter, (float)distance_cm, noise);
+            filter->measurement_us = timestamp_us;
+        }
+    }
+
+    if (estimate) {
+        lw_kalman_get_estimate(filter, measured, estimate);
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+lw_result lw_grf500_kalman_update_sample(lw_grf500_kalman *filter, const lw_grf500_distance_sample *sample, lw_grf500_kalman_estimate *estimate) {
+    int32_t distance = lw_grf500_get_distance_field(&sample->data, (uint32_t)lw_grf500_get_distance_field_index(filter->config.distance_field));
+    int32_t strength = 0;
+
+    if (filter->config.strength_field != 0) {
+        // A valid return with no strength is as weak as it gets.
+        strength = lw_grf500_get_distance_field(&sample->data, (uint32_t)lw_grf500_get_distance_field_index(filter->config.strength_field));
+        strength = (strength < 1) ? 1 : strength;
+    }
+
+    return lw_grf500_kalman_update(filter, sample->timestamp_us, distance, strength, estimate);
+}
@@ -0,0 +1,163 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Range Kalman Filter
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_KALMAN_H
+#define LW_GRF500_KALMAN_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Range Kalman filter.
+//
+// Estimates range, range rate and, for the constant acceleration model,
+// range acceleration from the distance stream, one sample at a time. Each
+// sample is predicted forward by the time since the previous one, using the
+// sample timestamps, so uneven sample spacing and dropped samples are
+// handled.
+//
+// A lost signal reading is a missing measurement: the estimate is predicted
+// to the sample time and its covariance grows, but nothing is corrected. If
+// no measurement arrives for longer than the max gap, the filter starts over
+// at the next measurement.
+//
+// The measurement noise scales with the return strength. The variance is
+// measurement_noise_cm^2 at the reference strength, and grows in inverse
+// proportion to the strength below it.
+//
+// The range rate is negative while the target closes in. The filter keeps
+// no history, and an update costs a fixed number of operations.
+// ----------------------------------------------------------------------------
+typedef enum {
+    LW_GRF500_KALMAN_CONSTANT_VELOCITY = 2,
+    LW_GRF500_KALMAN_CONSTANT_ACCELERATION = 3,
+} lw_grf500_kalman_model;
+
+#define LW_GRF500_KALMAN_MAX_STATES 3
+
+typedef struct {
+    lw_grf500_kalman_model model;
+
+    // The distance and strength fields used from distance samples, each a
+    // single distance config flag. A strength field of 0 uses the
+    // measurement noise as is.
+    lw_grf500_distance_config distance_field;
+    lw_grf500_distance_config strength_field;
+
+    // Spectral density of the white noise driving the model, acceleration
+    // for constant velocity in cm^2/s^3, jerk for constant acceleration in
+    // cm^2/s^5. Larger values follow manoeuvres faster but smooth less.
+    float process_noise;
+
+    // Measurement standard deviation in cm at the reference strength.
+    float measurement_noise_cm;
+    float reference_strength;
+
+    // Standard deviations of the range rate in cm/s and acceleration in
+    // cm/s^2 when the filter starts.
+    float initial_rate_noise;
+    float initial_acceleration_noise;
+
+    // Time without a measurement after which the filter starts over.
+    uint64_t max_gap_us;
+} lw_grf500_kalman_config;
+
+typedef struct {
+    uint64_t timestamp_us;
+    float range_cm;
+    float range_rate_cm_per_s;
+    float acceleration_cm_per_s2;
+
+    // Covariance of range, range rate and acceleration. The acceleration row
+    // and column are 0 for the constant velocity model.
+    float covariance[LW_GRF500_KALMAN_MAX_STATES][LW_GRF500_KALMAN_MAX_STATES];
+
+    // LW_FALSE if the sample had no measurement and the estimate is a prediction.
+    lw_bool measured;
+} lw_grf500_kalman_estimate;
+
+typedef struct {
+    lw_grf500_kalman_config config;
+    uint32_t states;
+    lw_bool started;
+    uint64_t timestamp_us;
+    uint64_t measurement_us;
+    float x[LW_GRF500_KALMAN_MAX_STATES];
+    float p[LW_GRF500_KALMAN_MAX_STATES][LW_GRF500_KALMAN_MAX_STATES];
+} lw_grf500_kalman;
+
+/*
+ * Get a filter config with defaults: constant velocity on the first return
+ * raw distance, with noise weighted by the first return strength.
+ *
+ * @param config The config is written here.
+ */
+void lw_grf500_kalman_get_default_config(lw_grf500_kalman_config *config);
+
+/*
+ * Initialize a filter.
+ *
+ * @param filter The filter to initialize.
+ * @param config The config, NULL for the defaults.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the config is out of range.
+ */
+lw_result lw_grf500_kalman_init(lw_grf500_kalman *filter, const lw_grf500_kalman_config *config);
+
+/*
+ * Forget the estimate. The filter starts over at the next measurement.
+ *
+ * @param filter The filter.
+ */
+void lw_grf500_kalman_reset(lw_grf500_kalman *filter);
+
+/*
+ * Update the filter with a reading. Readings must be in time order.
+ *
+ * @param filter The filter.
+ * @param timestamp_us The time of the reading.
+ * @param distance_cm The distance, or LW_GRF500_LOST_SIGNAL_DISTANCE for a missing measurement.
+ * @param strength The return strength, 0 or less to use the measurement noise as is.
+ * @param estimate The estimate at the time of the reading is written here, can be NULL.
+ * @return LW_RESULT_SUCCESS if the estimate was written, or LW_RESULT_AGAIN if the filter has not started yet.
+ */
+lw_result lw_grf500_kalman_update(lw_grf500_kalman *filter, uint64_t timestamp_us, int32_t distance_cm, int32_t strength, lw_grf500_kalman_estimate *estimate);
+
+/*
+ * Update the filter with the configured fields of a distance sample.
+ *
+ * @param filter The filter.
+ * @param sample The sample.
+ * @param estimate The estimate at the time of the sample is written here, can be NULL.
+ * @return LW_RESULT_SUCCESS if the estimate was written, or LW_RESULT_AGAIN if the filter has not started yet.
+ */
+lw_result lw_grf500_kalman_update_sample(lw_grf500_kalman *filter, const lw_grf500_distance_sample *sample, lw_grf500_kalman_estimate *estimate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_KALMAN_H
@@ -0,0 +1,134 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Latest Value Cell
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_latest.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint64_t lw_latest_publish(lw_grf500_latest *latest, const void *sample, uint32_t size) {
+    uint64_t sequence = latest->sequence + 1;
+    lw_grf500_latest_slot *slot = &latest->slots[sequence & 1];
+
+    lw_seqlock_write_begin(&slot->lock);
+    slot->sequence = sequence;
+    memcpy(&slot->sample, sample, size);
+    lw_seqlock_write_end(&slot->lock);
+
+    latest->sequence = sequence;
+    LW_SEQLOCK_STORE_RELEASE(&latest->published, (uint32_t)sequence);
+
+    return sequence;
+}
+
+static lw_result lw_latest_read(const lw_grf500_latest *latest, void *sample, uint32_t size, uint64_t *sequence_out) {
+    for (uint32_t attempt = 0; attempt < LW_GRF500_LATEST_READ_ATTEMPTS; ++attempt) {
+        uint32_t published = LW_SEQLOCK_LOAD_ACQUIRE(&latest->published);
+        const lw_grf500_latest_slot *slot = &latest->slots[published & 1];
+        uint32_t lock_sequence = lw_seqlock_read_begin(&slot->lock);
+        uint64_t slot_sequence = slot->sequence;
+        memcpy(sample, &slot->sample, size);
+
+        if (lw_seqlock_read_retry(&slot->lock, lock_sequence)) {
+            continue;
+        }
+
+        if (slot_sequence == 0) {
+            return LW_RESULT_AGAIN;
+        }
+
+        // The slot may already hold a newer sample than the one we looked
+        // for, which is just as good.
+        if ((int32_t)((uint32_t)slot_sequence - published) >= 0) {
+            if (sequence_out) {
+                *sequence_out = slot_sequence;
+            }
+
+            return LW_RESULT_SUCCESS;
+        }
+    }
+
+    return LW_RESULT_AGAIN;
+}
+
+static lw_result lw_latest_check_age(uint64_t timestamp_us, uint64_t now_us, uint64_t max_age_us) {
+    if (max_age_us != 0 && now_us > timestamp_us && now_us - timestamp_us > max_age_us) {
+        return LW_RESULT_TIMEOUT;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+// Latest value cell.
+// ----------------------------------------------------------------------------
+void lw_grf500_latest_init(lw_grf500_latest *latest) {
+    memset(latest, 0, sizeof(*latest));
+    lw_seqlock_init(&latest->slots[0].lock);
+    lw_seqlock_init(&latest->slots[1].lock);
+    LW_SEQLOCK_STORE_RELEASE(&latest->published, 0);
+}
+
+uint64_t lw_grf500_latest_publish_distance(lw_grf500_latest *latest, const lw_grf500_distance_sample *sample) {
+    return lw_latest_publish(latest, sample, sizeof(*sample));
+}
+
+uint64_t lw_grf500_latest_publish_multi(lw_grf500_latest *latest, const lw_grf500_multi_sample *sample) {
+    return lw_latest_publish(latest, sample, sizeof(*sample));
+}
+
+lw_result lw_grf500_latest_get_sequence(const lw_grf500_latest *latest, uint64_t *sequence) {
+    for (uint32_t attempt = 0; attempt < LW_GRF500_LATEST_READ_ATTEMPTS; ++attempt) {
+        uint32_t published = LW_SEQLOCK_LOAD_ACQUIRE(&latest->published);
+        const lw_grf500_latest_slot *slot = &latest->slots[published & 1];
+        uint32_t lock_sequence = lw_seqlock_read_begin(&slot->lock);
+        uint64_t slot_sequence = slot->sequence;
+
+        if (lw_seqlock_read_retry(&slot->lock, lock_sequence)) {
+            continue;
+        }
+
+        if (slot_sequence == 0) {
+            return LW_RESULT_AGAIN;
+        }
+
+        if ((int32_t)((uint32_t)slot_sequence - published) >= 0) {
+            *sequence = slot_sequence;
+            return LW_RESULT_SUCCESS;
+        }
+    }
+
+    return LW_RESULT_AGAIN;
+}
+
+lw_result lw_grf500_latest_read_distance(const lw_grf500_latest *latest, uint64_t now_us, uint64_t max_age_us, lw_grf500_distance_sample *sample, uint64_t *sequence) {
+    LW_CHECK_SUCCESS(lw_latest_read(latest, sample, sizeof(*sample), sequence))
+    return lw_latest_check_age(sample->timestamp_us, now_us, max_age_us);
+}
+
+lw_result lw_grf500_latest_read_multi(const lw_grf500_latest *latest, uint64_t now_us, uint64_t max_age_us, lw_grf500_multi_sample *sample, uint64_t *sequence) {
+    LW_CHECK_SUCCESS(lw_latest_read(latest, sample, sizeof(*sample), sequence))
+    return lw_latest_check_age(sample->timestamp_us, now_us, max_age_us);
+}
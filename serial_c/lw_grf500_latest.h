@@ -0,0 +1,150 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Latest Value Cell
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_LATEST_H
+#define LW_GRF500_LATEST_H
+
+#include "lw_grf500_sample.h"
+#include "lw_seqlock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Latest value cell.
+//
+// A latest value cell holds only the newest sample from a device, for
+// control loops that want the freshest reading rather than a queue of old
+// ones. The I/O side publishes every sample it decodes, and any number of
+// readers take a copy whenever they like, in constant time, without locks or
+// system calls and without ever delaying the writer.
+//
+// The cell keeps two slots, each with its own seqlock, and the writer
+// alternates between them. A reader copies the slot of the newest sample, and
+// that copy can only be torn if the writer publishes twice while it is being
+// made, so reads are bounded to a few attempts.
+//
+// Every sample is given a 64 bit sequence number, starting at 1, that goes up
+// by one per publish. Readers compare it to the last one they saw to tell a
+// new sample from a repeat and to count samples they skipped, and compare the
+// timestamp to the current time to tell a stale sample from a fresh one.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_LATEST_READ_ATTEMPTS
+#define LW_GRF500_LATEST_READ_ATTEMPTS 8
+#endif
+
+typedef union {
+    lw_grf500_distance_sample distance;
+    lw_grf500_multi_sample multi;
+} lw_grf500_latest_sample;
+
+typedef struct {
+    lw_seqlock lock;
+    uint32_t reserved;
+    uint64_t sequence;
+    lw_grf500_latest_sample sample;
+} lw_grf500_latest_slot;
+
+typedef struct {
+    lw_grf500_latest_slot slots[2];
+
+    // Low 32 bits of the sequence number of the newest sample, which picks
+    // the slot to read. The full number is kept in the slot.
+    volatile uint32_t published;
+    uint32_t reserved;
+
+    // Sequence number of the newest sample, only used by the writer.
+    uint64_t sequence;
+} lw_grf500_latest;
+
+/*
+ * Initialize an empty latest value cell.
+ *
+ * @param latest The cell.
+ */
+void lw_grf500_latest_init(lw_grf500_latest *latest);
+
+/*
+ * Publish a distance sample, replacing the previous one. There must only ever
+ * be one writer.
+ *
+ * @param latest The cell.
+ * @param sample The sample.
+ * @return The sequence number given to the sample.
+ */
+uint64_t lw_grf500_latest_publish_distance(lw_grf500_latest *latest, const lw_grf500_distance_sample *sample);
+
+/*
+ * Publish a multi sample, replacing the previous one. There must only ever be
+ * one writer.
+ *
+ * @param latest The cell.
+ * @param sample The sample.
+ * @return The sequence number given to the sample.
+ */
+uint64_t lw_grf500_latest_publish_multi(lw_grf500_latest *latest, const lw_grf500_multi_sample *sample);
+
+/*
+ * Get the sequence number of the newest sample, without copying it. This is
+ * enough to check whether a new sample has arrived.
+ *
+ * @param latest The cell.
+ * @param sequence The sequence number is written here.
+ * @return LW_RESULT_SUCCESS on success,
+ *         or LW_RESULT_AGAIN if nothing has been published or the writer kept overlapping the read.
+ */
+lw_result lw_grf500_latest_get_sequence(const lw_grf500_latest *latest, uint64_t *sequence);
+
+/*
+ * Copy the newest distance sample.
+ *
+ * @param latest The cell.
+ * @param now_us The current time, on the same clock as the sample timestamps.
+ * @param max_age_us The age beyond which the sample counts as stale, or 0 to never treat it as stale.
+ * @param sample The sample is written here.
+ * @param sequence The sequence number of the sample is written here, can be NULL.
+ * @return LW_RESULT_SUCCESS on success, LW_RESULT_TIMEOUT if the sample is stale, it is still copied,
+ *         or LW_RESULT_AGAIN if nothing has been published or the writer kept overlapping the read.
+ */
+lw_result lw_grf500_latest_read_distance(const lw_grf500_latest *latest, uint64_t now_us, uint64_t max_age_us, lw_grf500_distance_sample *sample, uint64_t *sequence);
+
+/*
+ * Copy the newest multi sample, the same way as lw_grf500_latest_read_distance.
+ *
+ * @param latest The cell.
+ * @param now_us The current time, on the same clock as the sample timestamps.
+ * @param max_age_us The age beyond which the sample counts as stale, or 0 to never treat it as stale.
+ * @param sample The sample is written here.
+ * @param sequence The sequence number of the sample is written here, can be NULL.
+ * @return LW_RESULT_SUCCESS on success, LW_RESULT_TIMEOUT if the sample is stale, it is still copied,
+ *         or LW_RESULT_AGAIN if nothing has been published or the writer kept overlapping the read.
+ */
+lw_result lw_grf500_latest_read_multi(const lw_grf500_latest *latest, uint64_t now_us, uint64_t max_age_us, lw_grf500_multi_sample *sample, uint64_t *sequence);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_LATEST_H
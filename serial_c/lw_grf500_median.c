@@ -0,0 +1,193 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Sliding Median
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_median.h"
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+//
+// Heap positions are relative to the median at position 0. The max heap of
+// the lower half uses negative positions and the min heap of the upper half
+// positive ones, and the children of position i are 2i and 2i+1, or 2i and
+// 2i-1 on the negative side.
+// ----------------------------------------------------------------------------
+static int32_t lw_median_min_count(const lw_grf500_median *median) {
+    return ((int32_t)median->count - 1) / 2;
+}
+
+static int32_t lw_median_max_count(const lw_grf500_median *median) {
+    return (int32_t)median->count / 2;
+}
+
+static lw_bool lw_median_less(const lw_grf500_median *median, int32_t i, int32_t j) {
+    return median->values[median->heap[i]] < median->values[median->heap[j]];
+}
+
+// Swap heap positions i and j if the value at i is less than the value at j.
+static lw_bool lw_median_order(lw_grf500_median *median, int32_t i, int32_t j) {
+    if (!lw_median_less(median, i, j)) {
+        return LW_FALSE;
+    }
+
+    int32_t swap = median->heap[i];
+    median->heap[i] = median->heap[j];
+    median->heap[j] = swap;
+    median->positions[median->heap[i]] = i;
+    median->positions[median->heap[j]] = j;
+
+    return LW_TRUE;
+}
+
+// Sift down the min heap, starting at child position i.
+static void lw_median_min_sift_down(lw_grf500_median *median, int32_t i) {
+    int32_t count = lw_median_min_count(median);
+
+    for (; i <= count; i *= 2) {
+        if (i > 1 && i < count && lw_median_less(median, i + 1, i)) {
+            i++;
+        }
+
+        if (!lw_median_order(median, i, i / 2)) {
+            break;
+        }
+    }
+}
+
+// Sift down the max heap, starting at child position i.
+static void lw_median_max_sift_down(lw_grf500_median *median, int32_t i) {
+    int32_t count = lw_median_max_count(median);
+
+    for (; i >= -count; i *= 2) {
+        if (i < -1 && i > -count && lw_median_less(median, i, i - 1)) {
+            i--;
+        }
+
+        if (!lw_median_order(median, i / 2, i)) {
+            break;
+        }
+    }
+}
+
+// Sift up the min heap, returns LW_TRUE if the value reached the median.
+static lw_bool lw_median_min_sift_up(lw_grf500_median *median, int32_t i) {
+    while (i > 0 && lw_median_order(median, i, i / 2)) {
+        i /= 2;
+    }
+
+    return i == 0;
+}
+
+// Sift up the max heap, returns LW_TRUE if the value reached the median.
+static lw_bool lw_median_max_sift_up(lw_grf500_median *median, int32_t i) {
+    while (i < 0 && lw_median_order(median, i / 2, i)) {
+        i /= 2;
+    }
+
+    return i == 0;
+}
+
+// ----------------------------------------------------------------------------
+// Sliding median.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_median_init(lw_grf500_median *median, uint32_t window_size, void *storage, uint64_t storage_size) {
+    if (window_size == 0 || window_size > INT32_MAX / 2 || storage == 0 || storage_size < LW_GRF500_MEDIAN_STORAGE_SIZE(window_size)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    int32_t *memory = (int32_t *)storage;
+    median->values = memory;
+    median->positions = memory + window_size;
+    median->heap = memory + window_size * 2 + window_size / 2;
+    median->window_size = window_size;
+    lw_grf500_median_reset(median);
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_median_reset(lw_grf500_median *median) {
+    median->index = 0;
+    median->count = 0;
+
+    // Ring positions alternate between the two heaps, spreading out from the median.
+    for (uint32_t i = 0; i < median->window_size; ++i) {
+        int32_t position = (int32_t)((i + 1) / 2) * ((i & 1) ? -1 : 1);
+        median->values[i] = 0;
+        median->positions[i] = position;
+        median->heap[position] = (int32_t)i;
+    }
+}
+
+int32_t lw_grf500_median_push(lw_grf500_median *median, int32_t value) {
+    lw_bool filling = (median->count < median->window_size);
+    int32_t position = median->positions[median->index];
+    int32_t old = median->values[median->index];
+
+    median->values[median->index] = value;
+    median->index = (median->index + 1 == median->window_size) ? 0 : median->index + 1;
+    median->count += filling ? 1 : 0;
+
+    if (position > 0) {
+        if (!filling && old < value) {
+            lw_median_min_sift_down(median, position * 2);
+        } else if (lw_median_min_sift_up(median, position)) {
+            lw_median_max_sift_down(median, -1);
+        }
+    } else if (position < 0) {
+        if (!filling && value < old) {
+            lw_median_max_sift_down(median, position * 2);
+        } else if (lw_median_max_sift_up(median, position)) {
+            lw_median_min_sift_down(median, 1);
+        }
+    } else {
+        if (lw_median_max_count(median) > 0) {
+            lw_median_max_sift_down(median, -1);
+        }
+
+        if (lw_median_min_count(median) > 0) {
+            lw_median_min_sift_down(median, 1);
+        }
+    }
+
+    int32_t result = 0;
+    lw_grf500_median_get(median, &result);
+
+    return result;
+}
+
+lw_result lw_grf500_median_get(const lw_grf500_median *median, int32_t *value) {
+    if (median->count == 0) {
+        return LW_RESULT_AGAIN;
+    }
+
+    // With an even count the median position holds the upper middle value,
+    // and the top of the max heap the lower one.
+    int32_t position = (median->count & 1) ? 0 : -1;
+    *value = median->values[median->heap[position]];
+
+    return LW_RESULT_SUCCESS;
+}
+
+uint32_t lw_grf500_median_get_count(const lw_grf500_median *median) {
+    return median->count;
+}
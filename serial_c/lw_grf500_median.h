@@ -0,0 +1,113 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Sliding Median
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_MEDIAN_H
+#define LW_GRF500_MEDIAN_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Sliding median filter.
+//
+// A host side median over the last N values of a stream, for windows far
+// larger than the on-device median filter, while the raw values stay
+// available. Each new value replaces the oldest one in O(log N) time.
+//
+// The window is kept in a ring in arrival order, together with two heaps of
+// ring positions laid out back to back around the median: a max heap of the
+// lower half and a min heap of the upper half. The replaced value's heap
+// entry is reused for the new value and sifted into place, then the two
+// heap tops are swapped with the median if they are out of order.
+//
+// The filter does not allocate. The caller provides storage of
+// LW_GRF500_MEDIAN_STORAGE_SIZE(window_size) bytes, so any number of filters
+// with any window size can be used. Lost signal readings are best left out
+// rather than pushed, so the window covers the last N valid readings.
+// ----------------------------------------------------------------------------
+
+// Storage needed for a filter, in bytes.
+#define LW_GRF500_MEDIAN_STORAGE_SIZE(window_size) ((uint64_t)(window_size) * 3 * sizeof(int32_t))
+
+typedef struct {
+    int32_t *values;
+    int32_t *positions;
+    int32_t *heap;
+    uint32_t window_size;
+    uint32_t index;
+    uint32_t count;
+} lw_grf500_median;
+
+/*
+ * Initialize a sliding median filter.
+ *
+ * @param median The filter to initialize.
+ * @param window_size The number of values in the window.
+ * @param storage Storage for the filter, aligned to 4 bytes. It must stay valid while the filter is used.
+ * @param storage_size The size of the storage, at least LW_GRF500_MEDIAN_STORAGE_SIZE(window_size).
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER on failure.
+ */
+lw_result lw_grf500_median_init(lw_grf500_median *median, uint32_t window_size, void *storage, uint64_t storage_size);
+
+/*
+ * Empty the window.
+ *
+ * @param median The filter.
+ */
+void lw_grf500_median_reset(lw_grf500_median *median);
+
+/*
+ * Add a value to the window, replacing the oldest value once the window is full.
+ *
+ * @param median The filter.
+ * @param value The new value.
+ * @return The median of the window including the new value. For an even number of values it is the lower of the two middle values.
+ */
+int32_t lw_grf500_median_push(lw_grf500_median *median, int32_t value);
+
+/*
+ * Get the median of the window.
+ *
+ * @param median The filter.
+ * @param value The median is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_AGAIN if the window is empty.
+ */
+lw_result lw_grf500_median_get(const lw_grf500_median *median, int32_t *value);
+
+/*
+ * Get the number of values in the window.
+ *
+ * @param median The filter.
+ * @return The number of values, at most the window size.
+ */
+uint32_t lw_grf500_median_get_count(const lw_grf500_median *median);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_MEDIAN_H
@@ -0,0 +1,367 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Quantile Sketch
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_quantile.h"
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Distance fields, the ones that can report a lost signal.
+#define LW_QUANTILE_DISTANCE_FIELDS (LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_RAW | LW_GRF500_DISTANCE_CONFIG_FIRST_RETURN_FILTERED | \
+                                     LW_GRF500_DISTANCE_CONFIG_LAST_RETURN_RAW | LW_GRF500_DISTANCE_CONFIG_LAST_RETURN_FILTERED)
+
+#define LW_QUANTILE_NO_PERIOD UINT64_MAX
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static int lw_quantile_compare(const void *a, const void *b) {
+    int32_t x = *(const int32_t *)a;
+    int32_t y = *(const int32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Level 0 is usually only a few values, where insertion sort beats qsort.
+static void lw_quantile_sort(int32_t *items, uint32_t count) {
+    if (count > 32) {
+        qsort(items, count, sizeof(items[0]), lw_quantile_compare);
+        return;
+    }
+
+    for (uint32_t i = 1; i < count; ++i) {
+        int32_t value = items[i];
+        uint32_t j = i;
+
+        while (j > 0 && items[j - 1] > value) {
+            items[j] = items[j - 1];
+            j--;
+        }
+
+        items[j] = value;
+    }
+}
+
+static uint32_t lw_quantile_random(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+// Capacity of every level, shrinking by 2/3 from K at the top. Returns the
+// total, the most values the levels hold before compacting.
+static uint32_t lw_quantile_capacities(uint32_t level_count, uint32_t *capacities) {
+    uint32_t capacity = LW_GRF500_QUANTILE_K;
+    uint32_t total = 0;
+
+    for (uint32_t depth = 0; depth < level_count; ++depth) {
+        uint32_t level = level_count - 1 - depth;
+        capacities[level] = (capacity < LW_GRF500_QUANTILE_MIN_CAPACITY) ? LW_GRF500_QUANTILE_MIN_CAPACITY : capacity;
+        total += capacities[level];
+        capacity = (2 * capacity + 2) / 3;
+    }
+
+    return total;
+}
+
+// Compact the lowest level at or over its capacity: keep one value if the
+// level is odd, and merge every other of the rest into the level above. A
+// new top level is added when needed. Everything below moves up to close the
+// space freed, so levels stay packed against levels[level_count].
+static void lw_quantile_compact(int32_t *items, uint32_t *levels, uint32_t *level_count, uint32_t *random) {
+    uint32_t capacities[LW_GRF500_QUANTILE_MAX_LEVELS];
+    uint32_t h = 0;
+
+    lw_quantile_capacities(*level_count, capacities);
+
+    while (h + 1 < *level_count && levels[h + 1] - levels[h] < capacities[h]) {
+        h++;
+    }
+
+    if (h + 1 == *level_count && *level_count < LW_GRF500_QUANTILE_MAX_LEVELS) {
+        levels[*level_count + 1] = levels[*level_count];
+        (*level_count)++;
+    }
+
+    uint32_t start = levels[h];
+    uint32_t end = levels[h + 1];
+    uint32_t odd = (end - start) & 1;
+    uint32_t half = (end - start) / 2;
+    uint32_t offset = lw_quantile_random(random) & 1;
+
+    if (h == 0) {
+        lw_quantile_sort(items + start, end - start);
+    }
+
+    // The smallest value stays behind when the level is odd.
+    for (uint32_t i = 0; i < half; ++i) {
+        items[start + odd + i] = items[start + odd + 2 * i + offset];
+    }
+
+    uint32_t kept = odd;
+
+    if (h + 1 < *level_count) {
+        // Merge the promoted values with the level above, writing from the
+        // bottom of the merged level up, which never overtakes unread values.
+        uint32_t a = start + odd;
+        uint32_t a_end = a + half;
+        uint32_t b = end;
+        uint32_t b_end = levels[h + 2];
+        uint32_t w = a_end;
+
+        while (a < a_end) {
+            items[w++] = (b < b_end && items[b] < items[a]) ? items[b++] : items[a++];
+        }
+
+        levels[h + 1] = start + odd + half;
+    } else {
+        // Out of levels, the top level compacts into itself. This only
+        // happens after some 2^50 values.
+        kept = odd + half;
+    }
+
+    memmove(items + levels[0] + half, items + levels[0], (start + kept - levels[0]) * sizeof(items[0]));
+
+    for (uint32_t i = 0; i <= h; ++i) {
+        levels[i] += half;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Quantile sketch.
+// ----------------------------------------------------------------------------
+void lw_grf500_quantile_init(lw_grf500_quantile_sketch *sketch) {
+    uint32_t capacities[1];
+
+    sketch->count = 0;
+    sketch->min = INT32_MAX;
+    sketch->max = INT32_MIN;
+    sketch->random = 0x9E3779B9;
+    sketch->level_count = 1;
+    sketch->target = lw_quantile_capacities(1, capacities);
+    sketch->levels[0] = LW_GRF500_QUANTILE_CAPACITY;
+    sketch->levels[1] = LW_GRF500_QUANTILE_CAPACITY;
+}
+
+void lw_grf500_quantile_add(lw_grf500_quantile_sketch *sketch, int32_t value) {
+    uint32_t capacities[LW_GRF500_QUANTILE_MAX_LEVELS];
+
+    while (LW_GRF500_QUANTILE_CAPACITY - sketch->levels[0] >= sketch->target) {
+        lw_quantile_compact(sketch->items, sketch->levels, &sketch->level_count, &sketch->random);
+        sketch->target = lw_quantile_capacities(sketch->level_count, capacities);
+    }
+
+    sketch->items[--sketch->levels[0]] = value;
+    sketch->count++;
+    sketch->min = (value < sketch->min) ? value : sketch->min;
+    sketch->max = (value > sketch->max) ? value : sketch->max;
+}
+
+void lw_grf500_quantile_merge(lw_grf500_quantile_sketch *sketch, const lw_grf500_quantile_sketch *other) {
+    int32_t items[2 * LW_GRF500_QUANTILE_CAPACITY];
+    uint32_t levels[LW_GRF500_QUANTILE_MAX_LEVELS + 1];
+    uint32_t capacities[LW_GRF500_QUANTILE_MAX_LEVELS];
+    uint32_t level_count = (sketch->level_count > other->level_count) ? sketch->level_count : other->level_count;
+    uint32_t position = 2 * LW_GRF500_QUANTILE_CAPACITY;
+
+    if (other->count == 0) {
+        return;
+    }
+
+    // Lay out the union of both sketches level by level, packed at the end.
+    levels[level_count] = position;
+
+    for (uint32_t h = level_count; h-- > 0;) {
+        const int32_t *a = sketch->items + ((h < sketch->level_count) ? sketch->levels[h] : 0);
+        const int32_t *b = other->items + ((h < other->level_count) ? other->levels[h] : 0);
+        uint32_t a_size = (h < sketch->level_count) ? sketch->levels[h + 1] - sketch->levels[h] : 0;
+        uint32_t b_size = (h < other->level_count) ? other->levels[h + 1] - other->levels[h] : 0;
+        uint32_t i = 0;
+        uint32_t j = 0;
+
+        position -= a_size + b_size;
+        levels[h] = position;
+
+        if (h == 0) {
+            memcpy(items + position, a, a_size * sizeof(items[0]));
+            memcpy(items + position + a_size, b, b_size * sizeof(items[0]));
+            continue;
+        }
+
+        for (uint32_t w = position; w < levels[h + 1]; ++w) {
+            items[w] = (j < b_size && (i == a_size || b[j] < a[i])) ? b[j++] : a[i++];
+        }
+    }
+
+    uint32_t target = lw_quantile_capacities(level_count, capacities);
+
+    while (2 * LW_GRF500_QUANTILE_CAPACITY - levels[0] > target) {
+        lw_quantile_compact(items, levels, &level_count, &sketch->random);
+        target = lw_quantile_capacities(level_count, capacities);
+    }
+
+    uint32_t held = 2 * LW_GRF500_QUANTILE_CAPACITY - levels[0];
+    memcpy(sketch->items + LW_GRF500_QUANTILE_CAPACITY - held, items + levels[0], held * sizeof(items[0]));
+
+    for (uint32_t h = 0; h <= level_count; ++h) {
+        sketch->levels[h] = levels[h] - LW_GRF500_QUANTILE_CAPACITY;
+    }
+
+    sketch->level_count = level_count;
+    sketch->target = target;
+    sketch->count += other->count;
+    sketch->min = (other->min < sketch->min) ? other->min : sketch->min;
+    sketch->max = (other->max > sketch->max) ? other->max : sketch->max;
+}
+
+lw_result lw_grf500_quantile_get(const lw_grf500_quantile_sketch *sketch, const float *fractions, uint32_t count, int32_t *values) {
+    int32_t level_zero[LW_GRF500_QUANTILE_CAPACITY];
+    uint32_t heads[LW_GRF500_QUANTILE_MAX_LEVELS];
+    uint32_t ends[LW_GRF500_QUANTILE_MAX_LEVELS];
+    uint64_t total_weight = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!(fractions[i] >= 0 && fractions[i] <= 1) || (i > 0 && fractions[i] < fractions[i - 1])) {
+            return LW_RESULT_INVALID_PARAMETER;
+        }
+    }
+
+    if (sketch->count == 0) {
+        return LW_RESULT_AGAIN;
+    }
+
+    uint32_t level_zero_size = sketch->levels[1] - sketch->levels[0];
+    memcpy(level_zero, sketch->items + sketch->levels[0], level_zero_size * sizeof(level_zero[0]));
+    lw_quantile_sort(level_zero, level_zero_size);
+
+    for (uint32_t h = 0; h < sketch->level_count; ++h) {
+        heads[h] = sketch->levels[h];
+        ends[h] = sketch->levels[h + 1];
+        total_weight += (uint64_t)(ends[h] - heads[h]) << h;
+    }
+
+    // Walk all levels in value order, adding up weights.
+    uint64_t weight = 0;
+    uint32_t next = 0;
+
+    while (next < count) {
+        int32_t value = 0;
+        uint32_t level = LW_GRF500_QUANTILE_MAX_LEVELS;
+
+        for (uint32_t h = 0; h < sketch->level_count; ++h) {
+            if (heads[h] == ends[h]) {
+                continue;
+            }
+
+            int32_t candidate = (h == 0) ? level_zero[heads[0] - sketch->levels[0]] : sketch->items[heads[h]];
+
+            if (level == LW_GRF500_QUANTILE_MAX_LEVELS || candidate < value) {
+                value = candidate;
+                level = h;
+            }
+        }
+
+        if (level == LW_GRF500_QUANTILE_MAX_LEVELS) {
+            break;
+        }
+
+        heads[level]++;
+        weight += (uint64_t)1 << level;
+
+        // Allow for the fractions being floats, so 0.99f of 100 values is 99.
+        while (next < count && (double)weight >= ((double)fractions[next] - FLT_EPSILON) * (double)total_weight) {
+            values[next++] = value;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (fractions[i] == 0) {
+            values[i] = sketch->min;
+        } else if (fractions[i] == 1 || i >= next) {
+            values[i] = sketch->max;
+        }
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+// Rolling window.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_quantile_window_init(lw_grf500_quantile_window *window, lw_grf500_distance_config field, uint64_t window_us) {
+    lw_bool single = (field != 0 && (field & (field - 1)) == 0 && field <= LW_GRF500_DISTANCE_CONFIG_ALARM_STATUS);
+
+    if (!single || window_us < LW_GRF500_QUANTILE_WINDOW_SLOTS) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    window->field = field;
+    window->slot_us = window_us / LW_GRF500_QUANTILE_WINDOW_SLOTS;
+
+    for (uint32_t i = 0; i < LW_GRF500_QUANTILE_WINDOW_SLOTS; ++i) {
+        window->slot_periods[i] = LW_QUANTILE_NO_PERIOD;
+        lw_grf500_quantile_init(&window->slots[i]);
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_quantile_window_add(lw_grf500_quantile_window *window, uint64_t timestamp_us, int32_t value) {
+    uint64_t period = timestamp_us / window->slot_us;
+    uint32_t slot = (uint32_t)(period % LW_GRF500_QUANTILE_WINDOW_SLOTS);
+
+    if (window->slot_periods[slot] != period) {
+        window->slot_periods[slot] = period;
+        lw_grf500_quantile_init(&window->slots[slot]);
+    }
+
+    lw_grf500_quantile_add(&window->slots[slot], value);
+}
+
+void lw_grf500_quantile_window_add_sample(lw_grf500_quantile_window *window, const lw_grf500_distance_sample *sample) {
+    int32_t value = lw_grf500_get_distance_field(&sample->data, (uint32_t)lw_grf500_get_distance_field_index(window->field));
+
+    if ((window->field & LW_QUANTILE_DISTANCE_FIELDS) && value == LW_GRF500_LOST_SIGNAL_DISTANCE) {
+        return;
+    }
+
+    lw_grf500_quantile_window_add(window, sample->timestamp_us, value);
+}
+
+void lw_grf500_quantile_window_get(const lw_grf500_quantile_window *window, uint64_t now_us, lw_grf500_quantile_sketch *sketch) {
+    uint64_t period = now_us / window->slot_us;
+
+    lw_grf500_quantile_init(sketch);
+
+    for (uint32_t i = 0; i < LW_GRF500_QUANTILE_WINDOW_SLOTS; ++i) {
+        uint64_t slot_period = window->slot_periods[i];
+
+        if (slot_period != LW_QUANTILE_NO_PERIOD && slot_period <= period && period - slot_period < LW_GRF500_QUANTILE_WINDOW_SLOTS) {
+            lw_grf500_quantile_merge(sketch, &window->slots[i]);
+        }
+    }
+}
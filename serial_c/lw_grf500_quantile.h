@@ -0,0 +1,181 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Quantile Sketch
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_QUANTILE_H
+#define LW_GRF500_QUANTILE_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Quantile sketch.
+//
+// A KLL sketch: a fixed amount of memory that summarises any number of
+// values well enough to answer quantile queries, such as the P50, P95 and
+// P99 of distance or strength, with a rank error of about 1% at the
+// default size. Sketches can be merged, to combine sensors or time windows,
+// and the result is as accurate as a sketch fed all the values directly.
+//
+// The sketch is a stack of levels. Values are added to level 0. When the
+// sketch is full, the lowest level over its capacity is sorted and every
+// other value, starting at random, is promoted to the next level, where each
+// value stands for twice as many. Level capacities shrink by 2/3 going down
+// from the top, so memory stays bounded while the count grows, and an add
+// costs O(1) amortised.
+//
+// The minimum and maximum are exact.
+// ----------------------------------------------------------------------------
+
+// Capacity of the top level, which sets the accuracy.
+#ifndef LW_GRF500_QUANTILE_K
+#define LW_GRF500_QUANTILE_K 128
+#endif
+
+// Enough levels for 2^47 times the smallest level capacity of values.
+#define LW_GRF500_QUANTILE_MAX_LEVELS 48
+#define LW_GRF500_QUANTILE_MIN_CAPACITY 8
+
+// Room for the capacities of every level at the most levels.
+#define LW_GRF500_QUANTILE_CAPACITY (3 * LW_GRF500_QUANTILE_K + 10 * LW_GRF500_QUANTILE_MAX_LEVELS)
+
+typedef struct {
+    // Number of values summarised, including merged sketches.
+    uint64_t count;
+    int32_t min;
+    int32_t max;
+
+    uint32_t random;
+    uint32_t level_count;
+
+    // Values held before the sketch must compact.
+    uint32_t target;
+
+    // Level h holds items[levels[h]] up to items[levels[h + 1]]. Levels are
+    // packed at the end of items, with level 0 first and unsorted, and the
+    // other levels sorted.
+    uint32_t levels[LW_GRF500_QUANTILE_MAX_LEVELS + 1];
+    int32_t items[LW_GRF500_QUANTILE_CAPACITY];
+} lw_grf500_quantile_sketch;
+
+/*
+ * Initialize an empty sketch.
+ *
+ * @param sketch The sketch to initialize.
+ */
+void lw_grf500_quantile_init(lw_grf500_quantile_sketch *sketch);
+
+/*
+ * Add a value.
+ *
+ * @param sketch The sketch.
+ * @param value The value.
+ */
+void lw_grf500_quantile_add(lw_grf500_quantile_sketch *sketch, int32_t value);
+
+/*
+ * Merge a sketch into another.
+ *
+ * @param sketch The sketch merged into.
+ * @param other The sketch to merge, unchanged.
+ */
+void lw_grf500_quantile_merge(lw_grf500_quantile_sketch *sketch, const lw_grf500_quantile_sketch *other);
+
+/*
+ * Get quantiles. The quantile of fraction q is the smallest value with at
+ * least q of all values at or below it. Fraction 0 gives the minimum, and
+ * fraction 1 the maximum.
+ *
+ * @param sketch The sketch.
+ * @param fractions The fractions, 0 to 1 in ascending order.
+ * @param count The number of fractions.
+ * @param values The quantiles are written here.
+ * @return LW_RESULT_SUCCESS on success, LW_RESULT_AGAIN if the sketch is empty, or LW_RESULT_INVALID_PARAMETER if the fractions are out of order or range.
+ */
+lw_result lw_grf500_quantile_get(const lw_grf500_quantile_sketch *sketch, const float *fractions, uint32_t count, int32_t *values);
+
+// ----------------------------------------------------------------------------
+// Rolling window.
+//
+// Quantiles of one field over the recent past, for example for a dashboard.
+// The window is a ring of LW_GRF500_QUANTILE_WINDOW_SLOTS sketches, each
+// covering a slot of the window length aligned on the sample clock. Samples
+// go into the sketch of their slot, and a query merges the sketches of the
+// slots still inside the window. The window moves forward one slot at a time,
+// so it covers between window_us less one slot and window_us.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_QUANTILE_WINDOW_SLOTS
+#define LW_GRF500_QUANTILE_WINDOW_SLOTS 4
+#endif
+
+typedef struct {
+    lw_grf500_distance_config field;
+    uint64_t slot_us;
+    uint64_t slot_periods[LW_GRF500_QUANTILE_WINDOW_SLOTS];
+    lw_grf500_quantile_sketch slots[LW_GRF500_QUANTILE_WINDOW_SLOTS];
+} lw_grf500_quantile_window;
+
+/*
+ * Initialize a rolling window.
+ *
+ * @param window The window to initialize.
+ * @param field The distance data field used from distance samples, as a single distance config flag.
+ * @param window_us The length of the window in microseconds, at least LW_GRF500_QUANTILE_WINDOW_SLOTS.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER on failure.
+ */
+lw_result lw_grf500_quantile_window_init(lw_grf500_quantile_window *window, lw_grf500_distance_config field, uint64_t window_us);
+
+/*
+ * Add a value. Values must be added in time order.
+ *
+ * @param window The window.
+ * @param timestamp_us The time of the value.
+ * @param value The value.
+ */
+void lw_grf500_quantile_window_add(lw_grf500_quantile_window *window, uint64_t timestamp_us, int32_t value);
+
+/*
+ * Add the window field of a distance sample. Lost signal distances are left out.
+ *
+ * @param window The window.
+ * @param sample The sample.
+ */
+void lw_grf500_quantile_window_add_sample(lw_grf500_quantile_window *window, const lw_grf500_distance_sample *sample);
+
+/*
+ * Get a sketch of the values in the window.
+ *
+ * @param window The window.
+ * @param now_us The current time, on the same clock as the samples.
+ * @param sketch The sketch of the window is written here.
+ */
+void lw_grf500_quantile_window_get(const lw_grf500_quantile_window *window, uint64_t now_us, lw_grf500_quantile_sketch *sketch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_QUANTILE_H
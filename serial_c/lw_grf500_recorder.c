@@ -0,0 +1,278 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Recorder
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_recorder.h"
+#include <string.h>
+
+// The chunk and header layouts are part of the file format, so they must come
+// out at exactly the sizes the format declares.
+typedef char lw_grf500_recorder_chunk_size_check[(sizeof(lw_grf500_chunk) == LW_GRF500_RECORDER_CHUNK_SIZE) ? 1 : -1];
+typedef char lw_grf500_recorder_header_size_check[(sizeof(lw_grf500_recording_header) == LW_GRF500_RECORDER_ALIGNMENT) ? 1 : -1];
+
+#define LW_GRF500_RECORDER_MULTI_COLUMNS LW_GRF500_MULTI_FIELD_COUNT
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static void lw_recorder_reset_chunk(lw_grf500_chunk *chunk, uint64_t chunk_index) {
+    chunk->footer.magic = LW_GRF500_RECORDER_CHUNK_MAGIC;
+    chunk->footer.sample_count = 0;
+    chunk->footer.chunk_index = chunk_index;
+}
+
+// Min and max are found once per chunk over each column, rather than per
+// sample, which keeps appends down to plain stores.
+static void lw_recorder_update_footer(lw_grf500_recorder *recorder, lw_grf500_chunk *chunk) {
+    lw_grf500_chunk_footer *footer = &chunk->footer;
+    uint32_t count = footer->sample_count;
+
+    footer->first_timestamp_us = chunk->timestamp_us[0];
+    footer->last_timestamp_us = chunk->timestamp_us[count - 1];
+    footer->first_sequence = chunk->sequence[0];
+    footer->last_sequence = chunk->sequence[count - 1];
+
+    for (uint32_t c = 0; c < recorder->header.column_count; ++c) {
+        const int32_t *column = chunk->columns[c];
+        int32_t min = column[0];
+        int32_t max = column[0];
+
+        for (uint32_t i = 1; i < count; ++i) {
+            min = (column[i] < min) ? column[i] : min;
+            max = (column[i] > max) ? column[i] : max;
+        }
+
+        footer->min[c] = min;
+        footer->max[c] = max;
+    }
+}
+
+static uint64_t lw_recorder_chunk_offset(uint64_t chunk_index) {
+    return LW_GRF500_RECORDER_ALIGNMENT + chunk_index * LW_GRF500_RECORDER_CHUNK_SIZE;
+}
+
+static lw_result lw_recorder_complete_chunk(lw_grf500_recorder *recorder) {
+    lw_grf500_chunk *chunk = &recorder->chunks[recorder->active_chunk];
+    uint64_t chunk_index = chunk->footer.chunk_index;
+
+    lw_recorder_update_footer(recorder, chunk);
+    recorder->header.chunk_count = chunk_index + 1;
+
+    // Switch buffers before writing, so the chunk handed over is never touched
+    // again until the next one completes.
+    recorder->active_chunk ^= 1;
+    lw_recorder_reset_chunk(&recorder->chunks[recorder->active_chunk], chunk_index + 1);
+
+    return recorder->write(recorder, chunk, sizeof(*chunk), lw_recorder_chunk_offset(chunk_index));
+}
+
+static lw_result lw_recorder_append(lw_grf500_recorder *recorder, uint64_t timestamp_us, uint32_t sequence, const int32_t *values) {
+    lw_grf500_chunk *chunk = &recorder->chunks[recorder->active_chunk];
+    uint32_t i = chunk->footer.sample_count;
+
+    chunk->timestamp_us[i] = timestamp_us;
+    chunk->sequence[i] = sequence;
+
+    for (uint32_t c = 0; c < recorder->header.column_count; ++c) {
+        chunk->columns[c][i] = values[recorder->fields[c]];
+    }
+
+    if (recorder->header.sample_count == 0) {
+        recorder->header.first_timestamp_us = timestamp_us;
+    }
+
+    recorder->header.last_timestamp_us = timestamp_us;
+    recorder->header.sample_count++;
+    chunk->footer.sample_count = i + 1;
+
+    if (i + 1 == LW_GRF500_RECORDER_CHUNK_SAMPLES) {
+        return lw_recorder_complete_chunk(recorder);
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+// Recorder.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_recorder_init(lw_grf500_recorder *recorder, lw_grf500_recording_kind kind, lw_grf500_distance_config distance_config, void *user_data, lw_grf500_recorder_callback_write write) {
+    memset(recorder, 0, sizeof(*recorder));
+    recorder->user_data = user_data;
+    recorder->write = write;
+
+    lw_grf500_recording_header *header = &recorder->header;
+    memcpy(header->magic, LW_GRF500_RECORDER_MAGIC, sizeof(header->magic));
+    header->version = LW_GRF500_RECORDER_VERSION;
+    header->kind = kind;
+    header->chunk_size = LW_GRF500_RECORDER_CHUNK_SIZE;
+    header->chunk_samples = LW_GRF500_RECORDER_CHUNK_SAMPLES;
+
+    if (kind == LW_GRF500_RECORDING_DISTANCE) {
+        if ((distance_config & LW_GRF500_DISTANCE_CONFIG_ALL) == 0) {
+            return LW_RESULT_INVALID_PARAMETER;
+        }
+
+        header->distance_config = distance_config & LW_GRF500_DISTANCE_CONFIG_ALL;
+
+        // The distance data fields are laid out in config bit order.
+        for (uint32_t bit = 0; bit < 8; ++bit) {
+            if (header->distance_config & (1u << bit)) {
+                recorder->fields[header->column_count++] = (uint8_t)bit;
+            }
+        }
+    } else if (kind == LW_GRF500_RECORDING_MULTI) {
+        // Distance and strength of each return, then the temperature.
+        for (uint32_t c = 0; c < LW_GRF500_RECORDER_MULTI_COLUMNS; ++c) {
+            recorder->fields[header->column_count++] = (uint8_t)c;
+        }
+    } else {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_recorder_reset_chunk(&recorder->chunks[0], 0);
+
+    return recorder->write(recorder, header, sizeof(*header), 0);
+}
+
+lw_result lw_grf500_recorder_append_distance(lw_grf500_recorder *recorder, const lw_grf500_distance_sample *sample) {
+    if (recorder->header.kind != LW_GRF500_RECORDING_DISTANCE) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    int32_t fields[LW_GRF500_DISTANCE_FIELD_COUNT];
+    lw_grf500_get_distance_fields(&sample->data, fields);
+
+    return lw_recorder_append(recorder, sample->timestamp_us, sample->sequence, fields);
+}
+
+lw_result lw_grf500_recorder_append_multi(lw_grf500_recorder *recorder, const lw_grf500_multi_sample *sample) {
+    if (recorder->header.kind != LW_GRF500_RECORDING_MULTI) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    int32_t fields[LW_GRF500_MULTI_FIELD_COUNT];
+    lw_grf500_get_multi_fields(&sample->data, fields);
+
+    return lw_recorder_append(recorder, sample->timestamp_us, sample->sequence, fields);
+}
+
+lw_result lw_grf500_recorder_flush(lw_grf500_recorder *recorder) {
+    lw_grf500_chunk *chunk = &recorder->chunks[recorder->active_chunk];
+
+    if (chunk->footer.sample_count > 0) {
+        uint64_t chunk_index = chunk->footer.chunk_index;
+
+        lw_recorder_update_footer(recorder, chunk);
+        recorder->header.chunk_count = chunk_index + 1;
+        LW_CHECK_SUCCESS(recorder->write(recorder, chunk, sizeof(*chunk), lw_recorder_chunk_offset(chunk_index)))
+    }
+
+    return recorder->write(recorder, &recorder->header, sizeof(recorder->header), 0);
+}
+
+// ----------------------------------------------------------------------------
+// Recording access.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_recording_open(lw_grf500_recording *recording, const void *data, uint64_t size) {
+    const lw_grf500_recording_header *header = (const lw_grf500_recording_header *)data;
+
+    memset(recording, 0, sizeof(*recording));
+
+    if (size < sizeof(*header) || memcmp(header->magic, LW_GRF500_RECORDER_MAGIC, sizeof(header->magic)) != 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (header->version != LW_GRF500_RECORDER_VERSION || header->chunk_size != sizeof(lw_grf500_chunk) || header->chunk_samples != LW_GRF500_RECORDER_CHUNK_SAMPLES || header->column_count > LW_GRF500_RECORDER_MAX_COLUMNS) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    const lw_grf500_chunk *chunks = (const lw_grf500_chunk *)((const uint8_t *)data + LW_GRF500_RECORDER_ALIGNMENT);
+    uint64_t chunk_count = (size - LW_GRF500_RECORDER_ALIGNMENT) / LW_GRF500_RECORDER_CHUNK_SIZE;
+
+    // The header is only rewritten on flush, so a recording that was cut short
+    // can hold more chunks than it claims. Trust the chunk footers instead,
+    // dropping any trailing chunks that were never completely written.
+    while (chunk_count > 0) {
+        const lw_grf500_chunk_footer *footer = &chunks[chunk_count - 1].footer;
+
+        if (footer->magic == LW_GRF500_RECORDER_CHUNK_MAGIC && footer->chunk_index == chunk_count - 1 && footer->sample_count > 0 && footer->sample_count <= LW_GRF500_RECORDER_CHUNK_SAMPLES) {
+            break;
+        }
+
+        chunk_count--;
+    }
+
+    recording->header = header;
+    recording->chunks = chunks;
+    recording->chunk_count = chunk_count;
+
+    return LW_RESULT_SUCCESS;
+}
+
+const lw_grf500_chunk *lw_grf500_recording_get_chunk(const lw_grf500_recording *recording, uint64_t index) {
+    if (index >= recording->chunk_count) {
+        return NULL;
+    }
+
+    return &recording->chunks[index];
+}
+
+lw_result lw_grf500_recording_find_time(const lw_grf500_recording *recording, uint64_t timestamp_us, uint64_t *chunk_index, uint32_t *sample_index) {
+    uint64_t low = 0;
+    uint64_t high = recording->chunk_count;
+
+    // First chunk that ends at or after the time.
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+
+        if (recording->chunks[mid].footer.last_timestamp_us < timestamp_us) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == recording->chunk_count) {
+        return LW_RESULT_ERROR;
+    }
+
+    const lw_grf500_chunk *chunk = &recording->chunks[low];
+    uint32_t first = 0;
+    uint32_t last = chunk->footer.sample_count;
+
+    // First sample in the chunk at or after the time.
+    while (first < last) {
+        uint32_t mid = first + (last - first) / 2;
+
+        if (chunk->timestamp_us[mid] < timestamp_us) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+
+    *chunk_index = low;
+    *sample_index = first;
+
+    return LW_RESULT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Recorder
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_RECORDER_H
+#define LW_GRF500_RECORDER_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Columnar recording.
+//
+// The recorder appends timestamped samples to fixed-size chunks. A chunk holds
+// LW_GRF500_RECORDER_CHUNK_SAMPLES samples, stored column by column: all the
+// timestamps, then all the sequence numbers, then one array per data field.
+// A footer at the end of every chunk holds the sample count, the time range
+// and the minimum and maximum of every column.
+//
+// A recording is a header page followed by the chunks. Both are whole
+// multiples of LW_GRF500_RECORDER_ALIGNMENT bytes and are always written at
+// aligned offsets, so a recording can be written with direct I/O and read
+// back by mapping the file into memory and casting, without any parsing.
+//
+// The recorder does no I/O itself. Completed chunks are handed to a write
+// callback, which can write them straight away or queue them for an I/O
+// thread. Chunks are double buffered: the buffer passed to the callback is
+// not touched again until the following chunk has been completed.
+//
+// Distance recordings use one column per distance config bit, in bit order.
+// Multi recordings use a distance and strength column for each of the 5
+// returns, followed by the temperature.
+// ----------------------------------------------------------------------------
+#define LW_GRF500_RECORDER_ALIGNMENT 4096
+#define LW_GRF500_RECORDER_CHUNK_SAMPLES 1024
+#define LW_GRF500_RECORDER_MAX_COLUMNS 11
+#define LW_GRF500_RECORDER_VERSION 1
+
+#define LW_GRF500_RECORDER_MAGIC "LWGRFREC"
+#define LW_GRF500_RECORDER_CHUNK_MAGIC 0x4B43574C // "LWCK"
+
+typedef enum {
+    LW_GRF500_RECORDING_DISTANCE = 1,
+    LW_GRF500_RECORDING_MULTI = 2,
+} lw_grf500_recording_kind;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sample_count;
+    uint64_t chunk_index;
+    uint64_t first_timestamp_us;
+    uint64_t last_timestamp_us;
+    uint32_t first_sequence;
+    uint32_t last_sequence;
+    int32_t min[LW_GRF500_RECORDER_MAX_COLUMNS];
+    int32_t max[LW_GRF500_RECORDER_MAX_COLUMNS];
+} lw_grf500_chunk_footer;
+
+#define LW_GRF500_RECORDER_CHUNK_DATA_SIZE                                                                     \
+    (LW_GRF500_RECORDER_CHUNK_SAMPLES * (sizeof(uint64_t) + sizeof(uint32_t) + LW_GRF500_RECORDER_MAX_COLUMNS * sizeof(int32_t)) + \
+     sizeof(lw_grf500_chunk_footer))
+
+#define LW_GRF500_RECORDER_CHUNK_SIZE                                                                          \
+    (((LW_GRF500_RECORDER_CHUNK_DATA_SIZE + LW_GRF500_RECORDER_ALIGNMENT - 1) / LW_GRF500_RECORDER_ALIGNMENT) * \
+     LW_GRF500_RECORDER_ALIGNMENT)
+
+typedef struct {
+    uint64_t timestamp_us[LW_GRF500_RECORDER_CHUNK_SAMPLES];
+    uint32_t sequence[LW_GRF500_RECORDER_CHUNK_SAMPLES];
+    int32_t columns[LW_GRF500_RECORDER_MAX_COLUMNS][LW_GRF500_RECORDER_CHUNK_SAMPLES];
+    uint8_t padding[LW_GRF500_RECORDER_CHUNK_SIZE - LW_GRF500_RECORDER_CHUNK_DATA_SIZE];
+    lw_grf500_chunk_footer footer;
+} lw_grf500_chunk;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint32_t distance_config;
+    uint32_t column_count;
+    uint32_t chunk_size;
+    uint32_t chunk_samples;
+    uint64_t chunk_count;
+    uint64_t sample_count;
+    uint64_t first_timestamp_us;
+    uint64_t last_timestamp_us;
+    uint8_t padding[LW_GRF500_RECORDER_ALIGNMENT - 64];
+} lw_grf500_recording_header;
+
+typedef struct lw_grf500_recorder_s lw_grf500_recorder;
+
+/*
+ * Recorder write callback. This callback is called with a complete header or
+ * chunk to be written at a byte offset in the recording. The same offset can
+ * be written more than once, when a partial chunk is flushed and later
+ * completed.
+ *
+ * A completed chunk stays untouched until the next chunk completes, so it can
+ * be written asynchronously. The header and a flushed partial chunk keep
+ * changing as samples are appended, so they must be written before the
+ * callback returns.
+ *
+ * @param recorder The recorder.
+ * @param data The data to write.
+ * @param size The number of bytes to write. Always a multiple of LW_GRF500_RECORDER_ALIGNMENT.
+ * @param offset The offset in the recording. Always a multiple of LW_GRF500_RECORDER_ALIGNMENT.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+typedef lw_result (*lw_grf500_recorder_callback_write)(lw_grf500_recorder *recorder, const void *data, uint32_t size, uint64_t offset);
+
+struct lw_grf500_recorder_s {
+    void *user_data;
+    lw_grf500_recorder_callback_write write;
+
+    lw_grf500_recording_header header;
+    lw_grf500_chunk chunks[2];
+    uint32_t active_chunk;
+    uint8_t fields[LW_GRF500_RECORDER_MAX_COLUMNS];
+};
+
+/*
+ * Initialize a recorder. The header is written straight away.
+ *
+ * @param recorder The recorder to initialize. It is large, so it should not be on the stack.
+ * @param kind The kind of samples to record.
+ * @param distance_config The distance config of the recorded samples, for distance recordings.
+ * @param user_data User data to pass to the write callback.
+ * @param write Write callback.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_grf500_recorder_init(lw_grf500_recorder *recorder, lw_grf500_recording_kind kind, lw_grf500_distance_config distance_config, void *user_data, lw_grf500_recorder_callback_write write);
+
+/*
+ * Append a distance sample to a distance recording.
+ *
+ * @param recorder The recorder.
+ * @param sample The sample to append.
+ * @return LW_RESULT_SUCCESS on success, or an error code from the write callback.
+ */
+lw_result lw_grf500_recorder_append_distance(lw_grf500_recorder *recorder, const lw_grf500_distance_sample *sample);
+
+/*
+ * Append a multi sample to a multi recording.
+ *
+ * @param recorder The recorder.
+ * @param sample The sample to append.
+ * @return LW_RESULT_SUCCESS on success, or an error code from the write callback.
+ */
+lw_result lw_grf500_recorder_append_multi(lw_grf500_recorder *recorder, const lw_grf500_multi_sample *sample);
+
+/*
+ * Write the partial chunk and the header, so that everything appended so far
+ * is in the recording. Appending continues in the same chunk.
+ *
+ * @param recorder The recorder.
+ * @return LW_RESULT_SUCCESS on success, or an error code from the write callback.
+ */
+lw_result lw_grf500_recorder_flush(lw_grf500_recorder *recorder);
+
+// ----------------------------------------------------------------------------
+// Recording access.
+//
+// A recording view works directly on the bytes of a recording, usually a
+// memory mapped file. Nothing is copied.
+// ----------------------------------------------------------------------------
+typedef struct {
+    const lw_grf500_recording_header *header;
+    const lw_grf500_chunk *chunks;
+    uint64_t chunk_count;
+} lw_grf500_recording;
+
+/*
+ * Open a view on a recording.
+ *
+ * @param recording The view to open.
+ * @param data The recording bytes. Must be aligned to 8 bytes, a memory mapping is page aligned.
+ * @param size The number of bytes.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the data is not a valid recording.
+ */
+lw_result lw_grf500_recording_open(lw_grf500_recording *recording, const void *data, uint64_t size);
+
+/*
+ * Get a chunk of a recording.
+ *
+ * @param recording The recording.
+ * @param index The index of the chunk.
+ * @return The chunk, or NULL if the index is out of range.
+ */
+const lw_grf500_chunk *lw_grf500_recording_get_chunk(const lw_grf500_recording *recording, uint64_t index);
+
+/*
+ * Find the first sample at or after a time, using the chunk footers and then
+ * the timestamp column of one chunk.
+ *
+ * @param recording The recording.
+ * @param timestamp_us The time to find.
+ * @param chunk_index The index of the chunk is written here.
+ * @param sample_index The index of the sample in the chunk is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_ERROR if every sample is earlier.
+ */
+lw_result lw_grf500_recording_find_time(const lw_grf500_recording *recording, uint64_t timestamp_us, uint64_t *chunk_index, uint32_t *sample_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_RECORDER_H
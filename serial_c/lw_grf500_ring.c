@@ -0,0 +1,168 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Sample Ring
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_ring.h"
+#include <string.h>
+
+typedef char lw_grf500_ring_header_size_check[(sizeof(lw_grf500_ring_header) % LW_GRF500_RING_CACHE_LINE == 0) ? 1 : -1];
+typedef char lw_grf500_ring_slot_size_check[(sizeof(lw_grf500_ring_slot) == LW_GRF500_RING_CACHE_LINE) ? 1 : -1];
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static void lw_ring_publish(lw_grf500_ring_publisher *publisher, const void *sample, uint32_t size) {
+    uint32_t index = publisher->write_index;
+    lw_grf500_ring_slot *slot = &publisher->slots[index & publisher->mask];
+
+    lw_seqlock_write_begin(&slot->lock);
+    slot->index = index;
+    memcpy(&slot->sample, sample, size);
+    lw_seqlock_write_end(&slot->lock);
+
+    publisher->write_index = index + 1;
+    LW_SEQLOCK_STORE_RELEASE(&publisher->header->write_index, index + 1);
+}
+
+static lw_result lw_ring_read(lw_grf500_ring_reader *reader, void *sample, uint32_t size) {
+    while (1) {
+        uint32_t write_index = LW_SEQLOCK_LOAD_ACQUIRE(&reader->header->write_index);
+        uint32_t available = write_index - reader->read_index;
+
+        if (available == 0) {
+            return LW_RESULT_AGAIN;
+        }
+
+        // Already overwritten, or about to be: skip to the oldest sample that
+        // the publisher can not reach before we have copied it.
+        if (available > reader->mask) {
+            uint32_t oldest = write_index - reader->mask;
+            reader->skipped += oldest - reader->read_index;
+            reader->overruns++;
+            reader->read_index = oldest;
+        }
+
+        const lw_grf500_ring_slot *slot = &reader->slots[reader->read_index & reader->mask];
+        uint32_t sequence = lw_seqlock_read_begin(&slot->lock);
+        uint32_t index = slot->index;
+        memcpy(sample, &slot->sample, size);
+
+        if (!lw_seqlock_read_retry(&slot->lock, sequence) && index == reader->read_index) {
+            reader->read_index++;
+            return LW_RESULT_SUCCESS;
+        }
+
+        // The publisher lapped us during the copy, go around again.
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Publisher.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_ring_create(lw_grf500_ring_publisher *publisher, void *memory, uint64_t size, uint32_t slot_count, lw_grf500_recording_kind kind, lw_grf500_distance_config distance_config, float update_rate, const lw_grf500_product_info *product_info) {
+    memset(publisher, 0, sizeof(*publisher));
+
+    if (slot_count < 2 || (slot_count & (slot_count - 1)) != 0 || size < LW_GRF500_RING_SIZE(slot_count)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (kind != LW_GRF500_RECORDING_DISTANCE && kind != LW_GRF500_RECORDING_MULTI) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    lw_grf500_ring_header *header = (lw_grf500_ring_header *)memory;
+    memset(memory, 0, (size_t)LW_GRF500_RING_SIZE(slot_count));
+
+    header->info.version = LW_GRF500_RING_VERSION;
+    header->info.kind = kind;
+    header->info.slot_count = slot_count;
+    header->info.slot_size = sizeof(lw_grf500_ring_slot);
+    header->info.distance_config = distance_config;
+    header->info.update_rate = update_rate;
+
+    if (product_info) {
+        header->info.product_info = *product_info;
+    }
+
+    publisher->header = header;
+    publisher->slots = (lw_grf500_ring_slot *)(header + 1);
+    publisher->mask = slot_count - 1;
+
+    // The magic goes in last, so a reader never sees a half built header.
+    LW_SEQLOCK_FENCE_RELEASE();
+    memcpy(header->info.magic, LW_GRF500_RING_MAGIC, sizeof(header->info.magic));
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_ring_publish_distance(lw_grf500_ring_publisher *publisher, const lw_grf500_distance_sample *sample) {
+    lw_ring_publish(publisher, sample, sizeof(*sample));
+}
+
+void lw_grf500_ring_publish_multi(lw_grf500_ring_publisher *publisher, const lw_grf500_multi_sample *sample) {
+    lw_ring_publish(publisher, sample, sizeof(*sample));
+}
+
+// ----------------------------------------------------------------------------
+// Reader.
+// ----------------------------------------------------------------------------
+lw_result lw_grf500_ring_open(lw_grf500_ring_reader *reader, const void *memory, uint64_t size) {
+    const lw_grf500_ring_header *header = (const lw_grf500_ring_header *)memory;
+
+    memset(reader, 0, sizeof(*reader));
+
+    if (size < sizeof(*header) || memcmp(header->info.magic, LW_GRF500_RING_MAGIC, sizeof(header->info.magic)) != 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    LW_SEQLOCK_FENCE_ACQUIRE();
+
+    uint32_t slot_count = header->info.slot_count;
+
+    if (header->info.version != LW_GRF500_RING_VERSION || header->info.slot_size != sizeof(lw_grf500_ring_slot)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    if (slot_count < 2 || (slot_count & (slot_count - 1)) != 0 || size < LW_GRF500_RING_SIZE(slot_count)) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    reader->header = header;
+    reader->slots = (const lw_grf500_ring_slot *)(header + 1);
+    reader->mask = slot_count - 1;
+    reader->read_index = LW_SEQLOCK_LOAD_ACQUIRE(&header->write_index);
+
+    return LW_RESULT_SUCCESS;
+}
+
+const lw_grf500_ring_info *lw_grf500_ring_get_info(const lw_grf500_ring_reader *reader) {
+    return &reader->header->info;
+}
+
+lw_result lw_grf500_ring_read_distance(lw_grf500_ring_reader *reader, lw_grf500_distance_sample *sample) {
+    return lw_ring_read(reader, sample, sizeof(*sample));
+}
+
+lw_result lw_grf500_ring_read_multi(lw_grf500_ring_reader *reader, lw_grf500_multi_sample *sample) {
+    return lw_ring_read(reader, sample, sizeof(*sample));
+}
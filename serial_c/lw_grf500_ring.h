@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Sample Ring
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_RING_H
+#define LW_GRF500_RING_H
+
+#include "lw_grf500_recorder.h"
+#include "lw_seqlock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Shared sample ring.
+//
+// A sample ring lets one publisher hand decoded samples to any number of
+// readers through a block of shared memory, usually a POSIX shared memory
+// object mapped by several processes. Readers never write to the ring and
+// never make a system call, so they can map it read only and cannot slow the
+// publisher down.
+//
+// The ring starts with a header describing the sensor and the samples,
+// followed by a power of two number of slots, each one cache line. Every slot
+// has its own seqlock and records which sample it holds, so a reader that
+// falls behind by more than the ring size notices that its samples have been
+// overwritten and skips forward to the oldest sample still in the ring.
+//
+// Sample indices are 32 bit and wrap, which is harmless as long as no reader
+// falls more than 2^31 samples behind.
+// ----------------------------------------------------------------------------
+#define LW_GRF500_RING_MAGIC "LWGRFSHM"
+#define LW_GRF500_RING_VERSION 1
+#define LW_GRF500_RING_CACHE_LINE 64
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    lw_grf500_distance_config distance_config;
+    float update_rate;
+    lw_grf500_product_info product_info;
+} lw_grf500_ring_info;
+
+typedef struct {
+    lw_grf500_ring_info info;
+    uint8_t info_padding[LW_GRF500_RING_CACHE_LINE * 3 - sizeof(lw_grf500_ring_info)];
+
+    // Index of the next sample to be published, on its own cache line.
+    volatile uint32_t write_index;
+    uint8_t index_padding[LW_GRF500_RING_CACHE_LINE - sizeof(uint32_t)];
+} lw_grf500_ring_header;
+
+typedef union {
+    lw_grf500_distance_sample distance;
+    lw_grf500_multi_sample multi;
+} lw_grf500_ring_sample;
+
+typedef struct {
+    lw_seqlock lock;
+    uint32_t index;
+    lw_grf500_ring_sample sample;
+} lw_grf500_ring_slot;
+
+// Shared memory size needed for a ring.
+#define LW_GRF500_RING_SIZE(slot_count) (sizeof(lw_grf500_ring_header) + (uint64_t)(slot_count) * sizeof(lw_grf500_ring_slot))
+
+typedef struct {
+    lw_grf500_ring_header *header;
+    lw_grf500_ring_slot *slots;
+    uint32_t mask;
+    uint32_t write_index;
+} lw_grf500_ring_publisher;
+
+typedef struct {
+    const lw_grf500_ring_header *header;
+    const lw_grf500_ring_slot *slots;
+    uint32_t mask;
+    uint32_t read_index;
+    uint32_t overruns;
+    uint32_t skipped;
+} lw_grf500_ring_reader;
+
+/*
+ * Create a ring in a block of shared memory, and become its publisher.
+ *
+ * @param publisher The publisher to initialize.
+ * @param memory The shared memory, aligned to LW_GRF500_RING_CACHE_LINE, a memory mapping is page aligned.
+ * @param size The size of the shared memory, at least LW_GRF500_RING_SIZE(slot_count).
+ * @param slot_count The number of slots, a power of two.
+ * @param kind The kind of samples published.
+ * @param distance_config The distance config of the samples, for distance rings.
+ * @param update_rate The update rate of the sensor in Hz.
+ * @param product_info The sensor product info, can be NULL.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER on failure.
+ */
+lw_result lw_grf500_ring_create(lw_grf500_ring_publisher *publisher, void *memory, uint64_t size, uint32_t slot_count, lw_grf500_recording_kind kind, lw_grf500_distance_config distance_config, float update_rate, const lw_grf500_product_info *product_info);
+
+/*
+ * Publish a distance sample.
+ *
+ * @param publisher The publisher.
+ * @param sample The sample.
+ */
+void lw_grf500_ring_publish_distance(lw_grf500_ring_publisher *publisher, const lw_grf500_distance_sample *sample);
+
+/*
+ * Publish a multi sample.
+ *
+ * @param publisher The publisher.
+ * @param sample The sample.
+ */
+void lw_grf500_ring_publish_multi(lw_grf500_ring_publisher *publisher, const lw_grf500_multi_sample *sample);
+
+/*
+ * Open a ring as a reader. Reading starts with the next sample published.
+ *
+ * @param reader The reader to initialize.
+ * @param memory The shared memory, can be mapped read only.
+ * @param size The size of the shared memory.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the memory does not hold a ring.
+ */
+lw_result lw_grf500_ring_open(lw_grf500_ring_reader *reader, const void *memory, uint64_t size);
+
+/*
+ * Get the ring info.
+ *
+ * @param reader The reader.
+ * @return The info from the ring header.
+ */
+const lw_grf500_ring_info *lw_grf500_ring_get_info(const lw_grf500_ring_reader *reader);
+
+/*
+ * Read the next distance sample. If the reader fell so far behind that its
+ * next sample was overwritten, it skips to the oldest sample still available
+ * and counts an overrun.
+ *
+ * @param reader The reader.
+ * @param sample The sample is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_AGAIN if no new sample has been published.
+ */
+lw_result lw_grf500_ring_read_distance(lw_grf500_ring_reader *reader, lw_grf500_distance_sample *sample);
+
+/*
+ * Read the next multi sample, the same way as lw_grf500_ring_read_distance.
+ *
+ * @param reader The reader.
+ * @param sample The sample is written here.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_AGAIN if no new sample has been published.
+ */
+lw_result lw_grf500_ring_read_multi(lw_grf500_ring_reader *reader, lw_grf500_multi_sample *sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_RING_H
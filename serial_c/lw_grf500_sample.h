@@ -0,0 +1,153 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Samples
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_SAMPLE_H
+#define LW_GRF500_SAMPLE_H
+
+#include "lw_serial_api_grf500.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Timestamped samples.
+//
+// The host side processing stages all work on samples that carry the time
+// they were acquired. The API itself has no notion of wall clock time, so the
+// application stamps each sample as it is received, usually with a
+// monotonic microsecond clock.
+// ----------------------------------------------------------------------------
+
+// Distance value reported by the device when the signal is lost.
+#define LW_GRF500_LOST_SIGNAL_DISTANCE (-1000)
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint32_t sequence;
+    lw_grf500_distance_data_cm data;
+} lw_grf500_distance_sample;
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint32_t sequence;
+    lw_grf500_multi_data data;
+} lw_grf500_multi_sample;
+
+// ----------------------------------------------------------------------------
+// Field access by index.
+//
+// Stages that work on any field of a sample address the fields by index.
+// Distance data fields are indexed in distance config bit order, multi data
+// fields as the distance and strength of each return, then the temperature.
+// ----------------------------------------------------------------------------
+#define LW_GRF500_DISTANCE_FIELD_COUNT 8
+#define LW_GRF500_MULTI_FIELD_COUNT 11
+
+// Index of a single distance config flag, or -1 if the config is not a single flag.
+static inline int32_t lw_grf500_get_distance_field_index(lw_grf500_distance_config field) {
+    for (int32_t i = 0; i < LW_GRF500_DISTANCE_FIELD_COUNT; ++i) {
+        if (field == (1u << i)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static inline int32_t lw_grf500_get_distance_field(const lw_grf500_distance_data_cm *data, uint32_t index) {
+    switch (index) {
+        case 0:
+            return data->first_return_raw_cm;
+        case 1:
+            return data->first_return_filtered_cm;
+        case 2:
+            return data->first_return_strength;
+        case 3:
+            return data->last_return_raw_cm;
+        case 4:
+            return data->last_return_filtered_cm;
+        case 5:
+            return data->last_return_strength;
+        case 6:
+            return data->temperature;
+        default:
+            return data->alarm_status;
+    }
+}
+
+static inline void lw_grf500_set_distance_field(lw_grf500_distance_data_cm *data, uint32_t index, int32_t value) {
+    switch (index) {
+        case 0:
+            data->first_return_raw_cm = value;
+            break;
+        case 1:
+            data->first_return_filtered_cm = value;
+            break;
+        case 2:
+            data->first_return_strength = value;
+            break;
+        case 3:
+            data->last_return_raw_cm = value;
+            break;
+        case 4:
+            data->last_return_filtered_cm = value;
+            break;
+        case 5:
+            data->last_return_strength = value;
+            break;
+        case 6:
+            data->temperature = value;
+            break;
+        default:
+            data->alarm_status = value;
+            break;
+    }
+}
+
+static inline void lw_grf500_get_distance_fields(const lw_grf500_distance_data_cm *data, int32_t fields[LW_GRF500_DISTANCE_FIELD_COUNT]) {
+    fields[0] = data->first_return_raw_cm;
+    fields[1] = data->first_return_filtered_cm;
+    fields[2] = data->first_return_strength;
+    fields[3] = data->last_return_raw_cm;
+    fields[4] = data->last_return_filtered_cm;
+    fields[5] = data->last_return_strength;
+    fields[6] = data->temperature;
+    fields[7] = data->alarm_status;
+}
+
+static inline void lw_grf500_get_multi_fields(const lw_grf500_multi_data *data, int32_t fields[LW_GRF500_MULTI_FIELD_COUNT]) {
+    for (uint32_t i = 0; i < 5; ++i) {
+        fields[i * 2] = data->signals[i].distance_mm;
+        fields[i * 2 + 1] = data->signals[i].strength;
+    }
+
+    fields[10] = data->temperature;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_SAMPLE_H
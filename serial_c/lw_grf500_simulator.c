@@ -0,0 +1,864 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Device Simulator
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_simulator.h"
+#include "lw_grf500_sample.h"
+#include <string.h>
+
+// Lost signal distance as sent on the wire.
+#define LW_SIMULATOR_LOST_SIGNAL (LW_GRF500_LOST_SIGNAL_DISTANCE / 10)
+
+// Readings are skipped rather than caught up when the simulator falls this
+// many readings behind.
+#define LW_SIMULATOR_MAX_CATCH_UP LW_GRF500_SIMULATOR_QUEUE_SIZE
+
+static const uint32_t lw_simulator_baud_rates[8] = {9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600};
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static uint32_t lw_simulator_random(lw_grf500_simulator *simulator) {
+    uint32_t x = simulator->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    simulator->random = x;
+
+    return x;
+}
+
+static float lw_simulator_random_unit(lw_grf500_simulator *simulator) {
+    return (float)(lw_simulator_random(simulator) >> 8) / 16777216.0f;
+}
+
+// Roughly gaussian with unit variance, from the sum of four uniforms.
+static float lw_simulator_random_gaussian(lw_grf500_simulator *simulator) {
+    float sum = 0;
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        sum += lw_simulator_random_unit(simulator);
+    }
+
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+static lw_bool lw_simulator_chance(lw_grf500_simulator *simulator, float probability) {
+    return (probability > 0 && lw_simulator_random_unit(simulator) < probability) ? LW_TRUE : LW_FALSE;
+}
+
+static int32_t lw_simulator_round(float value) {
+    return (value < 0) ? -(int32_t)(0.5f - value) : (int32_t)(value + 0.5f);
+}
+
+// Time to send a number of bytes at a baud rate, 10 bits per byte.
+static uint64_t lw_simulator_wire_time_us(const lw_grf500_simulator *simulator, uint32_t baud_rate, uint32_t bytes) {
+    if (!simulator->config.pace_baud_rate) {
+        return 0;
+    }
+
+    return ((uint64_t)bytes * 10000000 + baud_rate - 1) / baud_rate;
+}
+
+static uint32_t lw_simulator_baud_rate(const lw_grf500_simulator *simulator) {
+    return lw_simulator_baud_rates[simulator->registers.baud_rate];
+}
+
+static uint64_t lw_simulator_reading_period_us(const lw_grf500_simulator *simulator) {
+    return 10000000 / simulator->registers.update_rate;
+}
+
+static void lw_simulator_factory_registers(lw_grf500_simulator_registers *registers) {
+    memset(registers, 0, sizeof(*registers));
+    registers->distance_config = LW_GRF500_DISTANCE_CONFIG_ALL;
+    registers->laser_firing = 1;
+    registers->auto_exposure = 1;
+    registers->update_rate = 50;
+    registers->alarm_return_mode = LW_GRF500_RETURN_MODE_FIRST;
+    registers->lost_signal_counter = 1;
+    registers->gpio_mode = LW_GRF500_GPIO_MODE_NO_OUTPUT;
+    registers->gpio_alarm_confirm_count = 1;
+    registers->median_filter_size = 5;
+    registers->smooth_filter_factor = 50;
+    registers->baud_rate = LW_GRF500_BAUD_RATE_115200;
+    registers->i2c_address = 0x66;
+    registers->rolling_average_size = 4;
+    registers->led_state = 1;
+}
+
+// ----------------------------------------------------------------------------
+// Readings.
+// ----------------------------------------------------------------------------
+
+// Target distance at a time, moving back and forth over the period.
+static float lw_simulator_target_cm(const lw_grf500_simulator *simulator, uint64_t time_us) {
+    const lw_grf500_simulator_config *config = &simulator->config;
+    uint64_t period_us = (uint64_t)config->period_ms * 1000;
+
+    if (period_us < 2 || config->amplitude_cm == 0) {
+        return (float)config->distance_cm;
+    }
+
+    uint64_t phase_us = time_us % period_us;
+    uint64_t half_us = period_us / 2;
+    float fraction = (phase_us < half_us) ? (float)phase_us / (float)half_us : (float)(period_us - phase_us) / (float)(period_us - half_us);
+
+    return (float)config->distance_cm + (float)config->amplitude_cm * fraction;
+}
+
+static void lw_simulator_reset_filter(lw_grf500_simulator_filter *filter) {
+    memset(filter, 0, sizeof(*filter));
+    filter->last_raw = LW_SIMULATOR_LOST_SIGNAL;
+    filter->last_filtered = LW_SIMULATOR_LOST_SIGNAL;
+}
+
+// Median of the newest count values before index in a ring.
+static int32_t lw_simulator_median(const int32_t *history, uint32_t index, uint32_t count) {
+    int32_t values[LW_GRF500_SIMULATOR_FILTER_SIZE];
+
+    for (uint32_t i = 0; i < count; ++i) {
+        int32_t value = history[(index + LW_GRF500_SIMULATOR_FILTER_SIZE - 1 - i) % LW_GRF500_SIMULATOR_FILTER_SIZE];
+        uint32_t j = i;
+
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+
+        values[j] = value;
+    }
+
+    return values[count / 2];
+}
+
+// Run a raw reading through the enabled filters, in the device order of
+// median, rolling average, then smoothing.
+static int32_t lw_simulator_filter(lw_grf500_simulator *simulator, lw_grf500_simulator_filter *filter, int32_t raw) {
+    const lw_grf500_simulator_registers *registers = &simulator->registers;
+    uint32_t index = filter->index;
+    int32_t value = raw;
+
+    filter->index = (index + 1) % LW_GRF500_SIMULATOR_FILTER_SIZE;
+    filter->count = (filter->count < LW_GRF500_SIMULATOR_FILTER_SIZE) ? filter->count + 1 : filter->count;
+
+    filter->median_history[index] = raw;
+
+    if (registers->median_filter_enable) {
+        uint32_t count = (filter->count < registers->median_filter_size) ? filter->count : registers->median_filter_size;
+        value = lw_simulator_median(filter->median_history, filter->index, count);
+    }
+
+    filter->average_history[index] = value;
+
+    if (registers->rolling_average_enable) {
+        uint32_t count = (filter->count < registers->rolling_average_size) ? filter->count : registers->rolling_average_size;
+        int64_t sum = 0;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            sum += filter->average_history[(filter->index + LW_GRF500_SIMULATOR_FILTER_SIZE - 1 - i) % LW_GRF500_SIMULATOR_FILTER_SIZE];
+        }
+
+        value = lw_simulator_round((float)sum / (float)count);
+    }
+
+    if (filter->count == 1 || !registers->smooth_filter_enable) {
+        filter->smoothed = value;
+    } else {
+        int32_t factor = (int32_t)registers->smooth_filter_factor;
+        filter->smoothed = lw_simulator_round(((float)filter->smoothed * (float)factor + (float)value * (float)(100 - factor)) / 100.0f);
+    }
+
+    return filter->smoothed;
+}
+
+static void lw_simulator_update_alarms(lw_grf500_simulator *simulator, int32_t distance) {
+    const lw_grf500_simulator_registers *registers = &simulator->registers;
+    uint32_t thresholds[2] = {registers->alarm_a_distance, registers->alarm_b_distance};
+    uint32_t confirm_count = (registers->gpio_alarm_confirm_count > 0) ? registers->gpio_alarm_confirm_count : 1;
+
+    for (uint32_t a = 0; a < 2; ++a) {
+        int64_t threshold = (int64_t)thresholds[a];
+
+        if (simulator->alarm_active[a]) {
+            if (threshold == 0 || distance < 0 || distance > threshold + (int64_t)registers->alarm_hysteresis) {
+                simulator->alarm_active[a] = LW_FALSE;
+                simulator->alarm_count[a] = 0;
+            }
+        } else if (threshold > 0 && distance >= 0 && distance <= threshold) {
+            if (++simulator->alarm_count[a] >= confirm_count) {
+                simulator->alarm_active[a] = LW_TRUE;
+            }
+        } else {
+            simulator->alarm_count[a] = 0;
+        }
+    }
+}
+
+static void lw_simulator_take_reading(lw_grf500_simulator *simulator, uint64_t time_us) {
+    const lw_grf500_simulator_config *config = &simulator->config;
+    const lw_grf500_simulator_registers *registers = &simulator->registers;
+    lw_bool lost = (!registers->laser_firing || lw_simulator_chance(simulator, config->lost_probability)) ? LW_TRUE : LW_FALSE;
+    float target_cm = lw_simulator_target_cm(simulator, time_us);
+
+    simulator->lost_count = lost ? simulator->lost_count + 1 : 0;
+    lw_bool report_lost = (lost && simulator->lost_count >= registers->lost_signal_counter) ? LW_TRUE : LW_FALSE;
+
+    for (uint32_t r = 0; r < 2; ++r) {
+        lw_grf500_simulator_filter *filter = &simulator->filters[r];
+        int32_t *fields = simulator->reading + r * 3;
+
+        if (!lost) {
+            float offset_cm = (r == 1) ? (float)config->last_return_offset_cm : 0;
+            float distance_cm = target_cm + offset_cm + lw_simulator_random_gaussian(simulator) * config->noise_cm;
+            int32_t raw = lw_simulator_round(distance_cm / 10.0f) + registers->zero_offset;
+
+            filter->last_raw = raw;
+            filter->last_filtered = lw_simulator_filter(simulator, filter, raw);
+            simulator->multi_distance_mm[r] = lw_simulator_round(distance_cm * 10.0f) + registers->zero_offset * 100;
+            fields[2] = (r == 1 && config->last_return_offset_cm != 0) ? config->strength / 2 : config->strength;
+        } else if (report_lost) {
+            fields[2] = 0;
+        }
+
+        fields[0] = report_lost ? LW_SIMULATOR_LOST_SIGNAL : filter->last_raw;
+        fields[1] = report_lost ? LW_SIMULATOR_LOST_SIGNAL : filter->last_filtered;
+    }
+
+    lw_simulator_update_alarms(simulator, simulator->reading[registers->alarm_return_mode == LW_GRF500_RETURN_MODE_LAST ? 4 : 1]);
+
+    simulator->reading[6] = config->temperature;
+    simulator->reading[7] = (simulator->alarm_active[0] ? 1 : 0) | (simulator->alarm_active[1] ? 1 << 8 : 0);
+    simulator->stats.readings++;
+}
+
+// ----------------------------------------------------------------------------
+// Sending.
+// ----------------------------------------------------------------------------
+static void lw_simulator_queue(lw_grf500_simulator *simulator, uint64_t time_us, uint32_t baud_rate, const uint8_t *data, uint32_t size) {
+    if (simulator->queue_count == LW_GRF500_SIMULATOR_QUEUE_SIZE) {
+        simulator->stats.overflows++;
+        return;
+    }
+
+    lw_grf500_simulator_packet *packet = &simulator->queue[(simulator->queue_head + simulator->queue_count) % LW_GRF500_SIMULATOR_QUEUE_SIZE];
+    packet->start_us = (time_us > simulator->send_free_us) ? time_us : simulator->send_free_us;
+    packet->baud_rate = baud_rate;
+    packet->size = size;
+    packet->offset = 0;
+    memcpy(packet->data, data, size);
+
+    simulator->send_free_us = packet->start_us + lw_simulator_wire_time_us(simulator, baud_rate, size);
+    simulator->queue_count++;
+}
+
+// Send a packet from the device, injecting faults.
+static void lw_simulator_send(lw_grf500_simulator *simulator, uint64_t time_us, uint32_t baud_rate, uint8_t command_id, uint8_t *data, uint32_t size) {
+    const lw_grf500_simulator_config *config = &simulator->config;
+    uint8_t packet[LW_GRF500_SIMULATOR_PACKET_SIZE];
+    uint32_t packet_size = lw_create_packet(packet, command_id, 0, data, size);
+
+    if (lw_simulator_chance(simulator, config->drop_probability)) {
+        simulator->stats.dropped_packets++;
+        return;
+    }
+
+    if (lw_simulator_chance(simulator, config->junk_probability)) {
+        uint8_t junk[LW_GRF500_SIMULATOR_MAX_JUNK];
+        uint32_t junk_size = 1 + lw_simulator_random(simulator) % LW_GRF500_SIMULATOR_MAX_JUNK;
+
+        for (uint32_t i = 0; i < junk_size; ++i) {
+            junk[i] = (uint8_t)lw_simulator_random(simulator);
+        }
+
+        lw_simulator_queue(simulator, time_us, baud_rate, junk, junk_size);
+        simulator->stats.junk_bytes += junk_size;
+    }
+
+    if (lw_simulator_chance(simulator, config->corrupt_probability)) {
+        packet[lw_simulator_random(simulator) % packet_size] ^= (uint8_t)(1 + lw_simulator_random(simulator) % 255);
+        simulator->stats.corrupted_packets++;
+    }
+
+    lw_simulator_queue(simulator, time_us, baud_rate, packet, packet_size);
+}
+
+static void lw_simulator_send_distance_data(lw_grf500_simulator *simulator, uint64_t time_us, uint32_t baud_rate) {
+    uint8_t data[8 * sizeof(int32_t)];
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        if (simulator->registers.distance_config & (1u << i)) {
+            memcpy(data + size, &simulator->reading[i], sizeof(int32_t));
+            size += sizeof(int32_t);
+        }
+    }
+
+    lw_simulator_send(simulator, time_us, baud_rate, LW_GRF500_COMMAND_DISTANCE_DATA, data, size);
+}
+
+static void lw_simulator_send_multi_data(lw_grf500_simulator *simulator, uint64_t time_us, uint32_t baud_rate) {
+    int32_t values[11];
+    uint32_t returns = (simulator->config.last_return_offset_cm != 0) ? 2 : 1;
+
+    memset(values, 0, sizeof(values));
+
+    for (uint32_t r = 0; r < returns; ++r) {
+        if (simulator->reading[r * 3] != LW_SIMULATOR_LOST_SIGNAL) {
+            values[r * 2] = simulator->multi_distance_mm[r];
+            values[r * 2 + 1] = simulator->reading[r * 3 + 2];
+        }
+    }
+
+    values[10] = simulator->reading[6];
+
+    lw_simulator_send(simulator, time_us, baud_rate, LW_GRF500_COMMAND_MULTI_DATA, (uint8_t *)values, sizeof(values));
+}
+
+// Take the readings due by a time, streaming them if a stream is set.
+static void lw_simulator_advance(lw_grf500_simulator *simulator, uint64_t now_us) {
+    if (simulator->asleep) {
+        return;
+    }
+
+    uint64_t period_us = lw_simulator_reading_period_us(simulator);
+
+    if (simulator->next_reading_us + LW_SIMULATOR_MAX_CATCH_UP * period_us < now_us) {
+        uint64_t skipped = (now_us - simulator->next_reading_us) / period_us - LW_SIMULATOR_MAX_CATCH_UP;
+        simulator->next_reading_us += skipped * period_us;
+
+        if (simulator->stream != LW_GRF500_STREAM_ID_NONE) {
+            simulator->stats.overflows += skipped;
+        }
+    }
+
+    while (simulator->next_reading_us <= now_us) {
+        uint64_t time_us = simulator->next_reading_us;
+        lw_simulator_take_reading(simulator, time_us);
+
+        if (simulator->stream == LW_GRF500_STREAM_ID_DISTANCE_DATA) {
+            lw_simulator_send_distance_data(simulator, time_us, lw_simulator_baud_rate(simulator));
+            simulator->stats.stream_packets++;
+        } else if (simulator->stream == LW_GRF500_STREAM_ID_MULTI_DATA) {
+            lw_simulator_send_multi_data(simulator, time_us, lw_simulator_baud_rate(simulator));
+            simulator->stats.stream_packets++;
+        }
+
+        simulator->next_reading_us += lw_simulator_reading_period_us(simulator);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Registers.
+// ----------------------------------------------------------------------------
+
+// Restart as after power on, from the saved registers.
+static void lw_simulator_restart(lw_grf500_simulator *simulator, uint64_t time_us, uint32_t boot_time_ms) {
+    simulator->registers = simulator->saved;
+    simulator->stream = LW_GRF500_STREAM_ID_NONE;
+    simulator->token_valid = LW_FALSE;
+    simulator->asleep = LW_FALSE;
+    simulator->boot_end_us = time_us + (uint64_t)boot_time_ms * 1000;
+    simulator->next_reading_us = simulator->boot_end_us;
+    simulator->lost_count = 0;
+
+    for (uint32_t r = 0; r < 2; ++r) {
+        lw_simulator_reset_filter(&simulator->filters[r]);
+        simulator->multi_distance_mm[r] = 0;
+        simulator->alarm_count[r] = 0;
+        simulator->alarm_active[r] = LW_FALSE;
+    }
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        simulator->reading[i] = 0;
+    }
+
+    simulator->reading[0] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[1] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[3] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[4] = LW_SIMULATOR_LOST_SIGNAL;
+    simulator->reading[6] = simulator->config.temperature;
+
+    lw_init_response(&simulator->request);
+}
+
+static lw_bool lw_simulator_get_u8(const uint8_t *data, uint32_t size, uint32_t min, uint32_t max, uint8_t *value) {
+    if (size != 1 || data[0] < min || data[0] > max) {
+        return LW_FALSE;
+    }
+
+    *value = data[0];
+    return LW_TRUE;
+}
+
+static lw_bool lw_simulator_get_u32(const uint8_t *data, uint32_t size, uint32_t min, uint32_t max, uint32_t *value) {
+    uint32_t temp_value;
+
+    if (size != 4) {
+        return LW_FALSE;
+    }
+
+    memcpy(&temp_value, data, 4);
+
+    if (temp_value < min || temp_value > max) {
+        return LW_FALSE;
+    }
+
+    *value = temp_value;
+    return LW_TRUE;
+}
+
+// Check and use up the token for a save or reset.
+static lw_bool lw_simulator_check_token(lw_grf500_simulator *simulator, const uint8_t *data, uint32_t size) {
+    uint16_t token;
+    lw_bool valid = simulator->token_valid;
+
+    simulator->token_valid = LW_FALSE;
+
+    if (size != 2) {
+        return LW_FALSE;
+    }
+
+    memcpy(&token, data, 2);
+
+    return (valid && token == simulator->token) ? LW_TRUE : LW_FALSE;
+}
+
+static lw_result lw_simulator_write_register(lw_grf500_simulator *simulator, uint64_t time_us, uint8_t command_id, const uint8_t *data, uint32_t size) {
+    lw_grf500_simulator_registers *registers = &simulator->registers;
+    lw_bool accepted = LW_FALSE;
+
+    switch (command_id) {
+        case LW_GRF500_COMMAND_USER_DATA: {
+            accepted = (size == 16) ? LW_TRUE : LW_FALSE;
+
+            if (accepted) {
+                memcpy(registers->user_data, data, 16);
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_SAVE_PARAMETERS: {
+            accepted = lw_simulator_check_token(simulator, data, size);
+
+            if (accepted) {
+                simulator->saved = *registers;
+                simulator->stats.saves++;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_RESET: {
+            accepted = lw_simulator_check_token(simulator, data, size);
+
+            if (accepted) {
+                lw_simulator_restart(simulator, time_us, simulator->config.boot_time_ms);
+                simulator->stats.resets++;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_STREAM: {
+            uint32_t stream;
+            accepted = lw_simulator_get_u32(data, size, 0, LW_GRF500_STREAM_ID_MULTI_DATA, &stream);
+
+            if (accepted && stream != LW_GRF500_STREAM_ID_NONE && stream != LW_GRF500_STREAM_ID_DISTANCE_DATA && stream != LW_GRF500_STREAM_ID_MULTI_DATA) {
+                accepted = LW_FALSE;
+            }
+
+            if (accepted) {
+                simulator->stream = stream;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_SLEEP: {
+            uint8_t value;
+            accepted = lw_simulator_get_u8(data, size, 123, 123, &value);
+
+            if (accepted) {
+                simulator->asleep = LW_TRUE;
+                simulator->stats.sleeps++;
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_ZERO_OFFSET: {
+            accepted = (size == 4) ? LW_TRUE : LW_FALSE;
+
+            if (accepted) {
+                memcpy(&registers->zero_offset, data, 4);
+            }
+        } break;
+
+        case LW_GRF500_COMMAND_DISTANCE_CONFIG: accepted = lw_simulator_get_u32(data, size, 0, LW_GRF500_DISTANCE_CONFIG_ALL, &registers->distance_config); break;
+        case LW_GRF500_COMMAND_LASER_FIRING: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->laser_firing); break;
+        case LW_GRF500_COMMAND_AUTO_EXPOSURE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->auto_exposure); break;
+        case LW_GRF500_COMMAND_UPDATE_RATE: accepted = lw_simulator_get_u32(data, size, 5, 100, &registers->update_rate); break;
+        case LW_GRF500_COMMAND_ALARM_RETURN_MODE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->alarm_return_mode); break;
+        case LW_GRF500_COMMAND_LOST_SIGNAL_COUNTER: accepted = lw_simulator_get_u32(data, size, 1, 250, &registers->lost_signal_counter); break;
+        case LW_GRF500_COMMAND_ALARM_A_DISTANCE: accepted = lw_simulator_get_u32(data, size, 0, 3000, &registers->alarm_a_distance); break;
+        case LW_GRF500_COMMAND_ALARM_B_DISTANCE: accepted = lw_simulator_get_u32(data, size, 0, 3000, &registers->alarm_b_distance); break;
+        case LW_GRF500_COMMAND_ALARM_HYSTERESIS: accepted = lw_simulator_get_u32(data, size, 0, 300, &registers->alarm_hysteresis); break;
+        case LW_GRF500_COMMAND_GPIO_MODE: accepted = lw_simulator_get_u8(data, size, 0, 2, &registers->gpio_mode); break;
+        case LW_GRF500_COMMAND_GPIO_ALARM_CONFIRM_COUNT: accepted = lw_simulator_get_u32(data, size, 0, 1000, &registers->gpio_alarm_confirm_count); break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_ENABLE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->median_filter_enable); break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_SIZE: accepted = lw_simulator_get_u32(data, size, 3, 32, &registers->median_filter_size); break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_ENABLE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->smooth_filter_enable); break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_FACTOR: accepted = lw_simulator_get_u32(data, size, 1, 99, &registers->smooth_filter_factor); break;
+        case LW_GRF500_COMMAND_BAUD_RATE: accepted = lw_simulator_get_u8(data, size, 0, 7, &registers->baud_rate); break;
+        case LW_GRF500_COMMAND_I2C_ADDRESS: accepted = lw_simulator_get_u8(data, size, 0, 0x7F, &registers->i2c_address); break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_ENABLE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->rolling_average_enable); break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_SIZE: accepted = lw_simulator_get_u32(data, size, 2, 32, &registers->rolling_average_size); break;
+        case LW_GRF500_COMMAND_LED_STATE: accepted = lw_simulator_get_u8(data, size, 0, 1, &registers->led_state); break;
+
+        // Read only.
+        case LW_GRF500_COMMAND_PRODUCT_NAME:
+        case LW_GRF500_COMMAND_HARDWARE_VERSION:
+        case LW_GRF500_COMMAND_FIRMWARE_VERSION:
+        case LW_GRF500_COMMAND_SERIAL_NUMBER:
+        case LW_GRF500_COMMAND_TOKEN:
+        case LW_GRF500_COMMAND_DISTANCE_DATA:
+        case LW_GRF500_COMMAND_MULTI_DATA:
+        case LW_GRF500_COMMAND_TEMPERATURE:
+        case LW_GRF500_COMMAND_ALARM_STATUS: break;
+
+        default: return LW_RESULT_INCORRECT_COMMAND_ID;
+    }
+
+    return accepted ? LW_RESULT_SUCCESS : LW_RESULT_INVALID_PARAMETER;
+}
+
+#define LW_SIMULATOR_REPLY(value)           \
+    memcpy(data, &(value), sizeof(value)); \
+    *size = sizeof(value);
+
+static lw_result lw_simulator_read_register(lw_grf500_simulator *simulator, uint8_t command_id, uint8_t *data, uint32_t *size) {
+    const lw_grf500_simulator_registers *registers = &simulator->registers;
+
+    switch (command_id) {
+        case LW_GRF500_COMMAND_PRODUCT_NAME: LW_SIMULATOR_REPLY(simulator->config.product_name) break;
+        case LW_GRF500_COMMAND_HARDWARE_VERSION: LW_SIMULATOR_REPLY(simulator->config.hardware_version) break;
+        case LW_GRF500_COMMAND_FIRMWARE_VERSION: LW_SIMULATOR_REPLY(simulator->config.firmware_version) break;
+        case LW_GRF500_COMMAND_SERIAL_NUMBER: LW_SIMULATOR_REPLY(simulator->config.serial_number) break;
+        case LW_GRF500_COMMAND_USER_DATA: LW_SIMULATOR_REPLY(registers->user_data) break;
+        case LW_GRF500_COMMAND_DISTANCE_CONFIG: LW_SIMULATOR_REPLY(registers->distance_config) break;
+        case LW_GRF500_COMMAND_STREAM: LW_SIMULATOR_REPLY(simulator->stream) break;
+        case LW_GRF500_COMMAND_LASER_FIRING: LW_SIMULATOR_REPLY(registers->laser_firing) break;
+        case LW_GRF500_COMMAND_TEMPERATURE: LW_SIMULATOR_REPLY(simulator->reading[6]) break;
+        case LW_GRF500_COMMAND_AUTO_EXPOSURE: LW_SIMULATOR_REPLY(registers->auto_exposure) break;
+        case LW_GRF500_COMMAND_UPDATE_RATE: LW_SIMULATOR_REPLY(registers->update_rate) break;
+        case LW_GRF500_COMMAND_ALARM_STATUS: LW_SIMULATOR_REPLY(simulator->reading[7]) break;
+        case LW_GRF500_COMMAND_ALARM_RETURN_MODE: LW_SIMULATOR_REPLY(registers->alarm_return_mode) break;
+        case LW_GRF500_COMMAND_LOST_SIGNAL_COUNTER: LW_SIMULATOR_REPLY(registers->lost_signal_counter) break;
+        case LW_GRF500_COMMAND_ALARM_A_DISTANCE: LW_SIMULATOR_REPLY(registers->alarm_a_distance) break;
+        case LW_GRF500_COMMAND_ALARM_B_DISTANCE: LW_SIMULATOR_REPLY(registers->alarm_b_distance) break;
+        case LW_GRF500_COMMAND_ALARM_HYSTERESIS: LW_SIMULATOR_REPLY(registers->alarm_hysteresis) break;
+        case LW_GRF500_COMMAND_GPIO_MODE: LW_SIMULATOR_REPLY(registers->gpio_mode) break;
+        case LW_GRF500_COMMAND_GPIO_ALARM_CONFIRM_COUNT: LW_SIMULATOR_REPLY(registers->gpio_alarm_confirm_count) break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_ENABLE: LW_SIMULATOR_REPLY(registers->median_filter_enable) break;
+        case LW_GRF500_COMMAND_MEDIAN_FILTER_SIZE: LW_SIMULATOR_REPLY(registers->median_filter_size) break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_ENABLE: LW_SIMULATOR_REPLY(registers->smooth_filter_enable) break;
+        case LW_GRF500_COMMAND_SMOOTH_FILTER_FACTOR: LW_SIMULATOR_REPLY(registers->smooth_filter_factor) break;
+        case LW_GRF500_COMMAND_BAUD_RATE: LW_SIMULATOR_REPLY(registers->baud_rate) break;
+        case LW_GRF500_COMMAND_I2C_ADDRESS: LW_SIMULATOR_REPLY(registers->i2c_address) break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_ENABLE: LW_SIMULATOR_REPLY(registers->rolling_average_enable) break;
+        case LW_GRF500_COMMAND_ROLLING_AVERAGE_SIZE: LW_SIMULATOR_REPLY(registers->rolling_average_size) break;
+        case LW_GRF500_COMMAND_LED_STATE: LW_SIMULATOR_REPLY(registers->led_state) break;
+        case LW_GRF500_COMMAND_ZERO_OFFSET: LW_SIMULATOR_REPLY(registers->zero_offset) break;
+
+        case LW_GRF500_COMMAND_TOKEN: {
+            simulator->token = (uint16_t)(lw_simulator_random(simulator) | 1);
+            simulator->token_valid = LW_TRUE;
+            LW_SIMULATOR_REPLY(simulator->token)
+        } break;
+
+        // Write only.
+        case LW_GRF500_COMMAND_SAVE_PARAMETERS:
+        case LW_GRF500_COMMAND_RESET:
+        case LW_GRF500_COMMAND_SLEEP: return LW_RESULT_INVALID_PARAMETER;
+
+        default: return LW_RESULT_INCORRECT_COMMAND_ID;
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+static void lw_simulator_handle_request(lw_grf500_simulator *simulator, uint64_t time_us) {
+    lw_response *request = &simulator->request;
+    uint8_t command_id = request->command_id;
+    uint8_t *data = request->data + 4;
+    uint32_t size = request->payload_size - 1;
+    uint32_t baud_rate = lw_simulator_baud_rate(simulator);
+    uint8_t reply[LW_GRF500_SIMULATOR_PACKET_SIZE];
+    uint32_t reply_size = 0;
+    lw_result result;
+
+    simulator->stats.requests++;
+
+    if (lw_simulator_chance(simulator, simulator->config.request_drop_probability)) {
+        simulator->stats.dropped_requests++;
+        return;
+    }
+
+    if (request->data[1] & 1) {
+        result = lw_simulator_write_register(simulator, time_us, command_id, data, size);
+
+        // Commands without a value to read back echo the request.
+        if (result == LW_RESULT_SUCCESS && lw_simulator_read_register(simulator, command_id, reply, &reply_size) != LW_RESULT_SUCCESS) {
+            memcpy(reply, data, size);
+            reply_size = size;
+        }
+    } else if (command_id == LW_GRF500_COMMAND_DISTANCE_DATA || command_id == LW_GRF500_COMMAND_MULTI_DATA) {
+        result = LW_RESULT_SUCCESS;
+    } else {
+        result = lw_simulator_read_register(simulator, command_id, reply, &reply_size);
+    }
+
+    if (result == LW_RESULT_INCORRECT_COMMAND_ID) {
+        simulator->stats.unknown_commands++;
+        return;
+    }
+
+    if (result != LW_RESULT_SUCCESS) {
+        simulator->stats.rejected_requests++;
+        return;
+    }
+
+    uint32_t jitter_us = simulator->config.latency_jitter_us ? lw_simulator_random(simulator) % (simulator->config.latency_jitter_us + 1) : 0;
+    uint64_t reply_us = time_us + simulator->config.latency_us + jitter_us;
+
+    if (command_id == LW_GRF500_COMMAND_DISTANCE_DATA && !(request->data[1] & 1)) {
+        lw_simulator_send_distance_data(simulator, reply_us, baud_rate);
+    } else if (command_id == LW_GRF500_COMMAND_MULTI_DATA && !(request->data[1] & 1)) {
+        lw_simulator_send_multi_data(simulator, reply_us, baud_rate);
+    } else {
+        lw_simulator_send(simulator, reply_us, baud_rate, command_id, reply, reply_size);
+    }
+
+    simulator->stats.responses++;
+}
+
+// ----------------------------------------------------------------------------
+// Callback device.
+// ----------------------------------------------------------------------------
+static uint64_t lw_simulator_now_us(lw_grf500_simulator *simulator) {
+    if (simulator->speed > 0) {
+        uint64_t host_elapsed_us = simulator->get_time_us(simulator) - simulator->host_start_us;
+        simulator->virtual_time_us = (uint64_t)((double)host_elapsed_us * simulator->speed);
+    }
+
+    return simulator->virtual_time_us;
+}
+
+static void lw_simulator_wait(lw_grf500_simulator *simulator, uint64_t time_us) {
+    if (simulator->speed > 0) {
+        simulator->sleep_us(simulator, (uint64_t)((double)time_us / simulator->speed));
+    } else {
+        simulator->virtual_time_us += time_us;
+    }
+}
+
+static void lw_simulator_sleep(lw_callback_device *device, uint32_t time_ms) {
+    lw_simulator_wait((lw_grf500_simulator *)device->user_data, (uint64_t)time_ms * 1000);
+}
+
+static uint32_t lw_simulator_get_time_ms(lw_callback_device *device) {
+    return (uint32_t)(lw_simulator_now_us((lw_grf500_simulator *)device->user_data) / 1000);
+}
+
+static uint32_t lw_simulator_serial_send(lw_callback_device *device, uint8_t *buffer, uint32_t size) {
+    lw_grf500_simulator *simulator = (lw_grf500_simulator *)device->user_data;
+    lw_grf500_simulator_write(simulator, lw_simulator_now_us(simulator), buffer, size);
+
+    return size;
+}
+
+static int32_t lw_simulator_serial_receive(lw_callback_device *device, uint8_t *buffer, uint32_t size, uint32_t timeout_ms) {
+    lw_grf500_simulator *simulator = (lw_grf500_simulator *)device->user_data;
+
+    while (1) {
+        uint64_t now_us = lw_simulator_now_us(simulator);
+        uint32_t count = lw_grf500_simulator_read(simulator, now_us, buffer, size);
+
+        if (count > 0) {
+            return (int32_t)count;
+        }
+
+        if (timeout_ms == 0) {
+            return 0;
+        }
+
+        uint64_t next_us = lw_grf500_simulator_next_byte_us(simulator, now_us);
+        uint64_t timeout_us = (uint64_t)timeout_ms * 1000;
+        uint64_t wait_us = (next_us == UINT64_MAX) ? timeout_us : next_us - now_us;
+        lw_bool timed_out = (wait_us >= timeout_us) ? LW_TRUE : LW_FALSE;
+
+        if (timed_out) {
+            wait_us = timeout_us;
+        }
+
+        lw_simulator_wait(simulator, wait_us);
+
+        if (timed_out) {
+            return 0;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Simulator.
+// ----------------------------------------------------------------------------
+void lw_grf500_simulator_get_default_config(lw_grf500_simulator_config *config) {
+    memset(config, 0, sizeof(*config));
+    memcpy(config->product_name, "GRF500", 7);
+    memcpy(config->serial_number, "SIM00000001", 12);
+    config->hardware_version = 1;
+    config->firmware_version = (1 << 16) | (0 << 8) | 0;
+    config->distance_cm = 1000;
+    config->amplitude_cm = 200;
+    config->period_ms = 10000;
+    config->noise_cm = 5;
+    config->strength = 80;
+    config->temperature = 2500;
+    config->latency_us = 1000;
+    config->boot_time_ms = 500;
+    config->pace_baud_rate = LW_TRUE;
+    config->seed = 1;
+}
+
+lw_result lw_grf500_simulator_init(lw_grf500_simulator *simulator, const lw_grf500_simulator_config *config, double speed, void *user_data, lw_simulator_callback_get_time_us get_time_us, lw_simulator_callback_sleep_us sleep_us) {
+    memset(simulator, 0, sizeof(*simulator));
+
+    if (config) {
+        simulator->config = *config;
+    } else {
+        lw_grf500_simulator_get_default_config(&simulator->config);
+    }
+
+    config = &simulator->config;
+
+    float probabilities[5] = {config->lost_probability, config->drop_probability, config->corrupt_probability, config->junk_probability, config->request_drop_probability};
+
+    for (uint32_t i = 0; i < 5; ++i) {
+        if (!(probabilities[i] >= 0 && probabilities[i] <= 1)) {
+            return LW_RESULT_INVALID_PARAMETER;
+        }
+    }
+
+    if (!(config->noise_cm >= 0) || config->strength < 0 || (speed > 0 && (get_time_us == NULL || sleep_us == NULL))) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    simulator->config.product_name[15] = 0;
+    simulator->config.serial_number[15] = 0;
+    simulator->random = config->seed ? config->seed : 1;
+
+    lw_simulator_factory_registers(&simulator->registers);
+    simulator->saved = simulator->registers;
+    lw_simulator_restart(simulator, 0, 0);
+
+    simulator->user_data = user_data;
+    simulator->get_time_us = get_time_us;
+    simulator->sleep_us = sleep_us;
+    simulator->speed = (speed > 0) ? speed : 0;
+    simulator->device = lw_create_callback_device(simulator, lw_simulator_sleep, lw_simulator_get_time_ms, lw_simulator_serial_send, lw_simulator_serial_receive);
+
+    if (simulator->speed > 0) {
+        simulator->host_start_us = get_time_us(simulator);
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_simulator_write(lw_grf500_simulator *simulator, uint64_t now_us, const uint8_t *data, uint32_t size) {
+    for (uint32_t i = 0; i < size; ++i) {
+        // Bytes arrive one after another while the line is busy.
+        if (simulator->receive_count == 0 || now_us >= simulator->receive_start_us + lw_simulator_wire_time_us(simulator, lw_simulator_baud_rate(simulator), simulator->receive_count)) {
+            simulator->receive_start_us = now_us;
+            simulator->receive_count = 0;
+        }
+
+        simulator->receive_count++;
+        uint64_t arrival_us = simulator->receive_start_us + lw_simulator_wire_time_us(simulator, lw_simulator_baud_rate(simulator), simulator->receive_count);
+
+        simulator->stats.bytes_received++;
+        lw_simulator_advance(simulator, arrival_us);
+
+        if (arrival_us < simulator->boot_end_us) {
+            lw_init_response(&simulator->request);
+            continue;
+        }
+
+        // Any activity wakes the device, and the byte is lost.
+        if (simulator->asleep) {
+            simulator->asleep = LW_FALSE;
+            simulator->next_reading_us = arrival_us;
+            lw_init_response(&simulator->request);
+            continue;
+        }
+
+        if (lw_feed_response(&simulator->request, data[i]) == LW_RESULT_SUCCESS) {
+            lw_simulator_handle_request(simulator, arrival_us);
+        }
+    }
+}
+
+uint32_t lw_grf500_simulator_read(lw_grf500_simulator *simulator, uint64_t now_us, uint8_t *buffer, uint32_t size) {
+    uint32_t count = 0;
+
+    lw_simulator_advance(simulator, now_us);
+
+    while (count < size && simulator->queue_count > 0) {
+        lw_grf500_simulator_packet *packet = &simulator->queue[simulator->queue_head];
+
+        if (packet->start_us + lw_simulator_wire_time_us(simulator, packet->baud_rate, packet->offset + 1) > now_us) {
+            break;
+        }
+
+        buffer[count++] = packet->data[packet->offset++];
+
+        if (packet->offset == packet->size) {
+            simulator->queue_head = (simulator->queue_head + 1) % LW_GRF500_SIMULATOR_QUEUE_SIZE;
+            simulator->queue_count--;
+        }
+    }
+
+    simulator->stats.bytes_sent += count;
+
+    return count;
+}
+
+uint64_t lw_grf500_simulator_next_byte_us(lw_grf500_simulator *simulator, uint64_t now_us) {
+    uint64_t next_us = UINT64_MAX;
+
+    lw_simulator_advance(simulator, now_us);
+
+    if (simulator->queue_count > 0) {
+        lw_grf500_simulator_packet *packet = &simulator->queue[simulator->queue_head];
+        next_us = packet->start_us + lw_simulator_wire_time_us(simulator, packet->baud_rate, packet->offset + 1);
+    } else if (simulator->stream != LW_GRF500_STREAM_ID_NONE && !simulator->asleep) {
+        uint64_t start_us = (simulator->next_reading_us > simulator->send_free_us) ? simulator->next_reading_us : simulator->send_free_us;
+        next_us = start_us + lw_simulator_wire_time_us(simulator, lw_simulator_baud_rate(simulator), 1);
+    }
+
+    return (next_us > now_us) ? next_us : now_us;
+}
+
+uint64_t lw_grf500_simulator_get_time_us(lw_grf500_simulator *simulator) {
+    return lw_simulator_now_us(simulator);
+}
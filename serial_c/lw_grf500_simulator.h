@@ -0,0 +1,336 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Device Simulator
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_SIMULATOR_H
+#define LW_GRF500_SIMULATOR_H
+
+#include "lw_serial_api_grf500.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Device simulator.
+//
+// A simulator plays the device side of the serial protocol for every GRF-500
+// command, so the API can be exercised without hardware. Reads reply with the
+// register value, writes are checked against the same limits as the request
+// generators, applied, and reply with the new value. Writes that are out of
+// range, have the wrong size, target a read only register, or carry a stale
+// token get no reply at all, so the API sees them fail, and so do reads of
+// write only commands and unknown commands.
+//
+// Save parameters and reset need the token from the last token read, and
+// either one uses up the token. Save copies the registers to the saved set
+// and reset restores them from it, stops the stream, and ignores input for
+// the boot time. Sleep stops measuring until the next byte is received, which
+// is discarded.
+//
+// The simulated target moves back and forth between distance_cm and
+// distance_cm + amplitude_cm over period_ms, with gaussian noise on the raw
+// readings. Readings are taken at the update rate whether streaming or not,
+// and run through the median, rolling average and smoothing filters when
+// they are enabled. A lost reading is only reported as a lost signal once the
+// lost signal counter is reached, until then the last reading is repeated.
+// The alarms follow the filtered distance of the alarm return mode, with
+// hysteresis and the confirm count.
+//
+// Bytes are paced at the baud rate set on the device, in both directions,
+// and responses start latency_us after the request has been received. Faults
+// can be injected on the packets sent by the device, and requests can be lost
+// on the way to it.
+//
+// Registers and readings hold values as they are sent on the wire. Distances
+// are in tenths of the centimetre values the API reports, except multi data,
+// which is in millimetres.
+//
+// The simulator core works on bytes and explicit times, so it can be driven
+// by any transport. The callback device in the simulator runs it in process,
+// with the same time model as the serial replay: at speed 0 time is virtual
+// and jumps straight to the next byte from the device, so a run is the same
+// on any host; at any other speed time follows the host clock scaled by the
+// speed.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_SIMULATOR_QUEUE_SIZE
+#define LW_GRF500_SIMULATOR_QUEUE_SIZE 64
+#endif
+
+// Largest packet the device sends, multi data with its header and CRC.
+#define LW_GRF500_SIMULATOR_PACKET_SIZE 64
+
+// Longest burst of junk bytes injected in front of a packet.
+#define LW_GRF500_SIMULATOR_MAX_JUNK 16
+
+// History kept for the median and rolling average filters.
+#define LW_GRF500_SIMULATOR_FILTER_SIZE 32
+
+typedef struct {
+    // Identity reported by the device.
+    char product_name[16];
+    char serial_number[16];
+    uint32_t hardware_version;
+    uint32_t firmware_version;
+
+    // Target motion, noise and return strength.
+    int32_t distance_cm;
+    int32_t amplitude_cm;
+    uint32_t period_ms;
+    float noise_cm;
+    int32_t strength;
+
+    // Distance of the last return behind the first, or 0 for a single return.
+    int32_t last_return_offset_cm;
+
+    // Chance that a reading is lost.
+    float lost_probability;
+
+    // Temperature reported, in hundredths of a degree.
+    int32_t temperature;
+
+    // Chance that a packet from the device is dropped, has a byte corrupted,
+    // or has a burst of junk bytes in front of it.
+    float drop_probability;
+    float corrupt_probability;
+    float junk_probability;
+
+    // Chance that a request to the device is lost.
+    float request_drop_probability;
+
+    // Time from the end of a request to the start of its response, plus a
+    // uniform random jitter up to latency_jitter_us.
+    uint32_t latency_us;
+    uint32_t latency_jitter_us;
+
+    // Time after a reset during which input is ignored.
+    uint32_t boot_time_ms;
+
+    // Pace bytes at the baud rate, or send them as soon as they are due.
+    lw_bool pace_baud_rate;
+
+    uint32_t seed;
+} lw_grf500_simulator_config;
+
+// Writable registers, as sent on the wire. These are saved and restored.
+typedef struct {
+    uint8_t user_data[16];
+    uint32_t distance_config;
+    uint8_t laser_firing;
+    uint8_t auto_exposure;
+    uint32_t update_rate;
+    uint8_t alarm_return_mode;
+    uint32_t lost_signal_counter;
+    uint32_t alarm_a_distance;
+    uint32_t alarm_b_distance;
+    uint32_t alarm_hysteresis;
+    uint8_t gpio_mode;
+    uint32_t gpio_alarm_confirm_count;
+    uint8_t median_filter_enable;
+    uint32_t median_filter_size;
+    uint8_t smooth_filter_enable;
+    uint32_t smooth_filter_factor;
+    uint8_t baud_rate;
+    uint8_t i2c_address;
+    uint8_t rolling_average_enable;
+    uint32_t rolling_average_size;
+    uint8_t led_state;
+    int32_t zero_offset;
+} lw_grf500_simulator_registers;
+
+typedef struct {
+    int32_t median_history[LW_GRF500_SIMULATOR_FILTER_SIZE];
+    int32_t average_history[LW_GRF500_SIMULATOR_FILTER_SIZE];
+    uint32_t count;
+    uint32_t index;
+    int32_t smoothed;
+    int32_t last_raw;
+    int32_t last_filtered;
+} lw_grf500_simulator_filter;
+
+typedef struct {
+    uint64_t start_us;
+    uint32_t baud_rate;
+    uint32_t size;
+    uint32_t offset;
+    uint8_t data[LW_GRF500_SIMULATOR_PACKET_SIZE];
+} lw_grf500_simulator_packet;
+
+typedef struct {
+    uint64_t requests;
+    uint64_t responses;
+    uint64_t stream_packets;
+    uint64_t readings;
+    uint64_t bytes_received;
+    uint64_t bytes_sent;
+
+    // Requests refused for a bad value, size, register or token, and requests
+    // for commands the device doesn't know.
+    uint64_t rejected_requests;
+    uint64_t unknown_commands;
+
+    // Injected faults.
+    uint64_t dropped_requests;
+    uint64_t dropped_packets;
+    uint64_t corrupted_packets;
+    uint64_t junk_bytes;
+
+    // Packets lost because the host did not read them in time.
+    uint64_t overflows;
+
+    uint32_t saves;
+    uint32_t resets;
+    uint32_t sleeps;
+} lw_grf500_simulator_stats;
+
+typedef struct lw_grf500_simulator_s lw_grf500_simulator;
+
+/*
+ * Simulator host get time callback. Only used when the speed is not 0.
+ *
+ * @param simulator The simulator.
+ * @return The current host time in microseconds.
+ */
+typedef uint64_t (*lw_simulator_callback_get_time_us)(lw_grf500_simulator *simulator);
+
+/*
+ * Simulator host sleep callback. Only used when the speed is not 0.
+ *
+ * @param simulator The simulator.
+ * @param time_us The time to sleep in microseconds.
+ */
+typedef void (*lw_simulator_callback_sleep_us)(lw_grf500_simulator *simulator, uint64_t time_us);
+
+struct lw_grf500_simulator_s {
+    // The in process device, use this with the API.
+    lw_callback_device device;
+
+    lw_grf500_simulator_config config;
+    lw_grf500_simulator_registers registers;
+    lw_grf500_simulator_registers saved;
+    uint32_t stream;
+    uint16_t token;
+    lw_bool token_valid;
+    lw_bool asleep;
+    uint64_t boot_end_us;
+    uint32_t random;
+
+    // Reading state.
+    uint64_t next_reading_us;
+    uint32_t lost_count;
+    lw_grf500_simulator_filter filters[2];
+    int32_t reading[8];
+    int32_t multi_distance_mm[2];
+    uint32_t alarm_count[2];
+    lw_bool alarm_active[2];
+
+    // Bytes from the host, paced in at the baud rate.
+    lw_response request;
+    uint64_t receive_start_us;
+    uint32_t receive_count;
+
+    // Packets to the host, paced out at the baud rate.
+    lw_grf500_simulator_packet queue[LW_GRF500_SIMULATOR_QUEUE_SIZE];
+    uint32_t queue_head;
+    uint32_t queue_count;
+    uint64_t send_free_us;
+
+    // Time of the callback device.
+    void *user_data;
+    lw_simulator_callback_get_time_us get_time_us;
+    lw_simulator_callback_sleep_us sleep_us;
+    double speed;
+    uint64_t host_start_us;
+    uint64_t virtual_time_us;
+
+    lw_grf500_simulator_stats stats;
+};
+
+/*
+ * Get a simulator config with defaults: a GRF-500 with a target at 10 m
+ * moving 2 m over 10 s, 5 cm of noise, no faults, 1 ms latency, and baud
+ * rate pacing.
+ *
+ * @param config The config is written here.
+ */
+void lw_grf500_simulator_get_default_config(lw_grf500_simulator_config *config);
+
+/*
+ * Initialize a simulator. The registers start at their factory defaults,
+ * which are also the saved set, with no stream running.
+ *
+ * @param simulator The simulator to initialize. It must not be moved after this call.
+ * @param config The config, or NULL for the defaults.
+ * @param speed Speed of the callback device, 1 for real time, or 0 for virtual time.
+ * @param user_data User data to pass to the simulator callbacks.
+ * @param get_time_us Host get time callback, can be NULL when speed is 0.
+ * @param sleep_us Host sleep callback, can be NULL when speed is 0.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the config is invalid.
+ */
+lw_result lw_grf500_simulator_init(lw_grf500_simulator *simulator, const lw_grf500_simulator_config *config, double speed, void *user_data, lw_simulator_callback_get_time_us get_time_us, lw_simulator_callback_sleep_us sleep_us);
+
+/*
+ * Feed bytes from the host to the simulator. Complete requests are handled
+ * at the time their last byte arrives.
+ *
+ * @param simulator The simulator.
+ * @param now_us The current simulator time in microseconds, which must not go backwards.
+ * @param data The bytes sent by the host.
+ * @param size The number of bytes.
+ */
+void lw_grf500_simulator_write(lw_grf500_simulator *simulator, uint64_t now_us, const uint8_t *data, uint32_t size);
+
+/*
+ * Take the bytes the simulator has sent by a given time.
+ *
+ * @param simulator The simulator.
+ * @param now_us The current simulator time in microseconds, which must not go backwards.
+ * @param buffer The bytes are written here.
+ * @param size The size of the buffer.
+ * @return The number of bytes written to the buffer.
+ */
+uint32_t lw_grf500_simulator_read(lw_grf500_simulator *simulator, uint64_t now_us, uint8_t *buffer, uint32_t size);
+
+/*
+ * Get the earliest time the simulator can have another byte for the host.
+ * Dropped packets mean there may still be nothing to read at that time.
+ *
+ * @param simulator The simulator.
+ * @param now_us The current simulator time in microseconds.
+ * @return The time in microseconds, at least now_us, or UINT64_MAX if nothing is pending.
+ */
+uint64_t lw_grf500_simulator_next_byte_us(lw_grf500_simulator *simulator, uint64_t now_us);
+
+/*
+ * Get the current time of the callback device.
+ *
+ * @param simulator The simulator.
+ * @return The time in microseconds since the simulator was initialized.
+ */
+uint64_t lw_grf500_simulator_get_time_us(lw_grf500_simulator *simulator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_SIMULATOR_H
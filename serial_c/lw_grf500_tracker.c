@@ -0,0 +1,261 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Multi-Return Tracker
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_grf500_tracker.h"
+#include <string.h>
+
+#define LW_TRACKER_NONE 0xFF
+
+// Tracks and returns are paired by uint8_t index, with LW_TRACKER_NONE for none.
+#if LW_GRF500_TRACKER_MAX_TRACKS >= LW_TRACKER_NONE
+#error "LW_GRF500_TRACKER_MAX_TRACKS must be less than 255"
+#endif
+
+// ----------------------------------------------------------------------------
+// Internal helpers.
+// ----------------------------------------------------------------------------
+static float lw_tracker_abs(float value) {
+    return (value < 0) ? -value : value;
+}
+
+static void lw_tracker_free(lw_grf500_tracker *tracker, lw_grf500_track *track) {
+    LW_DEBUG_LVL_2("Tracker: Track %u dropped\n", track->id);
+    memset(track, 0, sizeof(*track));
+    tracker->stats.deaths++;
+}
+
+static lw_grf500_track *lw_tracker_birth(lw_grf500_tracker *tracker, const lw_grf500_multi_data_signal *signal, uint64_t timestamp_us) {
+    for (uint32_t t = 0; t < LW_GRF500_TRACKER_MAX_TRACKS; ++t) {
+        lw_grf500_track *track = &tracker->tracks[t];
+
+        if (track->id != 0) {
+            continue;
+        }
+
+        track->id = tracker->next_id;
+        tracker->next_id = (tracker->next_id == UINT32_MAX) ? 1 : tracker->next_id + 1;
+        track->confirmed = (tracker->config.confirm_hits <= 1);
+        track->distance_mm = (float)signal->distance_mm;
+        track->speed_mm_per_s = 0;
+        track->strength = (float)signal->strength;
+        track->hits = 1;
+        track->misses = 0;
+        track->first_timestamp_us = timestamp_us;
+        track->last_hit_us = timestamp_us;
+        tracker->stats.births++;
+
+        if (track->confirmed) {
+            tracker->stats.confirmations++;
+        }
+
+        return track;
+    }
+
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------
+// Tracker.
+// ----------------------------------------------------------------------------
+void lw_grf500_tracker_get_default_config(lw_grf500_tracker_config *config) {
+    config->gate_mm = 500;
+    config->alpha = 0.5f;
+    config->beta = 0.1f;
+    config->confirm_hits = 3;
+    config->max_misses = 5;
+    config->min_strength = 1;
+}
+
+lw_result lw_grf500_tracker_init(lw_grf500_tracker *tracker, const lw_grf500_tracker_config *config) {
+    memset(tracker, 0, sizeof(*tracker));
+
+    if (config) {
+        tracker->config = *config;
+    } else {
+        lw_grf500_tracker_get_default_config(&tracker->config);
+    }
+
+    config = &tracker->config;
+
+    if (config->gate_mm <= 0 || config->alpha < 0 || config->alpha > 1 || config->beta < 0 || config->beta > 1 || config->confirm_hits == 0) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    tracker->next_id = 1;
+
+    return LW_RESULT_SUCCESS;
+}
+
+void lw_grf500_tracker_reset(lw_grf500_tracker *tracker) {
+    memset(tracker->tracks, 0, sizeof(tracker->tracks));
+    tracker->has_timestamp = LW_FALSE;
+}
+
+void lw_grf500_tracker_update(lw_grf500_tracker *tracker, const lw_grf500_multi_sample *sample, uint32_t track_ids[LW_GRF500_TRACKER_RETURN_COUNT]) {
+    const lw_grf500_tracker_config *config = &tracker->config;
+    float predicted[LW_GRF500_TRACKER_MAX_TRACKS];
+    uint8_t track_return[LW_GRF500_TRACKER_MAX_TRACKS];
+    uint8_t return_track[LW_GRF500_TRACKER_RETURN_COUNT];
+    lw_bool usable[LW_GRF500_TRACKER_RETURN_COUNT];
+    float dt = 0;
+
+    if (tracker->has_timestamp && sample->timestamp_us > tracker->last_timestamp_us) {
+        dt = (float)(sample->timestamp_us - tracker->last_timestamp_us) / 1000000.0f;
+    }
+
+    tracker->last_timestamp_us = sample->timestamp_us;
+    tracker->has_timestamp = LW_TRUE;
+    tracker->stats.frames++;
+
+    // Predict every track to the frame time.
+    for (uint32_t t = 0; t < LW_GRF500_TRACKER_MAX_TRACKS; ++t) {
+        lw_grf500_track *track = &tracker->tracks[t];
+        predicted[t] = track->distance_mm + track->speed_mm_per_s * dt;
+        track_return[t] = LW_TRACKER_NONE;
+    }
+
+    for (uint32_t r = 0; r < LW_GRF500_TRACKER_RETURN_COUNT; ++r) {
+        const lw_grf500_multi_data_signal *signal = &sample->data.signals[r];
+        usable[r] = (signal->distance_mm > 0 && signal->strength >= config->min_strength);
+        return_track[r] = LW_TRACKER_NONE;
+    }
+
+    // Greedy nearest neighbour: pair the closest return and track within the
+    // gate, then the closest of the rest, and so on. Confirmed tracks pick
+    // first, so a new track started by clutter can't take over a target.
+    for (uint32_t pass = 0; pass < 2; ++pass) {
+        lw_bool confirmed = (pass == 0);
+
+        while (1) {
+            float best_error = config->gate_mm;
+            uint32_t best_track = LW_TRACKER_NONE;
+            uint32_t best_return = LW_TRACKER_NONE;
+
+            for (uint32_t r = 0; r < LW_GRF500_TRACKER_RETURN_COUNT; ++r) {
+                if (!usable[r] || return_track[r] != LW_TRACKER_NONE) {
+                    continue;
+                }
+
+                float distance = (float)sample->data.signals[r].distance_mm;
+
+                for (uint32_t t = 0; t < LW_GRF500_TRACKER_MAX_TRACKS; ++t) {
+                    if (tracker->tracks[t].id == 0 || tracker->tracks[t].confirmed != confirmed || track_return[t] != LW_TRACKER_NONE) {
+                        continue;
+                    }
+
+                    float error = lw_tracker_abs(distance - predicted[t]);
+
+                    // Ties go to the older track.
+                    if (error < best_error || (error == best_error && best_track != LW_TRACKER_NONE && tracker->tracks[t].id < tracker->tracks[best_track].id)) {
+                        best_error = error;
+                        best_track = t;
+                        best_return = r;
+                    }
+                }
+            }
+
+            if (best_track == LW_TRACKER_NONE) {
+                break;
+            }
+
+            track_return[best_track] = (uint8_t)best_return;
+            return_track[best_return] = (uint8_t)best_track;
+        }
+    }
+
+    // Correct the paired tracks, and age the others.
+    for (uint32_t t = 0; t < LW_GRF500_TRACKER_MAX_TRACKS; ++t) {
+        lw_grf500_track *track = &tracker->tracks[t];
+
+        if (track->id == 0) {
+            continue;
+        }
+
+        if (track_return[t] == LW_TRACKER_NONE) {
+            track->distance_mm = predicted[t];
+            track->misses++;
+
+            if (!track->confirmed || track->misses > config->max_misses) {
+                lw_tracker_free(tracker, track);
+            }
+
+            continue;
+        }
+
+        const lw_grf500_multi_data_signal *signal = &sample->data.signals[track_return[t]];
+        float error = (float)signal->distance_mm - predicted[t];
+
+        track->distance_mm = predicted[t] + config->alpha * error;
+
+        if (dt > 0) {
+            track->speed_mm_per_s += config->beta * error / dt;
+        }
+
+        track->strength += config->alpha * ((float)signal->strength - track->strength);
+        track->hits++;
+        track->misses = 0;
+        track->last_hit_us = sample->timestamp_us;
+
+        if (!track->confirmed && track->hits >= config->confirm_hits) {
+            LW_DEBUG_LVL_2("Tracker: Track %u confirmed\n", track->id);
+            track->confirmed = LW_TRUE;
+            tracker->stats.confirmations++;
+        }
+    }
+
+    // Start tracks for the returns left over.
+    for (uint32_t r = 0; r < LW_GRF500_TRACKER_RETURN_COUNT; ++r) {
+        uint32_t id = 0;
+
+        if (return_track[r] != LW_TRACKER_NONE) {
+            id = tracker->tracks[return_track[r]].id;
+        } else if (usable[r]) {
+            lw_grf500_track *track = lw_tracker_birth(tracker, &sample->data.signals[r], sample->timestamp_us);
+
+            if (track) {
+                id = track->id;
+            } else {
+                tracker->stats.dropped_returns++;
+            }
+        }
+
+        if (track_ids) {
+            track_ids[r] = id;
+        }
+    }
+}
+
+const lw_grf500_track *lw_grf500_tracker_find_track(const lw_grf500_tracker *tracker, uint32_t id) {
+    if (id == 0) {
+        return NULL;
+    }
+
+    for (uint32_t t = 0; t < LW_GRF500_TRACKER_MAX_TRACKS; ++t) {
+        if (tracker->tracks[t].id == id) {
+            return &tracker->tracks[t];
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,154 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API GRF-500 Multi-Return Tracker
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_GRF500_TRACKER_H
+#define LW_GRF500_TRACKER_H
+
+#include "lw_grf500_sample.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Multi-return tracker.
+//
+// The tracker follows the returns of one sensor across consecutive multi
+// data frames, so that a return keeps the same track ID from frame to frame,
+// for example a wire in front of a wall, or rain in front of a target.
+//
+// Every track has an alpha-beta filter for its distance and closing speed.
+// Each frame, the tracks are predicted to the frame time, and returns are
+// paired with the nearest predicted track within the gate, closest pairs
+// first, with confirmed tracks served before tentative ones. Returns left
+// over start new tentative tracks, which are confirmed
+// after enough consecutive hits. A tentative track is dropped at its first
+// miss, a confirmed one after too many consecutive misses.
+//
+// Returns with a distance of zero or less, which includes lost signal
+// readings and unused return slots, or below the minimum strength, are
+// ignored. The work per frame is bounded by the number of returns and
+// tracks, and nothing is allocated.
+// ----------------------------------------------------------------------------
+// Up to 254 tracks.
+#ifndef LW_GRF500_TRACKER_MAX_TRACKS
+#define LW_GRF500_TRACKER_MAX_TRACKS 8
+#endif
+
+#define LW_GRF500_TRACKER_RETURN_COUNT 5
+
+typedef struct {
+    // Largest distance in mm between a return and a predicted track for them to be paired.
+    float gate_mm;
+
+    // Share of the prediction error applied to the distance and speed, 0 to 1.
+    float alpha;
+    float beta;
+
+    // Consecutive hits before a new track is confirmed.
+    uint32_t confirm_hits;
+
+    // Consecutive misses after which a confirmed track is dropped.
+    uint32_t max_misses;
+
+    // Returns weaker than this are ignored.
+    int32_t min_strength;
+} lw_grf500_tracker_config;
+
+typedef struct {
+    // Track ID, never 0. A slot with ID 0 is free.
+    uint32_t id;
+    lw_bool confirmed;
+    float distance_mm;
+    float speed_mm_per_s;
+    float strength;
+    uint32_t hits;
+    uint32_t misses;
+    uint64_t first_timestamp_us;
+    uint64_t last_hit_us;
+} lw_grf500_track;
+
+typedef struct {
+    uint64_t frames;
+    uint64_t births;
+    uint64_t confirmations;
+    uint64_t deaths;
+    uint64_t dropped_returns;
+} lw_grf500_tracker_stats;
+
+typedef struct {
+    lw_grf500_tracker_config config;
+    lw_grf500_track tracks[LW_GRF500_TRACKER_MAX_TRACKS];
+    uint32_t next_id;
+    uint64_t last_timestamp_us;
+    lw_bool has_timestamp;
+    lw_grf500_tracker_stats stats;
+} lw_grf500_tracker;
+
+/*
+ * Get a tracker config with defaults suited to a sensor streaming at 10 Hz.
+ *
+ * @param config The config is written here.
+ */
+void lw_grf500_tracker_get_default_config(lw_grf500_tracker_config *config);
+
+/*
+ * Initialize a tracker.
+ *
+ * @param tracker The tracker to initialize.
+ * @param config The config, NULL for the defaults.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the config is out of range.
+ */
+lw_result lw_grf500_tracker_init(lw_grf500_tracker *tracker, const lw_grf500_tracker_config *config);
+
+/*
+ * Drop all tracks. Track IDs keep counting up.
+ *
+ * @param tracker The tracker.
+ */
+void lw_grf500_tracker_reset(lw_grf500_tracker *tracker);
+
+/*
+ * Update the tracks with the next frame. Frames must be in time order.
+ *
+ * @param tracker The tracker.
+ * @param sample The frame.
+ * @param track_ids The track ID of each return is written here, 0 for returns that are ignored or could not be tracked. Can be NULL.
+ */
+void lw_grf500_tracker_update(lw_grf500_tracker *tracker, const lw_grf500_multi_sample *sample, uint32_t track_ids[LW_GRF500_TRACKER_RETURN_COUNT]);
+
+/*
+ * Find a track by ID.
+ *
+ * @param tracker The tracker.
+ * @param id The track ID.
+ * @return The track, or NULL if there is no track with the ID.
+ */
+const lw_grf500_track *lw_grf500_tracker_find_track(const lw_grf500_tracker *tracker, uint32_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_GRF500_TRACKER_H
@@ -0,0 +1,142 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API Seqlock
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_SEQLOCK_H
+#define LW_SEQLOCK_H
+
+#include "lw_serial_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Sequence lock.
+//
+// A seqlock lets one writer publish data to any number of readers without
+// the readers ever blocking the writer, or writing to shared memory at all.
+// The writer makes the sequence odd before changing the data and even again
+// afterwards. A reader copies the data between two reads of the sequence and
+// keeps the copy only if the sequence was even and did not change.
+//
+// The lock uses the GCC and Clang __atomic builtins, which follow the C11
+// memory model, so it works across threads and across processes sharing
+// memory. With MSVC it falls back to volatile accesses with compiler
+// barriers on x86 and x64, and full barriers on ARM64.
+// ----------------------------------------------------------------------------
+#if defined(__GNUC__) || defined(__clang__)
+#define LW_SEQLOCK_LOAD_ACQUIRE(pointer) __atomic_load_n((pointer), __ATOMIC_ACQUIRE)
+#define LW_SEQLOCK_LOAD_RELAXED(pointer) __atomic_load_n((pointer), __ATOMIC_RELAXED)
+#define LW_SEQLOCK_STORE_RELEASE(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELEASE)
+#define LW_SEQLOCK_STORE_RELAXED(pointer, value) __atomic_store_n((pointer), (value), __ATOMIC_RELAXED)
+#define LW_SEQLOCK_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define LW_SEQLOCK_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#if defined(_M_ARM64) || defined(_M_ARM)
+#define LW_SEQLOCK_BARRIER() __dmb(_ARM64_BARRIER_ISH)
+#else
+#define LW_SEQLOCK_BARRIER() _ReadWriteBarrier()
+#endif
+#define LW_SEQLOCK_LOAD_ACQUIRE(pointer) lw_seqlock_msvc_load(pointer)
+#define LW_SEQLOCK_LOAD_RELAXED(pointer) (*(pointer))
+#define LW_SEQLOCK_STORE_RELEASE(pointer, value) \
+    do {                                         \
+        LW_SEQLOCK_BARRIER();                    \
+        *(pointer) = (value);                    \
+    } while (0)
+#define LW_SEQLOCK_STORE_RELAXED(pointer, value) (*(pointer) = (value))
+#define LW_SEQLOCK_FENCE_ACQUIRE() LW_SEQLOCK_BARRIER()
+#define LW_SEQLOCK_FENCE_RELEASE() LW_SEQLOCK_BARRIER()
+
+static inline uint32_t lw_seqlock_msvc_load(const volatile uint32_t *pointer) {
+    uint32_t value = *pointer;
+    LW_SEQLOCK_BARRIER();
+    return value;
+}
+#else
+#error "lw_seqlock.h needs GCC, Clang or MSVC atomics"
+#endif
+
+typedef struct {
+    volatile uint32_t sequence;
+} lw_seqlock;
+
+/*
+ * Initialize a seqlock.
+ *
+ * @param lock The seqlock.
+ */
+static inline void lw_seqlock_init(lw_seqlock *lock) {
+    LW_SEQLOCK_STORE_RELEASE(&lock->sequence, 0);
+}
+
+/*
+ * Start writing the protected data. There must only ever be one writer.
+ *
+ * @param lock The seqlock.
+ */
+static inline void lw_seqlock_write_begin(lw_seqlock *lock) {
+    uint32_t sequence = LW_SEQLOCK_LOAD_RELAXED(&lock->sequence);
+    LW_SEQLOCK_STORE_RELAXED(&lock->sequence, sequence + 1);
+    LW_SEQLOCK_FENCE_RELEASE();
+}
+
+/*
+ * Finish writing the protected data.
+ *
+ * @param lock The seqlock.
+ */
+static inline void lw_seqlock_write_end(lw_seqlock *lock) {
+    uint32_t sequence = LW_SEQLOCK_LOAD_RELAXED(&lock->sequence);
+    LW_SEQLOCK_STORE_RELEASE(&lock->sequence, sequence + 1);
+}
+
+/*
+ * Start reading the protected data.
+ *
+ * @param lock The seqlock.
+ * @return The sequence to pass to lw_seqlock_read_retry.
+ */
+static inline uint32_t lw_seqlock_read_begin(const lw_seqlock *lock) {
+    return LW_SEQLOCK_LOAD_ACQUIRE(&lock->sequence);
+}
+
+/*
+ * Finish reading the protected data, and check whether the copy is valid.
+ *
+ * @param lock The seqlock.
+ * @param sequence The sequence returned by lw_seqlock_read_begin.
+ * @return LW_TRUE if a write overlapped the read and the copy must be discarded.
+ */
+static inline lw_bool lw_seqlock_read_retry(const lw_seqlock *lock, uint32_t sequence) {
+    LW_SEQLOCK_FENCE_ACQUIRE();
+    return (sequence & 1) || LW_SEQLOCK_LOAD_RELAXED(&lock->sequence) != sequence;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_SEQLOCK_H
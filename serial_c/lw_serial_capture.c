@@ -0,0 +1,271 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API Capture
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#include "lw_serial_capture.h"
+#include <string.h>
+
+// ----------------------------------------------------------------------------
+// Capture callbacks.
+// ----------------------------------------------------------------------------
+static void lw_capture_record(lw_serial_capture *capture, lw_capture_direction direction, const uint8_t *data, uint32_t size) {
+    lw_capture_record_header header;
+    header.timestamp_us = capture->get_time_us(capture);
+    header.size = size;
+    header.direction = direction;
+
+    if (capture->write(capture, &header, sizeof(header)) != LW_RESULT_SUCCESS || capture->write(capture, data, size) != LW_RESULT_SUCCESS) {
+        // A failing capture must not take the live connection down with it.
+        capture->write_errors++;
+        return;
+    }
+
+    capture->records++;
+}
+
+static void lw_capture_sleep(lw_callback_device *device, uint32_t time_ms) {
+    lw_serial_capture *capture = (lw_serial_capture *)device->user_data;
+    capture->inner->sleep(capture->inner, time_ms);
+}
+
+static uint32_t lw_capture_get_time_ms(lw_callback_device *device) {
+    lw_serial_capture *capture = (lw_serial_capture *)device->user_data;
+    return capture->inner->get_time_ms(capture->inner);
+}
+
+static uint32_t lw_capture_serial_send(lw_callback_device *device, uint8_t *buffer, uint32_t size) {
+    lw_serial_capture *capture = (lw_serial_capture *)device->user_data;
+    uint32_t bytes_sent = capture->inner->serial_send(capture->inner, buffer, size);
+
+    if (bytes_sent > 0) {
+        lw_capture_record(capture, LW_CAPTURE_DIRECTION_SENT, buffer, bytes_sent);
+        capture->bytes_sent += bytes_sent;
+    }
+
+    return bytes_sent;
+}
+
+static int32_t lw_capture_serial_receive(lw_callback_device *device, uint8_t *buffer, uint32_t size, uint32_t timeout_ms) {
+    lw_serial_capture *capture = (lw_serial_capture *)device->user_data;
+
+    if (capture->buffer_offset == capture->buffer_size) {
+        int32_t bytes_read = capture->inner->serial_receive(capture->inner, capture->buffer, LW_CAPTURE_READ_SIZE, timeout_ms);
+
+        if (bytes_read <= 0) {
+            return bytes_read;
+        }
+
+        lw_capture_record(capture, LW_CAPTURE_DIRECTION_RECEIVED, capture->buffer, (uint32_t)bytes_read);
+        capture->bytes_received += (uint32_t)bytes_read;
+        capture->buffer_size = (uint32_t)bytes_read;
+        capture->buffer_offset = 0;
+    }
+
+    uint32_t count = capture->buffer_size - capture->buffer_offset;
+
+    if (count > size) {
+        count = size;
+    }
+
+    memcpy(buffer, capture->buffer + capture->buffer_offset, count);
+    capture->buffer_offset += count;
+
+    return (int32_t)count;
+}
+
+lw_result lw_serial_capture_init(lw_serial_capture *capture, lw_callback_device *inner, void *user_data, lw_capture_callback_get_time_us get_time_us, lw_capture_callback_write write) {
+    memset(capture, 0, sizeof(*capture));
+    capture->inner = inner;
+    capture->user_data = user_data;
+    capture->get_time_us = get_time_us;
+    capture->write = write;
+    capture->device = lw_create_callback_device(capture, lw_capture_sleep, lw_capture_get_time_ms, lw_capture_serial_send, lw_capture_serial_receive);
+
+    lw_capture_file_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LW_CAPTURE_MAGIC, sizeof(header.magic));
+    header.version = LW_CAPTURE_VERSION;
+
+    return write(capture, &header, sizeof(header));
+}
+
+// ----------------------------------------------------------------------------
+// Replay callbacks.
+// ----------------------------------------------------------------------------
+static uint64_t lw_replay_now_us(lw_serial_replay *replay) {
+    if (replay->speed > 0) {
+        uint64_t host_elapsed_us = replay->get_time_us(replay) - replay->host_start_us;
+        replay->virtual_time_us = (uint64_t)((double)host_elapsed_us * replay->speed);
+    }
+
+    return replay->virtual_time_us;
+}
+
+// Move to the next received record, skipping sent data.
+static void lw_replay_next_record(lw_serial_replay *replay) {
+    while (1) {
+        lw_capture_record_header header;
+
+        if (replay->size - replay->offset < sizeof(header)) {
+            replay->finished = LW_TRUE;
+            return;
+        }
+
+        memcpy(&header, replay->data + replay->offset, sizeof(header));
+        replay->offset += sizeof(header);
+
+        if (replay->size - replay->offset < header.size) {
+            replay->finished = LW_TRUE;
+            return;
+        }
+
+        replay->record = replay->data + replay->offset;
+        replay->offset += header.size;
+
+        if (header.direction == LW_CAPTURE_DIRECTION_RECEIVED && header.size > 0) {
+            replay->record_size = header.size;
+            replay->record_offset = 0;
+            replay->record_time_us = header.timestamp_us - replay->start_timestamp_us;
+            return;
+        }
+    }
+}
+
+static void lw_replay_sleep(lw_callback_device *device, uint32_t time_ms) {
+    lw_serial_replay *replay = (lw_serial_replay *)device->user_data;
+
+    if (replay->speed > 0) {
+        replay->sleep_us(replay, (uint64_t)((double)time_ms * 1000.0 / replay->speed));
+    } else {
+        replay->virtual_time_us += (uint64_t)time_ms * 1000;
+    }
+}
+
+static uint32_t lw_replay_get_time_ms(lw_callback_device *device) {
+    lw_serial_replay *replay = (lw_serial_replay *)device->user_data;
+    return (uint32_t)(lw_replay_now_us(replay) / 1000);
+}
+
+static uint32_t lw_replay_serial_send(lw_callback_device *device, uint8_t *buffer, uint32_t size) {
+    (void)device;
+    (void)buffer;
+
+    return size;
+}
+
+static int32_t lw_replay_serial_receive(lw_callback_device *device, uint8_t *buffer, uint32_t size, uint32_t timeout_ms) {
+    lw_serial_replay *replay = (lw_serial_replay *)device->user_data;
+
+    while (1) {
+        if (replay->record_offset == replay->record_size) {
+            lw_replay_next_record(replay);
+
+            if (replay->finished) {
+                return -1;
+            }
+        }
+
+        uint64_t now_us = lw_replay_now_us(replay);
+
+        if (replay->record_time_us <= now_us) {
+            uint32_t count = replay->record_size - replay->record_offset;
+
+            if (count > size) {
+                count = size;
+            }
+
+            memcpy(buffer, replay->record + replay->record_offset, count);
+            replay->record_offset += count;
+            replay->bytes_received += count;
+
+            return (int32_t)count;
+        }
+
+        if (timeout_ms == 0) {
+            return 0;
+        }
+
+        uint64_t wait_us = replay->record_time_us - now_us;
+        uint64_t timeout_us = (uint64_t)timeout_ms * 1000;
+        lw_bool timed_out = (wait_us > timeout_us);
+
+        if (timed_out) {
+            wait_us = timeout_us;
+        }
+
+        if (replay->speed > 0) {
+            replay->sleep_us(replay, (uint64_t)((double)wait_us / replay->speed));
+        } else {
+            replay->virtual_time_us += wait_us;
+        }
+
+        if (timed_out) {
+            return 0;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Replay.
+// ----------------------------------------------------------------------------
+lw_result lw_serial_replay_init(lw_serial_replay *replay, const void *data, uint64_t size, double speed, void *user_data, lw_replay_callback_get_time_us get_time_us, lw_replay_callback_sleep_us sleep_us) {
+    lw_capture_file_header header;
+
+    memset(replay, 0, sizeof(*replay));
+
+    if (size < sizeof(header) || (speed > 0 && (get_time_us == NULL || sleep_us == NULL))) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, LW_CAPTURE_MAGIC, sizeof(header.magic)) != 0 || header.version != LW_CAPTURE_VERSION) {
+        return LW_RESULT_INVALID_PARAMETER;
+    }
+
+    replay->user_data = user_data;
+    replay->get_time_us = get_time_us;
+    replay->sleep_us = sleep_us;
+    replay->speed = (speed > 0) ? speed : 0;
+    replay->data = (const uint8_t *)data;
+    replay->size = size;
+    replay->offset = sizeof(header);
+    replay->device = lw_create_callback_device(replay, lw_replay_sleep, lw_replay_get_time_ms, lw_replay_serial_send, lw_replay_serial_receive);
+
+    // Virtual time starts at the first record, sent or received.
+    if (size - replay->offset >= sizeof(lw_capture_record_header)) {
+        lw_capture_record_header first;
+        memcpy(&first, replay->data + replay->offset, sizeof(first));
+        replay->start_timestamp_us = first.timestamp_us;
+    }
+
+    if (replay->speed > 0) {
+        replay->host_start_us = get_time_us(replay);
+    }
+
+    return LW_RESULT_SUCCESS;
+}
+
+uint64_t lw_serial_replay_get_time_us(lw_serial_replay *replay) {
+    return lw_replay_now_us(replay);
+}
@@ -0,0 +1,216 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API Capture
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_SERIAL_CAPTURE_H
+#define LW_SERIAL_CAPTURE_H
+
+#include "lw_serial_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// Wire capture.
+//
+// A capture device wraps another callback device and records every chunk of
+// bytes that passes through its serial callbacks, stamped with a microsecond
+// clock. The API reads the serial port one byte at a time, so the capture
+// device reads from the wrapped device in larger blocks and records each
+// block as it arrived from the port.
+//
+// A capture is a file header followed by records. Each record is a record
+// header followed by the bytes it holds. Multi byte values are stored in host
+// byte order.
+// ----------------------------------------------------------------------------
+#define LW_CAPTURE_MAGIC "LWSERCAP"
+#define LW_CAPTURE_VERSION 1
+
+#ifndef LW_CAPTURE_READ_SIZE
+#define LW_CAPTURE_READ_SIZE 256
+#endif
+
+typedef enum {
+    LW_CAPTURE_DIRECTION_RECEIVED = 0,
+    LW_CAPTURE_DIRECTION_SENT = 1,
+} lw_capture_direction;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+} lw_capture_file_header;
+
+typedef struct {
+    uint64_t timestamp_us;
+    uint32_t size;
+    uint32_t direction;
+} lw_capture_record_header;
+
+typedef struct lw_serial_capture_s lw_serial_capture;
+
+/*
+ * Capture get time callback. This callback is called to stamp every record,
+ * and should return a monotonic time in microseconds.
+ *
+ * @param capture The capture.
+ * @return The current time in microseconds.
+ */
+typedef uint64_t (*lw_capture_callback_get_time_us)(lw_serial_capture *capture);
+
+/*
+ * Capture write callback. This callback is called with the capture file
+ * header once, and then with each record header followed by its bytes. It is
+ * called from inside the serial callbacks, so it should buffer rather than
+ * block.
+ *
+ * @param capture The capture.
+ * @param data The data to write.
+ * @param size The number of bytes to write.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+typedef lw_result (*lw_capture_callback_write)(lw_serial_capture *capture, const void *data, uint32_t size);
+
+struct lw_serial_capture_s {
+    // The capturing device, use this with the API instead of the wrapped device.
+    lw_callback_device device;
+    lw_callback_device *inner;
+
+    void *user_data;
+    lw_capture_callback_get_time_us get_time_us;
+    lw_capture_callback_write write;
+
+    uint8_t buffer[LW_CAPTURE_READ_SIZE];
+    uint32_t buffer_size;
+    uint32_t buffer_offset;
+
+    uint64_t records;
+    uint64_t bytes_received;
+    uint64_t bytes_sent;
+    uint32_t write_errors;
+};
+
+/*
+ * Initialize a capture around a callback device. The capture file header is
+ * written straight away.
+ *
+ * @param capture The capture to initialize. It must not be moved after this call.
+ * @param inner The device to capture, it must stay valid for the lifetime of the capture.
+ * @param user_data User data to pass to the capture callbacks.
+ * @param get_time_us Get time callback.
+ * @param write Write callback.
+ * @return LW_RESULT_SUCCESS on success, or an error code on failure.
+ */
+lw_result lw_serial_capture_init(lw_serial_capture *capture, lw_callback_device *inner, void *user_data, lw_capture_callback_get_time_us get_time_us, lw_capture_callback_write write);
+
+// ----------------------------------------------------------------------------
+// Wire replay.
+//
+// A replay device plays the received bytes of a capture back into the API,
+// through the serial receive callback. Time seen through the get time and
+// sleep callbacks is virtual time, which follows the capture timestamps
+// starting at 0, so timeouts behave as they did while capturing.
+//
+// At speed 0 the replay runs as fast as possible: virtual time only moves
+// when the API waits, and jumps straight to the next record instead of
+// waiting for it. The same capture then always produces the same sequence of
+// results, independent of the host. At any other speed virtual time follows
+// the host clock scaled by the speed, so 1 replays in real time and 10 at
+// ten times real time.
+//
+// Sent data is accepted and discarded. At the end of the capture, receive
+// reports a lost connection so that streaming loops terminate.
+// ----------------------------------------------------------------------------
+typedef struct lw_serial_replay_s lw_serial_replay;
+
+/*
+ * Replay host get time callback. Only used when the replay speed is not 0.
+ *
+ * @param replay The replay.
+ * @return The current host time in microseconds.
+ */
+typedef uint64_t (*lw_replay_callback_get_time_us)(lw_serial_replay *replay);
+
+/*
+ * Replay host sleep callback. Only used when the replay speed is not 0.
+ *
+ * @param replay The replay.
+ * @param time_us The time to sleep in microseconds.
+ */
+typedef void (*lw_replay_callback_sleep_us)(lw_serial_replay *replay, uint64_t time_us);
+
+struct lw_serial_replay_s {
+    // The replaying device, use this with the API.
+    lw_callback_device device;
+
+    void *user_data;
+    lw_replay_callback_get_time_us get_time_us;
+    lw_replay_callback_sleep_us sleep_us;
+    double speed;
+
+    const uint8_t *data;
+    uint64_t size;
+    uint64_t offset;
+
+    const uint8_t *record;
+    uint32_t record_size;
+    uint32_t record_offset;
+    uint64_t record_time_us;
+
+    uint64_t start_timestamp_us;
+    uint64_t host_start_us;
+    uint64_t virtual_time_us;
+    lw_bool finished;
+
+    uint64_t bytes_received;
+};
+
+/*
+ * Initialize a replay of a capture held in memory, usually a memory mapped
+ * capture file.
+ *
+ * @param replay The replay to initialize. It must not be moved after this call.
+ * @param data The capture bytes, these must stay valid for the lifetime of the replay.
+ * @param size The number of capture bytes.
+ * @param speed Replay speed, 1 for real time, or 0 for as fast as possible.
+ * @param user_data User data to pass to the replay callbacks.
+ * @param get_time_us Host get time callback, can be NULL when speed is 0.
+ * @param sleep_us Host sleep callback, can be NULL when speed is 0.
+ * @return LW_RESULT_SUCCESS on success, or LW_RESULT_INVALID_PARAMETER if the data is not a capture.
+ */
+lw_result lw_serial_replay_init(lw_serial_replay *replay, const void *data, uint64_t size, double speed, void *user_data, lw_replay_callback_get_time_us get_time_us, lw_replay_callback_sleep_us sleep_us);
+
+/*
+ * Get the current virtual time of a replay.
+ *
+ * @param replay The replay.
+ * @return The virtual time in microseconds since the start of the capture.
+ */
+uint64_t lw_serial_replay_get_time_us(lw_serial_replay *replay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_SERIAL_CAPTURE_H
@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------------
+// LightWare Serial API SIMD Support
+// Version: 1.1.0
+// Copyright (c) 2025 LightWare Optoelectronics (Pty) Ltd.
+// https://www.lightwarelidar.com
+// ----------------------------------------------------------------------------
+//
+// License: MIT No Attribution (MIT-0)
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+#ifndef LW_SIMD_H
+#define LW_SIMD_H
+
+#include "lw_serial_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ----------------------------------------------------------------------------
+// SIMD support.
+//
+// Vector code paths are built into the library alongside the scalar ones and
+// picked at runtime, so one binary runs on any CPU of its architecture.
+//
+// On x86-64 with GCC or Clang, AVX2 functions are compiled with a target
+// attribute, without needing -mavx2 for the whole build, and only called when
+// the CPU reports AVX2. On AArch64 NEON is always available.
+//
+// Define LW_SIMD_DISABLE to build the scalar paths only.
+// ----------------------------------------------------------------------------
+#if !defined(LW_SIMD_DISABLE) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define LW_SIMD_AVX2 1
+#define LW_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+#if !defined(LW_SIMD_DISABLE) && (defined(__aarch64__) || defined(__ARM_NEON))
+#define LW_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+typedef enum {
+    LW_SIMD_LEVEL_SCALAR = 0,
+    LW_SIMD_LEVEL_AVX2 = 1,
+    LW_SIMD_LEVEL_NEON = 2,
+} lw_simd_level;
+
+/*
+ * Get the best SIMD level supported by both the build and the CPU.
+ *
+ * @return The SIMD level.
+ */
+static inline lw_simd_level lw_simd_detect(void) {
+#if defined(LW_SIMD_AVX2)
+    if (__builtin_cpu_supports("avx2")) {
+        return LW_SIMD_LEVEL_AVX2;
+    }
+#elif defined(LW_SIMD_NEON)
+    return LW_SIMD_LEVEL_NEON;
+#endif
+
+    return LW_SIMD_LEVEL_SCALAR;
+}
+
+/*
+ * Get the name of a SIMD level.
+ *
+ * @param level The SIMD level.
+ * @return The name.
+ */
+static inline const char *lw_simd_level_name(lw_simd_level level) {
+    switch (level) {
+        case LW_SIMD_LEVEL_AVX2: {
+            return "avx2";
+        }
+        case LW_SIMD_LEVEL_NEON: {
+            return "neon";
+        }
+        default: {
+            return "scalar";
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LW_SIMD_H